@@ -0,0 +1,299 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/Implementation/BTreeBase.h>
+
+/// \brief An associative container with the same interface as nsMap, which is implemented as a B+ tree instead of a red-black tree.
+///
+/// nsMap allocates one node per element and every lookup follows one pointer per tree level. nsBTreeMap stores up to
+/// nsBTreeBase::Capacity keys per node contiguously, so it needs far fewer memory accesses per lookup and iterating over it is
+/// mostly a linear walk over arrays. This makes it the better choice for maps that are searched and iterated much more often than
+/// they are modified. Nodes of nsInt32 and nsUInt32 keys are searched with SIMD instructions.
+///
+/// All insertion/erasure/lookup functions take O(log n) time.
+///
+/// Unlike with nsMap, inserting or removing elements invalidates all iterators and moves the elements in memory,
+/// so pointers to keys or values must not be kept across modifications. Keys must be copyable.
+template <typename KeyType, typename ValueType, typename Comparer>
+class nsBTreeMapBase : public nsBTreeBase<KeyType, ValueType, Comparer>
+{
+  using Base = nsBTreeBase<KeyType, ValueType, Comparer>;
+  using Leaf = typename Base::Leaf;
+  using Position = typename Base::Position;
+
+public:
+  /// \brief Base class for all iterators.
+  struct ConstIterator
+  {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = ConstIterator;
+    using difference_type = ptrdiff_t;
+    using pointer = ConstIterator*;
+    using reference = ConstIterator&;
+
+    NS_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    NS_ALWAYS_INLINE ConstIterator() = default; // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    NS_ALWAYS_INLINE bool IsValid() const { return (m_pLeaf != nullptr); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    NS_ALWAYS_INLINE bool operator==(const ConstIterator& it2) const { return (m_pLeaf == it2.m_pLeaf && m_uiIndex == it2.m_uiIndex); }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    NS_ALWAYS_INLINE bool operator!=(const ConstIterator& it2) const { return !(*this == it2); }
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    NS_FORCE_INLINE const KeyType& Key() const
+    {
+      NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+      return m_pLeaf->GetKeys()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    NS_FORCE_INLINE const ValueType& Value() const
+    {
+      NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return m_pLeaf->GetValues()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns '*this' to enable foreach
+    NS_ALWAYS_INLINE ConstIterator& operator*() { return *this; } // [tested]
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    NS_FORCE_INLINE void Next()
+    {
+      NS_ASSERT_DEBUG(IsValid(), "The Iterator is invalid (end).");
+      Base::Next(m_pLeaf, m_uiIndex);
+    } // [tested]
+
+    /// \brief Advances the iterator to the previous element in the map. The iterator will not be valid anymore, if the end is reached.
+    NS_FORCE_INLINE void Prev()
+    {
+      NS_ASSERT_DEBUG(IsValid(), "The Iterator is invalid (end).");
+      Base::Prev(m_pLeaf, m_uiIndex);
+    } // [tested]
+
+    /// \brief Shorthand for 'Next'
+    NS_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    NS_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  protected:
+    friend class nsBTreeMapBase<KeyType, ValueType, Comparer>;
+
+    NS_ALWAYS_INLINE explicit ConstIterator(const Position& pos)
+      : m_pLeaf(pos.m_pLeaf)
+      , m_uiIndex(pos.m_uiIndex)
+    {
+    }
+
+    Leaf* m_pLeaf = nullptr;
+    nsUInt32 m_uiIndex = 0;
+  };
+
+  /// \brief Iterator to iterate over all elements in sorted order.
+  struct Iterator : public ConstIterator
+  {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Iterator;
+    using difference_type = ptrdiff_t;
+    using pointer = Iterator*;
+    using reference = Iterator&;
+
+    // this is required to pull in the const version of this function
+    using ConstIterator::Value;
+
+    NS_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    NS_ALWAYS_INLINE Iterator() = default;
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    NS_FORCE_INLINE ValueType& Value()
+    {
+      NS_ASSERT_DEBUG(this->IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return this->m_pLeaf->GetValues()[this->m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns '*this' to enable foreach
+    NS_ALWAYS_INLINE Iterator& operator*() { return *this; } // [tested]
+
+  private:
+    friend class nsBTreeMapBase<KeyType, ValueType, Comparer>;
+
+    NS_ALWAYS_INLINE explicit Iterator(const Position& pos)
+      : ConstIterator(pos)
+    {
+    }
+  };
+
+protected:
+  /// \brief Initializes the map to be empty.
+  nsBTreeMapBase(const Comparer& comparer, nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  nsBTreeMapBase(const nsBTreeMapBase<KeyType, ValueType, Comparer>& cc, nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  void operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs); // [tested]
+
+public:
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns an Iterator to the very last element. For reverse traversal.
+  Iterator GetLastIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very last element. For reverse traversal.
+  ConstIterator GetLastIterator() const; // [tested]
+
+  /// \brief Inserts the key/value pair into the tree and returns an Iterator to it. If the key already exists, its value is overwritten.
+  /// O(log n) operation.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  Iterator Insert(CompatibleKeyType&& key, CompatibleValueType&& value); // [tested]
+
+  /// \brief Erases the key/value pair with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. O(log n) operation. Returns an iterator to the element after the given
+  /// iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for the given key and returns an iterator to it. If it did not exist yet, it is default-created. \a out_pExisted is set
+  /// to true, if the key was found, false if it needed to be created.
+  template <typename CompatibleKeyType>
+  Iterator FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted = nullptr); // [tested]
+
+  /// \brief Allows read/write access to the value stored under the given key. If there is no such key, a new element is
+  /// default-constructed.
+  template <typename CompatibleKeyType>
+  ValueType& operator[](const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the corresponding value to out_value.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Either returns the value of the entry with the given key, if found, or the provided default value.
+  template <typename CompatibleKeyType>
+  const ValueType& GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const; // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator==(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator!=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(nsBTreeMapBase<KeyType, ValueType, Comparer>& other); // [tested]
+};
+
+/// \brief \see nsBTreeMapBase
+template <typename KeyType, typename ValueType, typename Comparer = nsCompareHelper<KeyType>, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsBTreeMap : public nsBTreeMapBase<KeyType, ValueType, Comparer>
+{
+public:
+  nsBTreeMap();
+  explicit nsBTreeMap(nsAllocatorBase* pAllocator);
+  nsBTreeMap(const Comparer& comparer, nsAllocatorBase* pAllocator);
+
+  nsBTreeMap(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other);
+  nsBTreeMap(const nsBTreeMapBase<KeyType, ValueType, Comparer>& other);
+
+  void operator=(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+};
+
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator begin(nsBTreeMapBase<KeyType, ValueType, Comparer>& ref_container)
+{
+  return ref_container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator begin(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cbegin(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator end(nsBTreeMapBase<KeyType, ValueType, Comparer>& ref_container)
+{
+  return typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator end(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cend(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeMap_inl.h>
@@ -0,0 +1,180 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/Implementation/BTreeBase.h>
+
+/// \brief A set container with the same interface as nsSet, which is implemented as a B+ tree instead of a red-black tree.
+///
+/// See nsBTreeMapBase for the differences to nsSet. Inserting or removing elements invalidates all iterators.
+template <typename KeyType, typename Comparer>
+class nsBTreeSetBase : public nsBTreeBase<KeyType, void, Comparer>
+{
+  using Base = nsBTreeBase<KeyType, void, Comparer>;
+  using Leaf = typename Base::Leaf;
+  using Position = typename Base::Position;
+
+public:
+  /// \brief Iterator to iterate over all elements in sorted order.
+  struct Iterator
+  {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Iterator;
+    using difference_type = ptrdiff_t;
+    using pointer = Iterator*;
+    using reference = Iterator&;
+
+    NS_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    NS_ALWAYS_INLINE Iterator() = default; // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    NS_ALWAYS_INLINE bool IsValid() const { return (m_pLeaf != nullptr); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    NS_ALWAYS_INLINE bool operator==(const Iterator& it2) const { return (m_pLeaf == it2.m_pLeaf && m_uiIndex == it2.m_uiIndex); }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    NS_ALWAYS_INLINE bool operator!=(const Iterator& it2) const { return !(*this == it2); }
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    NS_FORCE_INLINE const KeyType& Key() const
+    {
+      NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+      return m_pLeaf->GetKeys()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    NS_ALWAYS_INLINE const KeyType& operator*() const { return Key(); } // [tested]
+
+    /// \brief Advances the iterator to the next element in the set. The iterator will not be valid anymore, if the end is reached.
+    NS_FORCE_INLINE void Next()
+    {
+      NS_ASSERT_DEBUG(IsValid(), "The Iterator is invalid (end).");
+      Base::Next(m_pLeaf, m_uiIndex);
+    } // [tested]
+
+    /// \brief Advances the iterator to the previous element in the set. The iterator will not be valid anymore, if the end is reached.
+    NS_FORCE_INLINE void Prev()
+    {
+      NS_ASSERT_DEBUG(IsValid(), "The Iterator is invalid (end).");
+      Base::Prev(m_pLeaf, m_uiIndex);
+    } // [tested]
+
+    /// \brief Shorthand for 'Next'
+    NS_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    NS_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  private:
+    friend class nsBTreeSetBase<KeyType, Comparer>;
+
+    NS_ALWAYS_INLINE explicit Iterator(const Position& pos)
+      : m_pLeaf(pos.m_pLeaf)
+      , m_uiIndex(pos.m_uiIndex)
+    {
+    }
+
+    Leaf* m_pLeaf = nullptr;
+    nsUInt32 m_uiIndex = 0;
+  };
+
+protected:
+  /// \brief Initializes the set to be empty.
+  nsBTreeSetBase(const Comparer& comparer, nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all keys from the given set into this one.
+  nsBTreeSetBase(const nsBTreeSetBase<KeyType, Comparer>& cc, nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all keys from the given set into this one.
+  void operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs); // [tested]
+
+public:
+  /// \brief Returns a constant Iterator to the very first element.
+  Iterator GetIterator() const; // [tested]
+
+  /// \brief Returns a constant Iterator to the very last element. For reverse traversal.
+  Iterator GetLastIterator() const; // [tested]
+
+  /// \brief Inserts the key into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Insert(CompatibleKeyType&& key); // [tested]
+
+  /// \brief Erases the element with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the element at the given Iterator. O(log n) operation. Returns an iterator to the element after the given iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no such
+  /// element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no such
+  /// element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator==(const nsBTreeSetBase<KeyType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator!=(const nsBTreeSetBase<KeyType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Swaps this set with the other one.
+  void Swap(nsBTreeSetBase<KeyType, Comparer>& other); // [tested]
+};
+
+/// \brief \see nsBTreeSetBase
+template <typename KeyType, typename Comparer = nsCompareHelper<KeyType>, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsBTreeSet : public nsBTreeSetBase<KeyType, Comparer>
+{
+public:
+  nsBTreeSet();
+  explicit nsBTreeSet(nsAllocatorBase* pAllocator);
+  nsBTreeSet(const Comparer& comparer, nsAllocatorBase* pAllocator);
+
+  nsBTreeSet(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& other);
+  nsBTreeSet(const nsBTreeSetBase<KeyType, Comparer>& other);
+
+  void operator=(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs);
+};
+
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator begin(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator cbegin(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator end(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  return typename nsBTreeSetBase<KeyType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator cend(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  return typename nsBTreeSetBase<KeyType, Comparer>::Iterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeSet_inl.h>
@@ -71,10 +71,89 @@ public:
   /// \brief Clears the range starting at uiFirstBit up to (and including) uiLastBit to 0.
   void ClearBitRange(nsUInt32 uiFirstBit, nsUInt32 uiNumBits); // [tested]
 
+  /// \brief Returns the count of how many bits are set in total.
+  nsUInt32 GetNumBitsSet() const; // [tested]
+
+  /// \brief Returns the index of the lowest bit that is set. Returns GetCount() in case no bit is set, at all.
+  nsUInt32 GetLowestBitSet() const; // [tested]
+
+  /// \brief Returns the index of the first bit at or after uiStartBit that is set. Returns GetCount() in case there is none.
+  nsUInt32 FindNextBitSet(nsUInt32 uiStartBit) const; // [tested]
+
+  /// \brief Modifies \a this to only contain the bits that were set in \a this and \a rhs. Both bitfields must have the same size.
+  template <class OtherContainer>
+  void operator&=(const nsBitfield<OtherContainer>& rhs); // [tested]
+
+  /// \brief Modifies \a this to also contain the bits from \a rhs. Both bitfields must have the same size.
+  template <class OtherContainer>
+  void operator|=(const nsBitfield<OtherContainer>& rhs); // [tested]
+
+  /// \brief Modifies \a this to only contain the bits that are set in either \a this or \a rhs, but not in both. Both bitfields must have the same size.
+  template <class OtherContainer>
+  void operator^=(const nsBitfield<OtherContainer>& rhs); // [tested]
+
+  /// \brief Clears all bits in \a this that are set in \a rhs. Both bitfields must have the same size.
+  template <class OtherContainer>
+  void ClearBits(const nsBitfield<OtherContainer>& rhs); // [tested]
+
+  /// \brief Iterates over the indices of all bits that are set, in ascending order. Skips 32 cleared bits at a time.
+  ///
+  /// Use GetSetBitIndices() to iterate with a range based for loop. The bitfield must not be resized during the iteration.
+  class ConstSetBitIterator
+  {
+  public:
+    /// \brief Returns whether the iterator points to a set bit.
+    bool IsValid() const { return m_uiBit < m_pBitfield->m_uiCount; }
+
+    /// \brief Returns the index of the set bit that the iterator points to.
+    nsUInt32 Value() const { return m_uiBit; }
+
+    /// \brief Advances to the next set bit.
+    void Next();
+
+    nsUInt32 operator*() const { return m_uiBit; }
+    void operator++() { Next(); }
+    bool operator==(const ConstSetBitIterator& rhs) const { return m_uiBit == rhs.m_uiBit; }
+    bool operator!=(const ConstSetBitIterator& rhs) const { return m_uiBit != rhs.m_uiBit; }
+
+  private:
+    friend class nsBitfield<Container>;
+
+    ConstSetBitIterator(const nsBitfield<Container>* pBitfield, nsUInt32 uiStartBit);
+
+    const nsBitfield<Container>* m_pBitfield;
+    nsUInt32 m_uiBit;
+    nsUInt32 m_uiRemainingBits = 0; ///< The bits of the current int above m_uiBit.
+  };
+
+  /// \brief Helper to iterate over all set bits with a range based for loop, see GetSetBitIndices().
+  struct SetBitIndices
+  {
+    ConstSetBitIterator begin() const { return ConstSetBitIterator(m_pBitfield, 0); }
+    ConstSetBitIterator end() const { return ConstSetBitIterator(m_pBitfield, m_pBitfield->m_uiCount); }
+
+    const nsBitfield<Container>* m_pBitfield;
+  };
+
+  /// \brief Returns an iterator to the lowest set bit.
+  ConstSetBitIterator GetSetBitIterator() const { return ConstSetBitIterator(this, 0); } // [tested]
+
+  /// \brief Allows to iterate over the indices of all set bits with a range based for loop:
+  /// \code{.cpp}
+  ///   for (nsUInt32 uiBit : bitfield.GetSetBitIndices()) { ... }
+  /// \endcode
+  SetBitIndices GetSetBitIndices() const { return {this}; } // [tested]
+
 private:
+  template <class OtherContainer>
+  friend class nsBitfield;
+
   nsUInt32 GetBitInt(nsUInt32 uiBitIndex) const;
   nsUInt32 GetBitMask(nsUInt32 uiBitIndex) const;
 
+  /// \brief Returns the bits of the given int, without the unused bits of the last int.
+  nsUInt32 GetIntBits(nsUInt32 uiIntIndex) const;
+
   nsUInt32 m_uiCount = 0;
   Container m_Container;
 };
@@ -0,0 +1,216 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/Id.h>
+
+/// \brief A handle based object pool, similar to nsIdTable, that can insert and remove elements from multiple threads at the same time.
+///
+/// Values are stored in chunks that are never moved or freed while the pool exists, so pointers to values stay valid until the value
+/// is removed. Every chunk holds twice as many elements as the one before and stores its data as separate arrays: a bitmask of live slots,
+/// the slot states (generation + alive flag), the free-list links and the values themselves.
+///
+/// Insert() and Remove() are lock-free. Freed slots go into a lock-free free-list and are reused before new slots are taken.
+/// Every handle contains the generation of its slot, so stale handles to removed or reused slots are detected.
+/// Iteration only visits live elements by walking the bitmasks of each chunk.
+///
+/// It is safe to insert, remove and look up different elements concurrently. Accessing a value while another thread removes it,
+/// as well as iterating and Clear() while other threads modify the pool, is not.
+///
+/// \note Valid IDs will never be all zero (index + generation).
+///
+/// \see nsIdTable
+template <typename IdType, typename ValueType>
+class nsHandlePoolBase
+{
+  enum : nsUInt32
+  {
+    CHUNK_BASE_SHIFT = 6,
+    CHUNK_BASE_SIZE = 1u << CHUNK_BASE_SHIFT,
+    MAX_CHUNKS = 32 - CHUNK_BASE_SHIFT,
+    INVALID_FREELIST_INDEX = 0xFFFFFFFFu,
+  };
+
+public:
+  using IndexType = nsUInt32;
+  using TypeOfId = IdType;
+
+  /// \brief Const iterator.
+  class ConstIterator
+  {
+  public:
+    /// \brief Checks whether this iterator points to a valid element.
+    bool IsValid() const { return m_uiChunk < MAX_CHUNKS; } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator==(const ConstIterator& it2) const { return m_pPool == it2.m_pPool && m_uiChunk == it2.m_uiChunk && m_uiSlot == it2.m_uiSlot; }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator!=(const ConstIterator& it2) const { return !(*this == it2); }
+
+    /// \brief Returns the 'id' of the element that this iterator points to.
+    IdType Id() const; // [tested]
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    const ValueType& Value() const; // [tested]
+
+    /// \brief Advances the iterator to the next element in the pool. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    void operator++() { Next(); } // [tested]
+
+  protected:
+    friend class nsHandlePoolBase<IdType, ValueType>;
+
+    explicit ConstIterator(const nsHandlePoolBase<IdType, ValueType>& pool);
+
+    const nsHandlePoolBase<IdType, ValueType>* m_pPool = nullptr;
+    nsUInt32 m_uiChunk = 0;        // chunk of the current element
+    nsUInt32 m_uiSlot = 0;         // slot of the current element inside the chunk
+    nsUInt32 m_uiWord = 0;         // bitmask word that is currently searched
+    nsUInt64 m_uiRemainingBits = 0; // live slots of the current word that have not been visited yet
+  };
+
+  /// \brief Iterator with write access.
+  struct Iterator : public ConstIterator
+  {
+  public:
+    // this is required to pull in the const version of this function
+    using ConstIterator::Value;
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    ValueType& Value(); // [tested]
+
+  private:
+    friend class nsHandlePoolBase<IdType, ValueType>;
+
+    explicit Iterator(const nsHandlePoolBase<IdType, ValueType>& pool);
+  };
+
+protected:
+  /// \brief Creates an empty pool. Does not allocate any data yet.
+  explicit nsHandlePoolBase(nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~nsHandlePoolBase(); // [tested]
+
+public:
+  NS_DISALLOW_COPY_AND_ASSIGN(nsHandlePoolBase);
+
+  /// \brief Allocates all chunks that are needed to store the given number of elements. Not thread-safe.
+  void Reserve(IndexType capacity); // [tested]
+
+  /// \brief Returns the number of live entries in the pool. While other threads insert or remove elements, this is only a snapshot.
+  IndexType GetCount() const; // [tested]
+
+  /// \brief Returns true, if the pool does not contain any elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Removes all elements. All existing ids become invalid, the memory is kept. Not thread-safe.
+  void Clear(); // [tested]
+
+  /// \brief Inserts the value into the pool and returns the corresponding id. Thread-safe.
+  IdType Insert(const ValueType& value); // [tested]
+
+  /// \brief Inserts the temporary value into the pool and returns the corresponding id. Thread-safe.
+  IdType Insert(ValueType&& value); // [tested]
+
+  /// \brief Removes the entry with the given id. Returns if an entry was removed and optionally writes out the old value to out_pOldValue.
+  ///
+  /// Thread-safe. If several threads try to remove the same id, exactly one of them succeeds.
+  bool Remove(const IdType id, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Returns if an entry with the given id was found and if found writes out the corresponding value to out_value.
+  bool TryGetValue(const IdType id, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns if an entry with the given id was found and if found writes out the pointer to the corresponding value to out_pValue.
+  bool TryGetValue(const IdType id, ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns the value to the given id. Checks for stale access in debug builds.
+  const ValueType& operator[](const IdType id) const; // [tested]
+
+  /// \brief Returns the value to the given id. Checks for stale access in debug builds.
+  ValueType& operator[](const IdType id); // [tested]
+
+  /// \brief Returns if the pool contains an entry corresponding to the given id.
+  bool Contains(const IdType id) const; // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocatorBase* GetAllocator() const { return m_pAllocator; }
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Returns whether the internal free-list is valid. Not thread-safe, for testing purpose only.
+  bool IsFreelistValid() const;
+
+private:
+  template <typename CompatibleValueType>
+  IdType InsertInternal(CompatibleValueType&& value);
+
+  // A slot state stores the generation in the upper bits and whether the slot is in use in the lowest bit.
+  static constexpr nsInt32 MakeState(nsUInt32 uiGeneration, bool bAlive) { return static_cast<nsInt32>((uiGeneration << 1) | (bAlive ? 1u : 0u)); }
+  static nsUInt32 GetNextGeneration(IndexType index, nsUInt32 uiGeneration);
+
+  static nsUInt32 GetChunkIndex(IndexType index, nsUInt32& out_uiSlot);
+  static nsUInt32 GetChunkCapacity(nsUInt32 uiChunk) { return CHUNK_BASE_SIZE << uiChunk; }
+  static IndexType GetChunkStartIndex(nsUInt32 uiChunk) { return (CHUNK_BASE_SIZE << uiChunk) - CHUNK_BASE_SIZE; }
+  static size_t GetValuesOffset(nsUInt32 uiChunk);
+  static size_t GetChunkSize(nsUInt32 uiChunk);
+
+  static volatile nsInt64* GetLiveMasks(nsUInt8* pChunk) { return reinterpret_cast<volatile nsInt64*>(pChunk); }
+  static volatile nsInt32* GetStates(nsUInt8* pChunk, nsUInt32 uiChunk) { return reinterpret_cast<volatile nsInt32*>(pChunk + GetChunkCapacity(uiChunk) / 8); }
+  static volatile nsUInt32* GetFreelistLinks(nsUInt8* pChunk, nsUInt32 uiChunk) { return reinterpret_cast<volatile nsUInt32*>(pChunk + GetChunkCapacity(uiChunk) / 8 + GetChunkCapacity(uiChunk) * 4); }
+  static ValueType* GetValues(nsUInt8* pChunk, nsUInt32 uiChunk) { return reinterpret_cast<ValueType*>(pChunk + GetValuesOffset(uiChunk)); }
+
+  /// \brief Returns the chunk with the given index or nullptr, if it was not allocated yet.
+  nsUInt8* GetChunk(nsUInt32 uiChunk) const { return static_cast<nsUInt8*>(m_Chunks[uiChunk]); }
+
+  /// \brief Returns the chunk with the given index and allocates it, if necessary. Several threads may race to allocate the same chunk.
+  nsUInt8* GetOrCreateChunk(nsUInt32 uiChunk);
+
+  /// \brief Returns the chunk and slot of a live element with the given id or nullptr, if the id is stale or invalid.
+  nsUInt8* FindSlot(const IdType id, nsUInt32& out_uiChunk, nsUInt32& out_uiSlot) const;
+
+  IndexType PopFreelist();
+  void PushFreelist(IndexType index);
+
+  static constexpr IndexType GetMaxCapacity()
+  {
+    return static_cast<nsUInt64>(IdType::INVALID_INSTANCE_INDEX) < 0x7FFFFFFFull ? static_cast<IndexType>(IdType::INVALID_INSTANCE_INDEX) : 0x7FFFFFFFu;
+  }
+
+  void* volatile m_Chunks[MAX_CHUNKS] = {};
+
+  // Lower 32 bits are the first free index, the upper 32 bits are a counter that changes with every modification to prevent ABA problems.
+  volatile nsInt64 m_iFreelistHead = static_cast<nsInt64>(INVALID_FREELIST_INDEX);
+
+  // Slots below this index have been handed out at least once, everything above was never used. Never exceeds GetMaxCapacity().
+  nsAtomicInteger32 m_iNextUnusedIndex;
+
+  nsAtomicInteger32 m_iCount;
+  nsAllocatorBase* m_pAllocator;
+};
+
+/// \brief \see nsHandlePoolBase
+template <typename IdType, typename ValueType, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsHandlePool : public nsHandlePoolBase<IdType, ValueType>
+{
+public:
+  nsHandlePool();
+  explicit nsHandlePool(nsAllocatorBase* pAllocator);
+};
+
+#include <Foundation/Containers/Implementation/HandlePool_inl.h>
@@ -0,0 +1,209 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Algorithm/Comparer.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+
+/// \brief Searches sorted arrays of 32 bit integers, four keys at a time. Used by nsBTreeMap and nsBTreeSet to search their nodes.
+struct NS_FOUNDATION_DLL nsBTreeSearch
+{
+  /// \brief Returns the number of keys that are smaller than iKey, which is the index of the first key that is equal or larger.
+  static nsUInt32 CountLess(const nsInt32* pKeys, nsUInt32 uiCount, nsInt32 iKey);
+
+  /// \brief \see CountLess
+  static nsUInt32 CountLess(const nsUInt32* pKeys, nsUInt32 uiCount, nsUInt32 uiKey);
+
+  /// \brief Returns the number of keys that are smaller or equal to iKey, which is the index of the first key that is larger.
+  static nsUInt32 CountLessEqual(const nsInt32* pKeys, nsUInt32 uiCount, nsInt32 iKey);
+
+  /// \brief \see CountLessEqual
+  static nsUInt32 CountLessEqual(const nsUInt32* pKeys, nsUInt32 uiCount, nsUInt32 uiKey);
+};
+
+namespace nsInternal
+{
+  /// \brief Raw storage for the values of one nsBTreeBase leaf.
+  template <typename ValueType, nsUInt32 Capacity>
+  struct BTreeValues
+  {
+    NS_ALWAYS_INLINE ValueType* GetData() { return reinterpret_cast<ValueType*>(m_Data); }
+
+    alignas(ValueType) nsUInt8 m_Data[sizeof(ValueType) * Capacity];
+  };
+
+  /// \brief Sets don't store any values.
+  template <nsUInt32 Capacity>
+  struct BTreeValues<void, Capacity>
+  {
+    NS_ALWAYS_INLINE void* GetData() { return nullptr; }
+  };
+} // namespace nsInternal
+
+/// \brief The implementation shared by nsBTreeMap and nsBTreeSet. Use those instead.
+///
+/// This is a B+ tree. Every node stores up to Capacity keys contiguously, so a lookup touches only a few cache lines per level,
+/// and the tree is only a few levels deep. All elements are stored in the leaves, which are linked to each other, so iterating
+/// is a linear walk over arrays. Inner nodes only store copies of some keys to direct the search, so KeyType must be copyable.
+///
+/// Nodes of 32 bit integer keys are searched with SIMD instructions, as long as the default comparer is used.
+///
+/// ValueType is void for sets.
+template <typename KeyType, typename ValueType, typename Comparer>
+class nsBTreeBase
+{
+public:
+  /// \brief The maximum number of keys that are stored in one node.
+  static constexpr nsUInt32 Capacity = sizeof(KeyType) <= 8 ? 32 : (sizeof(KeyType) <= 32 ? 16 : 8);
+
+  /// \brief Returns whether there are no elements in the container. O(1) operation.
+  bool IsEmpty() const { return m_uiCount == 0; } // [tested]
+
+  /// \brief Returns the number of elements currently stored in the container. O(1) operation.
+  nsUInt32 GetCount() const { return m_uiCount; } // [tested]
+
+  /// \brief Destroys all elements and frees all nodes.
+  void Clear(); // [tested]
+
+  /// \brief Checks whether the given key is in the container. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocatorBase* GetAllocator() const { return m_pAllocator; }
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const { return (nsUInt64)m_uiNumLeaves * sizeof(Leaf) + (nsUInt64)m_uiNumInnerNodes * sizeof(Inner); } // [tested]
+
+protected:
+  static constexpr bool HasValues = !std::is_void<ValueType>::value;
+  static constexpr nsUInt32 MinCount = Capacity / 2;
+  static constexpr nsUInt32 MaxDepth = 24;
+
+  template <typename CompatibleKeyType>
+  static constexpr bool UseSimdSearch = std::is_same<Comparer, nsCompareHelper<KeyType>>::value && std::is_same<CompatibleKeyType, KeyType>::value &&
+                                        (std::is_same<KeyType, nsInt32>::value || std::is_same<KeyType, nsUInt32>::value);
+
+  struct Node
+  {
+    nsUInt32 m_uiCount = 0;
+    bool m_bIsLeaf = false;
+  };
+
+  struct Leaf : public Node
+  {
+    NS_ALWAYS_INLINE KeyType* GetKeys() { return reinterpret_cast<KeyType*>(m_KeyData); }
+    NS_ALWAYS_INLINE auto GetValues() { return m_Values.GetData(); }
+
+    Leaf* m_pPrev = nullptr;
+    Leaf* m_pNext = nullptr;
+    alignas(KeyType) nsUInt8 m_KeyData[sizeof(KeyType) * Capacity];
+    nsInternal::BTreeValues<ValueType, Capacity> m_Values;
+  };
+
+  struct Inner : public Node
+  {
+    NS_ALWAYS_INLINE KeyType* GetKeys() { return reinterpret_cast<KeyType*>(m_KeyData); }
+
+    alignas(KeyType) nsUInt8 m_KeyData[sizeof(KeyType) * Capacity];
+    Node* m_pChildren[Capacity + 1];
+  };
+
+  /// \brief An element in a leaf. An invalid position has no leaf.
+  struct Position
+  {
+    Leaf* m_pLeaf = nullptr;
+    nsUInt32 m_uiIndex = 0;
+  };
+
+  /// \brief The inner nodes that were visited on the way to a leaf and which child was taken in each of them.
+  struct Path
+  {
+    Inner* m_pNodes[MaxDepth];
+    nsUInt32 m_uiChildIndex[MaxDepth];
+    nsUInt32 m_uiDepth = 0;
+  };
+
+  nsBTreeBase(const Comparer& comparer, nsAllocatorBase* pAllocator);
+  ~nsBTreeBase();
+
+  void CopyFrom(const nsBTreeBase<KeyType, ValueType, Comparer>& rhs);
+  void SwapBase(nsBTreeBase<KeyType, ValueType, Comparer>& other);
+  bool IsEqual(const nsBTreeBase<KeyType, ValueType, Comparer>& rhs) const;
+
+  static void Next(Leaf*& ref_pLeaf, nsUInt32& ref_uiIndex);
+  static void Prev(Leaf*& ref_pLeaf, nsUInt32& ref_uiIndex);
+
+  Position GetFirst() const;
+  Position GetLast() const;
+
+  template <typename CompatibleKeyType>
+  Position Internal_Find(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  Position Internal_LowerBound(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  Position Internal_UpperBound(const CompatibleKeyType& key) const;
+
+  /// \brief Inserts the key, if it doesn't exist yet, and constructs its value from args. Otherwise only sets out_bExisted.
+  template <typename CompatibleKeyType, typename... Args>
+  Position Internal_Insert(CompatibleKeyType&& key, bool& out_bExisted, Args&&... args);
+
+  template <typename CompatibleKeyType>
+  bool Internal_Remove(const CompatibleKeyType& key);
+
+  /// \brief Removes the element at pos and returns the position of the element that followed it.
+  Position Internal_Remove(const Position& pos);
+
+private:
+  template <typename CompatibleKeyType>
+  nsUInt32 LowerBoundIndex(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  nsUInt32 UpperBoundIndex(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  Leaf* Descend(const CompatibleKeyType& key, Path* pPath) const;
+
+  template <typename T>
+  static void MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount);
+  template <typename T>
+  static void MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount, nsTypeIsPod);
+  template <typename T>
+  static void MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount, nsTypeIsMemRelocatable);
+  template <typename T>
+  static void MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount, nsTypeIsClass);
+  static void MoveEntries(Leaf* pDestination, nsUInt32 uiDestinationIndex, Leaf* pSource, nsUInt32 uiSourceIndex, nsUInt32 uiCount);
+  template <typename CompatibleKeyType>
+  static void InsertKey(KeyType* pKeys, nsUInt32 uiCount, nsUInt32 uiIndex, CompatibleKeyType&& key);
+  static void RemoveKey(KeyType* pKeys, nsUInt32 uiCount, nsUInt32 uiIndex);
+  static void InsertChild(Node** pChildren, nsUInt32 uiCount, nsUInt32 uiIndex, Node* pChild);
+  static void RemoveChild(Node** pChildren, nsUInt32 uiCount, nsUInt32 uiIndex);
+
+  static Position Normalize(Leaf* pLeaf, nsUInt32 uiIndex);
+
+  Leaf* AcquireLeaf();
+  Inner* AcquireInner();
+  void ReleaseLeaf(Leaf* pLeaf);
+  void ReleaseInner(Inner* pInner);
+  void FreeTree(Node* pNode);
+
+  /// \brief Inserts separator and pRight behind the child that was taken at the last level of the path, splitting nodes as needed.
+  void InsertIntoParent(Path& ref_path, KeyType& ref_separator, Node* pRight);
+
+  /// \brief Removes the key at uiKeyIndex and the child behind it from the inner node at uiLevel of the path and rebalances the tree.
+  void RemoveFromInner(Path& ref_path, nsUInt32 uiLevel, nsUInt32 uiKeyIndex);
+
+  Node* m_pRoot = nullptr;
+  Leaf* m_pFirstLeaf = nullptr;
+  Leaf* m_pLastLeaf = nullptr;
+  nsUInt32 m_uiCount = 0;
+  nsUInt32 m_uiNumLeaves = 0;
+  nsUInt32 m_uiNumInnerNodes = 0;
+  nsAllocatorBase* m_pAllocator;
+  Comparer m_Comparer;
+};
+
+#include <Foundation/Containers/Implementation/BTreeBase_inl.h>
@@ -0,0 +1,768 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Memory/MemoryUtils.h>
+
+template <typename KeyType, typename ValueType, typename Comparer>
+nsBTreeBase<KeyType, ValueType, Comparer>::nsBTreeBase(const Comparer& comparer, nsAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+  , m_Comparer(comparer)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+nsBTreeBase<KeyType, ValueType, Comparer>::~nsBTreeBase()
+{
+  Clear();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::Clear()
+{
+  if (m_pRoot != nullptr)
+  {
+    FreeTree(m_pRoot);
+  }
+
+  m_pRoot = nullptr;
+  m_pFirstLeaf = nullptr;
+  m_pLastLeaf = nullptr;
+  m_uiCount = 0;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::FreeTree(Node* pNode)
+{
+  if (pNode->m_bIsLeaf)
+  {
+    Leaf* pLeaf = static_cast<Leaf*>(pNode);
+    nsMemoryUtils::Destruct(pLeaf->GetKeys(), pLeaf->m_uiCount);
+
+    if constexpr (HasValues)
+    {
+      nsMemoryUtils::Destruct(pLeaf->GetValues(), pLeaf->m_uiCount);
+    }
+
+    ReleaseLeaf(pLeaf);
+  }
+  else
+  {
+    Inner* pInner = static_cast<Inner*>(pNode);
+    nsMemoryUtils::Destruct(pInner->GetKeys(), pInner->m_uiCount);
+
+    for (nsUInt32 i = 0; i <= pInner->m_uiCount; ++i)
+    {
+      FreeTree(pInner->m_pChildren[i]);
+    }
+
+    ReleaseInner(pInner);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::CopyFrom(const nsBTreeBase<KeyType, ValueType, Comparer>& rhs)
+{
+  bool bExisted = false;
+
+  for (Leaf* pLeaf = rhs.m_pFirstLeaf; pLeaf != nullptr; pLeaf = pLeaf->m_pNext)
+  {
+    for (nsUInt32 i = 0; i < pLeaf->m_uiCount; ++i)
+    {
+      if constexpr (HasValues)
+      {
+        Internal_Insert(static_cast<const KeyType&>(pLeaf->GetKeys()[i]), bExisted, static_cast<const ValueType&>(pLeaf->GetValues()[i]));
+      }
+      else
+      {
+        Internal_Insert(static_cast<const KeyType&>(pLeaf->GetKeys()[i]), bExisted);
+      }
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::SwapBase(nsBTreeBase<KeyType, ValueType, Comparer>& other)
+{
+  nsMath::Swap(m_pRoot, other.m_pRoot);
+  nsMath::Swap(m_pFirstLeaf, other.m_pFirstLeaf);
+  nsMath::Swap(m_pLastLeaf, other.m_pLastLeaf);
+  nsMath::Swap(m_uiCount, other.m_uiCount);
+  nsMath::Swap(m_uiNumLeaves, other.m_uiNumLeaves);
+  nsMath::Swap(m_uiNumInnerNodes, other.m_uiNumInnerNodes);
+  nsMath::Swap(m_pAllocator, other.m_pAllocator);
+  nsMath::Swap(m_Comparer, other.m_Comparer);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+bool nsBTreeBase<KeyType, ValueType, Comparer>::IsEqual(const nsBTreeBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  Position lhsPos = GetFirst();
+  Position rhsPos = rhs.GetFirst();
+
+  while (lhsPos.m_pLeaf != nullptr)
+  {
+    const KeyType& lhsKey = lhsPos.m_pLeaf->GetKeys()[lhsPos.m_uiIndex];
+    const KeyType& rhsKey = rhsPos.m_pLeaf->GetKeys()[rhsPos.m_uiIndex];
+
+    if (m_Comparer.Less(lhsKey, rhsKey) || m_Comparer.Less(rhsKey, lhsKey))
+      return false;
+
+    if constexpr (HasValues)
+    {
+      if (!(lhsPos.m_pLeaf->GetValues()[lhsPos.m_uiIndex] == rhsPos.m_pLeaf->GetValues()[rhsPos.m_uiIndex]))
+        return false;
+    }
+
+    Next(lhsPos.m_pLeaf, lhsPos.m_uiIndex);
+    Next(rhsPos.m_pLeaf, rhsPos.m_uiIndex);
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::Next(Leaf*& ref_pLeaf, nsUInt32& ref_uiIndex)
+{
+  if (++ref_uiIndex >= ref_pLeaf->m_uiCount)
+  {
+    ref_pLeaf = ref_pLeaf->m_pNext;
+    ref_uiIndex = 0;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::Prev(Leaf*& ref_pLeaf, nsUInt32& ref_uiIndex)
+{
+  if (ref_uiIndex > 0)
+  {
+    --ref_uiIndex;
+    return;
+  }
+
+  ref_pLeaf = ref_pLeaf->m_pPrev;
+  ref_uiIndex = ref_pLeaf != nullptr ? ref_pLeaf->m_uiCount - 1 : 0;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::GetFirst() const
+{
+  return {m_pFirstLeaf, 0};
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::GetLast() const
+{
+  if (m_pLastLeaf == nullptr)
+    return {};
+
+  return {m_pLastLeaf, m_pLastLeaf->m_uiCount - 1};
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::Normalize(Leaf* pLeaf, nsUInt32 uiIndex)
+{
+  if (uiIndex >= pLeaf->m_uiCount)
+    return {pLeaf->m_pNext, 0};
+
+  return {pLeaf, uiIndex};
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE nsUInt32 nsBTreeBase<KeyType, ValueType, Comparer>::LowerBoundIndex(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const
+{
+  if constexpr (UseSimdSearch<CompatibleKeyType>)
+  {
+    return nsBTreeSearch::CountLess(pKeys, uiCount, key);
+  }
+  else
+  {
+    nsUInt32 uiFirst = 0;
+
+    while (uiCount > 0)
+    {
+      const nsUInt32 uiHalf = uiCount / 2;
+
+      if (m_Comparer.Less(pKeys[uiFirst + uiHalf], key))
+      {
+        uiFirst += uiHalf + 1;
+        uiCount -= uiHalf + 1;
+      }
+      else
+      {
+        uiCount = uiHalf;
+      }
+    }
+
+    return uiFirst;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE nsUInt32 nsBTreeBase<KeyType, ValueType, Comparer>::UpperBoundIndex(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const
+{
+  if constexpr (UseSimdSearch<CompatibleKeyType>)
+  {
+    return nsBTreeSearch::CountLessEqual(pKeys, uiCount, key);
+  }
+  else
+  {
+    nsUInt32 uiFirst = 0;
+
+    while (uiCount > 0)
+    {
+      const nsUInt32 uiHalf = uiCount / 2;
+
+      if (!m_Comparer.Less(key, pKeys[uiFirst + uiHalf]))
+      {
+        uiFirst += uiHalf + 1;
+        uiCount -= uiHalf + 1;
+      }
+      else
+      {
+        uiCount = uiHalf;
+      }
+    }
+
+    return uiFirst;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Leaf* nsBTreeBase<KeyType, ValueType, Comparer>::Descend(const CompatibleKeyType& key, Path* pPath) const
+{
+  Node* pNode = m_pRoot;
+
+  while (!pNode->m_bIsLeaf)
+  {
+    Inner* pInner = static_cast<Inner*>(pNode);
+
+    // keys equal to a separator are stored right of it
+    const nsUInt32 uiChild = UpperBoundIndex(pInner->GetKeys(), pInner->m_uiCount, key);
+
+    if (pPath != nullptr)
+    {
+      NS_ASSERT_DEBUG(pPath->m_uiDepth < MaxDepth, "nsBTreeBase is deeper than expected.");
+      pPath->m_pNodes[pPath->m_uiDepth] = pInner;
+      pPath->m_uiChildIndex[pPath->m_uiDepth] = uiChild;
+      ++pPath->m_uiDepth;
+    }
+
+    pNode = pInner->m_pChildren[uiChild];
+  }
+
+  return static_cast<Leaf*>(pNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::Internal_Find(const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return {};
+
+  Leaf* pLeaf = Descend(key, nullptr);
+  const nsUInt32 uiIndex = LowerBoundIndex(pLeaf->GetKeys(), pLeaf->m_uiCount, key);
+
+  if (uiIndex < pLeaf->m_uiCount && !m_Comparer.Less(key, pLeaf->GetKeys()[uiIndex]))
+    return {pLeaf, uiIndex};
+
+  return {};
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::Internal_LowerBound(const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return {};
+
+  Leaf* pLeaf = Descend(key, nullptr);
+  return Normalize(pLeaf, LowerBoundIndex(pLeaf->GetKeys(), pLeaf->m_uiCount, key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::Internal_UpperBound(const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return {};
+
+  Leaf* pLeaf = Descend(key, nullptr);
+  return Normalize(pLeaf, UpperBoundIndex(pLeaf->GetKeys(), pLeaf->m_uiCount, key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeBase<KeyType, ValueType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return Internal_Find(key).m_pLeaf != nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename... Args>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::Internal_Insert(CompatibleKeyType&& key, bool& out_bExisted, Args&&... args)
+{
+  if (m_pRoot == nullptr)
+  {
+    m_pFirstLeaf = AcquireLeaf();
+    m_pLastLeaf = m_pFirstLeaf;
+    m_pRoot = m_pFirstLeaf;
+  }
+
+  Path path;
+  Leaf* pLeaf = Descend(key, &path);
+  nsUInt32 uiIndex = LowerBoundIndex(pLeaf->GetKeys(), pLeaf->m_uiCount, key);
+
+  if (uiIndex < pLeaf->m_uiCount && !m_Comparer.Less(key, pLeaf->GetKeys()[uiIndex]))
+  {
+    out_bExisted = true;
+    return {pLeaf, uiIndex};
+  }
+
+  out_bExisted = false;
+
+  if (pLeaf->m_uiCount == Capacity)
+  {
+    // move the upper half into a new leaf behind this one
+    Leaf* pRight = AcquireLeaf();
+    MoveEntries(pRight, 0, pLeaf, MinCount, Capacity - MinCount);
+    pRight->m_uiCount = Capacity - MinCount;
+    pLeaf->m_uiCount = MinCount;
+
+    pRight->m_pPrev = pLeaf;
+    pRight->m_pNext = pLeaf->m_pNext;
+    if (pLeaf->m_pNext != nullptr)
+      pLeaf->m_pNext->m_pPrev = pRight;
+    else
+      m_pLastLeaf = pRight;
+    pLeaf->m_pNext = pRight;
+
+    KeyType separator(pRight->GetKeys()[0]);
+    InsertIntoParent(path, separator, pRight);
+
+    if (uiIndex > MinCount)
+    {
+      pLeaf = pRight;
+      uiIndex -= MinCount;
+    }
+  }
+
+  MoveEntries(pLeaf, uiIndex + 1, pLeaf, uiIndex, pLeaf->m_uiCount - uiIndex);
+  nsMemoryUtils::CopyOrMoveConstruct<KeyType>(pLeaf->GetKeys() + uiIndex, std::forward<CompatibleKeyType>(key));
+
+  if constexpr (HasValues)
+  {
+    ::new (pLeaf->GetValues() + uiIndex) ValueType(std::forward<Args>(args)...);
+  }
+
+  ++pLeaf->m_uiCount;
+  ++m_uiCount;
+
+  return {pLeaf, uiIndex};
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::InsertIntoParent(Path& ref_path, KeyType& ref_separator, Node* pRight)
+{
+  while (true)
+  {
+    if (ref_path.m_uiDepth == 0)
+    {
+      Inner* pRoot = AcquireInner();
+      nsMemoryUtils::MoveConstruct(pRoot->GetKeys(), std::move(ref_separator));
+      pRoot->m_pChildren[0] = m_pRoot;
+      pRoot->m_pChildren[1] = pRight;
+      pRoot->m_uiCount = 1;
+      m_pRoot = pRoot;
+      return;
+    }
+
+    --ref_path.m_uiDepth;
+    Inner* pNode = ref_path.m_pNodes[ref_path.m_uiDepth];
+    const nsUInt32 uiIndex = ref_path.m_uiChildIndex[ref_path.m_uiDepth];
+    KeyType* pKeys = pNode->GetKeys();
+
+    if (pNode->m_uiCount < Capacity)
+    {
+      InsertKey(pKeys, pNode->m_uiCount, uiIndex, std::move(ref_separator));
+      InsertChild(pNode->m_pChildren, pNode->m_uiCount + 1, uiIndex + 1, pRight);
+      ++pNode->m_uiCount;
+      return;
+    }
+
+    // The node is full. Conceptually insert the separator, then move the upper half into a new node and pass the middle key up.
+    Inner* pNew = AcquireInner();
+    KeyType* pNewKeys = pNew->GetKeys();
+    constexpr nsUInt32 uiMid = MinCount;
+
+    if (uiIndex < uiMid)
+    {
+      MoveElements(pNewKeys, pKeys + uiMid, Capacity - uiMid);
+      nsMemoryUtils::Copy(pNew->m_pChildren, pNode->m_pChildren + uiMid, Capacity - uiMid + 1);
+      pNew->m_uiCount = Capacity - uiMid;
+
+      KeyType promoted(std::move(pKeys[uiMid - 1]));
+      nsMemoryUtils::Destruct(pKeys + uiMid - 1);
+
+      InsertKey(pKeys, uiMid - 1, uiIndex, std::move(ref_separator));
+      InsertChild(pNode->m_pChildren, uiMid, uiIndex + 1, pRight);
+      pNode->m_uiCount = uiMid;
+
+      ref_separator = std::move(promoted);
+    }
+    else if (uiIndex == uiMid)
+    {
+      MoveElements(pNewKeys, pKeys + uiMid, Capacity - uiMid);
+      pNew->m_pChildren[0] = pRight;
+      nsMemoryUtils::Copy(pNew->m_pChildren + 1, pNode->m_pChildren + uiMid + 1, Capacity - uiMid);
+      pNew->m_uiCount = Capacity - uiMid;
+      pNode->m_uiCount = uiMid;
+
+      // the separator itself is the middle key
+    }
+    else
+    {
+      MoveElements(pNewKeys, pKeys + uiMid + 1, Capacity - uiMid - 1);
+      nsMemoryUtils::Copy(pNew->m_pChildren, pNode->m_pChildren + uiMid + 1, Capacity - uiMid);
+
+      KeyType promoted(std::move(pKeys[uiMid]));
+      nsMemoryUtils::Destruct(pKeys + uiMid);
+      pNode->m_uiCount = uiMid;
+
+      InsertKey(pNewKeys, Capacity - uiMid - 1, uiIndex - uiMid - 1, std::move(ref_separator));
+      InsertChild(pNew->m_pChildren, Capacity - uiMid, uiIndex - uiMid, pRight);
+      pNew->m_uiCount = Capacity - uiMid;
+
+      ref_separator = std::move(promoted);
+    }
+
+    pRight = pNew;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool nsBTreeBase<KeyType, ValueType, Comparer>::Internal_Remove(const CompatibleKeyType& key)
+{
+  const Position pos = Internal_Find(key);
+
+  if (pos.m_pLeaf == nullptr)
+    return false;
+
+  Internal_Remove(pos);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Position nsBTreeBase<KeyType, ValueType, Comparer>::Internal_Remove(const Position& pos)
+{
+  NS_ASSERT_DEV(pos.m_pLeaf != nullptr, "Cannot remove an element with an invalid iterator.");
+
+  Path path;
+  Leaf* pLeaf = Descend(static_cast<const KeyType&>(pos.m_pLeaf->GetKeys()[pos.m_uiIndex]), &path);
+  NS_ASSERT_DEBUG(pLeaf == pos.m_pLeaf, "The iterator does not belong to this container.");
+
+  const nsUInt32 uiIndex = pos.m_uiIndex;
+
+  nsMemoryUtils::Destruct(pLeaf->GetKeys() + uiIndex);
+  if constexpr (HasValues)
+  {
+    nsMemoryUtils::Destruct(pLeaf->GetValues() + uiIndex);
+  }
+
+  MoveEntries(pLeaf, uiIndex, pLeaf, uiIndex + 1, pLeaf->m_uiCount - uiIndex - 1);
+  --pLeaf->m_uiCount;
+  --m_uiCount;
+
+  if (path.m_uiDepth == 0)
+  {
+    if (pLeaf->m_uiCount > 0)
+      return Normalize(pLeaf, uiIndex);
+
+    ReleaseLeaf(pLeaf);
+    m_pRoot = nullptr;
+    m_pFirstLeaf = nullptr;
+    m_pLastLeaf = nullptr;
+    return {};
+  }
+
+  if (pLeaf->m_uiCount >= MinCount)
+    return Normalize(pLeaf, uiIndex);
+
+  const nsUInt32 uiLevel = path.m_uiDepth - 1;
+  Inner* pParent = path.m_pNodes[uiLevel];
+  const nsUInt32 uiChild = path.m_uiChildIndex[uiLevel];
+  Leaf* pLeft = uiChild > 0 ? static_cast<Leaf*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+  Leaf* pRight = uiChild < pParent->m_uiCount ? static_cast<Leaf*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+  if (pLeft != nullptr && pLeft->m_uiCount > MinCount)
+  {
+    // take the last element of the left sibling
+    MoveEntries(pLeaf, 1, pLeaf, 0, pLeaf->m_uiCount);
+    MoveEntries(pLeaf, 0, pLeft, pLeft->m_uiCount - 1, 1);
+    --pLeft->m_uiCount;
+    ++pLeaf->m_uiCount;
+
+    pParent->GetKeys()[uiChild - 1] = pLeaf->GetKeys()[0];
+    return Normalize(pLeaf, uiIndex + 1);
+  }
+
+  if (pRight != nullptr && pRight->m_uiCount > MinCount)
+  {
+    // take the first element of the right sibling
+    MoveEntries(pLeaf, pLeaf->m_uiCount, pRight, 0, 1);
+    MoveEntries(pRight, 0, pRight, 1, pRight->m_uiCount - 1);
+    --pRight->m_uiCount;
+    ++pLeaf->m_uiCount;
+
+    pParent->GetKeys()[uiChild] = pRight->GetKeys()[0];
+    return Normalize(pLeaf, uiIndex);
+  }
+
+  if (pLeft != nullptr)
+  {
+    // merge this leaf into the left sibling
+    const nsUInt32 uiNewIndex = pLeft->m_uiCount + uiIndex;
+    MoveEntries(pLeft, pLeft->m_uiCount, pLeaf, 0, pLeaf->m_uiCount);
+    pLeft->m_uiCount += pLeaf->m_uiCount;
+    pLeaf->m_uiCount = 0;
+
+    pLeft->m_pNext = pLeaf->m_pNext;
+    if (pLeaf->m_pNext != nullptr)
+      pLeaf->m_pNext->m_pPrev = pLeft;
+    else
+      m_pLastLeaf = pLeft;
+
+    ReleaseLeaf(pLeaf);
+    RemoveFromInner(path, uiLevel, uiChild - 1);
+    return Normalize(pLeft, uiNewIndex);
+  }
+
+  // merge the right sibling into this leaf
+  NS_ASSERT_DEBUG(pRight != nullptr, "A leaf below an inner node must have a sibling.");
+  MoveEntries(pLeaf, pLeaf->m_uiCount, pRight, 0, pRight->m_uiCount);
+  pLeaf->m_uiCount += pRight->m_uiCount;
+  pRight->m_uiCount = 0;
+
+  pLeaf->m_pNext = pRight->m_pNext;
+  if (pRight->m_pNext != nullptr)
+    pRight->m_pNext->m_pPrev = pLeaf;
+  else
+    m_pLastLeaf = pLeaf;
+
+  ReleaseLeaf(pRight);
+  RemoveFromInner(path, uiLevel, uiChild);
+  return Normalize(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::RemoveFromInner(Path& ref_path, nsUInt32 uiLevel, nsUInt32 uiKeyIndex)
+{
+  while (true)
+  {
+    Inner* pNode = ref_path.m_pNodes[uiLevel];
+    KeyType* pKeys = pNode->GetKeys();
+
+    RemoveKey(pKeys, pNode->m_uiCount, uiKeyIndex);
+    RemoveChild(pNode->m_pChildren, pNode->m_uiCount + 1, uiKeyIndex + 1);
+    --pNode->m_uiCount;
+
+    if (uiLevel == 0)
+    {
+      // the root may have a single child, which then becomes the new root
+      if (pNode->m_uiCount == 0)
+      {
+        m_pRoot = pNode->m_pChildren[0];
+        ReleaseInner(pNode);
+      }
+
+      return;
+    }
+
+    if (pNode->m_uiCount >= MinCount)
+      return;
+
+    Inner* pParent = ref_path.m_pNodes[uiLevel - 1];
+    KeyType* pParentKeys = pParent->GetKeys();
+    const nsUInt32 uiChild = ref_path.m_uiChildIndex[uiLevel - 1];
+    Inner* pLeft = uiChild > 0 ? static_cast<Inner*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+    Inner* pRight = uiChild < pParent->m_uiCount ? static_cast<Inner*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+    if (pLeft != nullptr && pLeft->m_uiCount > MinCount)
+    {
+      // rotate the last child of the left sibling over the parent
+      KeyType* pLeftKeys = pLeft->GetKeys();
+
+      MoveElements(pKeys + 1, pKeys, pNode->m_uiCount);
+      InsertChild(pNode->m_pChildren, pNode->m_uiCount + 1, 0, pLeft->m_pChildren[pLeft->m_uiCount]);
+      nsMemoryUtils::MoveConstruct(pKeys, std::move(pParentKeys[uiChild - 1]));
+      ++pNode->m_uiCount;
+
+      pParentKeys[uiChild - 1] = std::move(pLeftKeys[pLeft->m_uiCount - 1]);
+      nsMemoryUtils::Destruct(pLeftKeys + pLeft->m_uiCount - 1);
+      --pLeft->m_uiCount;
+      return;
+    }
+
+    if (pRight != nullptr && pRight->m_uiCount > MinCount)
+    {
+      // rotate the first child of the right sibling over the parent
+      KeyType* pRightKeys = pRight->GetKeys();
+
+      nsMemoryUtils::MoveConstruct(pKeys + pNode->m_uiCount, std::move(pParentKeys[uiChild]));
+      pNode->m_pChildren[pNode->m_uiCount + 1] = pRight->m_pChildren[0];
+      ++pNode->m_uiCount;
+
+      pParentKeys[uiChild] = std::move(pRightKeys[0]);
+      RemoveKey(pRightKeys, pRight->m_uiCount, 0);
+      RemoveChild(pRight->m_pChildren, pRight->m_uiCount + 1, 0);
+      --pRight->m_uiCount;
+      return;
+    }
+
+    if (pLeft == nullptr)
+    {
+      // merge the right sibling into this node instead
+      NS_ASSERT_DEBUG(pRight != nullptr, "An inner node below another inner node must have a sibling.");
+      pLeft = pNode;
+      pNode = pRight;
+      uiKeyIndex = uiChild;
+    }
+    else
+    {
+      uiKeyIndex = uiChild - 1;
+    }
+
+    // merge pNode into pLeft, pulling down the separator between them
+    KeyType* pLeftKeys = pLeft->GetKeys();
+    nsMemoryUtils::MoveConstruct(pLeftKeys + pLeft->m_uiCount, std::move(pParentKeys[uiKeyIndex]));
+    MoveElements(pLeftKeys + pLeft->m_uiCount + 1, pNode->GetKeys(), pNode->m_uiCount);
+    nsMemoryUtils::Copy(pLeft->m_pChildren + pLeft->m_uiCount + 1, pNode->m_pChildren, pNode->m_uiCount + 1);
+    pLeft->m_uiCount += pNode->m_uiCount + 1;
+    pNode->m_uiCount = 0;
+    ReleaseInner(pNode);
+
+    --uiLevel;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename T>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount)
+{
+  MoveElements(pDestination, pSource, uiCount, nsGetTypeClass<T>());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename T>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount, nsTypeIsPod)
+{
+  memmove(static_cast<void*>(pDestination), pSource, uiCount * sizeof(T));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename T>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount, nsTypeIsMemRelocatable)
+{
+  memmove(static_cast<void*>(pDestination), pSource, uiCount * sizeof(T));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename T>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::MoveElements(T* pDestination, T* pSource, nsUInt32 uiCount, nsTypeIsClass)
+{
+  if (pDestination < pSource)
+  {
+    for (nsUInt32 i = 0; i < uiCount; ++i)
+    {
+      nsMemoryUtils::RelocateConstruct(pDestination + i, pSource + i);
+    }
+  }
+  else
+  {
+    for (nsUInt32 i = uiCount; i > 0; --i)
+    {
+      nsMemoryUtils::RelocateConstruct(pDestination + i - 1, pSource + i - 1);
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::MoveEntries(Leaf* pDestination, nsUInt32 uiDestinationIndex, Leaf* pSource, nsUInt32 uiSourceIndex, nsUInt32 uiCount)
+{
+  MoveElements(pDestination->GetKeys() + uiDestinationIndex, pSource->GetKeys() + uiSourceIndex, uiCount);
+
+  if constexpr (HasValues)
+  {
+    MoveElements(pDestination->GetValues() + uiDestinationIndex, pSource->GetValues() + uiSourceIndex, uiCount);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::InsertKey(KeyType* pKeys, nsUInt32 uiCount, nsUInt32 uiIndex, CompatibleKeyType&& key)
+{
+  MoveElements(pKeys + uiIndex + 1, pKeys + uiIndex, uiCount - uiIndex);
+  nsMemoryUtils::CopyOrMoveConstruct<KeyType>(pKeys + uiIndex, std::forward<CompatibleKeyType>(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::RemoveKey(KeyType* pKeys, nsUInt32 uiCount, nsUInt32 uiIndex)
+{
+  nsMemoryUtils::Destruct(pKeys + uiIndex);
+  MoveElements(pKeys + uiIndex, pKeys + uiIndex + 1, uiCount - uiIndex - 1);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::InsertChild(Node** pChildren, nsUInt32 uiCount, nsUInt32 uiIndex, Node* pChild)
+{
+  nsMemoryUtils::CopyOverlapped(pChildren + uiIndex + 1, pChildren + uiIndex, uiCount - uiIndex);
+  pChildren[uiIndex] = pChild;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_FORCE_INLINE void nsBTreeBase<KeyType, ValueType, Comparer>::RemoveChild(Node** pChildren, nsUInt32 uiCount, nsUInt32 uiIndex)
+{
+  nsMemoryUtils::CopyOverlapped(pChildren + uiIndex, pChildren + uiIndex + 1, uiCount - uiIndex - 1);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Leaf* nsBTreeBase<KeyType, ValueType, Comparer>::AcquireLeaf()
+{
+  Leaf* pLeaf = NS_NEW(m_pAllocator, Leaf);
+  pLeaf->m_bIsLeaf = true;
+  ++m_uiNumLeaves;
+  return pLeaf;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeBase<KeyType, ValueType, Comparer>::Inner* nsBTreeBase<KeyType, ValueType, Comparer>::AcquireInner()
+{
+  Inner* pInner = NS_NEW(m_pAllocator, Inner);
+  ++m_uiNumInnerNodes;
+  return pInner;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::ReleaseLeaf(Leaf* pLeaf)
+{
+  NS_DELETE(m_pAllocator, pLeaf);
+  --m_uiNumLeaves;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeBase<KeyType, ValueType, Comparer>::ReleaseInner(Inner* pInner)
+{
+  NS_DELETE(m_pAllocator, pInner);
+  --m_uiNumInnerNodes;
+}
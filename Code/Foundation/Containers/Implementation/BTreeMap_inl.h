@@ -0,0 +1,278 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+// ***** nsBTreeMapBase *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+nsBTreeMapBase<KeyType, ValueType, Comparer>::nsBTreeMapBase(const Comparer& comparer, nsAllocatorBase* pAllocator)
+  : Base(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+nsBTreeMapBase<KeyType, ValueType, Comparer>::nsBTreeMapBase(const nsBTreeMapBase<KeyType, ValueType, Comparer>& cc, nsAllocatorBase* pAllocator)
+  : Base(Comparer(), pAllocator)
+{
+  this->CopyFrom(cc);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeMapBase<KeyType, ValueType, Comparer>::operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  this->Clear();
+  this->CopyFrom(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator()
+{
+  return Iterator(this->GetFirst());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator() const
+{
+  return ConstIterator(this->GetFirst());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator()
+{
+  return Iterator(this->GetLast());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator() const
+{
+  return ConstIterator(this->GetLast());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  bool bExisted = false;
+  Iterator it(this->Internal_Insert(std::forward<CompatibleKeyType>(key), bExisted, std::forward<CompatibleValueType>(value)));
+
+  // the value was only consumed, if the key was newly inserted
+  if (bExisted)
+  {
+    it.Value() = std::forward<CompatibleValueType>(value);
+  }
+
+  return it;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return this->Internal_Remove(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const Iterator& pos)
+{
+  Position position;
+  position.m_pLeaf = pos.m_pLeaf;
+  position.m_uiIndex = pos.m_uiIndex;
+
+  return Iterator(this->Internal_Remove(position));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted)
+{
+  bool bExisted = false;
+  Iterator it(this->Internal_Insert(std::forward<CompatibleKeyType>(key), bExisted));
+
+  if (out_pExisted)
+    *out_pExisted = bExisted;
+
+  return it;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE ValueType& nsBTreeMapBase<KeyType, ValueType, Comparer>::operator[](const CompatibleKeyType& key)
+{
+  return FindOrAdd(key).Value();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const
+{
+  const Position pos = this->Internal_Find(key);
+  if (pos.m_pLeaf != nullptr)
+  {
+    out_value = pos.m_pLeaf->GetValues()[pos.m_uiIndex];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const
+{
+  const Position pos = this->Internal_Find(key);
+  if (pos.m_pLeaf != nullptr)
+  {
+    out_pValue = pos.m_pLeaf->GetValues() + pos.m_uiIndex;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const
+{
+  const Position pos = this->Internal_Find(key);
+  if (pos.m_pLeaf != nullptr)
+  {
+    out_pValue = pos.m_pLeaf->GetValues() + pos.m_uiIndex;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE const ValueType* nsBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key) const
+{
+  const Position pos = this->Internal_Find(key);
+  return pos.m_pLeaf ? pos.m_pLeaf->GetValues() + pos.m_uiIndex : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE ValueType* nsBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key)
+{
+  const Position pos = this->Internal_Find(key);
+  return pos.m_pLeaf ? pos.m_pLeaf->GetValues() + pos.m_uiIndex : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE const ValueType& nsBTreeMapBase<KeyType, ValueType, Comparer>::GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const
+{
+  const Position pos = this->Internal_Find(key);
+  return pos.m_pLeaf ? pos.m_pLeaf->GetValues()[pos.m_uiIndex] : defaultValue;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key)
+{
+  return Iterator(this->Internal_Find(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return ConstIterator(this->Internal_Find(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key)
+{
+  return Iterator(this->Internal_LowerBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return ConstIterator(this->Internal_LowerBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key)
+{
+  return Iterator(this->Internal_UpperBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return ConstIterator(this->Internal_UpperBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::operator==(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  return this->IsEqual(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::operator!=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  return !this->IsEqual(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE void nsBTreeMapBase<KeyType, ValueType, Comparer>::Swap(nsBTreeMapBase<KeyType, ValueType, Comparer>& other)
+{
+  this->SwapBase(other);
+}
+
+// ***** nsBTreeMap *****
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap()
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(nsAllocatorBase* pAllocator)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(const Comparer& comparer, nsAllocatorBase* pAllocator)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(const nsBTreeMapBase<KeyType, ValueType, Comparer>& other)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs)
+{
+  nsBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  nsBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
@@ -0,0 +1,106 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Containers/Implementation/BTreeBase.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+
+// The keys are sorted, so the keys that pass the comparison always form a prefix of each block of four keys and of the whole array.
+
+namespace
+{
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+
+  template <typename T>
+  NS_ALWAYS_INLINE __m128i LoadKeys(const T* pKeys, __m128i bias)
+  {
+    return _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pKeys)), bias);
+  }
+
+  /// \brief Unsigned keys are compared as signed keys, after flipping their sign bits.
+  template <typename T>
+  NS_ALWAYS_INLINE __m128i SignBias()
+  {
+    return _mm_set1_epi32(std::is_unsigned<T>::value ? static_cast<int>(0x80000000u) : 0);
+  }
+
+  NS_ALWAYS_INLINE nsUInt32 LaneMask(__m128i v)
+  {
+    return static_cast<nsUInt32>(_mm_movemask_ps(_mm_castsi128_ps(v)));
+  }
+
+#endif
+
+  template <typename T>
+  nsUInt32 CountLess(const T* pKeys, nsUInt32 uiCount, T key)
+  {
+    nsUInt32 i = 0;
+
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    const __m128i bias = SignBias<T>();
+    const __m128i vKey = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias);
+
+    for (; i + 4 <= uiCount; i += 4)
+    {
+      const nsUInt32 uiLess = LaneMask(_mm_cmplt_epi32(LoadKeys(pKeys + i, bias), vKey));
+
+      if (uiLess != 0xF)
+        return i + nsMath::CountBits(uiLess);
+    }
+#endif
+
+    while (i < uiCount && pKeys[i] < key)
+      ++i;
+
+    return i;
+  }
+
+  template <typename T>
+  nsUInt32 CountLessEqual(const T* pKeys, nsUInt32 uiCount, T key)
+  {
+    nsUInt32 i = 0;
+
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    const __m128i bias = SignBias<T>();
+    const __m128i vKey = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias);
+
+    for (; i + 4 <= uiCount; i += 4)
+    {
+      const nsUInt32 uiGreater = LaneMask(_mm_cmpgt_epi32(LoadKeys(pKeys + i, bias), vKey));
+
+      if (uiGreater != 0)
+        return i + 4 - nsMath::CountBits(uiGreater);
+    }
+#endif
+
+    while (i < uiCount && !(key < pKeys[i]))
+      ++i;
+
+    return i;
+  }
+} // namespace
+
+nsUInt32 nsBTreeSearch::CountLess(const nsInt32* pKeys, nsUInt32 uiCount, nsInt32 iKey)
+{
+  return ::CountLess(pKeys, uiCount, iKey);
+}
+
+nsUInt32 nsBTreeSearch::CountLess(const nsUInt32* pKeys, nsUInt32 uiCount, nsUInt32 uiKey)
+{
+  return ::CountLess(pKeys, uiCount, uiKey);
+}
+
+nsUInt32 nsBTreeSearch::CountLessEqual(const nsInt32* pKeys, nsUInt32 uiCount, nsInt32 iKey)
+{
+  return ::CountLessEqual(pKeys, uiCount, iKey);
+}
+
+nsUInt32 nsBTreeSearch::CountLessEqual(const nsUInt32* pKeys, nsUInt32 uiCount, nsUInt32 uiKey)
+{
+  return ::CountLessEqual(pKeys, uiCount, uiKey);
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Containers_Implementation_BTreeSearch);
@@ -0,0 +1,151 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+// ***** nsBTreeSetBase *****
+
+template <typename KeyType, typename Comparer>
+nsBTreeSetBase<KeyType, Comparer>::nsBTreeSetBase(const Comparer& comparer, nsAllocatorBase* pAllocator)
+  : Base(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+nsBTreeSetBase<KeyType, Comparer>::nsBTreeSetBase(const nsBTreeSetBase<KeyType, Comparer>& cc, nsAllocatorBase* pAllocator)
+  : Base(Comparer(), pAllocator)
+{
+  this->CopyFrom(cc);
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  this->Clear();
+  this->CopyFrom(rhs);
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::GetIterator() const
+{
+  return Iterator(this->GetFirst());
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::GetLastIterator() const
+{
+  return Iterator(this->GetLast());
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::Insert(CompatibleKeyType&& key)
+{
+  bool bExisted = false;
+  return Iterator(this->Internal_Insert(std::forward<CompatibleKeyType>(key), bExisted));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeSetBase<KeyType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return this->Internal_Remove(key);
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::Remove(const Iterator& pos)
+{
+  Position position;
+  position.m_pLeaf = pos.m_pLeaf;
+  position.m_uiIndex = pos.m_uiIndex;
+
+  return Iterator(this->Internal_Remove(position));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return Iterator(this->Internal_Find(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return Iterator(this->Internal_LowerBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return Iterator(this->Internal_UpperBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE bool nsBTreeSetBase<KeyType, Comparer>::operator==(const nsBTreeSetBase<KeyType, Comparer>& rhs) const
+{
+  return this->IsEqual(rhs);
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE bool nsBTreeSetBase<KeyType, Comparer>::operator!=(const nsBTreeSetBase<KeyType, Comparer>& rhs) const
+{
+  return !this->IsEqual(rhs);
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE void nsBTreeSetBase<KeyType, Comparer>::Swap(nsBTreeSetBase<KeyType, Comparer>& other)
+{
+  this->SwapBase(other);
+}
+
+// ***** nsBTreeSet *****
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet()
+  : nsBTreeSetBase<KeyType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(nsAllocatorBase* pAllocator)
+  : nsBTreeSetBase<KeyType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(const Comparer& comparer, nsAllocatorBase* pAllocator)
+  : nsBTreeSetBase<KeyType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& other)
+  : nsBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(const nsBTreeSetBase<KeyType, Comparer>& other)
+  : nsBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs)
+{
+  nsBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  nsBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
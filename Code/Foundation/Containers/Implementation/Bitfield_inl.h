@@ -304,6 +304,160 @@ void nsBitfield<Container>::ClearBitRange(nsUInt32 uiFirstBit, nsUInt32 uiNumBit
     ClearBit(i);
 }
 
+template <class Container>
+NS_ALWAYS_INLINE nsUInt32 nsBitfield<Container>::GetIntBits(nsUInt32 uiIntIndex) const
+{
+  const nsUInt32 uiBits = m_Container[uiIntIndex];
+
+  // the bits after m_uiCount may contain anything, e.g. after SetAllBits()
+  const nsUInt32 uiUsedBitsInLastInt = m_uiCount & 0x1F;
+  if (uiUsedBitsInLastInt != 0 && uiIntIndex == GetBitInt(m_uiCount))
+    return uiBits & ((1u << uiUsedBitsInLastInt) - 1);
+
+  return uiBits;
+}
+
+template <class Container>
+nsUInt32 nsBitfield<Container>::GetNumBitsSet() const
+{
+  if (m_uiCount == 0)
+    return 0;
+
+  const nsUInt32 uiLastInt = GetBitInt(m_uiCount - 1);
+  const nsUInt32* pInts = m_Container.GetData();
+
+  nsUInt32 uiNumSet = 0;
+
+  // count two ints at a time
+  nsUInt32 i = 0;
+  for (; i + 1 < uiLastInt; i += 2)
+  {
+    uiNumSet += nsMath::CountBits(static_cast<nsUInt64>(pInts[i]) | (static_cast<nsUInt64>(pInts[i + 1]) << 32));
+  }
+
+  for (; i <= uiLastInt; ++i)
+  {
+    uiNumSet += nsMath::CountBits(GetIntBits(i));
+  }
+
+  return uiNumSet;
+}
+
+template <class Container>
+NS_ALWAYS_INLINE nsUInt32 nsBitfield<Container>::GetLowestBitSet() const
+{
+  return FindNextBitSet(0);
+}
+
+template <class Container>
+nsUInt32 nsBitfield<Container>::FindNextBitSet(nsUInt32 uiStartBit) const
+{
+  if (uiStartBit >= m_uiCount)
+    return m_uiCount;
+
+  const nsUInt32 uiLastInt = GetBitInt(m_uiCount - 1);
+  nsUInt32 uiInt = GetBitInt(uiStartBit);
+
+  // ignore the bits below uiStartBit
+  nsUInt32 uiBits = GetIntBits(uiInt) & ~(GetBitMask(uiStartBit) - 1);
+
+  while (uiBits == 0)
+  {
+    if (++uiInt > uiLastInt)
+      return m_uiCount;
+
+    uiBits = GetIntBits(uiInt);
+  }
+
+  return uiInt * 32 + nsMath::FirstBitLow(uiBits);
+}
+
+template <class Container>
+template <class OtherContainer>
+void nsBitfield<Container>::operator&=(const nsBitfield<OtherContainer>& rhs)
+{
+  NS_ASSERT_DEV(m_uiCount == rhs.m_uiCount, "Bitfields of different size ({} and {}) cannot be combined.", m_uiCount, rhs.m_uiCount);
+
+  // plain loops over the ints, so that the compiler can vectorize them
+  nsUInt32* pInts = m_Container.GetData();
+  const nsUInt32* pOtherInts = rhs.m_Container.GetData();
+  const nsUInt32 uiNumInts = m_Container.GetCount();
+
+  for (nsUInt32 i = 0; i < uiNumInts; ++i)
+    pInts[i] &= pOtherInts[i];
+}
+
+template <class Container>
+template <class OtherContainer>
+void nsBitfield<Container>::operator|=(const nsBitfield<OtherContainer>& rhs)
+{
+  NS_ASSERT_DEV(m_uiCount == rhs.m_uiCount, "Bitfields of different size ({} and {}) cannot be combined.", m_uiCount, rhs.m_uiCount);
+
+  nsUInt32* pInts = m_Container.GetData();
+  const nsUInt32* pOtherInts = rhs.m_Container.GetData();
+  const nsUInt32 uiNumInts = m_Container.GetCount();
+
+  for (nsUInt32 i = 0; i < uiNumInts; ++i)
+    pInts[i] |= pOtherInts[i];
+}
+
+template <class Container>
+template <class OtherContainer>
+void nsBitfield<Container>::operator^=(const nsBitfield<OtherContainer>& rhs)
+{
+  NS_ASSERT_DEV(m_uiCount == rhs.m_uiCount, "Bitfields of different size ({} and {}) cannot be combined.", m_uiCount, rhs.m_uiCount);
+
+  nsUInt32* pInts = m_Container.GetData();
+  const nsUInt32* pOtherInts = rhs.m_Container.GetData();
+  const nsUInt32 uiNumInts = m_Container.GetCount();
+
+  for (nsUInt32 i = 0; i < uiNumInts; ++i)
+    pInts[i] ^= pOtherInts[i];
+}
+
+template <class Container>
+template <class OtherContainer>
+void nsBitfield<Container>::ClearBits(const nsBitfield<OtherContainer>& rhs)
+{
+  NS_ASSERT_DEV(m_uiCount == rhs.m_uiCount, "Bitfields of different size ({} and {}) cannot be combined.", m_uiCount, rhs.m_uiCount);
+
+  nsUInt32* pInts = m_Container.GetData();
+  const nsUInt32* pOtherInts = rhs.m_Container.GetData();
+  const nsUInt32 uiNumInts = m_Container.GetCount();
+
+  for (nsUInt32 i = 0; i < uiNumInts; ++i)
+    pInts[i] &= ~pOtherInts[i];
+}
+
+template <class Container>
+nsBitfield<Container>::ConstSetBitIterator::ConstSetBitIterator(const nsBitfield<Container>* pBitfield, nsUInt32 uiStartBit)
+  : m_pBitfield(pBitfield)
+  , m_uiBit(pBitfield->FindNextBitSet(uiStartBit))
+{
+  if (m_uiBit < m_pBitfield->m_uiCount)
+  {
+    // remember the remaining bits of the current int, to not look them up again
+    m_uiRemainingBits = m_pBitfield->GetIntBits(m_pBitfield->GetBitInt(m_uiBit)) & ~((m_pBitfield->GetBitMask(m_uiBit) << 1) - 1);
+  }
+}
+
+template <class Container>
+void nsBitfield<Container>::ConstSetBitIterator::Next()
+{
+  NS_ASSERT_DEBUG(IsValid(), "Cannot advance an invalid iterator.");
+
+  if (m_uiRemainingBits != 0)
+  {
+    const nsUInt32 uiBitInInt = nsMath::FirstBitLow(m_uiRemainingBits);
+    m_uiRemainingBits &= m_uiRemainingBits - 1;
+    m_uiBit = (m_uiBit & ~0x1Fu) + uiBitInInt;
+    return;
+  }
+
+  // continue with the next int
+  *this = ConstSetBitIterator(m_pBitfield, (m_uiBit | 0x1Fu) + 1);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,535 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+// ***** Const Iterator *****
+
+template <typename IdType, typename ValueType>
+nsHandlePoolBase<IdType, ValueType>::ConstIterator::ConstIterator(const nsHandlePoolBase<IdType, ValueType>& pool)
+  : m_pPool(&pool)
+{
+  nsUInt8* pChunk = pool.GetChunk(0);
+  if (pChunk == nullptr)
+  {
+    m_uiChunk = MAX_CHUNKS;
+    return;
+  }
+
+  m_uiRemainingBits = static_cast<nsUInt64>(GetLiveMasks(pChunk)[0]);
+  m_uiSlot = 0;
+  Next();
+}
+
+template <typename IdType, typename ValueType>
+IdType nsHandlePoolBase<IdType, ValueType>::ConstIterator::Id() const
+{
+  NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'id' of an invalid iterator.");
+
+  const nsInt32 iState = GetStates(m_pPool->GetChunk(m_uiChunk), m_uiChunk)[m_uiSlot];
+  return IdType(GetChunkStartIndex(m_uiChunk) + m_uiSlot, static_cast<nsUInt32>(iState) >> 1);
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE const ValueType& nsHandlePoolBase<IdType, ValueType>::ConstIterator::Value() const
+{
+  NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'value' of an invalid iterator.");
+  return GetValues(m_pPool->GetChunk(m_uiChunk), m_uiChunk)[m_uiSlot];
+}
+
+template <typename IdType, typename ValueType>
+void nsHandlePoolBase<IdType, ValueType>::ConstIterator::Next()
+{
+  // the constructor calls this with the bits of the very first word, all other calls come after a valid element
+  while (m_uiRemainingBits == 0)
+  {
+    ++m_uiWord;
+
+    if (m_uiWord == GetChunkCapacity(m_uiChunk) / 64)
+    {
+      ++m_uiChunk;
+      m_uiWord = 0;
+
+      if (m_uiChunk == MAX_CHUNKS || m_pPool->GetChunk(m_uiChunk) == nullptr)
+      {
+        m_uiChunk = MAX_CHUNKS;
+        m_uiSlot = 0;
+        return;
+      }
+    }
+
+    m_uiRemainingBits = static_cast<nsUInt64>(GetLiveMasks(m_pPool->GetChunk(m_uiChunk))[m_uiWord]);
+  }
+
+  m_uiSlot = m_uiWord * 64 + nsMath::FirstBitLow(m_uiRemainingBits);
+  m_uiRemainingBits &= m_uiRemainingBits - 1;
+}
+
+// ***** Iterator *****
+
+template <typename IdType, typename ValueType>
+nsHandlePoolBase<IdType, ValueType>::Iterator::Iterator(const nsHandlePoolBase<IdType, ValueType>& pool)
+  : ConstIterator(pool)
+{
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE ValueType& nsHandlePoolBase<IdType, ValueType>::Iterator::Value()
+{
+  return const_cast<ValueType&>(ConstIterator::Value());
+}
+
+// ***** nsHandlePoolBase *****
+
+template <typename IdType, typename ValueType>
+nsHandlePoolBase<IdType, ValueType>::nsHandlePoolBase(nsAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+{
+}
+
+template <typename IdType, typename ValueType>
+nsHandlePoolBase<IdType, ValueType>::~nsHandlePoolBase()
+{
+  Clear();
+
+  for (nsUInt32 uiChunk = 0; uiChunk < MAX_CHUNKS; ++uiChunk)
+  {
+    if (nsUInt8* pChunk = GetChunk(uiChunk))
+    {
+      m_pAllocator->Deallocate(pChunk);
+      m_Chunks[uiChunk] = nullptr;
+    }
+  }
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE nsUInt32 nsHandlePoolBase<IdType, ValueType>::GetChunkIndex(IndexType index, nsUInt32& out_uiSlot)
+{
+  // chunk n holds CHUNK_BASE_SIZE << n elements, so the chunk is given by the highest bit of the biased index
+  const nsUInt32 uiBiasedIndex = index + CHUNK_BASE_SIZE;
+  const nsUInt32 uiChunk = nsMath::FirstBitHigh(uiBiasedIndex) - CHUNK_BASE_SHIFT;
+  out_uiSlot = uiBiasedIndex - (CHUNK_BASE_SIZE << uiChunk);
+  return uiChunk;
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE size_t nsHandlePoolBase<IdType, ValueType>::GetValuesOffset(nsUInt32 uiChunk)
+{
+  const size_t uiCapacity = GetChunkCapacity(uiChunk);
+  return nsMemoryUtils::AlignSize<size_t>(uiCapacity / 8 + uiCapacity * 8, NS_ALIGNMENT_OF(ValueType));
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE size_t nsHandlePoolBase<IdType, ValueType>::GetChunkSize(nsUInt32 uiChunk)
+{
+  return GetValuesOffset(uiChunk) + GetChunkCapacity(uiChunk) * sizeof(ValueType);
+}
+
+template <typename IdType, typename ValueType>
+nsUInt8* nsHandlePoolBase<IdType, ValueType>::GetOrCreateChunk(nsUInt32 uiChunk)
+{
+  nsUInt8* pChunk = GetChunk(uiChunk);
+  if (pChunk != nullptr)
+    return pChunk;
+
+  const nsUInt32 uiCapacity = GetChunkCapacity(uiChunk);
+  const nsUInt32 uiFirstGeneration = GetNextGeneration(GetChunkStartIndex(uiChunk), 0);
+
+  nsUInt8* pNewChunk = static_cast<nsUInt8*>(m_pAllocator->Allocate(GetChunkSize(uiChunk), nsMath::Max<size_t>(NS_ALIGNMENT_OF(ValueType), 8)));
+
+  volatile nsInt64* pLiveMasks = GetLiveMasks(pNewChunk);
+  for (nsUInt32 i = 0; i < uiCapacity / 64; ++i)
+  {
+    pLiveMasks[i] = 0;
+  }
+
+  volatile nsInt32* pStates = GetStates(pNewChunk, uiChunk);
+  for (nsUInt32 i = 0; i < uiCapacity; ++i)
+  {
+    pStates[i] = MakeState(uiFirstGeneration, false);
+  }
+
+  if (nsAtomicUtils::TestAndSet(const_cast<void**>(&m_Chunks[uiChunk]), nullptr, pNewChunk))
+    return pNewChunk;
+
+  // another thread was faster
+  m_pAllocator->Deallocate(pNewChunk);
+  return GetChunk(uiChunk);
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE nsUInt32 nsHandlePoolBase<IdType, ValueType>::GetNextGeneration(IndexType index, nsUInt32 uiGeneration)
+{
+  // keep one bit for the alive flag and never hand out a generation that is truncated to zero by the id type
+  uiGeneration = (uiGeneration + 1) & 0x3FFFFFFFu;
+
+  while (IdType(index, uiGeneration).m_Generation == 0)
+  {
+    uiGeneration = (uiGeneration + 1) & 0x3FFFFFFFu;
+  }
+
+  return uiGeneration;
+}
+
+template <typename IdType, typename ValueType>
+typename nsHandlePoolBase<IdType, ValueType>::IndexType nsHandlePoolBase<IdType, ValueType>::PopFreelist()
+{
+  nsInt64 iHead = nsAtomicUtils::Read(m_iFreelistHead);
+
+  while (true)
+  {
+    const IndexType index = static_cast<IndexType>(static_cast<nsUInt64>(iHead) & 0xFFFFFFFFu);
+    if (index == INVALID_FREELIST_INDEX)
+      return INVALID_FREELIST_INDEX;
+
+    // the slot may be popped and reused by another thread in the meantime, in which case the link is garbage, but the tag makes the CAS fail
+    nsUInt32 uiSlot;
+    const nsUInt32 uiChunk = GetChunkIndex(index, uiSlot);
+    const IndexType next = GetFreelistLinks(GetChunk(uiChunk), uiChunk)[uiSlot];
+
+    const nsUInt64 uiTag = (static_cast<nsUInt64>(iHead) >> 32) + 1;
+    const nsInt64 iNewHead = static_cast<nsInt64>((uiTag << 32) | next);
+
+    const nsInt64 iPrevHead = nsAtomicUtils::CompareAndSwap(m_iFreelistHead, iHead, iNewHead);
+    if (iPrevHead == iHead)
+      return index;
+
+    iHead = iPrevHead;
+  }
+}
+
+template <typename IdType, typename ValueType>
+void nsHandlePoolBase<IdType, ValueType>::PushFreelist(IndexType index)
+{
+  nsUInt32 uiSlot;
+  const nsUInt32 uiChunk = GetChunkIndex(index, uiSlot);
+  volatile nsUInt32& link = GetFreelistLinks(GetChunk(uiChunk), uiChunk)[uiSlot];
+
+  nsInt64 iHead = nsAtomicUtils::Read(m_iFreelistHead);
+
+  while (true)
+  {
+    link = static_cast<nsUInt32>(static_cast<nsUInt64>(iHead) & 0xFFFFFFFFu);
+
+    const nsUInt64 uiTag = (static_cast<nsUInt64>(iHead) >> 32) + 1;
+    const nsInt64 iNewHead = static_cast<nsInt64>((uiTag << 32) | index);
+
+    const nsInt64 iPrevHead = nsAtomicUtils::CompareAndSwap(m_iFreelistHead, iHead, iNewHead);
+    if (iPrevHead == iHead)
+      return;
+
+    iHead = iPrevHead;
+  }
+}
+
+template <typename IdType, typename ValueType>
+void nsHandlePoolBase<IdType, ValueType>::Reserve(IndexType capacity)
+{
+  NS_ASSERT_DEV(capacity <= GetMaxCapacity(), "Capacity {0} exceeds the maximum number of elements ({1}).", capacity, GetMaxCapacity());
+
+  if (capacity == 0)
+    return;
+
+  nsUInt32 uiSlot;
+  const nsUInt32 uiLastChunk = GetChunkIndex(capacity - 1, uiSlot);
+
+  for (nsUInt32 uiChunk = 0; uiChunk <= uiLastChunk; ++uiChunk)
+  {
+    GetOrCreateChunk(uiChunk);
+  }
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE typename nsHandlePoolBase<IdType, ValueType>::IndexType nsHandlePoolBase<IdType, ValueType>::GetCount() const
+{
+  return static_cast<IndexType>(static_cast<nsInt32>(m_iCount));
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE bool nsHandlePoolBase<IdType, ValueType>::IsEmpty() const
+{
+  return GetCount() == 0;
+}
+
+template <typename IdType, typename ValueType>
+void nsHandlePoolBase<IdType, ValueType>::Clear()
+{
+  const IndexType uiNumUsed = static_cast<IndexType>(static_cast<nsInt32>(m_iNextUnusedIndex));
+
+  for (nsUInt32 uiChunk = 0; uiChunk < MAX_CHUNKS; ++uiChunk)
+  {
+    nsUInt8* pChunk = GetChunk(uiChunk);
+    if (pChunk == nullptr)
+      break;
+
+    volatile nsInt64* pLiveMasks = GetLiveMasks(pChunk);
+    volatile nsInt32* pStates = GetStates(pChunk, uiChunk);
+    ValueType* pValues = GetValues(pChunk, uiChunk);
+
+    for (nsUInt32 uiWord = 0; uiWord < GetChunkCapacity(uiChunk) / 64; ++uiWord)
+    {
+      nsUInt64 uiBits = static_cast<nsUInt64>(pLiveMasks[uiWord]);
+      pLiveMasks[uiWord] = 0;
+
+      while (uiBits != 0)
+      {
+        const nsUInt32 uiSlot = uiWord * 64 + nsMath::FirstBitLow(uiBits);
+        uiBits &= uiBits - 1;
+
+        const nsUInt32 uiGeneration = static_cast<nsUInt32>(pStates[uiSlot]) >> 1;
+        pStates[uiSlot] = MakeState(GetNextGeneration(GetChunkStartIndex(uiChunk) + uiSlot, uiGeneration), false);
+        nsMemoryUtils::Destruct(pValues + uiSlot, 1);
+      }
+    }
+  }
+
+  // rebuild the free-list in reverse, so that low indices are reused first
+  m_iFreelistHead = static_cast<nsInt64>(INVALID_FREELIST_INDEX);
+  for (IndexType index = uiNumUsed; index > 0; --index)
+  {
+    PushFreelist(index - 1);
+  }
+
+  m_iCount = 0;
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE IdType nsHandlePoolBase<IdType, ValueType>::Insert(const ValueType& value)
+{
+  return InsertInternal(value);
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE IdType nsHandlePoolBase<IdType, ValueType>::Insert(ValueType&& value)
+{
+  return InsertInternal(std::move(value));
+}
+
+template <typename IdType, typename ValueType>
+template <typename CompatibleValueType>
+IdType nsHandlePoolBase<IdType, ValueType>::InsertInternal(CompatibleValueType&& value)
+{
+  IndexType index = PopFreelist();
+  nsUInt8* pChunk = nullptr;
+  nsUInt32 uiSlot;
+  nsUInt32 uiChunk;
+
+  if (index != INVALID_FREELIST_INDEX)
+  {
+    uiChunk = GetChunkIndex(index, uiSlot);
+    pChunk = GetChunk(uiChunk);
+  }
+  else
+  {
+    // only advance the index while there is space left, so that failed inserts don't push it past the capacity
+    nsInt32 iIndex = m_iNextUnusedIndex;
+    while (true)
+    {
+      if (static_cast<IndexType>(iIndex) >= GetMaxCapacity())
+      {
+        NS_REPORT_FAILURE("Handle pool is full. It can hold at most {0} elements.", GetMaxCapacity());
+        return IdType();
+      }
+
+      const nsInt32 iPrevIndex = m_iNextUnusedIndex.CompareAndSwap(iIndex, iIndex + 1);
+      if (iPrevIndex == iIndex)
+        break;
+
+      iIndex = iPrevIndex;
+    }
+
+    index = static_cast<IndexType>(iIndex);
+
+    uiChunk = GetChunkIndex(index, uiSlot);
+    pChunk = GetOrCreateChunk(uiChunk);
+  }
+
+  // nobody else can touch this slot until the id is handed out
+  volatile nsInt32& state = GetStates(pChunk, uiChunk)[uiSlot];
+  const nsUInt32 uiGeneration = static_cast<nsUInt32>(state) >> 1;
+
+  nsMemoryUtils::CopyOrMoveConstruct<ValueType>(GetValues(pChunk, uiChunk) + uiSlot, std::forward<CompatibleValueType>(value));
+  nsAtomicUtils::Or(GetLiveMasks(pChunk)[uiSlot / 64], static_cast<nsInt64>(1ull << (uiSlot % 64)));
+  nsAtomicUtils::Set(state, MakeState(uiGeneration, true));
+
+  m_iCount.Increment();
+  return IdType(index, uiGeneration);
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE nsUInt8* nsHandlePoolBase<IdType, ValueType>::FindSlot(const IdType id, nsUInt32& out_uiChunk, nsUInt32& out_uiSlot) const
+{
+  const IndexType index = static_cast<IndexType>(id.m_InstanceIndex);
+  if (index >= GetMaxCapacity())
+    return nullptr;
+
+  out_uiChunk = GetChunkIndex(index, out_uiSlot);
+  nsUInt8* pChunk = GetChunk(out_uiChunk);
+  if (pChunk == nullptr)
+    return nullptr;
+
+  // a plain read is enough here, the id must have been handed over to this thread with proper synchronization
+  const nsInt32 iState = GetStates(pChunk, out_uiChunk)[out_uiSlot];
+  if ((iState & 1) == 0 || !IdType(index, static_cast<nsUInt32>(iState) >> 1).IsIndexAndGenerationEqual(id))
+    return nullptr;
+
+  return pChunk;
+}
+
+template <typename IdType, typename ValueType>
+bool nsHandlePoolBase<IdType, ValueType>::Remove(const IdType id, ValueType* out_pOldValue /*= nullptr*/)
+{
+  const IndexType index = static_cast<IndexType>(id.m_InstanceIndex);
+  if (index >= GetMaxCapacity())
+    return false;
+
+  nsUInt32 uiSlot;
+  const nsUInt32 uiChunk = GetChunkIndex(index, uiSlot);
+  nsUInt8* pChunk = GetChunk(uiChunk);
+  if (pChunk == nullptr)
+    return false;
+
+  // validate and claim with the same state value, otherwise the slot could be reused by another thread in between
+  volatile nsInt32& state = GetStates(pChunk, uiChunk)[uiSlot];
+  const nsInt32 iState = state;
+  const nsUInt32 uiGeneration = static_cast<nsUInt32>(iState) >> 1;
+
+  if ((iState & 1) == 0 || !IdType(index, uiGeneration).IsIndexAndGenerationEqual(id))
+    return false;
+
+  // only one thread can win this, everybody else sees a dead slot or a different generation
+  if (nsAtomicUtils::CompareAndSwap(state, iState, MakeState(GetNextGeneration(index, uiGeneration), false)) != iState)
+    return false;
+
+  ValueType* pValue = GetValues(pChunk, uiChunk) + uiSlot;
+  if (out_pOldValue != nullptr)
+    *out_pOldValue = std::move(*pValue);
+
+  nsMemoryUtils::Destruct(pValue, 1);
+  nsAtomicUtils::And(GetLiveMasks(pChunk)[uiSlot / 64], ~static_cast<nsInt64>(1ull << (uiSlot % 64)));
+
+  m_iCount.Decrement();
+  PushFreelist(index);
+  return true;
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE bool nsHandlePoolBase<IdType, ValueType>::TryGetValue(const IdType id, ValueType& out_value) const
+{
+  nsUInt32 uiChunk;
+  nsUInt32 uiSlot;
+  if (nsUInt8* pChunk = FindSlot(id, uiChunk, uiSlot))
+  {
+    out_value = GetValues(pChunk, uiChunk)[uiSlot];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE bool nsHandlePoolBase<IdType, ValueType>::TryGetValue(const IdType id, ValueType*& out_pValue) const
+{
+  nsUInt32 uiChunk;
+  nsUInt32 uiSlot;
+  if (nsUInt8* pChunk = FindSlot(id, uiChunk, uiSlot))
+  {
+    out_pValue = GetValues(pChunk, uiChunk) + uiSlot;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE const ValueType& nsHandlePoolBase<IdType, ValueType>::operator[](const IdType id) const
+{
+  nsUInt32 uiChunk;
+  nsUInt32 uiSlot;
+  nsUInt8* pChunk = FindSlot(id, uiChunk, uiSlot);
+  NS_ASSERT_DEBUG(pChunk != nullptr, "Stale or invalid access. Trying to access a value (index: {0}, generation: {1}) that does not exist.", static_cast<nsUInt64>(id.m_InstanceIndex), static_cast<nsUInt64>(id.m_Generation));
+
+  return GetValues(pChunk, uiChunk)[uiSlot];
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE ValueType& nsHandlePoolBase<IdType, ValueType>::operator[](const IdType id)
+{
+  return const_cast<ValueType&>(static_cast<const nsHandlePoolBase<IdType, ValueType>*>(this)->operator[](id));
+}
+
+template <typename IdType, typename ValueType>
+NS_FORCE_INLINE bool nsHandlePoolBase<IdType, ValueType>::Contains(const IdType id) const
+{
+  nsUInt32 uiChunk;
+  nsUInt32 uiSlot;
+  return FindSlot(id, uiChunk, uiSlot) != nullptr;
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE typename nsHandlePoolBase<IdType, ValueType>::Iterator nsHandlePoolBase<IdType, ValueType>::GetIterator()
+{
+  return Iterator(*this);
+}
+
+template <typename IdType, typename ValueType>
+NS_ALWAYS_INLINE typename nsHandlePoolBase<IdType, ValueType>::ConstIterator nsHandlePoolBase<IdType, ValueType>::GetIterator() const
+{
+  return ConstIterator(*this);
+}
+
+template <typename IdType, typename ValueType>
+nsUInt64 nsHandlePoolBase<IdType, ValueType>::GetHeapMemoryUsage() const
+{
+  nsUInt64 uiMemory = 0;
+
+  for (nsUInt32 uiChunk = 0; uiChunk < MAX_CHUNKS; ++uiChunk)
+  {
+    if (GetChunk(uiChunk) != nullptr)
+      uiMemory += GetChunkSize(uiChunk);
+  }
+
+  return uiMemory;
+}
+
+template <typename IdType, typename ValueType>
+bool nsHandlePoolBase<IdType, ValueType>::IsFreelistValid() const
+{
+  const IndexType uiNumUsed = static_cast<IndexType>(static_cast<nsInt32>(m_iNextUnusedIndex));
+  IndexType uiNumFree = 0;
+
+  IndexType index = static_cast<IndexType>(static_cast<nsUInt64>(m_iFreelistHead) & 0xFFFFFFFFu);
+  while (index != INVALID_FREELIST_INDEX)
+  {
+    if (index >= uiNumUsed || uiNumFree >= uiNumUsed)
+      return false;
+
+    nsUInt32 uiSlot;
+    const nsUInt32 uiChunk = GetChunkIndex(index, uiSlot);
+    nsUInt8* pChunk = GetChunk(uiChunk);
+
+    if ((GetStates(pChunk, uiChunk)[uiSlot] & 1) != 0)
+      return false;
+
+    ++uiNumFree;
+    index = GetFreelistLinks(pChunk, uiChunk)[uiSlot];
+  }
+
+  return uiNumFree + GetCount() == uiNumUsed;
+}
+
+// ***** nsHandlePool *****
+
+template <typename IdType, typename ValueType, typename AllocatorWrapper>
+nsHandlePool<IdType, ValueType, AllocatorWrapper>::nsHandlePool()
+  : nsHandlePoolBase<IdType, ValueType>(AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename IdType, typename ValueType, typename AllocatorWrapper>
+nsHandlePool<IdType, ValueType, AllocatorWrapper>::nsHandlePool(nsAllocatorBase* pAllocator)
+  : nsHandlePoolBase<IdType, ValueType>(pAllocator)
+{
+}
@@ -0,0 +1,561 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+namespace nsInternal
+{
+  /// \brief Sorts indices into the unsorted tail of an nsSoAArrayMapBase by their key. Equal keys keep their insertion order.
+  template <typename KEY>
+  struct SoAArrayMapTailComparer
+  {
+    NS_ALWAYS_INLINE bool Less(nsUInt32 a, nsUInt32 b) const
+    {
+      if (m_pKeys[a] < m_pKeys[b])
+        return true;
+
+      if (m_pKeys[b] < m_pKeys[a])
+        return false;
+
+      return a < b;
+    }
+
+    const KEY* m_pKeys;
+  };
+} // namespace nsInternal
+
+template <typename KEY, typename VALUE>
+inline nsSoAArrayMapBase<KEY, VALUE>::nsSoAArrayMapBase(nsAllocatorBase* pAllocator)
+  : m_Keys(pAllocator)
+  , m_Values(pAllocator)
+  , m_EytzingerKeys(pAllocator)
+  , m_EytzingerToSorted(pAllocator)
+{
+}
+
+template <typename KEY, typename VALUE>
+inline nsSoAArrayMapBase<KEY, VALUE>::nsSoAArrayMapBase(const nsSoAArrayMapBase& rhs, nsAllocatorBase* pAllocator)
+  : m_Keys(pAllocator)
+  , m_Values(pAllocator)
+  , m_EytzingerKeys(pAllocator)
+  , m_EytzingerToSorted(pAllocator)
+{
+  *this = rhs;
+}
+
+template <typename KEY, typename VALUE>
+inline void nsSoAArrayMapBase<KEY, VALUE>::operator=(const nsSoAArrayMapBase& rhs)
+{
+  m_bUseEytzingerLayout = rhs.m_bUseEytzingerLayout;
+  m_uiSortedCount = rhs.m_uiSortedCount;
+  m_bEytzingerDirty = rhs.m_bEytzingerDirty;
+  m_Keys = rhs.m_Keys;
+  m_Values = rhs.m_Values;
+  m_EytzingerKeys = rhs.m_EytzingerKeys;
+  m_EytzingerToSorted = rhs.m_EytzingerToSorted;
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::GetCount() const
+{
+  return m_Keys.GetCount();
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE bool nsSoAArrayMapBase<KEY, VALUE>::IsEmpty() const
+{
+  return m_Keys.IsEmpty();
+}
+
+template <typename KEY, typename VALUE>
+inline void nsSoAArrayMapBase<KEY, VALUE>::Clear()
+{
+  m_uiSortedCount = 0;
+  m_bEytzingerDirty = true;
+  m_Keys.Clear();
+  m_Values.Clear();
+  m_EytzingerKeys.Clear();
+  m_EytzingerToSorted.Clear();
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+inline nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  m_Keys.ExpandAndGetRef() = std::forward<CompatibleKeyType>(key);
+  m_Values.ExpandAndGetRef() = std::forward<CompatibleValueType>(value);
+  m_bEytzingerDirty = true;
+  return m_Keys.GetCount() - 1;
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::InsertBatch(nsArrayPtr<const KEY> keys, nsArrayPtr<const VALUE> values)
+{
+  NS_ASSERT_DEV(keys.GetCount() == values.GetCount(), "Number of keys ({0}) and values ({1}) does not match.", keys.GetCount(), values.GetCount());
+
+  m_Keys.PushBackRange(keys);
+  m_Values.PushBackRange(values);
+  m_bEytzingerDirty = true;
+
+  MergeUnsortedTail();
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::MergeUnsortedTail() const
+{
+  const nsUInt32 uiCount = m_Keys.GetCount();
+  const nsUInt32 uiSortedCount = m_uiSortedCount;
+  const nsUInt32 uiTailCount = uiCount - uiSortedCount;
+
+  if (uiTailCount == 0)
+    return;
+
+  m_uiSortedCount = uiCount;
+  m_bEytzingerDirty = true;
+
+  // sort indices instead of the elements, so that every key and value is moved exactly once
+  nsDynamicArray<nsUInt32> order(m_Keys.GetAllocator());
+  order.SetCountUninitialized(uiTailCount);
+  for (nsUInt32 i = 0; i < uiTailCount; ++i)
+  {
+    order[i] = i;
+  }
+
+  nsSorting::QuickSort(order, nsInternal::SoAArrayMapTailComparer<KEY>{m_Keys.GetData() + uiSortedCount});
+
+  nsDynamicArray<KEY> tailKeys(m_Keys.GetAllocator());
+  nsDynamicArray<VALUE> tailValues(m_Values.GetAllocator());
+  tailKeys.Reserve(uiTailCount);
+  tailValues.Reserve(uiTailCount);
+
+  for (nsUInt32 uiIndex : order)
+  {
+    tailKeys.PushBack(std::move(m_Keys[uiSortedCount + uiIndex]));
+    tailValues.PushBack(std::move(m_Values[uiSortedCount + uiIndex]));
+  }
+
+  // merge from the back, the tail slots are free now and the sorted part only ever moves towards the end
+  KEY* pKeys = m_Keys.GetData();
+  VALUE* pValues = m_Values.GetData();
+
+  nsUInt32 uiSorted = uiSortedCount;
+  nsUInt32 uiTail = uiTailCount;
+  nsUInt32 uiTarget = uiCount;
+
+  while (uiTail > 0)
+  {
+    --uiTarget;
+
+    if (uiSorted > 0 && tailKeys[uiTail - 1] < pKeys[uiSorted - 1])
+    {
+      --uiSorted;
+      pKeys[uiTarget] = std::move(pKeys[uiSorted]);
+      pValues[uiTarget] = std::move(pValues[uiSorted]);
+    }
+    else
+    {
+      --uiTail;
+      pKeys[uiTarget] = std::move(tailKeys[uiTail]);
+      pValues[uiTarget] = std::move(tailValues[uiTail]);
+    }
+  }
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::BuildEytzingerLayout() const
+{
+  m_bEytzingerDirty = false;
+
+  const nsUInt32 uiCount = m_Keys.GetCount();
+
+  // node 0 is never visited by the search, it only exists to make the indexing 1-based
+  m_EytzingerKeys.SetCount(uiCount + 1);
+  m_EytzingerToSorted.SetCountUninitialized(uiCount + 1);
+  m_EytzingerToSorted[0] = nsInvalidIndex;
+
+  BuildEytzingerLayout(0, 1);
+}
+
+template <typename KEY, typename VALUE>
+nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::BuildEytzingerLayout(nsUInt32 uiSortedIndex, nsUInt32 uiNode) const
+{
+  // in-order traversal of the implicit tree visits the nodes in sorted order
+  if (uiNode < m_EytzingerKeys.GetCount())
+  {
+    uiSortedIndex = BuildEytzingerLayout(uiSortedIndex, 2 * uiNode);
+
+    m_EytzingerKeys[uiNode] = m_Keys[uiSortedIndex];
+    m_EytzingerToSorted[uiNode] = uiSortedIndex;
+    ++uiSortedIndex;
+
+    uiSortedIndex = BuildEytzingerLayout(uiSortedIndex, 2 * uiNode + 1);
+  }
+
+  return uiSortedIndex;
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::Sort() const
+{
+  MergeUnsortedTail();
+
+  if (m_bUseEytzingerLayout && m_bEytzingerDirty)
+  {
+    BuildEytzingerLayout();
+  }
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::SetUseEytzingerLayout(bool bEnable)
+{
+  if (m_bUseEytzingerLayout == bEnable)
+    return;
+
+  m_bUseEytzingerLayout = bEnable;
+  m_bEytzingerDirty = true;
+
+  if (!bEnable)
+  {
+    m_EytzingerKeys.Clear();
+    m_EytzingerKeys.Compact();
+    m_EytzingerToSorted.Clear();
+    m_EytzingerToSorted.Compact();
+  }
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE void nsSoAArrayMapBase<KEY, VALUE>::EytzingerPrefetch(const KEY* pKeys, nsUInt32 uiNode)
+{
+  // all descendants of a node a few levels down are stored next to each other, so fetching them early hides most of the cache misses
+  constexpr nsUInt32 uiLevels = sizeof(KEY) <= 4 ? 4 : (sizeof(KEY) <= 8 ? 3 : 2);
+
+#if NS_ENABLED(NS_COMPILER_GCC) || NS_ENABLED(NS_COMPILER_CLANG)
+  __builtin_prefetch(pKeys + (static_cast<nsUInt64>(uiNode) << uiLevels));
+#else
+  NS_IGNORE_UNUSED(pKeys);
+  NS_IGNORE_UNUSED(uiNode);
+  NS_IGNORE_UNUSED(uiLevels);
+#endif
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::EytzingerLowerBound(const CompatibleKeyType& key) const
+{
+  const KEY* pKeys = m_EytzingerKeys.GetData();
+  const nsUInt32 uiCount = m_Keys.GetCount();
+
+  nsUInt32 uiNode = 1;
+  while (uiNode <= uiCount)
+  {
+    EytzingerPrefetch(pKeys, uiNode);
+    uiNode = 2 * uiNode + static_cast<nsUInt32>(pKeys[uiNode] < key);
+  }
+
+  // the path to the result is the last left turn, strip all right turns after it and the left turn itself
+  return uiNode >> (nsMath::FirstBitLow(~uiNode) + 1);
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::EytzingerUpperBound(const CompatibleKeyType& key) const
+{
+  const KEY* pKeys = m_EytzingerKeys.GetData();
+  const nsUInt32 uiCount = m_Keys.GetCount();
+
+  nsUInt32 uiNode = 1;
+  while (uiNode <= uiCount)
+  {
+    EytzingerPrefetch(pKeys, uiNode);
+    uiNode = 2 * uiNode + static_cast<nsUInt32>(!(key < pKeys[uiNode]));
+  }
+
+  return uiNode >> (nsMath::FirstBitLow(~uiNode) + 1);
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::Find(const CompatibleKeyType& key) const
+{
+  const nsUInt32 uiIndex = LowerBound(key);
+
+  if (uiIndex == nsInvalidIndex || key < m_Keys[uiIndex])
+    return nsInvalidIndex;
+
+  return uiIndex;
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::LowerBound(const CompatibleKeyType& key) const
+{
+  Sort();
+
+  if (m_bUseEytzingerLayout)
+  {
+    return m_EytzingerToSorted[EytzingerLowerBound(key)];
+  }
+
+  const KEY* pKeys = m_Keys.GetData();
+
+  nsUInt32 lb = 0;
+  nsUInt32 ub = m_Keys.GetCount();
+
+  while (lb < ub)
+  {
+    const nsUInt32 middle = lb + ((ub - lb) >> 1);
+
+    if (pKeys[middle] < key)
+    {
+      lb = middle + 1;
+    }
+    else
+    {
+      ub = middle;
+    }
+  }
+
+  if (lb == m_Keys.GetCount())
+    return nsInvalidIndex;
+
+  return lb;
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+nsUInt32 nsSoAArrayMapBase<KEY, VALUE>::UpperBound(const CompatibleKeyType& key) const
+{
+  Sort();
+
+  if (m_bUseEytzingerLayout)
+  {
+    return m_EytzingerToSorted[EytzingerUpperBound(key)];
+  }
+
+  const KEY* pKeys = m_Keys.GetData();
+
+  nsUInt32 lb = 0;
+  nsUInt32 ub = m_Keys.GetCount();
+
+  while (lb < ub)
+  {
+    const nsUInt32 middle = lb + ((ub - lb) >> 1);
+
+    if (key < pKeys[middle])
+    {
+      ub = middle;
+    }
+    else
+    {
+      lb = middle + 1;
+    }
+  }
+
+  if (ub == m_Keys.GetCount())
+    return nsInvalidIndex;
+
+  return ub;
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE const KEY& nsSoAArrayMapBase<KEY, VALUE>::GetKey(nsUInt32 uiIndex) const
+{
+  return m_Keys[uiIndex];
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE const VALUE& nsSoAArrayMapBase<KEY, VALUE>::GetValue(nsUInt32 uiIndex) const
+{
+  return m_Values[uiIndex];
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE VALUE& nsSoAArrayMapBase<KEY, VALUE>::GetValue(nsUInt32 uiIndex)
+{
+  return m_Values[uiIndex];
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE nsArrayPtr<const KEY> nsSoAArrayMapBase<KEY, VALUE>::GetKeys() const
+{
+  return m_Keys.GetArrayPtr();
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE nsArrayPtr<const VALUE> nsSoAArrayMapBase<KEY, VALUE>::GetValues() const
+{
+  return m_Values.GetArrayPtr();
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE nsArrayPtr<VALUE> nsSoAArrayMapBase<KEY, VALUE>::GetValues()
+{
+  return m_Values.GetArrayPtr();
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+VALUE& nsSoAArrayMapBase<KEY, VALUE>::FindOrAdd(const CompatibleKeyType& key, bool* out_pExisted)
+{
+  nsUInt32 index = Find<CompatibleKeyType>(key);
+
+  if (out_pExisted)
+    *out_pExisted = index != nsInvalidIndex;
+
+  if (index == nsInvalidIndex)
+  {
+    index = Insert(key, VALUE());
+  }
+
+  return GetValue(index);
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE VALUE& nsSoAArrayMapBase<KEY, VALUE>::operator[](const CompatibleKeyType& key)
+{
+  return FindOrAdd(key);
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::RemoveAtAndCopy(nsUInt32 uiIndex, bool bKeepSorted)
+{
+  NS_ASSERT_DEV(uiIndex < m_Keys.GetCount(), "Out of bounds access. Map has {0} elements, trying to remove element at index {1}.", m_Keys.GetCount(), uiIndex);
+
+  m_bEytzingerDirty = true;
+
+  if (bKeepSorted || uiIndex + 1 == m_Keys.GetCount())
+  {
+    m_Keys.RemoveAtAndCopy(uiIndex);
+    m_Values.RemoveAtAndCopy(uiIndex);
+
+    if (uiIndex < m_uiSortedCount)
+      --m_uiSortedCount;
+  }
+  else
+  {
+    m_Keys.RemoveAtAndSwap(uiIndex);
+    m_Values.RemoveAtAndSwap(uiIndex);
+
+    // the last element is now at uiIndex, so everything from there on needs to be merged again
+    m_uiSortedCount = nsMath::Min(m_uiSortedCount, uiIndex);
+  }
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+bool nsSoAArrayMapBase<KEY, VALUE>::RemoveAndCopy(const CompatibleKeyType& key, bool bKeepSorted)
+{
+  const nsUInt32 uiIndex = Find(key);
+
+  if (uiIndex == nsInvalidIndex)
+    return false;
+
+  RemoveAtAndCopy(uiIndex, bKeepSorted);
+  return true;
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsSoAArrayMapBase<KEY, VALUE>::Contains(const CompatibleKeyType& key) const
+{
+  return Find(key) != nsInvalidIndex;
+}
+
+template <typename KEY, typename VALUE>
+template <typename CompatibleKeyType>
+bool nsSoAArrayMapBase<KEY, VALUE>::Contains(const CompatibleKeyType& key, const VALUE& value) const
+{
+  nsUInt32 atpos = LowerBound(key);
+
+  if (atpos == nsInvalidIndex)
+    return false;
+
+  while (atpos < m_Keys.GetCount())
+  {
+    if (key < m_Keys[atpos])
+      return false;
+
+    if (m_Values[atpos] == value)
+      return true;
+
+    ++atpos;
+  }
+
+  return false;
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE void nsSoAArrayMapBase<KEY, VALUE>::Reserve(nsUInt32 uiSize)
+{
+  m_Keys.Reserve(uiSize);
+  m_Values.Reserve(uiSize);
+}
+
+template <typename KEY, typename VALUE>
+void nsSoAArrayMapBase<KEY, VALUE>::Compact()
+{
+  m_Keys.Compact();
+  m_Values.Compact();
+  m_EytzingerKeys.Compact();
+  m_EytzingerToSorted.Compact();
+}
+
+template <typename KEY, typename VALUE>
+bool nsSoAArrayMapBase<KEY, VALUE>::operator==(const nsSoAArrayMapBase<KEY, VALUE>& rhs) const
+{
+  MergeUnsortedTail();
+  rhs.MergeUnsortedTail();
+
+  return m_Keys == rhs.m_Keys && m_Values == rhs.m_Values;
+}
+
+template <typename KEY, typename VALUE>
+NS_ALWAYS_INLINE bool nsSoAArrayMapBase<KEY, VALUE>::operator!=(const nsSoAArrayMapBase<KEY, VALUE>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename KEY, typename VALUE>
+nsUInt64 nsSoAArrayMapBase<KEY, VALUE>::GetHeapMemoryUsage() const
+{
+  return m_Keys.GetHeapMemoryUsage() + m_Values.GetHeapMemoryUsage() + m_EytzingerKeys.GetHeapMemoryUsage() + m_EytzingerToSorted.GetHeapMemoryUsage();
+}
+
+template <typename KEY, typename VALUE, typename A>
+nsSoAArrayMap<KEY, VALUE, A>::nsSoAArrayMap()
+  : nsSoAArrayMapBase<KEY, VALUE>(A::GetAllocator())
+{
+}
+
+template <typename KEY, typename VALUE, typename A>
+nsSoAArrayMap<KEY, VALUE, A>::nsSoAArrayMap(nsAllocatorBase* pAllocator)
+  : nsSoAArrayMapBase<KEY, VALUE>(pAllocator)
+{
+}
+
+template <typename KEY, typename VALUE, typename A>
+nsSoAArrayMap<KEY, VALUE, A>::nsSoAArrayMap(const nsSoAArrayMap<KEY, VALUE, A>& rhs)
+  : nsSoAArrayMapBase<KEY, VALUE>(rhs, A::GetAllocator())
+{
+}
+
+template <typename KEY, typename VALUE, typename A>
+nsSoAArrayMap<KEY, VALUE, A>::nsSoAArrayMap(const nsSoAArrayMapBase<KEY, VALUE>& rhs)
+  : nsSoAArrayMapBase<KEY, VALUE>(rhs, A::GetAllocator())
+{
+}
+
+template <typename KEY, typename VALUE, typename A>
+void nsSoAArrayMap<KEY, VALUE, A>::operator=(const nsSoAArrayMap<KEY, VALUE, A>& rhs)
+{
+  nsSoAArrayMapBase<KEY, VALUE>::operator=(rhs);
+}
+
+template <typename KEY, typename VALUE, typename A>
+void nsSoAArrayMap<KEY, VALUE, A>::operator=(const nsSoAArrayMapBase<KEY, VALUE>& rhs)
+{
+  nsSoAArrayMapBase<KEY, VALUE>::operator=(rhs);
+}
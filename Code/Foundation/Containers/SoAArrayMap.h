@@ -0,0 +1,186 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+
+/// \brief A sorted associative container like nsArrayMap, but keys and values are stored in two separate arrays (structure of arrays).
+///
+/// Lookups only touch the key array, so many more keys fit into each cache line than with nsArrayMap, where every key is interleaved
+/// with its value. Elements that are added through Insert() are appended to an unsorted tail. The next lookup only sorts that tail and
+/// merges it into the already sorted part, instead of sorting the whole container again. Use InsertBatch() to add many elements at once.
+///
+/// Optionally an additional copy of the keys can be kept in Eytzinger (breadth-first) order, see SetUseEytzingerLayout().
+/// This makes searching branchless and cache friendly, which pays off for large tables that are built once and then queried a lot,
+/// at the cost of storing every key twice.
+///
+/// Like nsArrayMap, the container allows to store multiple values under the same key. Element indices are only valid until the
+/// container is modified or sorted.
+template <typename KEY, typename VALUE>
+class nsSoAArrayMapBase
+{
+public:
+  /// \brief Constructor.
+  explicit nsSoAArrayMapBase(nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copy-Constructor.
+  nsSoAArrayMapBase(const nsSoAArrayMapBase& rhs, nsAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copy assignment operator.
+  void operator=(const nsSoAArrayMapBase& rhs); // [tested]
+
+  /// \brief Returns the number of elements stored in the map.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief True if the map contains no elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Purges all elements from the map.
+  void Clear(); // [tested]
+
+  /// \brief Always inserts a new value under the given key. Duplicates are allowed.
+  /// Returns the index of the newly added element.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  nsUInt32 Insert(CompatibleKeyType&& key, CompatibleValueType&& value); // [tested]
+
+  /// \brief Inserts all given key/value pairs and sorts them into the map right away.
+  ///
+  /// Only the new elements are sorted, afterwards they are merged with the existing elements in linear time.
+  /// Elements with equal keys keep their relative order. Both arrays must have the same number of elements.
+  void InsertBatch(nsArrayPtr<const KEY> keys, nsArrayPtr<const VALUE> values); // [tested]
+
+  /// \brief Ensures the internal data structure is sorted. This is done automatically every time a lookup needs to be made.
+  void Sort() const; // [tested]
+
+  /// \brief Enables or disables keeping a copy of all keys in Eytzinger order, which is used for all lookups while enabled.
+  void SetUseEytzingerLayout(bool bEnable); // [tested]
+
+  /// \brief Returns whether lookups use a copy of the keys in Eytzinger order.
+  bool GetUseEytzingerLayout() const { return m_bUseEytzingerLayout; } // [tested]
+
+  /// \brief Returns an index to one element with the given key. If the key is inserted multiple times, there is no guarantee which one is returned.
+  /// Returns nsInvalidIndex when no such element exists.
+  template <typename CompatibleKeyType>
+  nsUInt32 Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the index to the first element with a key equal or larger than the given key.
+  /// Returns nsInvalidIndex when no such element exists.
+  /// If there are multiple keys with the same value, the one at the smallest index is returned.
+  template <typename CompatibleKeyType>
+  nsUInt32 LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the index to the first element with a key that is LARGER than the given key.
+  /// Returns nsInvalidIndex when no such element exists.
+  template <typename CompatibleKeyType>
+  nsUInt32 UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the key that is stored at the given index.
+  const KEY& GetKey(nsUInt32 uiIndex) const; // [tested]
+
+  /// \brief Returns the value that is stored at the given index.
+  const VALUE& GetValue(nsUInt32 uiIndex) const; // [tested]
+
+  /// \brief Returns the value that is stored at the given index.
+  VALUE& GetValue(nsUInt32 uiIndex); // [tested]
+
+  /// \brief Returns all keys. They are only sorted if Sort() or a lookup function was called after the last modification.
+  nsArrayPtr<const KEY> GetKeys() const; // [tested]
+
+  /// \brief Returns all values, in the same order as GetKeys().
+  nsArrayPtr<const VALUE> GetValues() const; // [tested]
+
+  /// \brief Returns all values, in the same order as GetKeys().
+  nsArrayPtr<VALUE> GetValues(); // [tested]
+
+  /// \brief Returns the value stored at the given key. If none exists, one is created. \a bExisted indicates whether an element needed to be created.
+  template <typename CompatibleKeyType>
+  VALUE& FindOrAdd(const CompatibleKeyType& key, bool* out_pExisted = nullptr); // [tested]
+
+  /// \brief Same as FindOrAdd.
+  template <typename CompatibleKeyType>
+  VALUE& operator[](const CompatibleKeyType& key); // [tested]
+
+  /// \brief Removes the element at the given index.
+  ///
+  /// If bKeepSorted is true, the remaining elements are shifted, such that the map stays sorted.
+  /// Otherwise the last element is moved into the gap and everything behind it will be sorted again on the next lookup.
+  void RemoveAtAndCopy(nsUInt32 uiIndex, bool bKeepSorted = false); // [tested]
+
+  /// \brief Removes one element with the given key. Returns true, if one was found and removed. If the same key exists multiple times, you need to
+  /// call this function multiple times to remove them all.
+  ///
+  /// See RemoveAtAndCopy() for the meaning of \a bKeepSorted.
+  template <typename CompatibleKeyType>
+  bool RemoveAndCopy(const CompatibleKeyType& key, bool bKeepSorted = false); // [tested]
+
+  /// \brief Returns whether an element with the given key exists.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns whether an element with the given key and value already exists.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key, const VALUE& value) const; // [tested]
+
+  /// \brief Reserves enough memory to store \a size elements.
+  void Reserve(nsUInt32 uiSize); // [tested]
+
+  /// \brief Compacts the internal memory to not waste any space.
+  void Compact(); // [tested]
+
+  /// \brief Compares the two containers for equality.
+  bool operator==(const nsSoAArrayMapBase<KEY, VALUE>& rhs) const; // [tested]
+
+  /// \brief Compares the two containers for equality.
+  bool operator!=(const nsSoAArrayMapBase<KEY, VALUE>& rhs) const; // [tested]
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const; // [tested]
+
+private:
+  void MergeUnsortedTail() const;
+  void BuildEytzingerLayout() const;
+  nsUInt32 BuildEytzingerLayout(nsUInt32 uiSortedIndex, nsUInt32 uiNode) const;
+
+  /// \brief Returns the Eytzinger node at which the search for the given key ended, or 0 if the key is larger than all keys.
+  template <typename CompatibleKeyType>
+  nsUInt32 EytzingerLowerBound(const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  nsUInt32 EytzingerUpperBound(const CompatibleKeyType& key) const;
+
+  static void EytzingerPrefetch(const KEY* pKeys, nsUInt32 uiNode);
+
+  bool m_bUseEytzingerLayout = false;
+
+  /// \brief Number of elements at the front of the arrays that are already sorted. Everything after that was appended by Insert().
+  mutable nsUInt32 m_uiSortedCount = 0;
+  mutable bool m_bEytzingerDirty = false;
+  mutable nsDynamicArray<KEY> m_Keys;
+  mutable nsDynamicArray<VALUE> m_Values;
+
+  // 1-based Eytzinger copy of m_Keys and the sorted index of every node. Only filled while m_bUseEytzingerLayout is set.
+  mutable nsDynamicArray<KEY> m_EytzingerKeys;
+  mutable nsDynamicArray<nsUInt32> m_EytzingerToSorted;
+};
+
+/// \brief See nsSoAArrayMapBase for details.
+template <typename KEY, typename VALUE, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsSoAArrayMap : public nsSoAArrayMapBase<KEY, VALUE>
+{
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
+public:
+  nsSoAArrayMap();
+  explicit nsSoAArrayMap(nsAllocatorBase* pAllocator);
+
+  nsSoAArrayMap(const nsSoAArrayMap<KEY, VALUE, AllocatorWrapper>& rhs);
+  nsSoAArrayMap(const nsSoAArrayMapBase<KEY, VALUE>& rhs);
+
+  void operator=(const nsSoAArrayMap<KEY, VALUE, AllocatorWrapper>& rhs);
+  void operator=(const nsSoAArrayMapBase<KEY, VALUE>& rhs);
+};
+
+#include <Foundation/Containers/Implementation/SoAArrayMap_inl.h>
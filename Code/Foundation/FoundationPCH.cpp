@@ -70,6 +70,7 @@ NS_STATICLINK_LIBRARY(Foundation)
   NS_STATICLINK_REFERENCE(Foundation_Configuration_Implementation_Plugin);
   NS_STATICLINK_REFERENCE(Foundation_Configuration_Implementation_Singleton);
   NS_STATICLINK_REFERENCE(Foundation_Configuration_Implementation_Startup);
+  NS_STATICLINK_REFERENCE(Foundation_Containers_Implementation_BTreeSearch);
   NS_STATICLINK_REFERENCE(Foundation_Containers_Implementation_Blob);
   NS_STATICLINK_REFERENCE(Foundation_DataProcessing_Stream_DefaultImplementations_Implementation_ZeroInitializer);
   NS_STATICLINK_REFERENCE(Foundation_DataProcessing_Stream_Implementation_ProcessingStream);
@@ -93,6 +94,7 @@ NS_STATICLINK_LIBRARY(Foundation)
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_DirectoryWatcher);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONParser);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONReader);
+  NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONTape);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONWriter);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_MemoryMappedFile);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_MemoryStream);
@@ -108,11 +110,14 @@ NS_STATICLINK_LIBRARY(Foundation)
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamUtils);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_StringDeduplicationContext);
   NS_STATICLINK_REFERENCE(Foundation_IO_Implementation_TypeVersionContext);
+  NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_AsyncLog);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ConsoleWriter);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ETWWriter);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_HTMLWriter);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_Log);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_LogEntry);
+  NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_LogRateLimiter);
+  NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_StructuredLog);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_VisualStudioWriter);
   NS_STATICLINK_REFERENCE(Foundation_Logging_Implementation_Win_ETWProvider_win);
   NS_STATICLINK_REFERENCE(Foundation_Math_Implementation_Color);
@@ -144,6 +149,7 @@ NS_STATICLINK_LIBRARY(Foundation)
   NS_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_GraphPatch);
   NS_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_GraphVersioning);
   NS_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionSerializer);
+  NS_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionSerializerPlan);
   NS_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterReader);
   NS_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterWriter);
   NS_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdMat4f);
@@ -152,6 +158,8 @@ NS_STATICLINK_LIBRARY(Foundation)
   NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_FormatString);
   NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_HashedString);
   NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_PathUtils);
+  NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_RopeStringBuilder);
+  NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_SharedString);
   NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_StringBuilder);
   NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_StringConversion);
   NS_STATICLINK_REFERENCE(Foundation_Strings_Implementation_StringUtils);
@@ -17,6 +17,7 @@ enum class nsArchiveCompressionMode : nsUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_dictionary, ///< zstd compressed with the dictionary that is stored in the nsArchiveTOC
 };
 
 /// \brief Data for a single file entry in an nsArchive file
@@ -108,6 +109,8 @@ public:
   nsHashTable<nsArchiveStoredString, nsUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   nsDynamicArray<nsUInt8> m_AllPathStrings;
+  /// the dictionary that all entries with nsArchiveCompressionMode::Compressed_zstd_dictionary were compressed with, may be empty
+  nsDynamicArray<nsUInt8> m_CompressionDictionary;
 
   /// \brief Returns the entry index for the given file or nsInvalidIndex, if not found.
   nsUInt32 FindEntry(nsStringView sFile) const;
@@ -51,13 +51,32 @@ public:
   nsResult WriteArchive(nsStringView sFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// Files with identical content are only stored once. All entries for such files reference the same data in the archive.
   nsResult WriteArchive(nsStreamWriter& inout_stream) const;
 
+  /// \brief Enables compressing small entries with a dictionary that is stored once in the archive.
+  ///
+  /// Small files (configs, materials, prefabs) compress poorly on their own, because the compressor has no history to find matches in.
+  /// When writing the archive, a dictionary of up to \a uiDictionarySizeKB is assembled from samples of all zstd compressed entries that are
+  /// at most \a uiMaxEntrySizeKB large. The samples are picked round-robin across file types, so that every type is represented.
+  /// Those entries are then compressed with the dictionary. If there is too little data for a dictionary to pay off, none is stored.
+  ///
+  /// Pass 0 for \a uiDictionarySizeKB to disable dictionary compression (the default).
+  void SetDictionaryCompression(nsUInt32 uiDictionarySizeKB = 64, nsUInt32 uiMaxEntrySizeKB = 32);
+
 protected:
   /// Override this to get a callback when the next file is being written to the output. Return 'true' to continue, 'false' to cancel the entire archive generation.
   virtual bool WriteNextFileCallback(nsUInt32 uiCurEntry, nsUInt32 uiMaxEntries, nsStringView sSourceFile) const;
   /// Override this to get a progress report for writing a single file to the output
   virtual bool WriteFileProgressCallback(nsUInt64 bytesWritten, nsUInt64 bytesTotal) const;
   /// Override this to get a callback after a file has been processed. Gets additional information about the compression result and duration.
+  /// \a uiStoredSize is zero, if the file's content was already stored for another entry.
   virtual void WriteFileResultCallback(nsUInt32 uiCurEntry, nsUInt32 uiMaxEntries, nsStringView sSourceFile, nsUInt64 uiSourceSize, nsUInt64 uiStoredSize, nsTime duration) const {}
+
+private:
+  void BuildCompressionDictionary(nsDynamicArray<nsUInt8>& out_dictionary, nsDynamicArray<bool>& out_useDictionary) const;
+
+  nsUInt32 m_uiDictionarySize = 0;
+  nsUInt32 m_uiDictionaryMaxEntrySize = 0;
 };
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -38,6 +39,13 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   nsUniquePtr<nsStreamReader> CreateEntryReader(nsUInt32 uiEntryIdx) const;
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  /// \brief Returns the prepared dictionary for entries with nsArchiveCompressionMode::Compressed_zstd_dictionary.
+  ///
+  /// Returns nullptr, if the archive does not contain a dictionary. The dictionary is prepared once in OpenArchive() and shared by all readers.
+  const nsCompressedStreamDictionaryZstd* GetCompressionDictionary() const;
+#endif
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(nsUInt32 uiCurEntry, nsUInt32 uiMaxEntries, nsStringView sSourceFile) const;
@@ -50,4 +58,8 @@ protected:
   nsUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   nsUInt64 m_uiMemFileSize = 0;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  nsCompressedStreamDictionaryZstd m_CompressionDictionary;
+#endif
 };
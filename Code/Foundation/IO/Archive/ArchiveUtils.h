@@ -15,6 +15,7 @@ class nsMemoryMappedFile;
 class nsArchiveTOC;
 class nsArchiveEntry;
 class nsRawMemoryStreamReader;
+class nsCompressedStreamDictionaryZstd;
 
 /// \brief Utilities for working with nsArchive files
 namespace nsArchiveUtils
@@ -46,15 +47,18 @@ namespace nsArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  ///
+  /// For nsArchiveCompressionMode::Compressed_zstd_dictionary \a compressionDictionary has to be the same data that ends up in
+  /// nsArchiveTOC::m_CompressionDictionary. Without a dictionary, the entry is stored as Compressed_zstd instead.
   NS_FOUNDATION_DLL nsResult WriteEntry(nsStreamWriter& inout_stream, nsStringView sAbsSourcePath, nsUInt32 uiPathStringOffset,
     nsArchiveCompressionMode compression, nsInt32 iCompressionLevel, nsArchiveEntry& ref_tocEntry, nsUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), nsArrayPtr<const nsUInt8> compressionDictionary = nsArrayPtr<const nsUInt8>());
 
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   NS_FOUNDATION_DLL nsResult WriteEntryOptimal(nsStreamWriter& inout_stream, nsStringView sAbsSourcePath, nsUInt32 uiPathStringOffset,
     nsArchiveCompressionMode compression, nsInt32 iCompressionLevel, nsArchiveEntry& ref_tocEntry, nsUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), nsArrayPtr<const nsUInt8> compressionDictionary = nsArrayPtr<const nsUInt8>());
 
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
@@ -65,7 +69,9 @@ namespace nsArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
-  NS_FOUNDATION_DLL nsUniquePtr<nsStreamReader> CreateEntryReader(const nsArchiveEntry& entry, const void* pStartOfArchiveData);
+  /// Entries that use nsArchiveCompressionMode::Compressed_zstd_dictionary need the prepared dictionary of the archive, which has to stay
+  /// alive as long as the reader is used.
+  NS_FOUNDATION_DLL nsUniquePtr<nsStreamReader> CreateEntryReader(const nsArchiveEntry& entry, const void* pStartOfArchiveData, const nsCompressedStreamDictionaryZstd* pDictionary = nullptr);
 
   NS_FOUNDATION_DLL nsResult ReadZipHeader(nsStreamReader& inout_stream, nsUInt8& out_uiVersion);
   NS_FOUNDATION_DLL nsResult ExtractZipTOC(nsMemoryMappedFile& ref_memFile, nsArchiveTOC& ref_toc);
@@ -55,6 +55,9 @@ nsResult nsArchiveTOC::Serialize(nsStreamWriter& inout_stream) const
 
   NS_SUCCEED_OR_RETURN(inout_stream.WriteArray(m_AllPathStrings));
 
+  // added in archive version 5
+  NS_SUCCEED_OR_RETURN(inout_stream.WriteArray(m_CompressionDictionary));
+
   return NS_SUCCESS;
 }
 
@@ -87,7 +90,7 @@ struct nsHashHelper<nsOldTempHashedString>
 
 nsResult nsArchiveTOC::Deserialize(nsStreamReader& inout_stream, nsUInt8 uiArchiveVersion)
 {
-  NS_ASSERT_ALWAYS(uiArchiveVersion <= 4, "Unsupported archive version {}", uiArchiveVersion);
+  NS_ASSERT_ALWAYS(uiArchiveVersion <= 5, "Unsupported archive version {}", uiArchiveVersion);
 
   // we don't use the TOC version anymore, but the archive version instead
   const nsTypeVersion version = inout_stream.ReadVersion(2);
@@ -121,6 +124,13 @@ nsResult nsArchiveTOC::Deserialize(nsStreamReader& inout_stream, nsUInt8 uiArchi
 
   NS_SUCCEED_OR_RETURN(inout_stream.ReadArray(m_AllPathStrings));
 
+  m_CompressionDictionary.Clear();
+
+  if (uiArchiveVersion >= 5)
+  {
+    NS_SUCCEED_OR_RETURN(inout_stream.ReadArray(m_CompressionDictionary));
+  }
+
   if (bRecreateStringHashes)
   {
     nsLog::Info("Archive uses older string hashing, recomputing hashes.");
@@ -5,9 +5,12 @@
  */
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/Containers/Map.h>
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
@@ -83,6 +86,53 @@ void nsArchiveBuilder::AddFolder(nsStringView sAbsFolderPath, nsArchiveCompressi
 #endif
 }
 
+static nsResult HashFileContent(nsStringView sFile, nsUInt64& out_uiHash)
+{
+  nsFileReader file;
+  NS_SUCCEED_OR_RETURN(file.Open(sFile, 1024 * 1024));
+
+  nsHashStreamWriter64 hashStream;
+  nsUInt8 uiTemp[1024 * 8];
+
+  while (true)
+  {
+    const nsUInt64 uiRead = file.ReadBytes(uiTemp, NS_ARRAY_SIZE(uiTemp));
+
+    if (uiRead == 0)
+      break;
+
+    NS_SUCCEED_OR_RETURN(hashStream.WriteBytes(uiTemp, uiRead));
+  }
+
+  out_uiHash = hashStream.GetHashValue();
+  return NS_SUCCESS;
+}
+
+static bool IsFileContentEqual(nsStringView sFile1, nsStringView sFile2)
+{
+  nsFileReader file1, file2;
+  if (file1.Open(sFile1, 1024 * 1024).Failed() || file2.Open(sFile2, 1024 * 1024).Failed())
+    return false;
+
+  if (file1.GetFileSize() != file2.GetFileSize())
+    return false;
+
+  nsUInt8 uiTemp1[1024 * 8];
+  nsUInt8 uiTemp2[1024 * 8];
+
+  while (true)
+  {
+    const nsUInt64 uiRead1 = file1.ReadBytes(uiTemp1, NS_ARRAY_SIZE(uiTemp1));
+    const nsUInt64 uiRead2 = file2.ReadBytes(uiTemp2, NS_ARRAY_SIZE(uiTemp2));
+
+    if (uiRead1 != uiRead2 || nsMemoryUtils::Compare<nsUInt8>(uiTemp1, uiTemp2, static_cast<size_t>(uiRead1)) != 0)
+      return false;
+
+    if (uiRead1 == 0)
+      return true;
+  }
+}
+
 nsResult nsArchiveBuilder::WriteArchive(nsStringView sFile) const
 {
   NS_LOG_BLOCK("WriteArchive", sFile);
@@ -103,11 +153,18 @@ nsResult nsArchiveBuilder::WriteArchive(nsStreamWriter& inout_stream) const
 
   nsArchiveTOC toc;
 
+  nsDynamicArray<bool> useDictionary;
+  BuildCompressionDictionary(toc.m_CompressionDictionary, useDictionary);
+
   nsStringBuilder sHashablePath;
 
   nsUInt64 uiStreamSize = 0;
   const nsUInt32 uiNumEntries = m_Entries.GetCount();
 
+  // maps the content hash of every stored file to its entry, so that files with identical content are only stored once
+  nsHashTable<nsUInt64, nsUInt32> contentHashToEntry;
+  contentHashToEntry.Reserve(uiNumEntries);
+
   nsStopwatch sw;
 
   for (nsUInt32 i = 0; i < uiNumEntries; ++i)
@@ -127,7 +184,31 @@ nsResult nsArchiveBuilder::WriteArchive(nsStreamWriter& inout_stream) const
 
     nsArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
 
-    NS_SUCCEED_OR_RETURN(nsArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, nsMakeDelegate(&nsArchiveBuilder::WriteFileProgressCallback, this)));
+    nsUInt64 uiContentHash = 0;
+    const bool bHashedContent = HashFileContent(e.m_sAbsSourcePath, uiContentHash).Succeeded();
+
+    if (bHashedContent)
+    {
+      nsUInt32 uiStoredEntry = 0;
+      if (contentHashToEntry.TryGetValue(uiContentHash, uiStoredEntry) && IsFileContentEqual(e.m_sAbsSourcePath, m_Entries[uiStoredEntry].m_sAbsSourcePath))
+      {
+        // identical content was already written, just reference the same data
+        tocEntry = toc.m_Entries[uiStoredEntry];
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+
+        WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, 0, sw.Checkpoint());
+        continue;
+      }
+    }
+
+    const nsArchiveCompressionMode compression = useDictionary[i] ? nsArchiveCompressionMode::Compressed_zstd_dictionary : e.m_CompressionMode;
+
+    NS_SUCCEED_OR_RETURN(nsArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, compression, e.m_iCompressionLevel, tocEntry, uiStreamSize, nsMakeDelegate(&nsArchiveBuilder::WriteFileProgressCallback, this), toc.m_CompressionDictionary));
+
+    if (bHashedContent && !contentHashToEntry.Contains(uiContentHash))
+    {
+      contentHashToEntry.Insert(uiContentHash, i);
+    }
 
     WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
   }
@@ -137,6 +218,127 @@ nsResult nsArchiveBuilder::WriteArchive(nsStreamWriter& inout_stream) const
   return NS_SUCCESS;
 }
 
+void nsArchiveBuilder::SetDictionaryCompression(nsUInt32 uiDictionarySizeKB /*= 64*/, nsUInt32 uiMaxEntrySizeKB /*= 32*/)
+{
+  m_uiDictionarySize = uiDictionarySizeKB * 1024;
+  m_uiDictionaryMaxEntrySize = uiMaxEntrySizeKB * 1024;
+}
+
+void nsArchiveBuilder::BuildCompressionDictionary(nsDynamicArray<nsUInt8>& out_dictionary, nsDynamicArray<bool>& out_useDictionary) const
+{
+  const nsUInt32 uiNumEntries = m_Entries.GetCount();
+
+  out_dictionary.Clear();
+  out_useDictionary.Clear();
+  out_useDictionary.SetCount(uiNumEntries, false);
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_uiDictionarySize == 0)
+    return;
+
+  struct Candidate
+  {
+    nsUInt32 m_uiEntry = 0;
+    nsUInt32 m_uiSize = 0;
+  };
+
+  // group all small, compressed entries by file type, the map keeps the order deterministic
+  nsMap<nsString, nsDynamicArray<Candidate>> candidatesByType;
+  nsUInt64 uiTotalCandidateSize = 0;
+
+  nsStringBuilder sExtension;
+
+  for (nsUInt32 i = 0; i < uiNumEntries; ++i)
+  {
+    const SourceEntry& e = m_Entries[i];
+
+    if (e.m_CompressionMode != nsArchiveCompressionMode::Compressed_zstd)
+      continue;
+
+    nsOSFile file;
+    if (file.Open(e.m_sAbsSourcePath, nsFileOpenMode::Read).Failed())
+      continue;
+
+    const nsUInt64 uiFileSize = file.GetFileSize();
+
+    if (uiFileSize == 0 || uiFileSize > m_uiDictionaryMaxEntrySize)
+      continue;
+
+    sExtension = nsPathUtils::GetFileExtension(e.m_sRelTargetPath);
+    sExtension.ToLower();
+
+    auto& candidate = candidatesByType[sExtension].ExpandAndGetRef();
+    candidate.m_uiEntry = i;
+    candidate.m_uiSize = static_cast<nsUInt32>(uiFileSize);
+
+    uiTotalCandidateSize += uiFileSize;
+  }
+
+  // the dictionary is stored in the archive, so it only pays off, if there is a lot more data that uses it
+  const nsUInt32 uiDictionarySize = static_cast<nsUInt32>(nsMath::Min<nsUInt64>(m_uiDictionarySize, uiTotalCandidateSize / 4));
+
+  if (uiDictionarySize < 1024)
+    return;
+
+  // take samples round-robin across all types, so that rare types are represented as well as common ones
+  // zstd uses the dictionary as raw content, so it is fine to just concatenate the samples
+  constexpr nsUInt32 uiMaxSampleSize = 1024 * 4;
+
+  nsDynamicArray<nsUInt32> nextCandidate;
+  nextCandidate.SetCount(candidatesByType.GetCount(), 0);
+
+  out_dictionary.Reserve(uiDictionarySize);
+
+  bool bSampledAny = true;
+  while (bSampledAny && out_dictionary.GetCount() < uiDictionarySize)
+  {
+    bSampledAny = false;
+
+    nsUInt32 uiType = 0;
+    for (auto it = candidatesByType.GetIterator(); it.IsValid() && out_dictionary.GetCount() < uiDictionarySize; ++it, ++uiType)
+    {
+      if (nextCandidate[uiType] >= it.Value().GetCount())
+        continue;
+
+      const Candidate& candidate = it.Value()[nextCandidate[uiType]++];
+      bSampledAny = true;
+
+      nsOSFile file;
+      if (file.Open(m_Entries[candidate.m_uiEntry].m_sAbsSourcePath, nsFileOpenMode::Read).Failed())
+        continue;
+
+      const nsUInt32 uiSampleSize = nsMath::Min(candidate.m_uiSize, uiMaxSampleSize, uiDictionarySize - out_dictionary.GetCount());
+      const nsUInt32 uiOffset = out_dictionary.GetCount();
+
+      out_dictionary.SetCountUninitialized(uiOffset + uiSampleSize);
+      const nsUInt64 uiRead = file.Read(out_dictionary.GetData() + uiOffset, uiSampleSize);
+      out_dictionary.SetCount(uiOffset + static_cast<nsUInt32>(uiRead));
+    }
+  }
+
+  // a dictionary starting with the zstd dictionary magic number would not be interpreted as raw content
+  const nsUInt8 uiZstdDictMagic[4] = {0x37, 0xA4, 0x30, 0xEC};
+  if (out_dictionary.GetCount() >= 4 && nsMemoryUtils::Compare<nsUInt8>(out_dictionary.GetData(), uiZstdDictMagic, 4) == 0)
+  {
+    out_dictionary.RemoveAtAndCopy(0);
+  }
+
+  if (out_dictionary.GetCount() < 1024)
+  {
+    out_dictionary.Clear();
+    return;
+  }
+
+  for (auto it = candidatesByType.GetIterator(); it.IsValid(); ++it)
+  {
+    for (const Candidate& candidate : it.Value())
+    {
+      out_useDictionary[candidate.m_uiEntry] = true;
+    }
+  }
+#endif
+}
+
 bool nsArchiveBuilder::WriteNextFileCallback(nsUInt32 uiCurEntry, nsUInt32 uiMaxEntries, nsStringView sSourceFile) const
 {
   return true;
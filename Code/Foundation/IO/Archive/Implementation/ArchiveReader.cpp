@@ -70,9 +70,29 @@ nsResult nsArchiveReader::OpenArchive(nsStringView sPath)
         nsLog::Error("Archive is corrupt. Invalid entry path-string offset.");
         return NS_FAILURE;
       }
+
+      if (e.m_CompressionMode == nsArchiveCompressionMode::Compressed_zstd_dictionary && m_ArchiveTOC.m_CompressionDictionary.IsEmpty())
+      {
+        nsLog::Error("Archive is corrupt. Entry requires a compression dictionary, but the archive contains none.");
+        return NS_FAILURE;
+      }
     }
   }
 
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  // prepare the dictionary once, all entry readers share it
+  m_CompressionDictionary.Clear();
+
+  if (!m_ArchiveTOC.m_CompressionDictionary.IsEmpty())
+  {
+    if (m_CompressionDictionary.Create(m_ArchiveTOC.m_CompressionDictionary).Failed())
+    {
+      nsLog::Error("Archive is corrupt. Invalid compression dictionary.");
+      return NS_FAILURE;
+    }
+  }
+#  endif
+
   return NS_SUCCESS;
 #else
   NS_REPORT_FAILURE("Memory mapped files are unsupported on this platform.");
@@ -111,9 +131,20 @@ void nsArchiveReader::ConfigureRawMemoryStreamReader(nsUInt32 uiEntryIdx, nsRawM
 
 nsUniquePtr<nsStreamReader> nsArchiveReader::CreateEntryReader(nsUInt32 uiEntryIdx) const
 {
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  return nsArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, GetCompressionDictionary());
+#else
   return nsArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+#endif
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+const nsCompressedStreamDictionaryZstd* nsArchiveReader::GetCompressionDictionary() const
+{
+  return m_CompressionDictionary.IsValid() ? &m_CompressionDictionary : nullptr;
+}
+#endif
+
 nsResult nsArchiveReader::ExtractFile(nsUInt32 uiEntryIdx, nsStringView sTargetFolder) const
 {
   nsStringView sFilePath = m_ArchiveTOC.GetEntryPathString(uiEntryIdx);
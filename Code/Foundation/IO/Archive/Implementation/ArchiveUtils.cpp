@@ -42,11 +42,12 @@ nsResult nsArchiveUtils::WriteHeader(nsStreamWriter& inout_stream)
   const char* szTag = "NSARCHIVE";
   NS_SUCCEED_OR_RETURN(inout_stream.WriteBytes(szTag, 10));
 
-  const nsUInt8 uiArchiveVersion = 4;
+  const nsUInt8 uiArchiveVersion = 5;
 
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
   // Version 4: use 64 Bit string hashes
+  // Version 5: TOC stores an optional compression dictionary
   inout_stream << uiArchiveVersion;
 
   const nsUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
@@ -67,7 +68,7 @@ nsResult nsArchiveUtils::ReadHeader(nsStreamReader& inout_stream, nsUInt8& out_u
   out_uiVersion = 0;
   inout_stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4)
+  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4 && out_uiVersion != 5)
   {
     nsLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return NS_FAILURE;
@@ -93,7 +94,8 @@ nsResult nsArchiveUtils::ReadHeader(nsStreamReader& inout_stream, nsUInt8& out_u
 
 nsResult nsArchiveUtils::WriteEntry(
   nsStreamWriter& inout_stream, nsStringView sAbsSourcePath, nsUInt32 uiPathStringOffset, nsArchiveCompressionMode compression,
-  nsInt32 iCompressionLevel, nsArchiveEntry& inout_tocEntry, nsUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  nsInt32 iCompressionLevel, nsArchiveEntry& inout_tocEntry, nsUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/,
+  nsArrayPtr<const nsUInt8> compressionDictionary /*= nsArrayPtr<const nsUInt8>()*/)
 {
   nsFileReader file;
   NS_SUCCEED_OR_RETURN(file.Open(sAbsSourcePath, 1024 * 1024));
@@ -112,6 +114,11 @@ nsResult nsArchiveUtils::WriteEntry(
   nsCompressedStreamWriterZstd zstdWriter;
 #endif
 
+  if (compression == nsArchiveCompressionMode::Compressed_zstd_dictionary && compressionDictionary.IsEmpty())
+  {
+    compression = nsArchiveCompressionMode::Compressed_zstd;
+  }
+
   switch (compression)
   {
     case nsArchiveCompressionMode::Uncompressed:
@@ -119,7 +126,13 @@ nsResult nsArchiveUtils::WriteEntry(
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     case nsArchiveCompressionMode::Compressed_zstd:
+    case nsArchiveCompressionMode::Compressed_zstd_dictionary:
     {
+      if (compression == nsArchiveCompressionMode::Compressed_zstd_dictionary)
+      {
+        zstdWriter.SetDictionary(compressionDictionary);
+      }
+
       constexpr nsUInt32 uiMaxNumWorkerThreads = 12u;
       zstdWriter.SetOutputStream(&inout_stream, uiMaxNumWorkerThreads, (nsCompressedStreamWriterZstd::Compression)iCompressionLevel);
       pWriter = &zstdWriter;
@@ -158,6 +171,7 @@ nsResult nsArchiveUtils::WriteEntry(
   {
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     case nsArchiveCompressionMode::Compressed_zstd:
+    case nsArchiveCompressionMode::Compressed_zstd_dictionary:
       NS_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
       inout_tocEntry.m_uiStoredDataSize = zstdWriter.GetWrittenBytes();
       break;
@@ -174,7 +188,7 @@ nsResult nsArchiveUtils::WriteEntry(
   return NS_SUCCESS;
 }
 
-nsResult nsArchiveUtils::WriteEntryOptimal(nsStreamWriter& inout_stream, nsStringView sAbsSourcePath, nsUInt32 uiPathStringOffset, nsArchiveCompressionMode compression, nsInt32 iCompressionLevel, nsArchiveEntry& ref_tocEntry, nsUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+nsResult nsArchiveUtils::WriteEntryOptimal(nsStreamWriter& inout_stream, nsStringView sAbsSourcePath, nsUInt32 uiPathStringOffset, nsArchiveCompressionMode compression, nsInt32 iCompressionLevel, nsArchiveEntry& ref_tocEntry, nsUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, nsArrayPtr<const nsUInt8> compressionDictionary /*= nsArrayPtr<const nsUInt8>()*/)
 {
   if (compression == nsArchiveCompressionMode::Uncompressed)
   {
@@ -186,7 +200,7 @@ nsResult nsArchiveUtils::WriteEntryOptimal(nsStreamWriter& inout_stream, nsStrin
     nsMemoryStreamWriter writer(&storage);
 
     nsUInt64 streamPos = inout_uiCurrentStreamPosition;
-    NS_SUCCEED_OR_RETURN(WriteEntry(writer, sAbsSourcePath, uiPathStringOffset, compression, iCompressionLevel, ref_tocEntry, streamPos, progress));
+    NS_SUCCEED_OR_RETURN(WriteEntry(writer, sAbsSourcePath, uiPathStringOffset, compression, iCompressionLevel, ref_tocEntry, streamPos, progress, compressionDictionary));
 
     if (ref_tocEntry.m_uiStoredDataSize * 12 >= ref_tocEntry.m_uiUncompressedDataSize * 10)
     {
@@ -214,7 +228,7 @@ public:
 #endif
 
 
-nsUniquePtr<nsStreamReader> nsArchiveUtils::CreateEntryReader(const nsArchiveEntry& entry, const void* pStartOfArchiveData)
+nsUniquePtr<nsStreamReader> nsArchiveUtils::CreateEntryReader(const nsArchiveEntry& entry, const void* pStartOfArchiveData, const nsCompressedStreamDictionaryZstd* pDictionary /*= nullptr*/)
 {
   nsUniquePtr<nsStreamReader> reader;
 
@@ -237,6 +251,22 @@ nsUniquePtr<nsStreamReader> nsArchiveUtils::CreateEntryReader(const nsArchiveEnt
       pRawReader->SetInputStream(&pRawReader->m_Source);
       break;
     }
+
+    case nsArchiveCompressionMode::Compressed_zstd_dictionary:
+    {
+      if (pDictionary == nullptr)
+      {
+        NS_REPORT_FAILURE("Archive entry was compressed with a dictionary, but no dictionary was provided");
+        break;
+      }
+
+      reader = NS_DEFAULT_NEW(nsCompressedStreamReaderZstdWithSource);
+      nsCompressedStreamReaderZstdWithSource* pRawReader = static_cast<nsCompressedStreamReaderZstdWithSource*>(reader.Borrow());
+      ConfigureRawMemoryStreamReader(entry, pStartOfArchiveData, pRawReader->m_Source);
+      pRawReader->SetDictionary(pDictionary);
+      pRawReader->SetInputStream(&pRawReader->m_Source);
+      break;
+    }
 #endif
 
     default:
@@ -78,17 +78,26 @@ nsDataDirectoryReader* nsDataDirectory::ArchiveType::OpenFileToRead(nsStringView
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
       case nsArchiveCompressionMode::Compressed_zstd:
+      case nsArchiveCompressionMode::Compressed_zstd_dictionary:
       {
+        ArchiveReaderZstd* pReaderZstd = nullptr;
+
         if (!m_FreeReadersZstd.IsEmpty())
         {
-          pReader = m_FreeReadersZstd.PeekBack();
+          pReaderZstd = m_FreeReadersZstd.PeekBack();
           m_FreeReadersZstd.PopBack();
         }
         else
         {
           m_ReadersZstd.PushBack(NS_DEFAULT_NEW(ArchiveReaderZstd, 1));
-          pReader = m_ReadersZstd.PeekBack().Borrow();
+          pReaderZstd = m_ReadersZstd.PeekBack().Borrow();
         }
+
+        // readers are recycled across entries, so the dictionary always has to be set (or reset)
+        const bool bUseDictionary = pEntry->m_CompressionMode == nsArchiveCompressionMode::Compressed_zstd_dictionary;
+        pReaderZstd->m_CompressedStreamReader.SetDictionary(bUseDictionary ? m_ArchiveReader.GetCompressionDictionary() : nullptr);
+
+        pReader = pReaderZstd;
         break;
       }
 #endif
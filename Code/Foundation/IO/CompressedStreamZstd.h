@@ -9,9 +9,38 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Types/SharedPtr.h>
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+/// \brief A prepared zstd dictionary for decompression.
+///
+/// Digesting a dictionary takes time, so this should be done once and the result shared by all readers that decompress data which was
+/// compressed with the same dictionary (see nsCompressedStreamWriterZstd::SetDictionary()).
+/// Any number of nsCompressedStreamReaderZstd instances may use the same dictionary concurrently.
+class NS_FOUNDATION_DLL nsCompressedStreamDictionaryZstd
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsCompressedStreamDictionaryZstd);
+
+public:
+  nsCompressedStreamDictionaryZstd();
+  ~nsCompressedStreamDictionaryZstd();
+
+  /// \brief Prepares the dictionary for decompression. The data is copied, so it does not need to stay valid afterwards.
+  nsResult Create(nsArrayPtr<const nsUInt8> dictionary); // [tested]
+
+  /// \brief Frees the prepared dictionary.
+  void Clear();
+
+  /// \brief Returns whether Create() was successfully called.
+  bool IsValid() const { return m_pZstdDDict != nullptr; }
+
+private:
+  friend class nsCompressedStreamReaderZstd;
+
+  /*ZSTD_DDict*/ void* m_pZstdDDict = nullptr;
+};
+
 /// \brief A stream reader that will decompress data that was stored using the nsCompressedStreamWriterZstd.
 ///
 /// The reader takes another reader as its source for the compressed data (e.g. a file or a memory stream).
@@ -31,6 +60,12 @@ public:
   /// one.
   void SetInputStream(nsStreamReader* pInputStream); // [tested]
 
+  /// \brief Sets the dictionary with which the data was compressed. Pass nullptr, if no dictionary was used.
+  ///
+  /// The dictionary is referenced, not copied, and must stay alive as long as this reader uses it.
+  /// It takes effect with the next call to SetInputStream() and is kept for all following streams, until it is changed again.
+  void SetDictionary(const nsCompressedStreamDictionaryZstd* pDictionary); // [tested]
+
   /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
   ///
   /// It is valid to pass nullptr for pReadBuffer, in this case the memory stream position is only advanced by the given number of bytes.
@@ -51,10 +86,53 @@ private:
   bool m_bReachedEnd = false;
   nsDynamicArray<nsUInt8> m_CompressedCache;
   nsStreamReader* m_pInputStream = nullptr;
+  const nsCompressedStreamDictionaryZstd* m_pDictionary = nullptr;
   /*ZSTD_DStream*/ void* m_pZstdDStream = nullptr;
   /*ZSTD_inBuffer*/ InBufferImpl m_InBuffer;
 };
 
+/// \brief A stream reader that decompresses data that was stored using the nsCompressedStreamWriterZstd, using multiple threads.
+///
+/// The compressed frames are read from the input stream on the calling thread and then decompressed ahead of time on the nsTaskSystem,
+/// into a ring of up to 'uiMaxFramesInFlight' frames. This only pays off, if the writer was configured to emit independent frames
+/// (see nsCompressedStreamWriterZstd::SetIndependentFrameSize()). Other streams consist of a single frame, which is then read entirely into
+/// memory and decompressed by a single task.
+///
+/// The input stream is read ahead of the decompressed data, but never past the end of the compressed data, so data that comes after the
+/// compressed stream can still be read.
+class NS_FOUNDATION_DLL nsCompressedStreamReaderZstdParallel : public nsStreamReader
+{
+public:
+  nsCompressedStreamReaderZstdParallel();
+
+  /// \brief Takes an input stream as the source from which to read the compressed data.
+  nsCompressedStreamReaderZstdParallel(nsStreamReader* pInputStream, nsUInt32 uiMaxFramesInFlight = 4);
+
+  ~nsCompressedStreamReaderZstdParallel();
+
+  /// \brief Configures the reader to decompress the data from the given input stream.
+  ///
+  /// Immediately reads the first frames from the input stream and starts decompressing them.
+  /// Calling this a second time on the same instance is valid and reuses the internal buffers.
+  void SetInputStream(nsStreamReader* pInputStream, nsUInt32 uiMaxFramesInFlight = 4);
+
+  /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
+  ///
+  /// It is valid to pass nullptr for pReadBuffer, in this case the stream position is only advanced by the given number of bytes.
+  virtual nsUInt64 ReadBytes(void* pReadBuffer, nsUInt64 uiBytesToRead) override;
+
+private:
+  class FrameTask;
+
+  void ScheduleNextFrame(nsUInt32 uiFrame);
+  void WaitForAllFrames();
+
+  nsStreamReader* m_pInputStream = nullptr;
+  bool m_bReachedEndOfInput = false;
+  nsUInt32 m_uiCurrentFrame = 0;
+  nsDynamicArray<nsSharedPtr<FrameTask>> m_Frames;
+};
+
 /// \brief A stream writer that will compress all incoming data and then passes it on into another stream.
 ///
 /// The stream uses an internal cache of 255 Bytes to compress data, before it passes that on to the output stream.
@@ -137,8 +215,30 @@ public:
   /// \note Flushing the stream reduces compression effectiveness. Only in rare circumstances should it be necessary to call this manually.
   virtual nsResult Flush() override; // [tested]
 
+  /// \brief Makes the writer split the data into independent zstd frames of the given uncompressed size.
+  ///
+  /// By default (0) all data ends up in a single frame, which gives the best compression ratio.
+  /// With independent frames, nsCompressedStreamReaderZstdParallel can decompress multiple frames at once.
+  /// Each frame stores its decompressed size, so that the reader can allocate the output up front. A few MB per frame are a good choice.
+  /// The stream stays readable with nsCompressedStreamReaderZstd.
+  ///
+  /// The data of a frame is cached uncompressed until the frame is full. Calling Flush() ends the current frame early.
+  /// This has to be called before writing any bytes to the stream. The setting is kept when SetOutputStream() is called again.
+  void SetIndependentFrameSize(nsUInt32 uiFrameSizeKB); // [tested]
+
+  /// \brief Makes the writer compress the data with the given dictionary.
+  ///
+  /// The dictionary is used as raw content, meaning any data that is similar to the data that gets compressed is a good dictionary.
+  /// This improves the compression ratio a lot for small streams, where the compressor otherwise has no history to work with.
+  /// The data has to be decompressed with the same dictionary (see nsCompressedStreamReaderZstd::SetDictionary()).
+  ///
+  /// The data is referenced and must stay valid as long as this writer uses it. Pass an empty array to disable the dictionary.
+  /// This has to be called before writing any bytes to the stream. The setting is kept when SetOutputStream() is called again.
+  void SetDictionary(nsArrayPtr<const nsUInt8> dictionary); // [tested]
+
 private:
   nsResult FlushWriteCache();
+  nsResult CompressFrame();
 
   nsUInt64 m_uiUncompressedSize = 0;
   nsUInt64 m_uiCompressedSize = 0;
@@ -157,6 +257,11 @@ private:
   /*ZSTD_outBuffer*/ OutBufferImpl m_OutBuffer;
 
   nsDynamicArray<nsUInt8> m_CompressedCache;
+
+  nsUInt32 m_uiFrameSize = 0;
+  nsDynamicArray<nsUInt8> m_FrameCache;
+
+  nsArrayPtr<const nsUInt8> m_Dictionary;
 };
 
 #endif // BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -5,11 +5,14 @@
  */
 #pragma once
 
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/MemoryStream.h>
 
 /// \brief A file writer that caches all written data and only opens and writes to the output file when everything is finished.
 /// Useful to ensure that only complete files are written, or nothing at all, in case of a crash.
+///
+/// By default all data is cached in memory. For large outputs SetMaxCacheSize() bounds the memory usage, see there.
 class NS_FOUNDATION_DLL nsDeferredFileWriter : public nsStreamWriter
 {
   NS_DISALLOW_COPY_AND_ASSIGN(nsDeferredFileWriter);
@@ -23,6 +26,18 @@ public:
   /// \brief This must be configured before anything is written to the file.
   void SetOutput(nsStringView sFileToWriteTo, bool bOnlyWriteIfDifferent = false); // [tested]
 
+  /// \brief Limits how much data is cached in memory. 0 (the default) means that everything is cached until Close().
+  ///
+  /// Once more than \a uiMaxCacheSize bytes are cached, the data is moved into a temporary file next to the output file and all further data
+  /// is written there. Close() then renames the temporary file to the output file, which replaces it in one step (see nsOSFile::ReplaceFile()).
+  ///
+  /// If the writer only writes when the content is different (see SetOutput()), the data is compared with the existing file block by block
+  /// as it is written. As long as it is identical, nothing needs to be cached at all. Only once a difference is found, the identical part is
+  /// copied from the existing file and caching starts. Thus unchanged outputs never need to be held in memory or written to disk.
+  ///
+  /// This must be configured before anything is written to the file.
+  void SetMaxCacheSize(nsUInt64 uiMaxCacheSize); // [tested]
+
   virtual nsResult WriteBytes(const void* pWriteBuffer, nsUInt64 uiBytesToWrite) override; // [tested]
 
   /// \brief Upon calling this the content is written to the file specified with SetOutput().
@@ -34,9 +49,24 @@ public:
   void Discard(); // [tested]
 
 private:
+  void StartStreaming();
+  nsUInt64 CompareWithExistingFile(const void* pWriteBuffer, nsUInt64 uiBytesToWrite);
+  nsResult StopComparing();
+  nsResult WriteToCache(const void* pWriteBuffer, nsUInt64 uiBytesToWrite);
+  nsResult SpillToTempFile();
+  nsResult CloseStreaming(bool* out_pWasWrittenTo);
+
   bool m_bOnlyWriteIfDifferent = false;
   bool m_bAlreadyClosed = false;
   nsString m_sOutputFile;
   nsDefaultMemoryStreamStorage m_Storage;
   nsMemoryStreamWriter m_Writer;
+
+  // only used with a max cache size
+  nsUInt64 m_uiMaxCacheSize = 0;
+  bool m_bStreamingStarted = false;
+  bool m_bComparing = false;
+  nsUInt64 m_uiMatchingBytes = 0; ///< number of written bytes that are identical to the existing file and therefore not cached
+  nsFileReader m_ExistingFile;
+  nsFileWriter m_TempFile;
 };
@@ -7,6 +7,12 @@
 
 #include <Foundation/IO/FileSystem/DeferredFileWriter.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/System/Process.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+static nsAtomicInteger32 s_iTempFileCounter;
 
 nsDeferredFileWriter::nsDeferredFileWriter()
   : m_Writer(&m_Storage)
@@ -19,11 +25,177 @@ void nsDeferredFileWriter::SetOutput(nsStringView sFileToWriteTo, bool bOnlyWrit
   m_sOutputFile = sFileToWriteTo;
 }
 
+void nsDeferredFileWriter::SetMaxCacheSize(nsUInt64 uiMaxCacheSize)
+{
+  NS_ASSERT_DEV(!m_bStreamingStarted && m_Storage.GetStorageSize64() == 0, "The cache size must be configured before writing any data");
+
+  m_uiMaxCacheSize = uiMaxCacheSize;
+}
+
 nsResult nsDeferredFileWriter::WriteBytes(const void* pWriteBuffer, nsUInt64 uiBytesToWrite)
 {
   NS_ASSERT_DEBUG(!m_sOutputFile.IsEmpty(), "Output file has not been configured");
 
-  return m_Writer.WriteBytes(pWriteBuffer, uiBytesToWrite);
+  if (m_uiMaxCacheSize == 0)
+    return m_Writer.WriteBytes(pWriteBuffer, uiBytesToWrite);
+
+  StartStreaming();
+
+  if (m_bComparing)
+  {
+    const nsUInt64 uiMatchingBytes = CompareWithExistingFile(pWriteBuffer, uiBytesToWrite);
+    m_uiMatchingBytes += uiMatchingBytes;
+
+    if (uiMatchingBytes == uiBytesToWrite)
+      return NS_SUCCESS;
+
+    NS_SUCCEED_OR_RETURN(StopComparing());
+
+    pWriteBuffer = nsMemoryUtils::AddByteOffset(pWriteBuffer, static_cast<ptrdiff_t>(uiMatchingBytes));
+    uiBytesToWrite -= uiMatchingBytes;
+  }
+
+  return WriteToCache(pWriteBuffer, uiBytesToWrite);
+}
+
+void nsDeferredFileWriter::StartStreaming()
+{
+  if (m_bStreamingStarted)
+    return;
+
+  m_bStreamingStarted = true;
+  m_bComparing = m_bOnlyWriteIfDifferent && m_ExistingFile.Open(m_sOutputFile).Succeeded();
+  m_uiMatchingBytes = 0;
+}
+
+nsUInt64 nsDeferredFileWriter::CompareWithExistingFile(const void* pWriteBuffer, nsUInt64 uiBytesToWrite)
+{
+  nsUInt8 tmp[1024 * 4];
+  nsUInt64 uiMatchingBytes = 0;
+
+  while (uiMatchingBytes < uiBytesToWrite)
+  {
+    const nsUInt64 uiBlockSize = nsMath::Min<nsUInt64>(NS_ARRAY_SIZE(tmp), uiBytesToWrite - uiMatchingBytes);
+    const nsUInt64 uiReadBytes = m_ExistingFile.ReadBytes(tmp, uiBlockSize);
+
+    // the existing file is shorter or differs within this block, only full blocks count as identical
+    if (uiReadBytes != uiBlockSize || nsMemoryUtils::RawByteCompare(tmp, nsMemoryUtils::AddByteOffset(pWriteBuffer, static_cast<ptrdiff_t>(uiMatchingBytes)), nsMath::SafeConvertToSizeT(uiBlockSize)) != 0)
+      break;
+
+    uiMatchingBytes += uiBlockSize;
+  }
+
+  return uiMatchingBytes;
+}
+
+nsResult nsDeferredFileWriter::StopComparing()
+{
+  m_bComparing = false;
+  m_ExistingFile.Close();
+
+  if (m_uiMatchingBytes == 0)
+    return NS_SUCCESS;
+
+  // the identical data was not cached, so copy it from the existing file now
+  NS_SUCCEED_OR_RETURN(m_ExistingFile.Open(m_sOutputFile));
+
+  nsUInt8 tmp[1024 * 4];
+
+  while (m_uiMatchingBytes > 0)
+  {
+    const nsUInt64 uiBlockSize = nsMath::Min<nsUInt64>(NS_ARRAY_SIZE(tmp), m_uiMatchingBytes);
+
+    if (m_ExistingFile.ReadBytes(tmp, uiBlockSize) != uiBlockSize)
+    {
+      m_ExistingFile.Close();
+      return NS_FAILURE;
+    }
+
+    NS_SUCCEED_OR_RETURN(WriteToCache(tmp, uiBlockSize));
+    m_uiMatchingBytes -= uiBlockSize;
+  }
+
+  m_ExistingFile.Close();
+  return NS_SUCCESS;
+}
+
+nsResult nsDeferredFileWriter::WriteToCache(const void* pWriteBuffer, nsUInt64 uiBytesToWrite)
+{
+  if (m_TempFile.IsOpen())
+    return m_TempFile.WriteBytes(pWriteBuffer, uiBytesToWrite);
+
+  NS_SUCCEED_OR_RETURN(m_Writer.WriteBytes(pWriteBuffer, uiBytesToWrite));
+
+  if (m_Storage.GetStorageSize64() > m_uiMaxCacheSize)
+    return SpillToTempFile();
+
+  return NS_SUCCESS;
+}
+
+nsResult nsDeferredFileWriter::SpillToTempFile()
+{
+  // the temp file is placed next to the output file, so that it can be renamed without copying the data
+  // the name is unique per process and writer, so that it neither overwrites an existing file nor collides with other writers of the same output
+  nsStringBuilder sTempFile(m_sOutputFile);
+
+#if NS_ENABLED(NS_SUPPORTS_PROCESSES)
+  sTempFile.AppendFormat(".{}", nsProcess::GetCurrentProcessID());
+#endif
+
+  sTempFile.AppendFormat("-{}.tmp", s_iTempFileCounter.Increment());
+
+  NS_SUCCEED_OR_RETURN(m_TempFile.Open(sTempFile));
+  NS_SUCCEED_OR_RETURN(m_Storage.CopyToStream(m_TempFile));
+
+  m_Storage.Clear();
+  m_Writer.SetWritePosition(0);
+
+  return NS_SUCCESS;
+}
+
+nsResult nsDeferredFileWriter::CloseStreaming(bool* out_pWasWrittenTo)
+{
+  StartStreaming();
+
+  if (m_bComparing)
+  {
+    nsUInt8 uiByte = 0;
+    if (m_ExistingFile.ReadBytes(&uiByte, 1) == 0)
+    {
+      // content is already the same as what we would write -> skip the write (do not modify file write date)
+      m_ExistingFile.Close();
+      m_sOutputFile.Clear();
+      return NS_SUCCESS;
+    }
+
+    // the existing file is longer
+    NS_SUCCEED_OR_RETURN(StopComparing());
+  }
+
+  if (!m_TempFile.IsOpen())
+  {
+    NS_SUCCEED_OR_RETURN(SpillToTempFile());
+  }
+
+  const nsString128 sTempFileAbs = m_TempFile.GetFilePathAbsolute();
+  m_TempFile.Close();
+
+  nsStringBuilder sOutputFileAbs;
+  if (nsFileSystem::ResolvePath(m_sOutputFile, &sOutputFileAbs, nullptr).Failed() || nsOSFile::ReplaceFile(sTempFileAbs, sOutputFileAbs).Failed())
+  {
+    // the existing output is untouched when the replace fails, so the temp file is not needed anymore
+    nsOSFile::DeleteFile(sTempFileAbs).IgnoreResult();
+    m_sOutputFile.Clear();
+    return NS_FAILURE;
+  }
+
+  if (out_pWasWrittenTo)
+  {
+    *out_pWasWrittenTo = true;
+  }
+
+  m_sOutputFile.Clear();
+  return NS_SUCCESS;
 }
 
 nsResult nsDeferredFileWriter::Close(bool* out_pWasWrittenTo /*= nullptr*/)
@@ -41,6 +213,9 @@ nsResult nsDeferredFileWriter::Close(bool* out_pWasWrittenTo /*= nullptr*/)
 
   m_bAlreadyClosed = true;
 
+  if (m_uiMaxCacheSize > 0)
+    return CloseStreaming(out_pWasWrittenTo);
+
   if (m_bOnlyWriteIfDifferent)
   {
     nsFileReader fileIn;
@@ -87,6 +262,14 @@ write_data:
 void nsDeferredFileWriter::Discard()
 {
   m_sOutputFile.Clear();
+  m_ExistingFile.Close();
+
+  if (m_TempFile.IsOpen())
+  {
+    const nsString128 sTempFileAbs = m_TempFile.GetFilePathAbsolute();
+    m_TempFile.Close();
+    nsOSFile::DeleteFile(sTempFileAbs).IgnoreResult();
+  }
 }
 
 NS_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_DeferredFileWriter);
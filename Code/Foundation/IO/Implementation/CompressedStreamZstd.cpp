@@ -10,8 +10,39 @@
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
 #  include <Foundation/System/SystemInformation.h>
+#  include <Foundation/Threading/TaskSystem.h>
 #  include <zstd/zstd.h>
 
+nsCompressedStreamDictionaryZstd::nsCompressedStreamDictionaryZstd() = default;
+
+nsCompressedStreamDictionaryZstd::~nsCompressedStreamDictionaryZstd()
+{
+  Clear();
+}
+
+nsResult nsCompressedStreamDictionaryZstd::Create(nsArrayPtr<const nsUInt8> dictionary)
+{
+  Clear();
+
+  if (dictionary.IsEmpty())
+    return NS_FAILURE;
+
+  m_pZstdDDict = ZSTD_createDDict(dictionary.GetPtr(), dictionary.GetCount());
+
+  return m_pZstdDDict != nullptr ? NS_SUCCESS : NS_FAILURE;
+}
+
+void nsCompressedStreamDictionaryZstd::Clear()
+{
+  if (m_pZstdDDict != nullptr)
+  {
+    ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(m_pZstdDDict));
+    m_pZstdDDict = nullptr;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 nsCompressedStreamReaderZstd::nsCompressedStreamReaderZstd() = default;
 
 nsCompressedStreamReaderZstd::nsCompressedStreamReaderZstd(nsStreamReader* pInputStream)
@@ -41,6 +72,17 @@ void nsCompressedStreamReaderZstd::SetInputStream(nsStreamReader* pInputStream)
   }
 
   ZSTD_initDStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream));
+
+  if (m_pDictionary != nullptr)
+  {
+    NS_ASSERT_DEV(m_pDictionary->IsValid(), "The decompression dictionary has not been created.");
+    ZSTD_DCtx_refDDict(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream), reinterpret_cast<const ZSTD_DDict*>(m_pDictionary->m_pZstdDDict));
+  }
+}
+
+void nsCompressedStreamReaderZstd::SetDictionary(const nsCompressedStreamDictionaryZstd* pDictionary)
+{
+  m_pDictionary = pDictionary;
 }
 
 nsUInt64 nsCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, nsUInt64 uiBytesToRead)
@@ -138,6 +180,270 @@ nsResult nsCompressedStreamReaderZstd::RefillReadCache()
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 
+class nsCompressedStreamReaderZstdParallel::FrameTask final : public nsTask
+{
+public:
+  FrameTask() { ConfigureTask("Decompress Zstd Frame", nsTaskNesting::Never); }
+
+  ~FrameTask()
+  {
+    if (m_pZstdDCtx != nullptr)
+    {
+      ZSTD_freeDCtx(m_pZstdDCtx);
+      m_pZstdDCtx = nullptr;
+    }
+  }
+
+  void Clear()
+  {
+    m_Compressed.Clear();
+    m_Decompressed.Clear();
+    m_uiCompleteBytes = 0;
+    m_uiReadPosition = 0;
+    m_bScheduled = false;
+    m_bWaitedFor = false;
+    m_bSucceeded = false;
+  }
+
+  /// \brief Returns true once the compressed data ends with a complete frame.
+  bool ContainsCompleteFrames()
+  {
+    // the writer ends each frame at a chunk boundary, so the data is complete once it ends exactly with a frame
+    // frames that were already found to be complete are not looked at again
+    while (m_uiCompleteBytes < m_Compressed.GetCount())
+    {
+      const size_t uiFrameSize = ZSTD_findFrameCompressedSize(m_Compressed.GetData() + m_uiCompleteBytes, m_Compressed.GetCount() - m_uiCompleteBytes);
+
+      if (ZSTD_isError(uiFrameSize))
+        return false;
+
+      m_uiCompleteBytes += static_cast<nsUInt32>(uiFrameSize);
+    }
+
+    return true;
+  }
+
+  nsDynamicArray<nsUInt8> m_Compressed;
+  nsDynamicArray<nsUInt8> m_Decompressed;
+  nsUInt32 m_uiCompleteBytes = 0;
+  nsUInt64 m_uiReadPosition = 0;
+  nsTaskGroupID m_GroupID;
+  bool m_bScheduled = false;
+  bool m_bWaitedFor = false;
+  bool m_bSucceeded = false;
+
+private:
+  virtual void Execute() override
+  {
+    if (m_pZstdDCtx == nullptr)
+    {
+      m_pZstdDCtx = ZSTD_createDCtx();
+    }
+
+    const void* pSrc = m_Compressed.GetData();
+    const size_t uiSrcSize = m_Compressed.GetCount();
+
+    // a buffer may contain multiple frames, if the writer was flushed
+    nsUInt64 uiDecompressedSize = 0;
+    for (size_t uiPos = 0; uiPos < uiSrcSize;)
+    {
+      const nsUInt64 uiFrameContentSize = ZSTD_getFrameContentSize(nsMemoryUtils::AddByteOffset(pSrc, uiPos), uiSrcSize - uiPos);
+
+      if (uiFrameContentSize == ZSTD_CONTENTSIZE_UNKNOWN || uiFrameContentSize == ZSTD_CONTENTSIZE_ERROR)
+      {
+        uiDecompressedSize = ZSTD_CONTENTSIZE_UNKNOWN;
+        break;
+      }
+
+      uiDecompressedSize += uiFrameContentSize;
+      uiPos += ZSTD_findFrameCompressedSize(nsMemoryUtils::AddByteOffset(pSrc, uiPos), uiSrcSize - uiPos);
+    }
+
+    if (uiDecompressedSize != ZSTD_CONTENTSIZE_UNKNOWN)
+    {
+      m_Decompressed.SetCountUninitialized(static_cast<nsUInt32>(uiDecompressedSize));
+
+      const size_t res = ZSTD_decompressDCtx(m_pZstdDCtx, m_Decompressed.GetData(), m_Decompressed.GetCount(), pSrc, uiSrcSize);
+      m_bSucceeded = !ZSTD_isError(res) && res == m_Decompressed.GetCount();
+      return;
+    }
+
+    // streams that were not written with independent frames don't know their decompressed size, grow the output as needed
+    ZSTD_DCtx_reset(m_pZstdDCtx, ZSTD_reset_session_only);
+
+    ZSTD_inBuffer inBuffer;
+    inBuffer.src = pSrc;
+    inBuffer.size = uiSrcSize;
+    inBuffer.pos = 0;
+
+    m_Decompressed.SetCountUninitialized(nsMath::Max<nsUInt32>(m_Decompressed.GetCapacity(), static_cast<nsUInt32>(uiSrcSize) * 4, 1024u * 64u));
+
+    ZSTD_outBuffer outBuffer;
+    outBuffer.pos = 0;
+
+    while (true)
+    {
+      outBuffer.dst = m_Decompressed.GetData();
+      outBuffer.size = m_Decompressed.GetCount();
+
+      const size_t res = ZSTD_decompressStream(m_pZstdDCtx, &outBuffer, &inBuffer);
+
+      if (ZSTD_isError(res))
+      {
+        m_bSucceeded = false;
+        return;
+      }
+
+      if (inBuffer.pos == inBuffer.size && outBuffer.pos < outBuffer.size)
+        break;
+
+      if (outBuffer.pos == outBuffer.size)
+      {
+        m_Decompressed.SetCountUninitialized(m_Decompressed.GetCount() * 2);
+      }
+    }
+
+    m_Decompressed.SetCountUninitialized(static_cast<nsUInt32>(outBuffer.pos));
+    m_bSucceeded = true;
+  }
+
+  ZSTD_DCtx* m_pZstdDCtx = nullptr;
+};
+
+nsCompressedStreamReaderZstdParallel::nsCompressedStreamReaderZstdParallel() = default;
+
+nsCompressedStreamReaderZstdParallel::nsCompressedStreamReaderZstdParallel(nsStreamReader* pInputStream, nsUInt32 uiMaxFramesInFlight /*= 4*/)
+{
+  SetInputStream(pInputStream, uiMaxFramesInFlight);
+}
+
+nsCompressedStreamReaderZstdParallel::~nsCompressedStreamReaderZstdParallel()
+{
+  WaitForAllFrames();
+}
+
+void nsCompressedStreamReaderZstdParallel::SetInputStream(nsStreamReader* pInputStream, nsUInt32 uiMaxFramesInFlight /*= 4*/)
+{
+  WaitForAllFrames();
+
+  m_pInputStream = pInputStream;
+  m_bReachedEndOfInput = false;
+  m_uiCurrentFrame = 0;
+
+  m_Frames.SetCount(nsMath::Max(1u, uiMaxFramesInFlight));
+
+  for (nsUInt32 i = 0; i < m_Frames.GetCount(); ++i)
+  {
+    if (m_Frames[i] == nullptr)
+    {
+      m_Frames[i] = NS_DEFAULT_NEW(FrameTask);
+    }
+
+    ScheduleNextFrame(i);
+  }
+}
+
+void nsCompressedStreamReaderZstdParallel::WaitForAllFrames()
+{
+  for (auto& pFrame : m_Frames)
+  {
+    if (pFrame->m_bScheduled && !pFrame->m_bWaitedFor)
+    {
+      nsTaskSystem::WaitForGroup(pFrame->m_GroupID);
+      pFrame->m_bWaitedFor = true;
+    }
+  }
+}
+
+void nsCompressedStreamReaderZstdParallel::ScheduleNextFrame(nsUInt32 uiFrame)
+{
+  FrameTask& frame = *m_Frames[uiFrame];
+  frame.Clear();
+
+  if (m_bReachedEndOfInput || m_pInputStream == nullptr)
+    return;
+
+  while (true)
+  {
+    nsUInt16 uiCompressedSize = 0;
+    if (m_pInputStream->ReadBytes(&uiCompressedSize, sizeof(nsUInt16)) != sizeof(nsUInt16) || uiCompressedSize == 0)
+    {
+      // reached the zero-terminator
+      m_bReachedEndOfInput = true;
+      break;
+    }
+
+    const nsUInt32 uiOffset = frame.m_Compressed.GetCount();
+    frame.m_Compressed.SetCountUninitialized(uiOffset + uiCompressedSize);
+
+    NS_VERIFY(m_pInputStream->ReadBytes(frame.m_Compressed.GetData() + uiOffset, uiCompressedSize) == uiCompressedSize, "Reading the compressed chunk of size {0} from the input stream failed.", uiCompressedSize);
+
+    if (frame.ContainsCompleteFrames())
+      break;
+  }
+
+  if (frame.m_Compressed.IsEmpty())
+    return;
+
+  frame.m_bScheduled = true;
+  frame.m_GroupID = nsTaskSystem::StartSingleTask(m_Frames[uiFrame], nsTaskPriority::EarlyThisFrame);
+}
+
+nsUInt64 nsCompressedStreamReaderZstdParallel::ReadBytes(void* pReadBuffer, nsUInt64 uiBytesToRead)
+{
+  NS_ASSERT_DEV(m_pInputStream != nullptr, "No input stream has been specified");
+
+  nsUInt64 uiBytesRead = 0;
+
+  while (uiBytesRead < uiBytesToRead)
+  {
+    FrameTask& frame = *m_Frames[m_uiCurrentFrame];
+
+    if (!frame.m_bScheduled)
+      break; // reached the end of the stream
+
+    if (!frame.m_bWaitedFor)
+    {
+      nsTaskSystem::WaitForGroup(frame.m_GroupID);
+      frame.m_bWaitedFor = true;
+
+      NS_ASSERT_DEV(frame.m_bSucceeded, "Decompressing the stream failed.");
+
+      if (!frame.m_bSucceeded)
+      {
+        // don't return garbage
+        frame.m_Decompressed.Clear();
+      }
+    }
+
+    const nsUInt64 uiAvailable = frame.m_Decompressed.GetCount() - frame.m_uiReadPosition;
+    const nsUInt64 uiToCopy = nsMath::Min(uiAvailable, uiBytesToRead - uiBytesRead);
+
+    if (pReadBuffer != nullptr)
+    {
+      nsMemoryUtils::Copy(static_cast<nsUInt8*>(pReadBuffer) + uiBytesRead, frame.m_Decompressed.GetData() + frame.m_uiReadPosition, static_cast<size_t>(uiToCopy));
+    }
+
+    frame.m_uiReadPosition += uiToCopy;
+    uiBytesRead += uiToCopy;
+
+    if (frame.m_uiReadPosition == frame.m_Decompressed.GetCount())
+    {
+      // this slot is free again, the frame after the last one in flight goes in here
+      ScheduleNextFrame(m_uiCurrentFrame);
+      m_uiCurrentFrame = (m_uiCurrentFrame + 1) % m_Frames.GetCount();
+    }
+  }
+
+  return uiBytesRead;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
 nsCompressedStreamWriterZstd::nsCompressedStreamWriterZstd() = default;
 
 nsCompressedStreamWriterZstd::nsCompressedStreamWriterZstd(nsStreamWriter* pOutputStream, nsUInt32 uiMaxNumWorkerThreads, Compression ratio /*= Compression::Default*/, nsUInt32 uiCompressionCacheSizeKB /*= 4*/)
@@ -195,6 +501,11 @@ void nsCompressedStreamWriterZstd::SetOutputStream(nsStreamWriter* pOutputStream
     ZSTD_CCtx_setParameter(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), ZSTD_c_compressionLevel, (int)ratio);
     ZSTD_CCtx_setParameter(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), ZSTD_c_nbWorkers, uiCoreCount);
 
+    if (!m_Dictionary.IsEmpty())
+    {
+      ZSTD_CCtx_loadDictionary(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), m_Dictionary.GetPtr(), m_Dictionary.GetCount());
+    }
+
     m_CompressedCache.SetCountUninitialized(nsMath::Max(1U, uiCompressionCacheSizeKB) * 1024);
 
     m_OutBuffer.dst = m_CompressedCache.GetData();
@@ -211,17 +522,21 @@ nsResult nsCompressedStreamWriterZstd::FinishCompressedStream()
   if (Flush().Failed())
     return NS_FAILURE;
 
-  ZSTD_inBuffer emptyBuffer;
-  emptyBuffer.pos = 0;
-  emptyBuffer.size = 0;
-  emptyBuffer.src = nullptr;
+  // with independent frames, Flush() has already completed the last frame
+  if (m_uiFrameSize == 0)
+  {
+    ZSTD_inBuffer emptyBuffer;
+    emptyBuffer.pos = 0;
+    emptyBuffer.size = 0;
+    emptyBuffer.src = nullptr;
 
-  const size_t res = ZSTD_compressStream2(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<ZSTD_outBuffer*>(&m_OutBuffer), &emptyBuffer, ZSTD_e_end);
-  NS_VERIFY(!ZSTD_isError(res), "Deinitializing the zstd compression stream failed: '{0}'", ZSTD_getErrorName(res));
+    const size_t res = ZSTD_compressStream2(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<ZSTD_outBuffer*>(&m_OutBuffer), &emptyBuffer, ZSTD_e_end);
+    NS_VERIFY(!ZSTD_isError(res), "Deinitializing the zstd compression stream failed: '{0}'", ZSTD_getErrorName(res));
 
-  // one more flush to write out the last chunk
-  if (FlushWriteCache() == NS_FAILURE)
-    return NS_FAILURE;
+    // one more flush to write out the last chunk
+    if (FlushWriteCache() == NS_FAILURE)
+      return NS_FAILURE;
+  }
 
   // write a zero-terminator
   const nsUInt16 uiTerminator = 0;
@@ -239,6 +554,11 @@ nsResult nsCompressedStreamWriterZstd::Flush()
   if (m_pOutputStream == nullptr)
     return NS_SUCCESS;
 
+  if (m_uiFrameSize > 0)
+  {
+    return CompressFrame();
+  }
+
   ZSTD_inBuffer emptyBuffer;
   emptyBuffer.pos = 0;
   emptyBuffer.size = 0;
@@ -281,12 +601,82 @@ nsResult nsCompressedStreamWriterZstd::FlushWriteCache()
   return NS_SUCCESS;
 }
 
+void nsCompressedStreamWriterZstd::SetIndependentFrameSize(nsUInt32 uiFrameSizeKB)
+{
+  NS_ASSERT_DEV(m_uiUncompressedSize == 0, "The frame size has to be set before writing any data.");
+
+  m_uiFrameSize = uiFrameSizeKB * 1024;
+}
+
+void nsCompressedStreamWriterZstd::SetDictionary(nsArrayPtr<const nsUInt8> dictionary)
+{
+  NS_ASSERT_DEV(m_uiUncompressedSize == 0, "The dictionary has to be set before writing any data.");
+
+  m_Dictionary = dictionary;
+
+  if (m_pZstdCStream != nullptr && m_pOutputStream != nullptr)
+  {
+    ZSTD_CCtx_loadDictionary(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), m_Dictionary.GetPtr(), m_Dictionary.GetCount());
+  }
+}
+
+nsResult nsCompressedStreamWriterZstd::CompressFrame()
+{
+  if (m_FrameCache.IsEmpty())
+    return NS_SUCCESS;
+
+  // compressing the entire frame in one go stores the decompressed size in the frame header
+  ZSTD_inBuffer inBuffer;
+  inBuffer.pos = 0;
+  inBuffer.src = m_FrameCache.GetData();
+  inBuffer.size = m_FrameCache.GetCount();
+
+  while (true)
+  {
+    const size_t res = ZSTD_compressStream2(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<ZSTD_outBuffer*>(&m_OutBuffer), &inBuffer, ZSTD_e_end);
+    NS_VERIFY(!ZSTD_isError(res), "Compressing the zstd frame failed: '{0}'", ZSTD_getErrorName(res));
+
+    if (res == 0)
+      break;
+
+    if (FlushWriteCache() == NS_FAILURE)
+      return NS_FAILURE;
+  }
+
+  m_FrameCache.Clear();
+
+  // always end a frame at a chunk boundary, this is what allows nsCompressedStreamReaderZstdParallel to find the frames
+  return FlushWriteCache();
+}
+
 nsResult nsCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, nsUInt64 uiBytesToWrite)
 {
   NS_ASSERT_DEV(m_pZstdCStream != nullptr, "The stream is already closed, you cannot write more data to it.");
 
   m_uiUncompressedSize += static_cast<nsUInt32>(uiBytesToWrite);
 
+  if (m_uiFrameSize > 0)
+  {
+    const nsUInt8* pData = static_cast<const nsUInt8*>(pWriteBuffer);
+
+    while (uiBytesToWrite > 0)
+    {
+      const nsUInt32 uiToCopy = static_cast<nsUInt32>(nsMath::Min<nsUInt64>(m_uiFrameSize - m_FrameCache.GetCount(), uiBytesToWrite));
+      m_FrameCache.PushBackRange(nsArrayPtr<const nsUInt8>(pData, uiToCopy));
+
+      pData += uiToCopy;
+      uiBytesToWrite -= uiToCopy;
+
+      if (m_FrameCache.GetCount() == m_uiFrameSize)
+      {
+        if (CompressFrame() == NS_FAILURE)
+          return NS_FAILURE;
+      }
+    }
+
+    return NS_SUCCESS;
+  }
+
   ZSTD_inBuffer inBuffer;
   inBuffer.pos = 0;
   inBuffer.src = pWriteBuffer;
@@ -6,6 +6,7 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/IO/JSONParser.h>
+#include <Foundation/IO/JSONTape.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
@@ -111,6 +112,101 @@ void nsJSONParser::ParseAll()
   }
 }
 
+void nsJSONParser::ParseTape(const nsJSONTape& tape)
+{
+  m_StateStack.Clear();
+  m_bSkippingMode = false;
+
+  m_pTape = &tape;
+  m_uiTapePos = 0;
+  m_TapeStack.Clear();
+
+  while (m_uiTapePos < tape.m_Tape.GetCount())
+  {
+    const nsUInt32 uiIndex = m_uiTapePos;
+    const nsUInt8 uiType = tape.GetTypeAt(uiIndex);
+
+    if (uiType == nsJSONTape::s_uiEndMarker)
+    {
+      const bool bObject = m_TapeStack.PeekBack().m_bObject;
+      m_TapeStack.PopBack();
+      m_uiTapePos = uiIndex + 1;
+
+      if (bObject)
+        OnEndObject();
+      else
+        OnEndArray();
+
+      continue;
+    }
+
+    if (!m_TapeStack.IsEmpty() && m_TapeStack.PeekBack().m_bObject)
+    {
+      TapeScope& scope = m_TapeStack.PeekBack();
+
+      if (scope.m_bExpectName)
+      {
+        scope.m_bExpectName = false;
+        m_uiTapePos = uiIndex + 2;
+
+        if (!OnVariable(nsJSONTapeValue(&tape, uiIndex).GetString()))
+        {
+          // skip the entire value of this variable
+          m_uiTapePos = tape.GetSkipIndex(m_uiTapePos);
+          m_TapeStack.PeekBack().m_bExpectName = true;
+        }
+
+        continue;
+      }
+
+      scope.m_bExpectName = true;
+    }
+
+    m_uiTapePos = tape.GetSkipIndex(uiIndex);
+
+    switch (uiType)
+    {
+      case nsJSONTapeType::Object:
+      case nsJSONTapeType::Array:
+      {
+        const bool bObject = uiType == nsJSONTapeType::Object;
+        m_TapeStack.PushBack({uiIndex, bObject, true});
+        m_uiTapePos = uiIndex + 1;
+
+        if (bObject)
+          OnBeginObject();
+        else
+          OnBeginArray();
+
+        break;
+      }
+
+      case nsJSONTapeType::String:
+        OnReadValue(nsJSONTapeValue(&tape, uiIndex).GetString());
+        break;
+
+      case nsJSONTapeType::Number:
+        OnReadValue(nsJSONTapeValue(&tape, uiIndex).GetNumber());
+        break;
+
+      case nsJSONTapeType::Bool:
+        OnReadValue(nsJSONTapeValue(&tape, uiIndex).GetBool());
+        break;
+
+      case nsJSONTapeType::Null:
+        OnReadValueNULL();
+        break;
+
+      default:
+        NS_REPORT_FAILURE("Invalid entry on JSON tape.");
+        break;
+    }
+  }
+
+  m_pTape = nullptr;
+  m_TapeStack.Clear();
+}
+
 void nsJSONParser::ParsingError(nsStringView sMessage, bool bFatal)
 {
   if (bFatal)
@@ -140,6 +236,22 @@ void nsJSONParser::SkipArray()
 
 void nsJSONParser::SkipStack(State s)
 {
+  if (m_pTape != nullptr)
+  {
+    // when replaying a tape, jump behind the end of the innermost object or array
+    for (nsUInt32 top = m_TapeStack.GetCount(); top > 0; --top)
+    {
+      if (m_TapeStack[top - 1].m_bObject == (s == ReadingObject))
+      {
+        m_uiTapePos = m_pTape->GetSkipIndex(m_TapeStack[top - 1].m_uiTapeIndex);
+        m_TapeStack.SetCount(top - 1);
+        break;
+      }
+    }
+
+    return;
+  }
+
   m_bSkippingMode = true;
 
   nsUInt32 iSkipToStackHeight = m_StateStack.GetCount();
@@ -43,6 +43,24 @@ nsResult nsJSONReader::Parse(nsStreamReader& ref_inputStream, nsUInt32 uiFirstLi
   return NS_SUCCESS;
 }
 
+nsResult nsJSONReader::Parse(const nsJSONTape& tape)
+{
+  m_bParsingError = false;
+  m_Stack.Clear();
+  m_sLastName.Clear();
+
+  ParseTape(tape);
+
+  // make sure there is one top level element
+  if (m_Stack.IsEmpty())
+  {
+    Element& e = m_Stack.ExpandAndGetRef();
+    e.m_Mode = ElementType::None;
+  }
+
+  return NS_SUCCESS;
+}
+
 bool nsJSONReader::OnVariable(nsStringView sVarName)
 {
   m_sLastName = sVarName;
@@ -0,0 +1,858 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/JSONTape.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Strings/UnicodeUtils.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+namespace
+{
+  struct nsJSONBlockMasks
+  {
+    nsUInt64 m_uiQuote = 0;
+    nsUInt64 m_uiBackslash = 0;
+    nsUInt64 m_uiWhitespace = 0;
+    nsUInt64 m_uiOperator = 0;
+    nsUInt64 m_uiSlash = 0;
+  };
+
+  /// Classifies 64 bytes of input, one bit per byte.
+  void ClassifyBlock(const char* pBlock, nsJSONBlockMasks& out_masks)
+  {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    auto Match = [](__m128i v, char c)
+    { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + i * 16));
+      const nsUInt32 uiShift = i * 16;
+
+      const __m128i ws = _mm_or_si128(_mm_or_si128(Match(v, ' '), Match(v, '\t')), _mm_or_si128(Match(v, '\n'), Match(v, '\r')));
+      const __m128i braces = _mm_or_si128(_mm_or_si128(Match(v, '{'), Match(v, '}')), _mm_or_si128(Match(v, '['), Match(v, ']')));
+      const __m128i op = _mm_or_si128(braces, _mm_or_si128(Match(v, ':'), Match(v, ',')));
+
+      out_masks.m_uiQuote |= nsUInt64(nsUInt32(_mm_movemask_epi8(Match(v, '"')))) << uiShift;
+      out_masks.m_uiBackslash |= nsUInt64(nsUInt32(_mm_movemask_epi8(Match(v, '\\')))) << uiShift;
+      out_masks.m_uiWhitespace |= nsUInt64(nsUInt32(_mm_movemask_epi8(ws))) << uiShift;
+      out_masks.m_uiOperator |= nsUInt64(nsUInt32(_mm_movemask_epi8(op))) << uiShift;
+      out_masks.m_uiSlash |= nsUInt64(nsUInt32(_mm_movemask_epi8(Match(v, '/')))) << uiShift;
+    }
+#else
+    for (nsUInt32 i = 0; i < 64; ++i)
+    {
+      const nsUInt64 uiBit = nsUInt64(1) << i;
+
+      switch (pBlock[i])
+      {
+        case '"':
+          out_masks.m_uiQuote |= uiBit;
+          break;
+        case '\\':
+          out_masks.m_uiBackslash |= uiBit;
+          break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+          out_masks.m_uiWhitespace |= uiBit;
+          break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+          out_masks.m_uiOperator |= uiBit;
+          break;
+        case '/':
+          out_masks.m_uiSlash |= uiBit;
+          break;
+        default:
+          break;
+      }
+    }
+#endif
+  }
+
+  /// Sets every bit that has an odd number of set bits at or below it, i.e. turns quote positions into a string mask.
+  NS_ALWAYS_INLINE nsUInt64 PrefixXor(nsUInt64 x)
+  {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+  /// Returns the offset of the next '"' or '\' at or after uiStart, or uiSize if there is none.
+  nsUInt32 FindQuoteOrBackslash(const char* pData, nsUInt32 uiSize, nsUInt32 uiStart)
+  {
+    nsUInt32 i = uiStart;
+
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    for (; i + 16 <= uiSize; i += 16)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+      const nsUInt32 uiMask = static_cast<nsUInt32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash))));
+
+      if (uiMask != 0)
+        return i + nsMath::FirstBitLow(uiMask);
+    }
+#endif
+
+    while (i < uiSize && pData[i] != '"' && pData[i] != '\\')
+      ++i;
+
+    return i;
+  }
+
+  NS_ALWAYS_INLINE bool IsScalarTerminator(char c)
+  {
+    switch (c)
+    {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+      case '"':
+      case '/':
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool ReadHex4(const char* pData, nsUInt32& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      const char c = pData[i];
+      nsUInt32 uiDigit = 0;
+
+      if (c >= '0' && c <= '9')
+        uiDigit = c - '0';
+      else if (c >= 'a' && c <= 'f')
+        uiDigit = c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        uiDigit = c - 'A' + 10;
+      else
+        return false;
+
+      out_uiValue = (out_uiValue << 4) | uiDigit;
+    }
+
+    return true;
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+nsJSONTapeType::Enum nsJSONTapeValue::GetType() const
+{
+  if (m_pTape == nullptr)
+    return nsJSONTapeType::Invalid;
+
+  return static_cast<nsJSONTapeType::Enum>(m_pTape->GetTypeAt(m_uiIndex));
+}
+
+nsStringView nsJSONTapeValue::GetString() const
+{
+  NS_ASSERT_DEV(IsString(), "JSON value is not a string.");
+
+  const nsUInt64 uiPayload = m_pTape->GetPayloadAt(m_uiIndex);
+  const nsUInt64 uiOffset = uiPayload & (nsJSONTape::s_uiDecodedStringFlag - 1);
+  const nsUInt64 uiLength = m_pTape->m_Tape[m_uiIndex + 1];
+  const char* pBase = (uiPayload & nsJSONTape::s_uiDecodedStringFlag) ? m_pTape->m_DecodedStrings.GetData() : m_pTape->m_pDocument;
+
+  return nsStringView(pBase + uiOffset, static_cast<nsUInt32>(uiLength));
+}
+
+double nsJSONTapeValue::GetNumber() const
+{
+  NS_ASSERT_DEV(IsNumber(), "JSON value is not a number.");
+
+  double fValue = 0;
+  nsMemoryUtils::Copy(reinterpret_cast<nsUInt8*>(&fValue), reinterpret_cast<const nsUInt8*>(&m_pTape->m_Tape[m_uiIndex + 1]), sizeof(double));
+  return fValue;
+}
+
+bool nsJSONTapeValue::GetBool() const
+{
+  NS_ASSERT_DEV(IsBool(), "JSON value is not a bool.");
+
+  return m_pTape->GetPayloadAt(m_uiIndex) != 0;
+}
+
+nsUInt32 nsJSONTapeValue::GetCount() const
+{
+  const nsJSONTapeType::Enum type = GetType();
+  if (type != nsJSONTapeType::Object && type != nsJSONTapeType::Array)
+    return 0;
+
+  const nsUInt32 uiCount = static_cast<nsUInt32>(m_pTape->GetPayloadAt(m_uiIndex) >> nsJSONTape::s_uiCountShift);
+  if (uiCount < nsJSONTape::s_uiMaxCount)
+    return uiCount;
+
+  // the count did not fit into the tape entry, count the children instead
+  nsUInt32 uiChildren = 0;
+  for (nsJSONTapeValue child = GetFirstChild(); child.IsValid(); child = child.GetNextSibling())
+    ++uiChildren;
+
+  return type == nsJSONTapeType::Object ? uiChildren / 2 : uiChildren;
+}
+
+nsJSONTapeValue nsJSONTapeValue::GetFirstChild() const
+{
+  const nsJSONTapeType::Enum type = GetType();
+  if (type != nsJSONTapeType::Object && type != nsJSONTapeType::Array)
+    return nsJSONTapeValue();
+
+  if (m_pTape->GetTypeAt(m_uiIndex + 1) == nsJSONTape::s_uiEndMarker)
+    return nsJSONTapeValue();
+
+  return nsJSONTapeValue(m_pTape, m_uiIndex + 1);
+}
+
+nsJSONTapeValue nsJSONTapeValue::GetNextSibling() const
+{
+  if (m_pTape == nullptr)
+    return nsJSONTapeValue();
+
+  const nsUInt32 uiNext = m_pTape->GetSkipIndex(m_uiIndex);
+
+  if (uiNext >= m_pTape->m_Tape.GetCount() || m_pTape->GetTypeAt(uiNext) == nsJSONTape::s_uiEndMarker)
+    return nsJSONTapeValue();
+
+  return nsJSONTapeValue(m_pTape, uiNext);
+}
+
+nsJSONTapeValue nsJSONTapeValue::FindMember(nsStringView sName) const
+{
+  if (!IsObject())
+    return nsJSONTapeValue();
+
+  for (nsJSONTapeValue name = GetFirstChild(); name.IsValid();)
+  {
+    const nsJSONTapeValue value = name.GetNextSibling();
+
+    if (name.GetString() == sName)
+      return value;
+
+    name = value.GetNextSibling();
+  }
+
+  return nsJSONTapeValue();
+}
+
+nsJSONTapeValue nsJSONTapeValue::GetElement(nsUInt32 uiIndex) const
+{
+  if (!IsArray())
+    return nsJSONTapeValue();
+
+  nsJSONTapeValue element = GetFirstChild();
+  for (nsUInt32 i = 0; i < uiIndex && element.IsValid(); ++i)
+    element = element.GetNextSibling();
+
+  return element;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+nsJSONTape::nsJSONTape() = default;
+nsJSONTape::~nsJSONTape() = default;
+
+void nsJSONTape::Clear()
+{
+  m_Tape.Clear();
+  m_Structurals.Clear();
+  m_DecodedStrings.Clear();
+  m_StrippedDocument.Clear();
+  m_pDocument = nullptr;
+  m_uiDocumentSize = 0;
+}
+
+nsJSONTapeValue nsJSONTape::GetRoot() const
+{
+  if (m_Tape.IsEmpty())
+    return nsJSONTapeValue();
+
+  return nsJSONTapeValue(this, 0);
+}
+
+nsUInt32 nsJSONTape::GetSkipIndex(nsUInt32 uiIndex) const
+{
+  switch (GetTypeAt(uiIndex))
+  {
+    case nsJSONTapeType::Object:
+    case nsJSONTapeType::Array:
+      return static_cast<nsUInt32>(m_Tape[uiIndex] & 0xFFFFFFFFu);
+
+    case nsJSONTapeType::String:
+    case nsJSONTapeType::Number:
+      return uiIndex + 2;
+
+    default:
+      return uiIndex + 1;
+  }
+}
+
+nsResult nsJSONTape::Parse(nsArrayPtr<const char> document, nsLogInterface* pLog)
+{
+  Clear();
+  m_pLog = pLog;
+
+  if (document.GetCount() >= 0xFFFFFFFFu)
+  {
+    nsLog::Error(m_pLog, "JSON document is too large ({0} bytes).", document.GetCount());
+    return NS_FAILURE;
+  }
+
+  // skip the Utf8 BOM
+  const char* szStart = document.GetPtr();
+  if (document.GetCount() >= 3 && nsUnicodeUtils::SkipUtf8Bom(szStart))
+  {
+    document = document.GetSubArray(3);
+  }
+
+  m_pDocument = document.GetPtr();
+  m_uiDocumentSize = document.GetCount();
+
+  nsUInt32 uiFirstComment = nsInvalidIndex;
+  nsResult res = FindStructurals(m_pDocument, m_uiDocumentSize, uiFirstComment);
+
+  if (res.Succeeded() && uiFirstComment != nsInvalidIndex)
+  {
+    StripComments(document);
+    m_pDocument = m_StrippedDocument.GetData();
+
+    res = FindStructurals(m_pDocument, m_uiDocumentSize, uiFirstComment);
+
+    if (res.Succeeded() && uiFirstComment != nsInvalidIndex)
+    {
+      ReportError(uiFirstComment, "Unexpected character '/'.");
+      res = NS_FAILURE;
+    }
+  }
+
+  if (res.Succeeded())
+  {
+    res = BuildTape(m_pDocument, m_uiDocumentSize);
+  }
+
+  m_Structurals.Clear();
+
+  if (res.Failed())
+  {
+    m_Tape.Clear();
+  }
+
+  return res;
+}
+
+nsResult nsJSONTape::FindStructurals(const char* pData, nsUInt32 uiSize, nsUInt32& out_uiFirstComment)
+{
+  out_uiFirstComment = nsInvalidIndex;
+  m_Structurals.Clear();
+
+  nsUInt64 uiPrevEscaped = 0;
+  nsUInt64 uiPrevInString = 0;
+  nsUInt64 uiPrevScalar = 0;
+
+  char paddedBlock[64];
+
+  for (nsUInt32 uiBlockStart = 0; uiBlockStart < uiSize; uiBlockStart += 64)
+  {
+    const char* pBlock = pData + uiBlockStart;
+
+    if (uiSize - uiBlockStart < 64)
+    {
+      // the last block is padded with whitespace, so that it can be classified like all others
+      nsMemoryUtils::PatternFillArray(paddedBlock, ' ');
+      nsMemoryUtils::Copy(paddedBlock, pBlock, uiSize - uiBlockStart);
+      pBlock = paddedBlock;
+    }
+
+    nsJSONBlockMasks masks;
+    ClassifyBlock(pBlock, masks);
+
+    // find all characters that are escaped by a backslash, backslashes are rare enough to handle them one by one
+    nsUInt64 uiEscaped = uiPrevEscaped;
+    uiPrevEscaped = 0;
+
+    for (nsUInt64 uiBackslashes = masks.m_uiBackslash; uiBackslashes != 0;)
+    {
+      const nsUInt64 uiBit = uiBackslashes & (~uiBackslashes + 1);
+      uiBackslashes ^= uiBit;
+
+      if ((uiEscaped & uiBit) != 0)
+        continue;
+
+      if (uiBit == (nsUInt64(1) << 63))
+        uiPrevEscaped = 1;
+      else
+        uiEscaped |= uiBit << 1;
+    }
+
+    const nsUInt64 uiQuotes = masks.m_uiQuote & ~uiEscaped;
+
+    // the string mask includes the opening quote but not the closing quote
+    const nsUInt64 uiInString = PrefixXor(uiQuotes) ^ uiPrevInString;
+    uiPrevInString = static_cast<nsUInt64>(static_cast<nsInt64>(uiInString) >> 63);
+
+    if ((masks.m_uiSlash & ~uiInString) != 0)
+    {
+      out_uiFirstComment = uiBlockStart + nsMath::FirstBitLow(masks.m_uiSlash & ~uiInString);
+      return NS_SUCCESS;
+    }
+
+    // scalars are all characters outside of strings that are neither whitespace, nor operators, nor quotes
+    const nsUInt64 uiScalars = ~(masks.m_uiOperator | masks.m_uiWhitespace | uiQuotes) & ~uiInString;
+    const nsUInt64 uiScalarStarts = uiScalars & ~((uiScalars << 1) | uiPrevScalar);
+    uiPrevScalar = uiScalars >> 63;
+
+    nsUInt64 uiStructurals = (masks.m_uiOperator & ~uiInString) | (uiQuotes & uiInString) | uiScalarStarts;
+
+    while (uiStructurals != 0)
+    {
+      m_Structurals.PushBack(uiBlockStart + nsMath::FirstBitLow(uiStructurals));
+      uiStructurals &= uiStructurals - 1;
+    }
+  }
+
+  if (uiPrevInString != 0)
+  {
+    ReportError(uiSize, "Reached end of document before end of string was found.");
+    return NS_FAILURE;
+  }
+
+  return NS_SUCCESS;
+}
+
+void nsJSONTape::StripComments(nsArrayPtr<const char> document)
+{
+  m_StrippedDocument = document;
+
+  char* pData = m_StrippedDocument.GetData();
+  const nsUInt32 uiSize = m_StrippedDocument.GetCount();
+
+  for (nsUInt32 i = 0; i < uiSize; ++i)
+  {
+    if (pData[i] == '"')
+    {
+      // skip over strings, comments cannot start in there
+      for (++i; i < uiSize && pData[i] != '"'; ++i)
+      {
+        if (pData[i] == '\\')
+          ++i;
+      }
+    }
+    else if (pData[i] == '/' && i + 1 < uiSize && pData[i + 1] == '/')
+    {
+      for (; i < uiSize && pData[i] != '\n'; ++i)
+        pData[i] = ' ';
+    }
+    else if (pData[i] == '/' && i + 1 < uiSize && pData[i + 1] == '*')
+    {
+      pData[i] = ' ';
+      pData[i + 1] = ' ';
+
+      for (i += 2; i < uiSize; ++i)
+      {
+        if (pData[i] == '*' && i + 1 < uiSize && pData[i + 1] == '/')
+        {
+          pData[i] = ' ';
+          pData[i + 1] = ' ';
+          ++i;
+          break;
+        }
+
+        // keep line breaks, so that errors report the correct line
+        if (pData[i] != '\n')
+          pData[i] = ' ';
+      }
+    }
+  }
+}
+
+nsResult nsJSONTape::BuildTape(const char* pData, nsUInt32 uiSize)
+{
+  const nsUInt32 uiNumStructurals = m_Structurals.GetCount();
+
+  if (uiNumStructurals == 0)
+    return NS_SUCCESS;
+
+  const nsUInt32* pStructurals = m_Structurals.GetData();
+
+  if (pData[pStructurals[0]] != '{' && pData[pStructurals[0]] != '[')
+  {
+    nsStringBuilder s;
+    s.Format("Start of document: Expected a { or [ or an empty document. Got '{0}' instead.", nsArgC(pData[pStructurals[0]]));
+    ReportError(pStructurals[0], s);
+    return NS_FAILURE;
+  }
+
+  m_Tape.Reserve(uiNumStructurals);
+
+  struct Scope
+  {
+    NS_DECLARE_POD_TYPE();
+
+    nsUInt32 m_uiTapeIndex;
+    nsUInt32 m_uiCount;
+    bool m_bObject;
+  };
+
+  nsHybridArray<Scope, 32> scopes;
+  nsUInt32 uiNext = 0;
+
+  auto CloseScope = [&]()
+  {
+    const Scope scope = scopes.PeekBack();
+    scopes.PopBack();
+
+    const nsUInt32 uiEndIndex = m_Tape.GetCount();
+    m_Tape.PushBack((nsUInt64(s_uiEndMarker) << s_uiTypeShift) | scope.m_uiTapeIndex);
+    m_Tape[scope.m_uiTapeIndex] |= (nsUInt64(nsMath::Min(scope.m_uiCount, s_uiMaxCount)) << s_uiCountShift) | (uiEndIndex + 1);
+  };
+
+  auto Peek = [&]() -> char
+  { return uiNext < uiNumStructurals ? pData[pStructurals[uiNext]] : '\0'; };
+
+  // like nsJSONParser, superfluous commas are allowed in objects and a single trailing comma is allowed in arrays
+  enum class Step
+  {
+    Value,
+    Member,
+    Element,
+    AfterValue,
+  };
+
+  Step step = Step::Value;
+
+  while (true)
+  {
+    if (step == Step::Member)
+    {
+      while (Peek() == ',')
+        ++uiNext;
+    }
+
+    if (step != Step::AfterValue || !scopes.IsEmpty())
+    {
+      if (uiNext == uiNumStructurals)
+      {
+        ReportError(uiSize, "End of the document reached without closing all objects.");
+        return NS_FAILURE;
+      }
+    }
+
+    switch (step)
+    {
+      case Step::Value:
+      {
+        const nsUInt32 uiOffset = pStructurals[uiNext++];
+
+        switch (pData[uiOffset])
+        {
+          case '{':
+          case '[':
+          {
+            const bool bObject = pData[uiOffset] == '{';
+            scopes.PushBack({m_Tape.GetCount(), 0, bObject});
+            m_Tape.PushBack(nsUInt64(bObject ? nsJSONTapeType::Object : nsJSONTapeType::Array) << s_uiTypeShift);
+            step = bObject ? Step::Member : Step::Element;
+            break;
+          }
+
+          case '"':
+            NS_SUCCEED_OR_RETURN(WriteString(pData, uiSize, uiOffset));
+            step = Step::AfterValue;
+            break;
+
+          case '}':
+          case ']':
+          case ':':
+          case ',':
+          {
+            nsStringBuilder s;
+            s.Format("Expected a value, got '{0}' instead.", nsArgC(pData[uiOffset]));
+            ReportError(uiOffset, s);
+            return NS_FAILURE;
+          }
+
+          default:
+            NS_SUCCEED_OR_RETURN(WriteScalar(pData, uiSize, uiOffset));
+            step = Step::AfterValue;
+            break;
+        }
+        break;
+      }
+
+      case Step::Member:
+      {
+        const nsUInt32 uiOffset = pStructurals[uiNext++];
+
+        if (pData[uiOffset] == '}')
+        {
+          CloseScope();
+          step = Step::AfterValue;
+          break;
+        }
+
+        if (pData[uiOffset] != '"')
+        {
+          nsStringBuilder s;
+          s.Format("Expected a member name, got '{0}' instead.", nsArgC(pData[uiOffset]));
+          ReportError(uiOffset, s);
+          return NS_FAILURE;
+        }
+
+        NS_SUCCEED_OR_RETURN(WriteString(pData, uiSize, uiOffset));
+
+        if (Peek() != ':')
+        {
+          ReportError(uiNext < uiNumStructurals ? pStructurals[uiNext] : uiSize, "Expected a ':' after the member name.");
+          return NS_FAILURE;
+        }
+
+        ++uiNext;
+        ++scopes.PeekBack().m_uiCount;
+        step = Step::Value;
+        break;
+      }
+
+      case Step::Element:
+        if (Peek() == ']')
+        {
+          ++uiNext;
+          CloseScope();
+          step = Step::AfterValue;
+          break;
+        }
+
+        ++scopes.PeekBack().m_uiCount;
+        step = Step::Value;
+        break;
+
+      case Step::AfterValue:
+      {
+        if (scopes.IsEmpty())
+        {
+          if (uiNext != uiNumStructurals)
+          {
+            ReportError(pStructurals[uiNext], "Unexpected data after the end of the document.");
+            return NS_FAILURE;
+          }
+
+          return NS_SUCCESS;
+        }
+
+        const nsUInt32 uiOffset = pStructurals[uiNext++];
+        Scope& scope = scopes.PeekBack();
+
+        if (pData[uiOffset] == ',')
+        {
+          step = scope.m_bObject ? Step::Member : Step::Element;
+        }
+        else if (pData[uiOffset] == (scope.m_bObject ? '}' : ']'))
+        {
+          CloseScope();
+        }
+        else
+        {
+          nsStringBuilder s;
+          s.Format("Expected ',' or '{0}', got '{1}' instead.", nsArgC(scope.m_bObject ? '}' : ']'), nsArgC(pData[uiOffset]));
+          ReportError(uiOffset, s);
+          return NS_FAILURE;
+        }
+        break;
+      }
+    }
+  }
+}
+
+nsResult nsJSONTape::WriteString(const char* pData, nsUInt32 uiSize, nsUInt32 uiStart)
+{
+  const nsUInt32 uiFirst = uiStart + 1;
+  nsUInt32 i = FindQuoteOrBackslash(pData, uiSize, uiFirst);
+
+  // stage one already made sure that every string is terminated
+  NS_ASSERT_DEBUG(i < uiSize, "Unterminated string in JSON document.");
+
+  if (pData[i] == '"')
+  {
+    // no escape sequences, reference the string in the document
+    m_Tape.PushBack((nsUInt64(nsJSONTapeType::String) << s_uiTypeShift) | uiFirst);
+    m_Tape.PushBack(i - uiFirst);
+    return NS_SUCCESS;
+  }
+
+  const nsUInt32 uiDecodedStart = m_DecodedStrings.GetCount();
+  m_DecodedStrings.PushBackRange(nsArrayPtr<const char>(pData + uiFirst, i - uiFirst));
+
+  while (pData[i] != '"')
+  {
+    if (pData[i] != '\\')
+    {
+      const nsUInt32 uiEnd = FindQuoteOrBackslash(pData, uiSize, i);
+      m_DecodedStrings.PushBackRange(nsArrayPtr<const char>(pData + i, uiEnd - i));
+      i = uiEnd;
+      continue;
+    }
+
+    const char cEscape = pData[i + 1];
+    i += 2;
+
+    switch (cEscape)
+    {
+      case '"':
+      case '\\':
+      case '/':
+        m_DecodedStrings.PushBack(cEscape);
+        break;
+      case 'b':
+        m_DecodedStrings.PushBack('\b');
+        break;
+      case 'f':
+        m_DecodedStrings.PushBack('\f');
+        break;
+      case 'n':
+        m_DecodedStrings.PushBack('\n');
+        break;
+      case 'r':
+        m_DecodedStrings.PushBack('\r');
+        break;
+      case 't':
+        m_DecodedStrings.PushBack('\t');
+        break;
+      case 'u':
+      {
+        nsUInt32 uiCodePoint = 0;
+        if (i + 4 > uiSize || !ReadHex4(pData + i, uiCodePoint))
+        {
+          ReportError(i, "Unicode literal is malformed, must be 4 HEX characters.");
+          return NS_FAILURE;
+        }
+        i += 4;
+
+        if (uiCodePoint >= 0xD800 && uiCodePoint <= 0xDBFF)
+        {
+          nsUInt32 uiLowSurrogate = 0;
+          if (i + 6 > uiSize || pData[i] != '\\' || pData[i + 1] != 'u' || !ReadHex4(pData + i + 2, uiLowSurrogate) || uiLowSurrogate < 0xDC00 || uiLowSurrogate > 0xDFFF)
+          {
+            ReportError(i, "Unicode surrogate must be followed by another unicode escape sequence");
+            return NS_FAILURE;
+          }
+          i += 6;
+
+          uiCodePoint = 0x10000 + ((uiCodePoint - 0xD800) << 10) + (uiLowSurrogate - 0xDC00);
+        }
+
+        nsUnicodeUtils::UtfInserter<char, nsDynamicArray<char>> inserter(&m_DecodedStrings);
+        nsUnicodeUtils::EncodeUtf32ToUtf8(uiCodePoint, inserter);
+        break;
+      }
+      default:
+      {
+        nsStringBuilder s;
+        s.Format("Unknown escape-sequence '\\{0}'", nsArgC(cEscape));
+        ReportError(i - 1, s);
+        return NS_FAILURE;
+      }
+    }
+  }
+
+  m_Tape.PushBack((nsUInt64(nsJSONTapeType::String) << s_uiTypeShift) | s_uiDecodedStringFlag | uiDecodedStart);
+  m_Tape.PushBack(m_DecodedStrings.GetCount() - uiDecodedStart);
+  return NS_SUCCESS;
+}
+
+nsResult nsJSONTape::WriteScalar(const char* pData, nsUInt32 uiSize, nsUInt32 uiStart)
+{
+  nsUInt32 uiEnd = uiStart;
+  while (uiEnd < uiSize && !IsScalarTerminator(pData[uiEnd]))
+    ++uiEnd;
+
+  const nsStringView sScalar(pData + uiStart, pData + uiEnd);
+
+  if (sScalar == "true" || sScalar == "false")
+  {
+    m_Tape.PushBack((nsUInt64(nsJSONTapeType::Bool) << s_uiTypeShift) | (sScalar == "true" ? 1 : 0));
+    return NS_SUCCESS;
+  }
+
+  if (sScalar == "null")
+  {
+    m_Tape.PushBack(nsUInt64(nsJSONTapeType::Null) << s_uiTypeShift);
+    return NS_SUCCESS;
+  }
+
+  const char c = pData[uiStart];
+  if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+  {
+    double fValue = 0;
+    const char* szLastParsePos = nullptr;
+
+    if (nsConversionUtils::StringToFloat(sScalar, fValue, &szLastParsePos).Succeeded() && szLastParsePos == sScalar.GetEndPointer())
+    {
+      nsUInt64 uiBits = 0;
+      nsMemoryUtils::Copy(reinterpret_cast<nsUInt8*>(&uiBits), reinterpret_cast<const nsUInt8*>(&fValue), sizeof(double));
+
+      m_Tape.PushBack(nsUInt64(nsJSONTapeType::Number) << s_uiTypeShift);
+      m_Tape.PushBack(uiBits);
+      return NS_SUCCESS;
+    }
+
+    nsStringBuilder s;
+    s.Format("Reading number failed: Could not convert '{0}' to a floating point value.", sScalar);
+    ReportError(uiStart, s);
+    return NS_FAILURE;
+  }
+
+  nsStringBuilder s;
+  s.Format("Unexpected value '{0}'.", sScalar);
+  ReportError(uiStart, s);
+  return NS_FAILURE;
+}
+
+void nsJSONTape::ReportError(nsUInt32 uiOffset, nsStringView sMessage)
+{
+  nsUInt32 uiLine = 1;
+  nsUInt32 uiColumn = 0;
+
+  for (nsUInt32 i = 0; i < uiOffset && i < m_uiDocumentSize; ++i)
+  {
+    if (m_pDocument[i] == '\n')
+    {
+      ++uiLine;
+      uiColumn = 0;
+    }
+    else
+      ++uiColumn;
+  }
+
+  nsLog::Error(m_pLog, "Line {0} ({1}): {2}", uiLine, uiColumn, sMessage);
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_JSONTape);
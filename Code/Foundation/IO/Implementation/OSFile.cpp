@@ -6,6 +6,7 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 nsString64 nsOSFile::s_sApplicationPath;
 nsString64 nsOSFile::s_sUserDataPath;
@@ -372,6 +373,19 @@ nsResult nsOSFile::MoveFileOrDirectory(nsStringView sDirectoryFrom, nsStringView
   return InternalMoveFileOrDirectory(sFrom, sTo);
 }
 
+nsResult nsOSFile::ReplaceFile(nsStringView sFileFrom, nsStringView sFileTo)
+{
+  nsStringBuilder sFrom(sFileFrom);
+  sFrom.MakeCleanPath();
+  sFrom.MakePathSeparatorsNative();
+
+  nsStringBuilder sTo(sFileTo);
+  sTo.MakeCleanPath();
+  sTo.MakePathSeparatorsNative();
+
+  return InternalReplaceFile(sFrom, sTo);
+}
+
 nsResult nsOSFile::CopyFile(nsStringView sSource, nsStringView sDestination)
 {
   const nsTime t0 = nsTime::Now();
@@ -387,6 +401,19 @@ nsResult nsOSFile::CopyFile(nsStringView sSource, nsStringView sDestination)
   if (DstFile.Open(sDestination, nsFileOpenMode::Write) == NS_FAILURE)
     goto done;
 
+  {
+    nsUInt64 uiBytesCopied = 0;
+    if (InternalCopyFileData(SrcFile.m_FileData, DstFile.m_FileData, uiBytesCopied).Succeeded())
+    {
+      Res = NS_SUCCESS;
+      goto done;
+    }
+
+    // the fast path may have bailed out after copying some of the data, just continue from there
+    SrcFile.InternalSetFilePosition(uiBytesCopied, nsFileSeekMode::FromStart);
+    DstFile.InternalSetFilePosition(uiBytesCopied, nsFileSeekMode::FromStart);
+  }
+
   {
     const nsUInt32 uiTempSize = 1024 * 1024 * 8; // 8 MB
 
@@ -540,6 +567,58 @@ void nsOSFile::GatherAllItemsInFolder(nsDynamicArray<nsFileStats>& out_itemList,
   }
 }
 
+void nsOSFile::GatherAllItemsInFolderParallel(nsDynamicArray<nsFileStats>& out_itemList, nsStringView sFolder, nsBitflags<nsFileSystemIteratorFlags> flags /*= nsFileSystemIteratorFlags::Default*/)
+{
+  if (!flags.IsSet(nsFileSystemIteratorFlags::Recursive))
+  {
+    GatherAllItemsInFolder(out_itemList, sFolder, flags);
+    return;
+  }
+
+  out_itemList.Clear();
+
+  // the top-level folders are needed in any case, to know where to recurse into
+  nsDynamicArray<nsFileStats> topLevelItems;
+  GatherAllItemsInFolder(topLevelItems, sFolder, nsFileSystemIteratorFlags::ReportFiles | nsFileSystemIteratorFlags::ReportFolders);
+
+  nsDynamicArray<nsDynamicArray<nsFileStats>> subFolderItems;
+  subFolderItems.SetCount(topLevelItems.GetCount());
+
+  nsParallelForParams params;
+  params.m_uiMaxTasksPerThread = 4; // sub-folders can differ vastly in size
+
+  nsTaskSystem::ParallelForSingleIndex(
+    topLevelItems.GetArrayPtr(), [&](nsUInt32 uiIndex, const nsFileStats& item) {
+      if (!item.m_bIsDirectory)
+        return;
+
+      nsStringBuilder sSubFolder;
+      item.GetFullPath(sSubFolder);
+      GatherAllItemsInFolder(subFolderItems[uiIndex], sSubFolder, flags);
+    },
+    "GatherAllItemsInFolder", params);
+
+  nsUInt32 uiTotalItems = topLevelItems.GetCount();
+  for (const auto& items : subFolderItems)
+  {
+    uiTotalItems += items.GetCount();
+  }
+
+  out_itemList.Reserve(uiTotalItems);
+
+  for (nsUInt32 i = 0; i < topLevelItems.GetCount(); ++i)
+  {
+    const bool bReport = topLevelItems[i].m_bIsDirectory ? flags.IsSet(nsFileSystemIteratorFlags::ReportFolders) : flags.IsSet(nsFileSystemIteratorFlags::ReportFiles);
+
+    if (bReport)
+    {
+      out_itemList.PushBack(std::move(topLevelItems[i]));
+    }
+
+    out_itemList.PushBackRange(subFolderItems[i]);
+  }
+}
+
 nsResult nsOSFile::CopyFolder(nsStringView sSourceFolder, nsStringView sDestinationFolder, nsDynamicArray<nsString>* out_pFilesCopied /*= nullptr*/)
 {
   nsDynamicArray<nsFileStats> items;
@@ -1110,14 +1110,16 @@ void nsOpenDdlParser::ContinueFloat()
     // Decimal literal
     ReadDecimalFloat();
 
-    if (nsConversionUtils::StringToFloat((const char*)&m_TempString[0], dValue) == NS_FAILURE)
+    // floats are rounded directly from the text, casting the double would round twice
+    const nsResult res = curState == ReadingFloat ? nsConversionUtils::StringToFloat((const char*)&m_TempString[0], fValue)
+                                                  : nsConversionUtils::StringToFloat((const char*)&m_TempString[0], dValue);
+
+    if (res == NS_FAILURE)
     {
       nsStringBuilder s;
       s.Format("Reading number failed: Could not convert '{0}' to a floating point value.", (const char*)&m_TempString[0]);
       ParsingError(s.GetData(), true);
     }
-
-    fValue = (float)dValue;
   }
   else
   {
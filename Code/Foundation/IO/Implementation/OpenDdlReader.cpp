@@ -28,6 +28,155 @@ nsResult nsOpenDdlReader::ParseDocument(nsStreamReader& inout_stream, nsUInt32 u
 
   m_TempCache.Reserve(s_uiChunkSize);
 
+  CreateRootElement();
+
+  return ParseAll();
+}
+
+bool nsOpenDdlReader::IsBinaryDocument(nsArrayPtr<const nsUInt8> data)
+{
+  return data.GetCount() >= nsOpenDdlBinaryElement::s_uiDocumentHeaderSize &&
+         nsMemoryUtils::RawByteCompare(data.GetPtr(), nsOpenDdlBinaryElement::s_Magic, sizeof(nsOpenDdlBinaryElement::s_Magic)) == 0;
+}
+
+nsResult nsOpenDdlReader::ParseBinaryDocument(nsArrayPtr<const nsUInt8> data, nsLogInterface* pLog)
+{
+  NS_ASSERT_DEBUG(m_ObjectStack.IsEmpty(), "A reader can only be used once.");
+
+  if (!IsBinaryDocument(data))
+  {
+    nsLog::Error(pLog, "Data is not a binary OpenDDL document.");
+    return NS_FAILURE;
+  }
+
+  nsUInt32 uiVersion = 0;
+  nsMemoryUtils::Copy(reinterpret_cast<nsUInt8*>(&uiVersion), data.GetPtr() + sizeof(nsOpenDdlBinaryElement::s_Magic), sizeof(uiVersion));
+  if (uiVersion != nsOpenDdlBinaryElement::s_uiVersion)
+  {
+    nsLog::Error(pLog, "Binary OpenDDL version {0} is not supported.", uiVersion);
+    return NS_FAILURE;
+  }
+
+  if (!nsMemoryUtils::IsAligned(data.GetPtr(), 8))
+  {
+    nsLog::Error(pLog, "Binary OpenDDL data must be 8 byte aligned.");
+    return NS_FAILURE;
+  }
+
+  CreateRootElement();
+
+  auto Fail = [&](nsUInt32 uiOffset) {
+    nsLog::Error(pLog, "Binary OpenDDL document is corrupted at offset {0}.", uiOffset);
+    OnParsingError("Corrupted binary document", true, 0, 0);
+    return NS_FAILURE;
+  };
+
+  // End offsets of the open custom elements, the root element spans the entire document.
+  nsHybridArray<nsUInt32, 16> elementEnds;
+  elementEnds.PushBack(data.GetCount());
+
+  nsUInt32 uiOffset = nsOpenDdlBinaryElement::s_uiDocumentHeaderSize;
+  while (true)
+  {
+    // close all elements that end here
+    while (uiOffset == elementEnds.PeekBack())
+    {
+      // the root element stays on the stack, GetRootElement() returns it from there
+      if (elementEnds.GetCount() == 1)
+        return NS_SUCCESS;
+
+      m_ObjectStack.PopBack();
+      elementEnds.PopBack();
+    }
+
+    const nsUInt32 uiElementEnd = elementEnds.PeekBack();
+    if (uiOffset + sizeof(nsOpenDdlBinaryElement) > uiElementEnd)
+      return Fail(uiOffset);
+
+    const auto* pHeader = reinterpret_cast<const nsOpenDdlBinaryElement*>(data.GetPtr() + uiOffset);
+    const nsUInt32 uiStringsOffset = uiOffset + sizeof(nsOpenDdlBinaryElement);
+    if (pHeader->m_uiTypeLength > uiElementEnd - uiStringsOffset)
+      return Fail(uiOffset);
+
+    const nsUInt32 uiDataOffset = nsMemoryUtils::AlignSize(uiStringsOffset + pHeader->m_uiTypeLength + pHeader->m_uiNameLength, 8u);
+
+    if (pHeader->m_uiPrimitiveType > (nsUInt8)nsOpenDdlPrimitiveType::Custom || pHeader->m_uiSize < uiDataOffset - uiOffset ||
+        pHeader->m_uiSize > uiElementEnd - uiOffset || (pHeader->m_uiSize % 8) != 0 || pHeader->m_uiCount >= NS_BIT(31))
+      return Fail(uiOffset);
+
+    const nsOpenDdlPrimitiveType type = static_cast<nsOpenDdlPrimitiveType>(pHeader->m_uiPrimitiveType);
+    const char* szStrings = reinterpret_cast<const char*>(data.GetPtr() + uiStringsOffset);
+    const nsStringView sType(szStrings, pHeader->m_uiTypeLength);
+    const nsStringView sName(szStrings + pHeader->m_uiTypeLength, pHeader->m_uiNameLength);
+    const bool bGlobalName = pHeader->m_uiGlobalName != 0;
+
+    // names point into the document, only global names are copied into the lookup table
+    nsOpenDdlReaderElement* pElement = CreateElement(type, sType, {}, bGlobalName);
+    pElement->m_sName = sName;
+    if (bGlobalName && !sName.IsEmpty())
+    {
+      m_GlobalNames[sName] = pElement;
+    }
+
+    const nsUInt32 uiNextOffset = uiOffset + pHeader->m_uiSize;
+
+    if (type == nsOpenDdlPrimitiveType::Custom)
+    {
+      // the children follow directly, the child count is recomputed by CreateElement
+      elementEnds.PushBack(uiNextOffset);
+      uiOffset = uiDataOffset;
+      continue;
+    }
+
+    const nsUInt32 uiDataSize = uiNextOffset - uiDataOffset;
+    const nsUInt8* pData = data.GetPtr() + uiDataOffset;
+
+    if (type == nsOpenDdlPrimitiveType::String)
+    {
+      // every string needs at least its length, so a larger count can only come from a corrupted document
+      const nsUInt64 uiViewsSize = static_cast<nsUInt64>(pHeader->m_uiCount) * sizeof(nsStringView);
+      if (static_cast<nsUInt64>(pHeader->m_uiCount) * sizeof(nsUInt32) > uiDataSize || uiViewsSize > 0xFFFFFFFFu)
+        return Fail(uiDataOffset);
+
+      nsStringView* pStrings = reinterpret_cast<nsStringView*>(AllocateBytes(static_cast<nsUInt32>(uiViewsSize)));
+      nsUInt32 uiStringOffset = 0;
+
+      for (nsUInt32 i = 0; i < pHeader->m_uiCount; ++i)
+      {
+        if (static_cast<nsUInt64>(uiStringOffset) + sizeof(nsUInt32) > uiDataSize)
+          return Fail(uiDataOffset + uiStringOffset);
+
+        const nsUInt32 uiLength = *reinterpret_cast<const nsUInt32*>(pData + uiStringOffset);
+        uiStringOffset += sizeof(nsUInt32);
+
+        if (uiLength > uiDataSize - uiStringOffset)
+          return Fail(uiDataOffset + uiStringOffset);
+
+        pStrings[i] = nsStringView(reinterpret_cast<const char*>(pData + uiStringOffset), uiLength);
+        uiStringOffset = nsMemoryUtils::AlignSize(uiStringOffset + uiLength, 4u);
+      }
+
+      pElement->m_pFirstChild = pStrings;
+    }
+    else
+    {
+      static constexpr nsUInt8 s_PrimitiveSizes[] = {sizeof(bool), 1, 2, 4, 8, 1, 2, 4, 8, sizeof(float), sizeof(double)};
+
+      if (static_cast<nsUInt64>(pHeader->m_uiCount) * s_PrimitiveSizes[pHeader->m_uiPrimitiveType] > uiDataSize)
+        return Fail(uiDataOffset);
+
+      pElement->m_pFirstChild = pData;
+    }
+
+    pElement->m_uiNumChildElements += pHeader->m_uiCount;
+    m_ObjectStack.PopBack();
+
+    uiOffset = uiNextOffset;
+  }
+}
+
+void nsOpenDdlReader::CreateRootElement()
+{
   nsOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
   pElement->m_pFirstChild = nullptr;
   pElement->m_pLastChild = nullptr;
@@ -38,8 +187,6 @@ nsResult nsOpenDdlReader::ParseDocument(nsStreamReader& inout_stream, nsUInt32 u
   pElement->m_uiNumChildElements = 0;
 
   m_ObjectStack.PushBack(pElement);
-
-  return ParseAll();
 }
 
 const nsOpenDdlReaderElement* nsOpenDdlReader::GetRootElement() const
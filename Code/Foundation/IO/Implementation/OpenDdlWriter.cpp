@@ -218,6 +218,12 @@ nsOpenDdlWriter::nsOpenDdlWriter()
 
 void nsOpenDdlWriter::BeginObject(nsStringView sType, nsStringView sName /*= {}*/, bool bGlobalName /*= false*/, bool bSingleLine /*= false*/)
 {
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryBeginElement(nsOpenDdlPrimitiveType::Custom, sType, sName, bGlobalName);
+    return;
+  }
+
   {
     const auto state = m_StateStack.PeekBack().m_State;
     NS_IGNORE_UNUSED(state);
@@ -334,6 +340,12 @@ void nsOpenDdlWriter::OutputObjectName(nsStringView sName, bool bGlobalName)
 
 void nsOpenDdlWriter::EndObject()
 {
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryEndElement();
+    return;
+  }
+
   const auto state = m_StateStack.PeekBack().m_State;
   NS_ASSERT_DEBUG(state == State::ObjectSingleLine || state == State::ObjectMultiLine || state == State::ObjectStart, "No object is open");
 
@@ -374,6 +386,12 @@ void nsOpenDdlWriter::EndObject()
 
 void nsOpenDdlWriter::BeginPrimitiveList(nsOpenDdlPrimitiveType type, nsStringView sName /*= {}*/, bool bGlobalName /*= false*/)
 {
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryBeginElement(type, {}, sName, bGlobalName);
+    return;
+  }
+
   OutputObjectBeginning();
 
   const auto state = m_StateStack.PeekBack().m_State;
@@ -405,6 +423,12 @@ void nsOpenDdlWriter::BeginPrimitiveList(nsOpenDdlPrimitiveType type, nsStringVi
 
 void nsOpenDdlWriter::EndPrimitiveList()
 {
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryEndElement();
+    return;
+  }
+
   const auto state = m_StateStack.PeekBack().m_State;
   NS_IGNORE_UNUSED(state);
   NS_ASSERT_DEBUG(state >= State::PrimitivesBool && state <= State::PrimitivesString, "No primitive list is open");
@@ -457,6 +481,12 @@ void nsOpenDdlWriter::WriteBool(const bool* pValues, nsUInt32 uiCount /*= 1*/)
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Bool, pValues, sizeof(bool), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesBool);
 
   if (m_bCompactMode || m_TypeStringMode == TypeStringMode::Shortest)
@@ -498,6 +528,12 @@ void nsOpenDdlWriter::WriteInt8(const nsInt8* pValues, nsUInt32 uiCount /*= 1*/)
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Int8, pValues, sizeof(nsInt8), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesInt8);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -515,6 +551,12 @@ void nsOpenDdlWriter::WriteInt16(const nsInt16* pValues, nsUInt32 uiCount /*= 1*
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Int16, pValues, sizeof(nsInt16), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesInt16);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -532,6 +574,12 @@ void nsOpenDdlWriter::WriteInt32(const nsInt32* pValues, nsUInt32 uiCount /*= 1*
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Int32, pValues, sizeof(nsInt32), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesInt32);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -549,6 +597,12 @@ void nsOpenDdlWriter::WriteInt64(const nsInt64* pValues, nsUInt32 uiCount /*= 1*
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Int64, pValues, sizeof(nsInt64), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesInt64);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -567,6 +621,12 @@ void nsOpenDdlWriter::WriteUInt8(const nsUInt8* pValues, nsUInt32 uiCount /*= 1*
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::UInt8, pValues, sizeof(nsUInt8), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesUInt8);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -584,6 +644,12 @@ void nsOpenDdlWriter::WriteUInt16(const nsUInt16* pValues, nsUInt32 uiCount /*=
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::UInt16, pValues, sizeof(nsUInt16), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesUInt16);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -601,6 +667,12 @@ void nsOpenDdlWriter::WriteUInt32(const nsUInt32* pValues, nsUInt32 uiCount /*=
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::UInt32, pValues, sizeof(nsUInt32), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesUInt32);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -618,6 +690,12 @@ void nsOpenDdlWriter::WriteUInt64(const nsUInt64* pValues, nsUInt32 uiCount /*=
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::UInt64, pValues, sizeof(nsUInt64), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesUInt64);
 
   m_sTemp.Format("{0}", pValues[0]);
@@ -635,17 +713,28 @@ void nsOpenDdlWriter::WriteFloat(const float* pValues, nsUInt32 uiCount /*= 1*/)
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Float, pValues, sizeof(float), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesFloat);
 
   if (m_FloatPrecisionMode == FloatPrecisionMode::Readable)
   {
-    m_sTemp.Format("{0}", pValues[0]);
-    OutputString(m_sTemp.GetData());
+    // the shortest text that reads back to exactly the same value
+    char szTemp[64];
 
-    for (nsUInt32 i = 1; i < uiCount; ++i)
+    for (nsUInt32 i = 0; i < uiCount; ++i)
     {
-      m_sTemp.Format(",{0}", pValues[i]);
-      OutputString(m_sTemp.GetData());
+      nsUInt32 uiLength = 0;
+
+      if (i > 0)
+        szTemp[uiLength++] = ',';
+
+      nsStringUtils::OutputShortestFloat(szTemp, NS_ARRAY_SIZE(szTemp), uiLength, pValues[i]);
+      OutputString(nsStringView(szTemp, uiLength));
     }
   }
   else
@@ -682,17 +771,28 @@ void nsOpenDdlWriter::WriteDouble(const double* pValues, nsUInt32 uiCount /*= 1*
   NS_ASSERT_DEBUG(pValues != nullptr, "Invalid value array");
   NS_ASSERT_DEBUG(uiCount > 0, "This is pointless");
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWritePrimitives(nsOpenDdlPrimitiveType::Double, pValues, sizeof(double), uiCount);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesDouble);
 
   if (m_FloatPrecisionMode == FloatPrecisionMode::Readable)
   {
-    m_sTemp.Format("{0}", pValues[0]);
-    OutputString(m_sTemp.GetData());
+    // the shortest text that reads back to exactly the same value
+    char szTemp[64];
 
-    for (nsUInt32 i = 1; i < uiCount; ++i)
+    for (nsUInt32 i = 0; i < uiCount; ++i)
     {
-      m_sTemp.Format(",{0}", pValues[i]);
-      OutputString(m_sTemp.GetData());
+      nsUInt32 uiLength = 0;
+
+      if (i > 0)
+        szTemp[uiLength++] = ',';
+
+      nsStringUtils::OutputShortestFloat(szTemp, NS_ARRAY_SIZE(szTemp), uiLength, pValues[i]);
+      OutputString(nsStringView(szTemp, uiLength));
     }
   }
   else
@@ -726,6 +826,12 @@ void nsOpenDdlWriter::WriteDouble(const double* pValues, nsUInt32 uiCount /*= 1*
 
 void nsOpenDdlWriter::WriteString(const nsStringView& sString)
 {
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    BinaryWriteString(sString);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesString);
 
   OutputEscapedString(sString);
@@ -735,6 +841,21 @@ void nsOpenDdlWriter::WriteBinaryAsString(const void* pData, nsUInt32 uiBytes)
 {
   /// \test nsOpenDdlWriter::WriteBinaryAsString
 
+  if (m_OutputFormat == OutputFormat::Binary)
+  {
+    // keep the HEX representation, so that readers see the same string in both formats
+    nsStringBuilder sHex;
+    char tmp[4];
+    for (nsUInt32 i = 0; i < uiBytes; ++i)
+    {
+      nsStringUtils::snprintf(tmp, 4, "%02X", (nsUInt32) static_cast<const nsUInt8*>(pData)[i]);
+      sHex.Append(tmp);
+    }
+
+    BinaryWriteString(sHex);
+    return;
+  }
+
   WritePrimitiveType(State::PrimitivesString);
 
   OutputString("\"", 1);
@@ -743,5 +864,96 @@ void nsOpenDdlWriter::WriteBinaryAsString(const void* pData, nsUInt32 uiBytes)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+
+void nsOpenDdlWriter::BinaryAppend(const void* pData, nsUInt32 uiBytes)
+{
+  if (uiBytes == 0)
+    return;
+
+  const nsUInt32 uiOffset = m_BinaryData.GetCount();
+  m_BinaryData.SetCountUninitialized(uiOffset + uiBytes);
+  nsMemoryUtils::Copy(m_BinaryData.GetData() + uiOffset, static_cast<const nsUInt8*>(pData), uiBytes);
+}
+
+void nsOpenDdlWriter::BinaryPad(nsUInt32 uiAlignment)
+{
+  // m_BinaryData always starts at an 8 byte aligned position in the output
+  m_BinaryData.SetCount(nsMemoryUtils::AlignSize(m_BinaryData.GetCount(), uiAlignment));
+}
+
+void nsOpenDdlWriter::BinaryBeginElement(nsOpenDdlPrimitiveType type, nsStringView sType, nsStringView sName, bool bGlobalName)
+{
+  NS_ASSERT_DEBUG(m_BinaryElementOffsets.IsEmpty() || m_BinaryData[m_BinaryElementOffsets.PeekBack()] == (nsUInt8)nsOpenDdlPrimitiveType::Custom,
+    "Elements can only be added to objects, not to primitive lists");
+  NS_ASSERT_DEV(sName.GetElementCount() <= 0xFFFF, "Binary DDL only supports names of up to 65535 bytes");
+
+  if (!m_bBinaryHeaderWritten)
+  {
+    m_bBinaryHeaderWritten = true;
+    m_pOutput->WriteBytes(nsOpenDdlBinaryElement::s_Magic, sizeof(nsOpenDdlBinaryElement::s_Magic)).AssertSuccess();
+    *m_pOutput << nsOpenDdlBinaryElement::s_uiVersion;
+  }
+
+  if (!m_BinaryElementOffsets.IsEmpty())
+  {
+    reinterpret_cast<nsOpenDdlBinaryElement*>(m_BinaryData.GetData() + m_BinaryElementOffsets.PeekBack())->m_uiCount++;
+  }
+
+  nsOpenDdlBinaryElement element;
+  element.m_uiPrimitiveType = static_cast<nsUInt8>(type);
+  element.m_uiGlobalName = bGlobalName ? 1 : 0;
+  element.m_uiNameLength = static_cast<nsUInt16>(sName.GetElementCount());
+  element.m_uiTypeLength = sType.GetElementCount();
+
+  m_BinaryElementOffsets.PushBack(m_BinaryData.GetCount());
+  BinaryAppend(&element, sizeof(element));
+  BinaryAppend(sType.GetStartPointer(), sType.GetElementCount());
+  BinaryAppend(sName.GetStartPointer(), sName.GetElementCount());
+  BinaryPad(8);
+}
+
+void nsOpenDdlWriter::BinaryEndElement()
+{
+  NS_ASSERT_DEBUG(!m_BinaryElementOffsets.IsEmpty(), "No object or primitive list is open");
+
+  BinaryPad(8);
+
+  const nsUInt32 uiOffset = m_BinaryElementOffsets.PeekBack();
+  m_BinaryElementOffsets.PopBack();
+  reinterpret_cast<nsOpenDdlBinaryElement*>(m_BinaryData.GetData() + uiOffset)->m_uiSize = m_BinaryData.GetCount() - uiOffset;
+
+  if (m_BinaryElementOffsets.IsEmpty())
+  {
+    m_pOutput->WriteBytes(m_BinaryData.GetData(), m_BinaryData.GetCount()).AssertSuccess();
+    m_BinaryData.Clear();
+  }
+}
+
+void nsOpenDdlWriter::BinaryWritePrimitives(nsOpenDdlPrimitiveType type, const void* pValues, nsUInt32 uiElementSize, nsUInt32 uiCount)
+{
+  NS_ASSERT_DEBUG(!m_BinaryElementOffsets.IsEmpty(), "No primitive list is open");
+
+  auto* pElement = reinterpret_cast<nsOpenDdlBinaryElement*>(m_BinaryData.GetData() + m_BinaryElementOffsets.PeekBack());
+  NS_ASSERT_DEBUG(pElement->m_uiPrimitiveType == (nsUInt8)type, "Cannot write this primitive type without having the correct primitive list open");
+  NS_IGNORE_UNUSED(type);
+  pElement->m_uiCount += uiCount;
+
+  BinaryAppend(pValues, uiElementSize * uiCount);
+}
+
+void nsOpenDdlWriter::BinaryWriteString(nsStringView sString)
+{
+  NS_ASSERT_DEBUG(!m_BinaryElementOffsets.IsEmpty(), "No primitive list is open");
+
+  auto* pElement = reinterpret_cast<nsOpenDdlBinaryElement*>(m_BinaryData.GetData() + m_BinaryElementOffsets.PeekBack());
+  NS_ASSERT_DEBUG(pElement->m_uiPrimitiveType == (nsUInt8)nsOpenDdlPrimitiveType::String, "Cannot write a string without having a string list open");
+  pElement->m_uiCount++;
+
+  const nsUInt32 uiLength = sString.GetElementCount();
+  BinaryAppend(&uiLength, sizeof(uiLength));
+  BinaryAppend(sString.GetStartPointer(), uiLength);
+  BinaryPad(4);
+}
 
 NS_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_OpenDdlWriter);
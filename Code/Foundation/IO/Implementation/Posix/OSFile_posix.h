@@ -28,6 +28,12 @@ NS_FOUNDATION_INTERNAL_HEADER
 #  define NS_USE_OLD_POSIX_FUNCTIONS NS_OFF
 #endif
 
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+#  include <linux/fs.h>
+#  include <sys/ioctl.h>
+#  include <sys/sendfile.h>
+#endif
+
 #if NS_ENABLED(NS_PLATFORM_OSX)
 #  include <CoreFoundation/CoreFoundation.h>
 #endif
@@ -348,6 +354,86 @@ nsResult nsOSFile::InternalMoveFileOrDirectory(nsStringView sDirectoryFrom, nsSt
   return NS_SUCCESS;
 }
 
+nsResult nsOSFile::InternalReplaceFile(nsStringView sFrom, nsStringView sTo)
+{
+  // rename() atomically replaces an existing file
+  if (rename(nsString(sFrom), nsString(sTo)) != 0)
+  {
+    return NS_FAILURE;
+  }
+  return NS_SUCCESS;
+}
+
+nsResult nsOSFile::InternalCopyFileData(const nsOSFileData& source, const nsOSFileData& destination, nsUInt64& out_uiBytesCopied)
+{
+  out_uiBytesCopied = 0;
+
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+  const int srcFd = fileno(source.m_pFileHandle);
+  const int dstFd = fileno(destination.m_pFileHandle);
+
+  if (srcFd == -1 || dstFd == -1)
+    return NS_FAILURE;
+
+  // nothing may be buffered on the stdio level, otherwise the fd-level copy would reorder the data
+  fflush(destination.m_pFileHandle);
+
+#  ifdef FICLONE
+  // on copy-on-write file systems (btrfs, xfs, ...) the destination can share the extents of the source
+  if (ioctl(dstFd, FICLONE, srcFd) == 0)
+  {
+    struct stat srcStat;
+    if (fstat(srcFd, &srcStat) != 0)
+      return NS_FAILURE;
+
+    out_uiBytesCopied = static_cast<nsUInt64>(srcStat.st_size);
+    lseek(srcFd, static_cast<off_t>(out_uiBytesCopied), SEEK_SET);
+    lseek(dstFd, static_cast<off_t>(out_uiBytesCopied), SEEK_SET);
+    return NS_SUCCESS;
+  }
+#  endif
+
+  const size_t uiChunkSize = 1024 * 1024 * 1024; // 1 GB
+
+  // copy_file_range keeps the data in the kernel and may use server-side copies on network file systems
+  while (true)
+  {
+    const ssize_t iCopied = copy_file_range(srcFd, nullptr, dstFd, nullptr, uiChunkSize, 0);
+
+    if (iCopied == 0)
+      return NS_SUCCESS;
+
+    if (iCopied < 0)
+    {
+      // EXDEV, ENOSYS, EINVAL etc. are returned when the file systems don't support it, try sendfile instead
+      if (out_uiBytesCopied == 0)
+        break;
+
+      return NS_FAILURE;
+    }
+
+    out_uiBytesCopied += static_cast<nsUInt64>(iCopied);
+  }
+
+  while (true)
+  {
+    const ssize_t iCopied = sendfile(dstFd, srcFd, nullptr, uiChunkSize);
+
+    if (iCopied == 0)
+      return NS_SUCCESS;
+
+    if (iCopied < 0)
+      return NS_FAILURE;
+
+    out_uiBytesCopied += static_cast<nsUInt64>(iCopied);
+  }
+#else
+  NS_IGNORE_UNUSED(source);
+  NS_IGNORE_UNUSED(destination);
+  return NS_FAILURE;
+#endif
+}
+
 #if NS_ENABLED(NS_SUPPORTS_FILE_STATS) && NS_DISABLED(NS_PLATFORM_WINDOWS_UWP)
 nsResult nsOSFile::InternalGetFileStats(nsStringView sFileOrFolder, nsFileStats& out_Stats)
 {
@@ -532,18 +618,33 @@ namespace
       }
     }
 
-    nsStringBuilder absFileName = curPath;
-    absFileName.AppendPath(hCurrentFile->d_name);
+    const char* szName = hCurrentFile->d_name;
+    const bool bIsDotEntry = szName[0] == '.' && (szName[1] == '\0' || (szName[1] == '.' && szName[2] == '\0'));
 
     struct stat fileStat = {};
-    stat(absFileName.GetData(), &fileStat);
+
+    // '.' and '..' are skipped by the caller anyway, so don't bother querying their stats
+    if (!bIsDotEntry)
+    {
+      // stat relative to the directory handle, this avoids building the absolute path and resolving it again for every entry
+      fstatat(dirfd(hSearch), szName, &fileStat, 0);
+    }
 
     curFile.m_uiFileSize = fileStat.st_size;
-    curFile.m_bIsDirectory = hCurrentFile->d_type == DT_DIR;
     curFile.m_sParentPath = curPath;
-    curFile.m_sName = hCurrentFile->d_name;
+    curFile.m_sName = szName;
     curFile.m_LastModificationTime = nsTimestamp::MakeFromInt(fileStat.st_mtime, nsSIUnitOfTime::Second);
 
+    if (hCurrentFile->d_type == DT_UNKNOWN)
+    {
+      // some file systems don't fill out d_type
+      curFile.m_bIsDirectory = bIsDotEntry || S_ISDIR(fileStat.st_mode);
+    }
+    else
+    {
+      curFile.m_bIsDirectory = hCurrentFile->d_type == DT_DIR;
+    }
+
     return NS_SUCCESS;
   }
 } // namespace
@@ -186,20 +186,26 @@ void nsStandardJSONWriter::WriteFloat(float value)
 {
   CommaWriter cw(this);
 
-  nsStringBuilder s;
-  s.Format("{0}", value);
+  // the shortest text that reads back to exactly the same value
+  char szTemp[64];
+  nsUInt32 uiLength = 0;
+  nsStringUtils::OutputShortestFloat(szTemp, NS_ARRAY_SIZE(szTemp), uiLength, value);
+  szTemp[uiLength] = '\0';
 
-  OutputString(s.GetData());
+  OutputString(szTemp);
 }
 
 void nsStandardJSONWriter::WriteDouble(double value)
 {
   CommaWriter cw(this);
 
-  nsStringBuilder s;
-  s.Format("{0}", value);
+  // the shortest text that reads back to exactly the same value
+  char szTemp[64];
+  nsUInt32 uiLength = 0;
+  nsStringUtils::OutputShortestFloat(szTemp, NS_ARRAY_SIZE(szTemp), uiLength, value);
+  szTemp[uiLength] = '\0';
 
-  OutputString(s.GetData());
+  OutputString(szTemp);
 }
 
 void nsStandardJSONWriter::WriteString(nsStringView value)
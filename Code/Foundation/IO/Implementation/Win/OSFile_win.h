@@ -292,6 +292,25 @@ nsResult nsOSFile::InternalMoveFileOrDirectory(nsStringView sDirectoryFrom, nsSt
   return NS_SUCCESS;
 }
 
+nsResult nsOSFile::InternalReplaceFile(nsStringView sFrom, nsStringView sTo)
+{
+  if (MoveFileExW(nsDosDevicePath(sFrom), nsDosDevicePath(sTo), MOVEFILE_REPLACE_EXISTING) == 0)
+  {
+    return NS_FAILURE;
+  }
+  return NS_SUCCESS;
+}
+
+nsResult nsOSFile::InternalCopyFileData(const nsOSFileData& source, const nsOSFileData& destination, nsUInt64& out_uiBytesCopied)
+{
+  NS_IGNORE_UNUSED(source);
+  NS_IGNORE_UNUSED(destination);
+
+  // there is no handle based copy function, the regular read / write loop is used instead
+  out_uiBytesCopied = 0;
+  return NS_FAILURE;
+}
+
 #endif // not NS_USE_POSIX_FILE_API
 
 nsResult nsOSFile::InternalGetFileStats(nsStringView sFileOrFolder, nsFileStats& out_Stats)
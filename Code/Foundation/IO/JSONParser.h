@@ -10,6 +10,7 @@
 #include <Foundation/IO/Stream.h>
 
 class nsLogInterface;
+class nsJSONTape;
 
 /// \brief A low level JSON parser that can incrementally parse the structure of a JSON document.
 ///
@@ -40,6 +41,12 @@ protected:
   /// \brief Calls ContinueParsing() in a loop until that returns false.
   void ParseAll();
 
+  /// \brief Reports the document stored in \a tape through the OnSomething functions, in the same order as ParseAll() would.
+  ///
+  /// This allows to use existing parsers on documents that were parsed with nsJSONTape. SkipObject() and SkipArray() can be used from
+  /// within the callbacks as usual. Parsing errors have already been reported by nsJSONTape::Parse(), so OnParsingError() is never called.
+  void ParseTape(const nsJSONTape& tape);
+
   /// \brief Skips the rest of the currently open object. No OnEndArray() and OnEndObject() calls will be done for this object,
   /// cleanup must be done manually.
   void SkipObject();
@@ -139,6 +146,15 @@ private:
 
   void SkipStack(State s);
 
+  struct TapeScope
+  {
+    NS_DECLARE_POD_TYPE();
+
+    nsUInt32 m_uiTapeIndex;
+    bool m_bObject;
+    bool m_bExpectName;
+  };
+
   nsUInt8 m_uiCurByte;
   nsUInt8 m_uiNextByte;
   nsUInt32 m_uiCurLine;
@@ -149,4 +165,8 @@ private:
   nsHybridArray<nsUInt8, 4096> m_TempString;
 
   bool m_bSkippingMode;
+
+  const nsJSONTape* m_pTape = nullptr;
+  nsUInt32 m_uiTapePos = 0;
+  nsHybridArray<TapeScope, 32> m_TapeStack;
 };
@@ -31,6 +31,12 @@ public:
   /// error occurred.
   nsResult Parse(nsStreamReader& ref_input, nsUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Creates the internal data structure from a document that was already parsed into an nsJSONTape.
+  ///
+  /// For large documents, parsing them with nsJSONTape from memory is much faster than parsing them from a stream.
+  /// The tape does not need to be kept alive afterwards.
+  nsResult Parse(const nsJSONTape& tape);
+
   /// \brief Returns the top-level object of the JSON document.
   const nsVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -0,0 +1,162 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/StringView.h>
+
+class nsLogInterface;
+class nsJSONTape;
+
+/// \brief The type of a value stored in an nsJSONTape.
+struct nsJSONTapeType
+{
+  enum Enum : nsUInt8
+  {
+    Invalid,
+    Object,
+    Array,
+    String,
+    Number,
+    Bool,
+    Null,
+  };
+};
+
+/// \brief A lightweight cursor to a value inside an nsJSONTape.
+///
+/// Values are only decoded when they are accessed, nothing is copied or allocated. A cursor stays valid as long as the tape it
+/// points into is alive and has not been parsed again.
+///
+/// Children of arrays are iterated with GetFirstChild() and GetNextSibling(). For objects the children alternate between the
+/// member name (a string) and the member value, i.e. the value of a member is the next sibling of its name.
+class NS_FOUNDATION_DLL nsJSONTapeValue
+{
+public:
+  nsJSONTapeValue() = default;
+
+  /// \brief Whether the cursor points to a value at all. Lookups that fail return an invalid cursor.
+  bool IsValid() const { return m_pTape != nullptr; }
+
+  nsJSONTapeType::Enum GetType() const;
+
+  bool IsObject() const { return GetType() == nsJSONTapeType::Object; }
+  bool IsArray() const { return GetType() == nsJSONTapeType::Array; }
+  bool IsString() const { return GetType() == nsJSONTapeType::String; }
+  bool IsNumber() const { return GetType() == nsJSONTapeType::Number; }
+  bool IsBool() const { return GetType() == nsJSONTapeType::Bool; }
+  bool IsNull() const { return GetType() == nsJSONTapeType::Null; }
+
+  /// \brief Returns the string value. The view points either into the parsed buffer or, for strings with escape sequences, into the tape.
+  nsStringView GetString() const;
+
+  /// \brief Returns the number value. As with nsJSONParser all numbers are read as double.
+  double GetNumber() const;
+
+  bool GetBool() const;
+
+  /// \brief Returns the number of elements in an array or the number of members in an object.
+  nsUInt32 GetCount() const;
+
+  /// \brief Returns the first element of an array or the name of the first member of an object.
+  nsJSONTapeValue GetFirstChild() const;
+
+  /// \brief Returns the next value in the same array or object, or an invalid cursor at the end.
+  nsJSONTapeValue GetNextSibling() const;
+
+  /// \brief Returns the value of the member with the given name. Returns an invalid cursor if this is not an object or there is no such member.
+  nsJSONTapeValue FindMember(nsStringView sName) const;
+
+  /// \brief Returns the element at the given index of an array. This has to walk over the previous elements.
+  nsJSONTapeValue GetElement(nsUInt32 uiIndex) const;
+
+  nsJSONTapeValue operator[](nsStringView sName) const { return FindMember(sName); }
+
+  /// \brief Returns the position of the value on the tape.
+  nsUInt32 GetTapeIndex() const { return m_uiIndex; }
+
+private:
+  friend class nsJSONTape;
+  friend class nsJSONParser;
+
+  nsJSONTapeValue(const nsJSONTape* pTape, nsUInt32 uiIndex)
+    : m_pTape(pTape)
+    , m_uiIndex(uiIndex)
+  {
+  }
+
+  const nsJSONTape* m_pTape = nullptr;
+  nsUInt32 m_uiIndex = 0;
+};
+
+/// \brief Parses a JSON document from a contiguous buffer into a compact tape of 64 bit words.
+///
+/// Parsing is done in two stages. The first stage classifies the input in blocks of 64 bytes, using SSE where available, and records
+/// the offsets of all structural characters and the starts of all scalar values that are not inside of a string. The second stage walks
+/// over these offsets, validates the document structure and writes the tape. Objects and arrays store the tape index behind their end,
+/// so whole sub-trees can be skipped in constant time.
+///
+/// Strings without escape sequences are not copied, the tape references them in the input buffer directly. Therefore the buffer (e.g. the
+/// read pointer of an nsMemoryMappedFile) must stay alive and unchanged as long as the tape is used.
+///
+/// Like nsJSONParser, comments and superfluous commas are accepted, but comments may only appear between values, not inside of them.
+/// Documents that contain comments are copied once to blank them out, which is slower than parsing comment free documents. Unlike
+/// nsJSONParser, data after the end of the top level object or array is reported as an error.
+///
+/// The tape can be traversed lazily through nsJSONTapeValue or replayed into any nsJSONParser with nsJSONParser::ParseTape().
+class NS_FOUNDATION_DLL nsJSONTape
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsJSONTape);
+
+public:
+  nsJSONTape();
+  ~nsJSONTape();
+
+  /// \brief Parses the given document. Returns NS_FAILURE and logs an error if the document is malformed.
+  ///
+  /// An empty document (only whitespace) is valid, in that case GetRoot() returns an invalid cursor.
+  nsResult Parse(nsArrayPtr<const char> document, nsLogInterface* pLog = nullptr);
+
+  /// \brief Removes all parsed data.
+  void Clear();
+
+  /// \brief Returns the top level value of the document.
+  nsJSONTapeValue GetRoot() const;
+
+  /// \brief Returns the number of 64 bit words on the tape.
+  nsUInt32 GetTapeSize() const { return m_Tape.GetCount(); }
+
+private:
+  friend class nsJSONTapeValue;
+  friend class nsJSONParser;
+
+  static constexpr nsUInt32 s_uiTypeShift = 56;
+  static constexpr nsUInt32 s_uiCountShift = 32;
+  static constexpr nsUInt32 s_uiMaxCount = (1u << 23) - 1;
+  static constexpr nsUInt64 s_uiPayloadMask = (nsUInt64(1) << s_uiTypeShift) - 1;
+  static constexpr nsUInt64 s_uiDecodedStringFlag = nsUInt64(1) << 55;
+  static constexpr nsUInt8 s_uiEndMarker = 0xFF;
+
+  nsResult FindStructurals(const char* pData, nsUInt32 uiSize, nsUInt32& out_uiFirstComment);
+  nsResult BuildTape(const char* pData, nsUInt32 uiSize);
+  nsResult WriteString(const char* pData, nsUInt32 uiSize, nsUInt32 uiStart);
+  nsResult WriteScalar(const char* pData, nsUInt32 uiSize, nsUInt32 uiStart);
+  void StripComments(nsArrayPtr<const char> document);
+  void ReportError(nsUInt32 uiOffset, nsStringView sMessage);
+
+  nsUInt8 GetTypeAt(nsUInt32 uiIndex) const { return static_cast<nsUInt8>(m_Tape[uiIndex] >> s_uiTypeShift); }
+  nsUInt64 GetPayloadAt(nsUInt32 uiIndex) const { return m_Tape[uiIndex] & s_uiPayloadMask; }
+  nsUInt32 GetSkipIndex(nsUInt32 uiIndex) const;
+
+  nsDynamicArray<nsUInt64> m_Tape;
+  nsDynamicArray<nsUInt32> m_Structurals;
+  nsDynamicArray<char> m_DecodedStrings;
+  nsDynamicArray<char> m_StrippedDocument;
+  const char* m_pDocument = nullptr;
+  nsUInt32 m_uiDocumentSize = 0;
+  nsLogInterface* m_pLog = nullptr;
+};
@@ -244,7 +244,14 @@ public:
   /// Returns NS_FAILURE if the move failed.
   static nsResult MoveFileOrDirectory(nsStringView sFrom, nsStringView sTo);
 
+  /// \brief Renames / Moves the file at sFrom to sTo. If sTo already exists, it is replaced in one step, so it always contains either the
+  /// old or the new content. Both paths should be on the same volume. Returns NS_FAILURE if the file could not be moved, sTo is untouched then.
+  static nsResult ReplaceFile(nsStringView sFrom, nsStringView sTo); // [tested]
+
   /// \brief Copies the source file into the destination file.
+  ///
+  /// Where the OS supports it, the data is copied without passing through user space (e.g. reflinks or in-kernel copies on Linux).
+  /// Otherwise, or if that fails, the file is copied through a regular read / write loop.
   static nsResult CopyFile(nsStringView sSource, nsStringView sDestination); // [tested]
 
 #if NS_ENABLED(NS_SUPPORTS_FILE_STATS) || defined(NS_DOCS)
@@ -263,6 +270,12 @@ public:
   /// \brief Returns the nsFileStats for all files and folders in the given folder
   static void GatherAllItemsInFolder(nsDynamicArray<nsFileStats>& out_itemList, nsStringView sFolder, nsBitflags<nsFileSystemIteratorFlags> flags = nsFileSystemIteratorFlags::Default);
 
+  /// \brief Same as GatherAllItemsInFolder(), but the sub-folders of \a sFolder are enumerated in parallel through the nsTaskSystem.
+  ///
+  /// The items are returned in the same order as GatherAllItemsInFolder() would return them.
+  /// Only worth it for large and deep folder hierarchies, for small folders the task overhead dominates.
+  static void GatherAllItemsInFolderParallel(nsDynamicArray<nsFileStats>& out_itemList, nsStringView sFolder, nsBitflags<nsFileSystemIteratorFlags> flags = nsFileSystemIteratorFlags::Default);
+
   /// \brief Copies \a szSourceFolder to \a szDestinationFolder. Overwrites existing files.
   ///
   /// If \a out_FilesCopied is provided, the destination path of every successfully copied file is appended to it.
@@ -382,6 +395,13 @@ private:
   static nsResult InternalDeleteDirectory(nsStringView sDirectory);
   static nsResult InternalCreateDirectory(nsStringView sFile);
   static nsResult InternalMoveFileOrDirectory(nsStringView sDirectoryFrom, nsStringView sDirectoryTo);
+  static nsResult InternalReplaceFile(nsStringView sFrom, nsStringView sTo);
+
+  /// \brief Tries to copy the content of an open source file into an open destination file through an OS specific fast path.
+  ///
+  /// Returns NS_FAILURE, if no fast path is available or it could not be used for these files. out_uiBytesCopied is set to the number of bytes
+  /// that were copied nonetheless, the file positions of both files are always at that offset afterwards.
+  static nsResult InternalCopyFileData(const nsOSFileData& source, const nsOSFileData& destination, nsUInt64& out_uiBytesCopied);
 
 #if NS_ENABLED(NS_SUPPORTS_FILE_STATS)
   static nsResult InternalGetFileStats(nsStringView sFileOrFolder, nsFileStats& out_Stats);
@@ -33,6 +33,28 @@ enum class nsOpenDdlPrimitiveType
   Custom
 };
 
+/// \brief Element header of the binary OpenDDL format, written by nsOpenDdlWriter and read by nsOpenDdlReader::ParseBinaryDocument().
+///
+/// A binary document starts with the 4 magic bytes and the 32 bit format version, followed by the top-level elements.
+/// Each element consists of this header, the custom type and name strings padded to 8 bytes, and then either the child elements or the
+/// primitive data. Strings in primitive lists are stored as a 32 bit length followed by the characters, padded to 4 bytes.
+/// Elements are padded to a multiple of 8 bytes, so all primitive data is naturally aligned when the document is mapped into memory.
+struct nsOpenDdlBinaryElement
+{
+  static constexpr nsUInt8 s_Magic[4] = {0, 'D', 'D', 'B'}; // text documents never start with a zero byte
+  static constexpr nsUInt32 s_uiVersion = 1;
+  static constexpr nsUInt32 s_uiDocumentHeaderSize = 8;
+
+  nsUInt8 m_uiPrimitiveType = 0; ///< nsOpenDdlPrimitiveType
+  nsUInt8 m_uiGlobalName = 0;
+  nsUInt16 m_uiNameLength = 0;
+  nsUInt32 m_uiSize = 0;  ///< Size of the entire element including its header, children and padding.
+  nsUInt32 m_uiCount = 0; ///< Number of child elements or primitives.
+  nsUInt32 m_uiTypeLength = 0;
+};
+
+NS_CHECK_AT_COMPILETIME(sizeof(nsOpenDdlBinaryElement) == 16);
+
 /// \brief A low level parser for the OpenDDL format. It can incrementally parse the structure, individual blocks can be skipped.
 ///
 /// The document structure is returned through virtual functions that need to be overridden.
@@ -135,6 +135,16 @@ public:
   nsResult ParseDocument(nsStreamReader& inout_stream, nsUInt32 uiFirstLineOffset = 0, nsLogInterface* pLog = nsLog::GetThreadLocalLogSystem(),
     nsUInt32 uiCacheSizeInKB = 4); // [tested]
 
+  /// \brief Builds the document structure from binary OpenDDL, as written by nsOpenDdlWriter with nsOpenDdlWriter::OutputFormat::Binary.
+  ///
+  /// Nothing is parsed or copied, all names and primitive data point directly into \a data, which therefore must stay valid and unmodified
+  /// for as long as this reader is used. This makes it possible to use the reader directly on a memory mapped file.
+  /// Returns NS_FAILURE if the data is not a valid binary document.
+  nsResult ParseBinaryDocument(nsArrayPtr<const nsUInt8> data, nsLogInterface* pLog = nsLog::GetThreadLocalLogSystem()); // [tested]
+
+  /// \brief Returns whether \a data starts with the header of a binary OpenDDL document.
+  static bool IsBinaryDocument(nsArrayPtr<const nsUInt8> data); // [tested]
+
   /// \brief Every document has exactly one root element.
   const nsOpenDdlReaderElement* GetRootElement() const; // [tested]
 
@@ -169,6 +179,7 @@ protected:
 
 protected:
   nsOpenDdlReaderElement* CreateElement(nsOpenDdlPrimitiveType type, nsStringView sType, nsStringView sName, bool bGlobalName);
+  void CreateRootElement();
   nsStringView CopyString(const nsStringView& string);
   void StorePrimitiveData(bool bThisIsAll, nsUInt32 bytecount, const nsUInt8* pData);
 
@@ -31,6 +31,13 @@ public:
     Exact,    ///< Float values are printed as HEX, representing the exact binary data.
   };
 
+  enum class OutputFormat
+  {
+    Text,   ///< Regular OpenDDL text.
+    Binary, ///< A binary encoding of the document tree that nsOpenDdlReader::ParseBinaryDocument() can use in place, e.g. from a memory mapped
+            ///< file. Whitespace, type string and float precision settings are ignored in this format.
+  };
+
   /// \brief Constructor
   nsOpenDdlWriter();
 
@@ -51,6 +58,14 @@ public:
   /// \brief Returns how float values are output.
   FloatPrecisionMode GetFloatPrecisionMode() const { return m_FloatPrecisionMode; }
 
+  /// \brief Configures whether text or binary OpenDDL is written. Has to be set before anything is written.
+  ///
+  /// In binary mode each top-level object is buffered until it is complete and then written to the output stream in one piece.
+  void SetOutputFormat(OutputFormat format) { m_OutputFormat = format; }
+
+  /// \brief Returns whether text or binary OpenDDL is written.
+  OutputFormat GetOutputFormat() const { return m_OutputFormat; }
+
   /// \brief Allows to set the indentation. Negative values are possible.
   /// This makes it possible to set the indentation e.g. to -2, thus the output will only have indentation after a level of 3 has been reached.
   void SetIndentation(nsInt8 iIndentation) { m_iIndentation = iIndentation; }
@@ -147,6 +162,13 @@ protected:
   void WriteBinaryAsHex(const void* pData, nsUInt32 uiBytes);
   void OutputObjectBeginning();
 
+  void BinaryBeginElement(nsOpenDdlPrimitiveType type, nsStringView sType, nsStringView sName, bool bGlobalName);
+  void BinaryEndElement();
+  void BinaryWritePrimitives(nsOpenDdlPrimitiveType type, const void* pValues, nsUInt32 uiElementSize, nsUInt32 uiCount);
+  void BinaryWriteString(nsStringView sString);
+  void BinaryAppend(const void* pData, nsUInt32 uiBytes);
+  void BinaryPad(nsUInt32 uiAlignment);
+
   nsInt32 m_iIndentation = 0;
   bool m_bCompactMode = false;
   TypeStringMode m_TypeStringMode = TypeStringMode::ShortenedUnsignedInt;
@@ -155,4 +177,9 @@ protected:
   nsStringBuilder m_sTemp;
 
   nsHybridArray<DdlState, 16> m_StateStack;
+
+  OutputFormat m_OutputFormat = OutputFormat::Text;
+  bool m_bBinaryHeaderWritten = false;
+  nsDynamicArray<nsUInt8> m_BinaryData;              ///< The top-level element that is currently being written.
+  nsHybridArray<nsUInt32, 16> m_BinaryElementOffsets; ///< Offsets of all open elements in m_BinaryData.
 };
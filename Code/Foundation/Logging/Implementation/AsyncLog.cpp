@@ -0,0 +1,465 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+#include <atomic>
+
+namespace
+{
+  // The queues are split into slots of this size. Every message starts at the beginning of a slot with a header,
+  // the tag and the text follow directly behind it and continue in the next slots, if necessary.
+  constexpr nsUInt32 s_uiSlotSize = 128;
+
+  struct nsAsyncLogRecordHeader
+  {
+    nsUInt64 m_uiSequence;
+    double m_fSeconds;
+    nsUInt32 m_uiTextLength;
+    nsUInt16 m_uiTagLength;
+    nsUInt16 m_uiNumSlots;
+    nsLogMsgType::Enum m_EventType;
+    nsUInt8 m_uiIndentation;
+  };
+
+  static_assert(sizeof(nsAsyncLogRecordHeader) <= s_uiSlotSize);
+
+  /// \brief A single producer / single consumer ring buffer.
+  ///
+  /// Only the thread that owns the queue writes to it, only the thread that holds nsAsyncLogState::m_DispatchMutex reads from it.
+  /// Positions are counted in slots and never wrap around, the slot index is the position modulo the number of slots.
+  struct alignas(64) nsAsyncLogQueue
+  {
+    nsAsyncLogQueue(nsUInt32 uiNumSlots)
+      : m_uiNumSlots(uiNumSlots)
+    {
+      m_pData = new nsUInt8[uiNumSlots * s_uiSlotSize];
+    }
+
+    ~nsAsyncLogQueue() { delete[] m_pData; }
+
+    nsUInt8* GetSlot(nsInt64 iPos) { return m_pData + (iPos & (m_uiNumSlots - 1)) * s_uiSlotSize; }
+
+    nsUInt8* m_pData = nullptr;
+    nsUInt32 m_uiNumSlots = 0;
+    nsAtomicBool m_bOrphaned;
+
+    // only accessed by the owning thread
+    alignas(64) nsInt64 m_iWritePos = 0;
+
+    // written by the owning thread, read by the dispatching thread
+    alignas(64) std::atomic<nsInt64> m_iPublishedPos{0};
+
+    // written by the dispatching thread, read by the owning thread
+    alignas(64) std::atomic<nsInt64> m_iReadPos{0};
+  };
+
+  struct nsAsyncLogState
+  {
+    nsUInt32 m_uiSlotsPerQueue = 0;
+    nsLogOverflowPolicy::Enum m_OverflowPolicy = nsLogOverflowPolicy::Block;
+
+    // protects m_Queues, only held for short durations
+    nsMutex m_QueuesMutex;
+    nsDynamicArray<nsAsyncLogQueue*> m_Queues;
+
+    // held while messages are taken out of the queues and passed to the log writers
+    nsMutex m_DispatchMutex;
+    nsDynamicArray<nsAsyncLogQueue*> m_DispatchQueues;
+    nsDynamicArray<char> m_ReassemblyBuffer;
+    nsUInt64 m_uiNextSequenceToDispatch = 1;
+
+    // positions and counters use std::atomic, because they may exceed 32 bits in long sessions
+    std::atomic<nsInt64> m_iNextSequence{0};
+    std::atomic<nsInt64> m_iDroppedSinceReport{0};
+    nsAtomicBool m_bDispatcherSleeping;
+    nsThreadSignal m_WakeUpDispatcher;
+  };
+
+  // Enabling and disabling async mode must not overlap with logging on other threads (see nsGlobalLog::EnableAsyncMode()).
+  // Both are still atomic, so that threads which log afterwards are guaranteed to see the new state.
+  std::atomic<nsAsyncLogState*> s_pAsyncLogState{nullptr};
+  nsAtomicInteger32 s_iAsyncLogGeneration;
+  std::atomic<nsInt64> s_iNumDroppedMessages{0};
+
+  // set while a thread passes messages to the log writers, messages logged by the writers themselves are dispatched synchronously
+  thread_local bool s_bIsDispatchingAsyncMessages = false;
+
+  // Set once the queue owner of this thread was destroyed. Other thread_local destructors may still log afterwards, those messages
+  // are dispatched synchronously. A bool has no destructor, so it stays valid until the thread is gone.
+  thread_local bool s_bThreadQueueDestroyed = false;
+
+  /// \brief Marks the queue of a thread as orphaned, once the thread exits. The dispatcher deletes it after it was drained.
+  struct nsAsyncLogQueueOwner
+  {
+    ~nsAsyncLogQueueOwner()
+    {
+      s_bThreadQueueDestroyed = true;
+
+      if (m_pQueue != nullptr && m_iGeneration == s_iAsyncLogGeneration)
+      {
+        m_pQueue->m_bOrphaned = true;
+      }
+
+      m_pQueue = nullptr;
+    }
+
+    nsAsyncLogQueue* m_pQueue = nullptr;
+    nsInt32 m_iGeneration = 0;
+  };
+
+  thread_local nsAsyncLogQueueOwner s_ThreadQueue;
+
+  nsAsyncLogQueue* GetThreadQueue(nsAsyncLogState* pState)
+  {
+    if (s_bThreadQueueDestroyed)
+      return nullptr;
+
+    const nsInt32 iGeneration = s_iAsyncLogGeneration;
+
+    if (s_ThreadQueue.m_pQueue == nullptr || s_ThreadQueue.m_iGeneration != iGeneration)
+    {
+      // use new, not NS_DEFAULT_NEW, to prevent tracking (same as for the thread local nsGlobalLog)
+      s_ThreadQueue.m_pQueue = new nsAsyncLogQueue(pState->m_uiSlotsPerQueue);
+      s_ThreadQueue.m_iGeneration = iGeneration;
+
+      NS_LOCK(pState->m_QueuesMutex);
+      pState->m_Queues.PushBack(s_ThreadQueue.m_pQueue);
+    }
+
+    return s_ThreadQueue.m_pQueue;
+  }
+
+  void CopyToQueue(nsAsyncLogQueue* pQueue, nsInt64 iSlotPos, nsUInt32 uiOffset, const void* pSource, nsUInt32 uiSize)
+  {
+    if (uiSize == 0)
+      return;
+
+    const nsUInt32 uiQueueSize = pQueue->m_uiNumSlots * s_uiSlotSize;
+    const nsUInt32 uiStart = static_cast<nsUInt32>((iSlotPos & (pQueue->m_uiNumSlots - 1)) * s_uiSlotSize + uiOffset) & (uiQueueSize - 1);
+    const nsUInt32 uiFirstPart = nsMath::Min(uiSize, uiQueueSize - uiStart);
+
+    nsMemoryUtils::Copy(pQueue->m_pData + uiStart, static_cast<const nsUInt8*>(pSource), uiFirstPart);
+    nsMemoryUtils::Copy(pQueue->m_pData, static_cast<const nsUInt8*>(pSource) + uiFirstPart, uiSize - uiFirstPart);
+  }
+
+  /// \brief Returns the payload of a record, either in place or, if it wraps around the end of the queue, copied into the reassembly buffer.
+  const char* GetPayload(nsAsyncLogState* pState, nsAsyncLogQueue* pQueue, nsInt64 iSlotPos, nsUInt32 uiSize)
+  {
+    const nsUInt32 uiQueueSize = pQueue->m_uiNumSlots * s_uiSlotSize;
+    const nsUInt32 uiStart = static_cast<nsUInt32>((iSlotPos & (pQueue->m_uiNumSlots - 1)) * s_uiSlotSize + sizeof(nsAsyncLogRecordHeader));
+
+    if (uiStart + uiSize <= uiQueueSize)
+      return reinterpret_cast<const char*>(pQueue->m_pData + uiStart);
+
+    const nsUInt32 uiFirstPart = uiQueueSize - uiStart;
+    pState->m_ReassemblyBuffer.SetCountUninitialized(uiSize);
+    nsMemoryUtils::Copy(pState->m_ReassemblyBuffer.GetData(), reinterpret_cast<const char*>(pQueue->m_pData + uiStart), uiFirstPart);
+    nsMemoryUtils::Copy(pState->m_ReassemblyBuffer.GetData() + uiFirstPart, reinterpret_cast<const char*>(pQueue->m_pData), uiSize - uiFirstPart);
+    return pState->m_ReassemblyBuffer.GetData();
+  }
+
+  bool HasPendingMessages(nsAsyncLogState* pState)
+  {
+    NS_LOCK(pState->m_QueuesMutex);
+
+    for (nsAsyncLogQueue* pQueue : pState->m_Queues)
+    {
+      if (pQueue->m_iPublishedPos.load() != pQueue->m_iReadPos.load())
+        return true;
+    }
+
+    return false;
+  }
+} // namespace
+
+class nsAsyncLogThread : public nsThread
+{
+public:
+  nsAsyncLogThread()
+    : nsThread("nsAsyncLog")
+  {
+  }
+
+  nsAtomicBool m_bQuit;
+
+private:
+  virtual nsUInt32 Run() override
+  {
+    nsAsyncLogState* pState = s_pAsyncLogState.load(std::memory_order_acquire);
+
+    while (!m_bQuit)
+    {
+      pState->m_bDispatcherSleeping = true;
+
+      // check again after announcing that we go to sleep, otherwise a message that was published in between would be delayed
+      if (!HasPendingMessages(pState))
+      {
+        pState->m_WakeUpDispatcher.WaitForSignal(nsTime::MakeFromMilliseconds(100));
+      }
+
+      pState->m_bDispatcherSleeping = false;
+
+      nsGlobalLog::FlushAsyncMessages();
+    }
+
+    return 0;
+  }
+};
+
+static nsAsyncLogThread* s_pAsyncLogThread = nullptr;
+
+void nsGlobalLog::EnableAsyncMode(nsUInt32 uiQueueSizePerThread, nsLogOverflowPolicy::Enum overflowPolicy)
+{
+  if (s_pAsyncLogState.load(std::memory_order_acquire) != nullptr)
+    return;
+
+  const nsUInt32 uiNumSlots = nsMath::PowerOfTwo_Ceil(nsMath::Max(uiQueueSizePerThread, 16 * s_uiSlotSize) / s_uiSlotSize);
+
+  nsAsyncLogState* pState = new nsAsyncLogState();
+  pState->m_uiSlotsPerQueue = uiNumSlots;
+  pState->m_OverflowPolicy = overflowPolicy;
+
+  s_iAsyncLogGeneration.Increment();
+  s_pAsyncLogState.store(pState, std::memory_order_release);
+
+  s_pAsyncLogThread = new nsAsyncLogThread();
+  s_pAsyncLogThread->Start();
+}
+
+void nsGlobalLog::DisableAsyncMode()
+{
+  nsAsyncLogState* pState = s_pAsyncLogState.load(std::memory_order_acquire);
+
+  if (pState == nullptr)
+    return;
+
+  s_pAsyncLogThread->m_bQuit = true;
+  pState->m_WakeUpDispatcher.RaiseSignal();
+  s_pAsyncLogThread->Join();
+
+  delete s_pAsyncLogThread;
+  s_pAsyncLogThread = nullptr;
+
+  FlushAsyncMessages();
+
+  // from now on all messages are dispatched synchronously again
+  s_pAsyncLogState.store(nullptr, std::memory_order_release);
+  s_iAsyncLogGeneration.Increment();
+
+  for (nsAsyncLogQueue* pQueue : pState->m_Queues)
+  {
+    delete pQueue;
+  }
+
+  delete pState;
+}
+
+bool nsGlobalLog::IsAsyncModeEnabled()
+{
+  return s_pAsyncLogState.load(std::memory_order_acquire) != nullptr;
+}
+
+nsUInt64 nsGlobalLog::GetNumDroppedMessages()
+{
+  return static_cast<nsUInt64>(s_iNumDroppedMessages.load());
+}
+
+bool nsGlobalLog::EnqueueAsyncMessage(const nsLoggingEventData& le)
+{
+  nsAsyncLogState* pState = s_pAsyncLogState.load(std::memory_order_acquire);
+
+  if (pState == nullptr || s_bIsDispatchingAsyncMessages)
+    return false;
+
+  nsAsyncLogQueue* pQueue = GetThreadQueue(pState);
+  if (pQueue == nullptr)
+  {
+    // the message is dispatched synchronously, after everything this thread has queued before
+    FlushAsyncMessages();
+    return false;
+  }
+
+  const nsUInt32 uiMaxPayload = (pState->m_uiSlotsPerQueue / 2) * s_uiSlotSize - sizeof(nsAsyncLogRecordHeader);
+
+  const nsUInt32 uiTagLength = nsMath::Min(le.m_sTag.GetElementCount(), nsMath::Min(uiMaxPayload / 2, 0xFFFFu));
+  nsUInt32 uiTextLength = nsMath::Min(le.m_sText.GetElementCount(), uiMaxPayload - uiTagLength);
+
+  // don't cut a message in the middle of a Utf8 sequence
+  while (uiTextLength < le.m_sText.GetElementCount() && uiTextLength > 0 && nsUnicodeUtils::IsUtf8ContinuationByte(le.m_sText.GetStartPointer()[uiTextLength]))
+    --uiTextLength;
+
+  const nsUInt32 uiRecordSize = sizeof(nsAsyncLogRecordHeader) + uiTagLength + uiTextLength;
+  const nsUInt32 uiNumSlots = (uiRecordSize + s_uiSlotSize - 1) / s_uiSlotSize;
+
+  // wait for (or give up on) enough free space
+  while (pQueue->m_iWritePos + uiNumSlots - pQueue->m_iReadPos > pQueue->m_uiNumSlots)
+  {
+    if (pState->m_OverflowPolicy != nsLogOverflowPolicy::Block)
+    {
+      ++s_iNumDroppedMessages;
+      ++pState->m_iDroppedSinceReport;
+      return true;
+    }
+
+    pState->m_WakeUpDispatcher.RaiseSignal();
+    nsThreadUtils::YieldTimeSlice();
+  }
+
+  const nsInt64 iPos = pQueue->m_iWritePos;
+  CopyToQueue(pQueue, iPos, sizeof(nsAsyncLogRecordHeader), le.m_sTag.GetStartPointer(), uiTagLength);
+  CopyToQueue(pQueue, iPos, sizeof(nsAsyncLogRecordHeader) + uiTagLength, le.m_sText.GetStartPointer(), uiTextLength);
+
+  nsAsyncLogRecordHeader header;
+  header.m_uiTextLength = uiTextLength;
+  header.m_uiTagLength = static_cast<nsUInt16>(uiTagLength);
+  header.m_uiNumSlots = static_cast<nsUInt16>(uiNumSlots);
+  header.m_EventType = le.m_EventType;
+  header.m_uiIndentation = le.m_uiIndentation;
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+  header.m_fSeconds = le.m_fSeconds;
+#else
+  header.m_fSeconds = 0;
+#endif
+
+  // The dispatcher waits for every sequence number that was handed out, so take it as late as possible, directly before publishing.
+  header.m_uiSequence = static_cast<nsUInt64>(++pState->m_iNextSequence);
+  nsMemoryUtils::Copy(pQueue->GetSlot(iPos), reinterpret_cast<const nsUInt8*>(&header), sizeof(header));
+
+  pQueue->m_iWritePos += uiNumSlots;
+
+  // the atomic write makes the record visible to the dispatcher
+  pQueue->m_iPublishedPos = pQueue->m_iWritePos;
+
+  if (pState->m_bDispatcherSleeping && pState->m_bDispatcherSleeping.Set(false))
+  {
+    pState->m_WakeUpDispatcher.RaiseSignal();
+  }
+
+  return true;
+}
+
+void nsGlobalLog::FlushAsyncMessages()
+{
+  nsAsyncLogState* pState = s_pAsyncLogState.load(std::memory_order_acquire);
+
+  if (pState == nullptr || s_bIsDispatchingAsyncMessages)
+    return;
+
+  NS_LOCK(pState->m_DispatchMutex);
+
+  s_bIsDispatchingAsyncMessages = true;
+
+  // Only dispatch what was logged until now, otherwise a flush could go on forever while other threads keep logging.
+  // This has to be read before the queues are copied: a thread registers its queue before it takes its first sequence number,
+  // so the queues of all messages up to uiLastSequence are part of the copy.
+  const nsUInt64 uiLastSequence = static_cast<nsUInt64>(pState->m_iNextSequence.load());
+  nsUInt32 uiGapWaitRounds = 0;
+
+  {
+    NS_LOCK(pState->m_QueuesMutex);
+    pState->m_DispatchQueues = pState->m_Queues;
+  }
+
+  while (true)
+  {
+    nsAsyncLogQueue* pNextQueue = nullptr;
+    nsAsyncLogRecordHeader nextHeader;
+    nextHeader.m_uiSequence = 0xFFFFFFFFFFFFFFFFull;
+
+    // messages are merged across all threads by their sequence number
+    for (nsAsyncLogQueue* pQueue : pState->m_DispatchQueues)
+    {
+      const nsInt64 iReadPos = pQueue->m_iReadPos;
+
+      if (iReadPos == pQueue->m_iPublishedPos)
+        continue;
+
+      nsAsyncLogRecordHeader header;
+      nsMemoryUtils::Copy(reinterpret_cast<nsUInt8*>(&header), pQueue->GetSlot(iReadPos), sizeof(header));
+
+      if (header.m_uiSequence < nextHeader.m_uiSequence)
+      {
+        nextHeader = header;
+        pNextQueue = pQueue;
+      }
+    }
+
+    if (pNextQueue == nullptr || nextHeader.m_uiSequence > uiLastSequence)
+      break;
+
+    // Another thread has taken the next sequence number, but not published its message yet. It only needs to write the record header
+    // for that, so wait for it to keep the order intact. If that thread got preempted, give up the time slice instead of spinning.
+    if (nextHeader.m_uiSequence > pState->m_uiNextSequenceToDispatch)
+    {
+      if (++uiGapWaitRounds < 64)
+        nsThreadUtils::YieldHardwareThread();
+      else
+        nsThreadUtils::YieldTimeSlice();
+
+      continue;
+    }
+
+    uiGapWaitRounds = 0;
+
+    const nsInt64 iReadPos = pNextQueue->m_iReadPos;
+    const char* szPayload = GetPayload(pState, pNextQueue, iReadPos, nextHeader.m_uiTagLength + nextHeader.m_uiTextLength);
+
+    nsLoggingEventData le;
+    le.m_EventType = nextHeader.m_EventType;
+    le.m_uiIndentation = nextHeader.m_uiIndentation;
+    le.m_sTag = nsStringView(szPayload, nextHeader.m_uiTagLength);
+    le.m_sText = nsStringView(szPayload + nextHeader.m_uiTagLength, nextHeader.m_uiTextLength);
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+    le.m_fSeconds = nextHeader.m_fSeconds;
+#endif
+
+    s_LoggingEvent.Broadcast(le);
+
+    pState->m_uiNextSequenceToDispatch = nextHeader.m_uiSequence + 1;
+
+    // frees the slots for the owning thread
+    pNextQueue->m_iReadPos = iReadPos + nextHeader.m_uiNumSlots;
+  }
+
+  const nsInt64 iDropped = pState->m_iDroppedSinceReport.exchange(0);
+
+  if (iDropped > 0 && pState->m_OverflowPolicy == nsLogOverflowPolicy::DropAndReport)
+  {
+    nsStringBuilder sText;
+    sText.Format("{} log messages were dropped, because the async log queue was full.", iDropped);
+
+    nsLoggingEventData le;
+    le.m_EventType = nsLogMsgType::WarningMsg;
+    le.m_sText = sText;
+    s_LoggingEvent.Broadcast(le);
+  }
+
+  // delete the queues of threads that don't exist anymore
+  {
+    NS_LOCK(pState->m_QueuesMutex);
+
+    for (nsUInt32 i = pState->m_Queues.GetCount(); i > 0; --i)
+    {
+      nsAsyncLogQueue* pQueue = pState->m_Queues[i - 1];
+
+      if (pQueue->m_bOrphaned && pQueue->m_iReadPos.load() == pQueue->m_iPublishedPos.load())
+      {
+        pState->m_Queues.RemoveAtAndSwap(i - 1);
+        delete pQueue;
+      }
+    }
+  }
+
+  s_bIsDispatchingAsyncMessages = false;
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_AsyncLog);
@@ -89,6 +89,15 @@ void nsGlobalLog::HandleLogMessage(const nsLoggingEventData& le)
     if ((ThisType > nsLogMsgType::None) && (ThisType < nsLogMsgType::All))
       s_uiMessageCount[ThisType].Increment();
 
+    if (EnqueueAsyncMessage(le))
+    {
+      // errors must not get lost in case the application goes down right afterwards
+      if (ThisType == nsLogMsgType::ErrorMsg)
+        FlushAsyncMessages();
+
+      return;
+    }
+
     s_LoggingEvent.Broadcast(le);
   }
 }
@@ -186,7 +195,7 @@ void nsLog::WriteBlockHeader(nsLogInterface* pInterface, nsLogBlock* pBlock)
   pInterface->HandleLogMessage(le);
 }
 
-void nsLog::BroadcastLoggingEvent(nsLogInterface* pInterface, nsLogMsgType::Enum type, nsStringView sString)
+void nsLog::BroadcastLoggingEvent(nsLogInterface* pInterface, nsLogMsgType::Enum type, nsStringView sString, nsStringView sFormat)
 {
   nsLogBlock* pTopBlock = pInterface->m_pCurrentBlock;
   nsUInt8 uiIndentation = 0;
@@ -232,6 +241,7 @@ void nsLog::BroadcastLoggingEvent(nsLogInterface* pInterface, nsLogMsgType::Enum
   le.m_sText = sString;
   le.m_uiIndentation = uiIndentation;
   le.m_sTag = szTag;
+  le.m_sFormat = sFormat;
 
   pInterface->HandleLogMessage(le);
   pInterface->m_uiLoggedMsgsSinceFlush++;
@@ -369,7 +379,7 @@ void nsLog::Error(nsLogInterface* pInterface, const nsFormatString& string)
   LOG_LEVEL_FILTER(nsLogMsgType::ErrorMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::ErrorMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::ErrorMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 void nsLog::SeriousWarning(nsLogInterface* pInterface, const nsFormatString& string)
@@ -377,7 +387,7 @@ void nsLog::SeriousWarning(nsLogInterface* pInterface, const nsFormatString& str
   LOG_LEVEL_FILTER(nsLogMsgType::SeriousWarningMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::SeriousWarningMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::SeriousWarningMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 void nsLog::Warning(nsLogInterface* pInterface, const nsFormatString& string)
@@ -385,7 +395,7 @@ void nsLog::Warning(nsLogInterface* pInterface, const nsFormatString& string)
   LOG_LEVEL_FILTER(nsLogMsgType::WarningMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::WarningMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::WarningMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 void nsLog::Success(nsLogInterface* pInterface, const nsFormatString& string)
@@ -393,7 +403,7 @@ void nsLog::Success(nsLogInterface* pInterface, const nsFormatString& string)
   LOG_LEVEL_FILTER(nsLogMsgType::SuccessMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::SuccessMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::SuccessMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 void nsLog::Info(nsLogInterface* pInterface, const nsFormatString& string)
@@ -401,7 +411,7 @@ void nsLog::Info(nsLogInterface* pInterface, const nsFormatString& string)
   LOG_LEVEL_FILTER(nsLogMsgType::InfoMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::InfoMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::InfoMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 #if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
@@ -411,7 +421,7 @@ void nsLog::Dev(nsLogInterface* pInterface, const nsFormatString& string)
   LOG_LEVEL_FILTER(nsLogMsgType::DevMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::DevMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::DevMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 #endif
@@ -423,7 +433,7 @@ void nsLog::Debug(nsLogInterface* pInterface, const nsFormatString& string)
   LOG_LEVEL_FILTER(nsLogMsgType::DebugMsg);
 
   nsStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, nsLogMsgType::DebugMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, nsLogMsgType::DebugMsg, string.GetText(tmp), string.GetFormatString());
 }
 
 #endif
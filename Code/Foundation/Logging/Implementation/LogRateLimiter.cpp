@@ -0,0 +1,239 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Logging/LogRateLimiter.h>
+
+nsLogRateLimiter::nsLogRateLimiter()
+{
+  m_LastSummary = nsTime::Now();
+}
+
+nsLogRateLimiter::~nsLogRateLimiter()
+{
+  EmitSummaries();
+}
+
+nsEventSubscriptionID nsLogRateLimiter::AddLogWriter(nsLoggingEvent::Handler handler)
+{
+  if (m_Output.HasEventHandler(handler))
+    return 0;
+
+  return m_Output.AddEventHandler(handler);
+}
+
+void nsLogRateLimiter::RemoveLogWriter(nsLoggingEvent::Handler handler)
+{
+  if (!m_Output.HasEventHandler(handler))
+    return;
+
+  m_Output.RemoveEventHandler(handler);
+}
+
+void nsLogRateLimiter::SetDeduplicationWindow(nsTime window)
+{
+  NS_LOCK(m_Mutex);
+  m_DeduplicationWindow = window;
+}
+
+void nsLogRateLimiter::SetRateLimit(double fMessagesPerSecond, nsUInt32 uiBurstSize)
+{
+  NS_LOCK(m_Mutex);
+  m_fMessagesPerSecond = fMessagesPerSecond;
+  m_fBurstSize = nsMath::Max(1.0, static_cast<double>(uiBurstSize));
+  m_Buckets.Clear();
+}
+
+void nsLogRateLimiter::SetSummaryInterval(nsTime interval)
+{
+  NS_LOCK(m_Mutex);
+  m_SummaryInterval = interval;
+}
+
+void nsLogRateLimiter::SetFilterErrors(bool bFilter)
+{
+  NS_LOCK(m_Mutex);
+  m_bFilterErrors = bFilter;
+}
+
+nsUInt64 nsLogRateLimiter::GetNumSuppressedMessages() const
+{
+  NS_LOCK(m_Mutex);
+  return m_uiNumSuppressed;
+}
+
+void nsLogRateLimiter::LogMessageHandler(const nsLoggingEventData& eventData)
+{
+  if (eventData.m_EventType == nsLogMsgType::Flush)
+  {
+    EmitSummaries();
+    m_Output.Broadcast(eventData);
+    return;
+  }
+
+  if (eventData.m_EventType <= nsLogMsgType::None)
+  {
+    m_Output.Broadcast(eventData);
+    return;
+  }
+
+  const nsTime now = nsTime::Now();
+  bool bPassOn = true;
+  bool bEmitSummaries = false;
+
+  {
+    NS_LOCK(m_Mutex);
+
+    if (eventData.m_EventType != nsLogMsgType::ErrorMsg || m_bFilterErrors)
+    {
+      bPassOn = FilterMessage(eventData, now);
+    }
+
+    bEmitSummaries = now - m_LastSummary >= m_SummaryInterval;
+  }
+
+  // the summaries of the previous interval are reported before the message that ends it
+  if (bEmitSummaries)
+  {
+    EmitSummaries(now);
+  }
+
+  if (bPassOn)
+  {
+    m_Output.Broadcast(eventData);
+  }
+}
+
+bool nsLogRateLimiter::FilterMessage(const nsLoggingEventData& eventData, nsTime now)
+{
+  const nsUInt64 uiTypeAndTagHash = nsHashingUtils::StringHash(eventData.m_sTag, static_cast<nsUInt64>(eventData.m_EventType));
+
+  if (m_DeduplicationWindow.IsPositive())
+  {
+    // messages from the same code share the format string, no matter which arguments they insert
+    const nsStringView sIdentity = eventData.m_sFormat.IsEmpty() ? eventData.m_sText : eventData.m_sFormat;
+    const nsUInt64 uiKey = nsHashingUtils::StringHash(sIdentity, uiTypeAndTagHash);
+
+    bool bExisted = false;
+    Repeat& repeat = m_Repeats.FindOrAdd(uiKey, &bExisted);
+
+    if (bExisted && now - repeat.m_WindowStart < m_DeduplicationWindow)
+    {
+      if (repeat.m_uiSuppressed == 0)
+      {
+        repeat.m_Type = eventData.m_EventType;
+        repeat.m_sTag = eventData.m_sTag;
+        repeat.m_sExample = eventData.m_sText;
+      }
+
+      ++repeat.m_uiSuppressed;
+      ++m_uiNumSuppressed;
+      return false;
+    }
+
+    repeat.m_WindowStart = now;
+  }
+
+  if (m_fMessagesPerSecond > 0.0)
+  {
+    bool bExisted = false;
+    Bucket& bucket = m_Buckets.FindOrAdd(uiTypeAndTagHash, &bExisted);
+
+    if (!bExisted)
+    {
+      bucket.m_fTokens = m_fBurstSize;
+      bucket.m_Type = eventData.m_EventType;
+      bucket.m_sTag = eventData.m_sTag;
+    }
+    else
+    {
+      bucket.m_fTokens = nsMath::Min(m_fBurstSize, bucket.m_fTokens + (now - bucket.m_LastRefill).GetSeconds() * m_fMessagesPerSecond);
+    }
+
+    bucket.m_LastRefill = now;
+
+    if (bucket.m_fTokens < 1.0)
+    {
+      ++bucket.m_uiSuppressed;
+      ++m_uiNumSuppressed;
+      return false;
+    }
+
+    bucket.m_fTokens -= 1.0;
+  }
+
+  return true;
+}
+
+void nsLogRateLimiter::EmitSummaries()
+{
+  EmitSummaries(nsTime::Now());
+}
+
+void nsLogRateLimiter::EmitSummaries(nsTime now)
+{
+  nsHybridArray<Summary, 8> summaries;
+  nsStringBuilder sText;
+
+  {
+    NS_LOCK(m_Mutex);
+
+    m_LastSummary = now;
+
+    for (auto it = m_Repeats.GetIterator(); it.IsValid();)
+    {
+      Repeat& repeat = it.Value();
+
+      if (repeat.m_uiSuppressed > 0)
+      {
+        Summary& summary = summaries.ExpandAndGetRef();
+        summary.m_Type = repeat.m_Type;
+        summary.m_sTag = repeat.m_sTag;
+        sText.Format("Suppressed {} repeats of: {}", repeat.m_uiSuppressed, repeat.m_sExample);
+        summary.m_sText = sText;
+
+        repeat.m_uiSuppressed = 0;
+        repeat.m_sExample.Clear();
+      }
+
+      // forget about messages that stopped repeating, to not grow forever
+      if (now - repeat.m_WindowStart >= m_DeduplicationWindow)
+        it = m_Repeats.Remove(it);
+      else
+        ++it;
+    }
+
+    for (auto it = m_Buckets.GetIterator(); it.IsValid(); ++it)
+    {
+      Bucket& bucket = it.Value();
+
+      if (bucket.m_uiSuppressed > 0)
+      {
+        Summary& summary = summaries.ExpandAndGetRef();
+        summary.m_Type = bucket.m_Type;
+        summary.m_sTag = bucket.m_sTag;
+        sText.Format("Suppressed {} messages that exceeded the rate limit", bucket.m_uiSuppressed);
+        summary.m_sText = sText;
+
+        bucket.m_uiSuppressed = 0;
+      }
+    }
+  }
+
+  // pass the summaries on outside the lock, log writers may log themselves
+  for (const Summary& summary : summaries)
+  {
+    nsLoggingEventData le;
+    le.m_EventType = summary.m_Type;
+    le.m_sTag = summary.m_sTag;
+    le.m_sText = summary.m_sText;
+
+    m_Output.Broadcast(le);
+  }
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_LogRateLimiter);
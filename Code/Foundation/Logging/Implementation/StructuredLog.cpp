@@ -0,0 +1,388 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Logging/LogEntry.h>
+#include <Foundation/Logging/StructuredLog.h>
+
+nsStructuredLogWriter* nsStructuredLog::s_pWriter = nullptr;
+
+namespace
+{
+  constexpr nsUInt32 s_uiStructuredLogMagic = 0x474C534E; // "NSLG"
+  constexpr nsUInt8 s_uiStructuredLogVersion = 1;
+
+  struct nsStructuredLogRecord
+  {
+    enum Enum : nsUInt8
+    {
+      FormatDefinition = 1,
+      Message = 2,
+    };
+  };
+
+  /// \brief Splits off a "[Tag]" at the start of the format string, following the same rules as nsLog::BroadcastLoggingEvent().
+  nsStringView SplitTag(nsStringView sFormat, nsStringView& out_sTag)
+  {
+    out_sTag = {};
+
+    if (!sFormat.StartsWith("["))
+      return sFormat;
+
+    const char* szTagStart = sFormat.GetStartPointer() + 1;
+    const char* szTagEnd = szTagStart;
+
+    while (szTagEnd < sFormat.GetEndPointer() && *szTagEnd != '[' && *szTagEnd != ']' && *szTagEnd != ' ' && szTagEnd - szTagStart < 31)
+    {
+      ++szTagEnd;
+    }
+
+    if (szTagEnd == sFormat.GetEndPointer() || *szTagEnd != ']')
+      return sFormat;
+
+    out_sTag = nsStringView(szTagStart, szTagEnd);
+    return nsStringView(szTagEnd + 1, sFormat.GetEndPointer());
+  }
+
+  template <typename T>
+  nsResult ReadValue(nsStreamReader& inout_stream, T& out_value)
+  {
+    return inout_stream.ReadBytes(&out_value, sizeof(T)) == sizeof(T) ? NS_SUCCESS : NS_FAILURE;
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+nsStructuredLogWriter::nsStructuredLogWriter() = default;
+
+nsStructuredLogWriter::~nsStructuredLogWriter()
+{
+  EndLog();
+}
+
+nsResult nsStructuredLogWriter::BeginLog(nsStringView sFile)
+{
+  EndLog();
+
+  if (m_File.Open(sFile, 1024 * 64, nsFileShareMode::SharedReads).Failed())
+  {
+    nsLog::Error("Could not open structured log file '{}'.", sFile);
+    return NS_FAILURE;
+  }
+
+  BeginLog(m_File);
+  return NS_SUCCESS;
+}
+
+void nsStructuredLogWriter::BeginLog(nsStreamWriter& ref_stream)
+{
+  NS_LOCK(m_Mutex);
+
+  NS_ASSERT_DEV(m_pStream == nullptr, "EndLog() has to be called before a new log can be started.");
+
+  m_pStream = &ref_stream;
+  m_Formats.Clear();
+
+  *m_pStream << s_uiStructuredLogMagic;
+  *m_pStream << s_uiStructuredLogVersion;
+}
+
+void nsStructuredLogWriter::EndLog()
+{
+  NS_LOCK(m_Mutex);
+
+  if (m_pStream == nullptr)
+    return;
+
+  m_pStream->Flush().IgnoreResult();
+  m_pStream = nullptr;
+  m_Formats.Clear();
+
+  m_File.Close();
+}
+
+void nsStructuredLogWriter::SetTagEnabled(nsStringView sTag, bool bEnabled)
+{
+  NS_LOCK(m_Mutex);
+
+  if (bEnabled)
+    m_DisabledTags.Remove(sTag);
+  else
+    m_DisabledTags.Insert(sTag);
+
+  for (auto it = m_Formats.GetIterator(); it.IsValid(); ++it)
+  {
+    if (it.Value().m_sTag == sTag)
+    {
+      it.Value().m_bEnabled = bEnabled;
+    }
+  }
+}
+
+bool nsStructuredLogWriter::FilterMessage(nsLogMsgType::Enum type, const char* szFormat, nsUInt32& out_uiFormatID)
+{
+  const nsLogMsgType::Enum logLevel = m_LogLevel == nsLogMsgType::GlobalDefault ? nsLog::GetDefaultLogLevel() : m_LogLevel;
+  if (logLevel < type)
+    return false;
+
+  NS_LOCK(m_Mutex);
+
+  if (m_pStream == nullptr)
+    return false;
+
+  bool bExisted = false;
+  FormatInfo& info = m_Formats.FindOrAdd(szFormat, &bExisted);
+
+  if (!bExisted)
+  {
+    nsStringView sTag;
+    const nsStringView sText = SplitTag(szFormat, sTag);
+
+    info.m_uiID = m_Formats.GetCount() - 1;
+    info.m_sTag = sTag;
+    info.m_bEnabled = !m_DisabledTags.Contains(info.m_sTag);
+
+    // the format is written even if the tag is disabled, to keep the IDs in the file sequential
+    *m_pStream << static_cast<nsUInt8>(nsStructuredLogRecord::FormatDefinition);
+    *m_pStream << info.m_uiID;
+    m_pStream->WriteString(sTag).IgnoreResult();
+    m_pStream->WriteString(sText).IgnoreResult();
+  }
+
+  out_uiFormatID = info.m_uiID;
+  return info.m_bEnabled;
+}
+
+void nsStructuredLogWriter::WriteMessage(nsLogMsgType::Enum type, nsUInt32 uiFormatID, const nsStructuredLogArguments& args)
+{
+  const double fSeconds = nsTime::Now().GetSeconds();
+
+  NS_LOCK(m_Mutex);
+
+  if (m_pStream == nullptr)
+    return;
+
+  *m_pStream << static_cast<nsUInt8>(nsStructuredLogRecord::Message);
+  *m_pStream << uiFormatID;
+  *m_pStream << static_cast<nsInt8>(type);
+  *m_pStream << fSeconds;
+  *m_pStream << args.GetNumArguments();
+  m_pStream->WriteBytes(args.GetData().GetPtr(), args.GetData().GetCount()).IgnoreResult();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+nsResult nsStructuredLogReader::Open(nsStreamReader& ref_stream)
+{
+  m_pStream = &ref_stream;
+  m_Formats.Clear();
+
+  nsUInt32 uiMagic = 0;
+  nsUInt8 uiVersion = 0;
+  NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiMagic));
+  NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiVersion));
+
+  if (uiMagic != s_uiStructuredLogMagic || uiVersion > s_uiStructuredLogVersion)
+  {
+    m_pStream = nullptr;
+    return NS_FAILURE;
+  }
+
+  return NS_SUCCESS;
+}
+
+nsResult nsStructuredLogReader::ReadNextEntry(nsLogEntry& out_entry)
+{
+  if (m_pStream == nullptr)
+    return NS_FAILURE;
+
+  while (true)
+  {
+    nsUInt8 uiRecord = 0;
+    NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiRecord));
+
+    if (uiRecord == nsStructuredLogRecord::FormatDefinition)
+    {
+      nsUInt32 uiFormatID = 0;
+      NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiFormatID));
+
+      if (uiFormatID != m_Formats.GetCount())
+        return NS_FAILURE;
+
+      Format& format = m_Formats.ExpandAndGetRef();
+      NS_SUCCEED_OR_RETURN(m_pStream->ReadString(format.m_sTag));
+      NS_SUCCEED_OR_RETURN(m_pStream->ReadString(format.m_sFormat));
+      continue;
+    }
+
+    if (uiRecord != nsStructuredLogRecord::Message)
+      return NS_FAILURE;
+
+    nsUInt32 uiFormatID = 0;
+    nsInt8 iType = 0;
+    double fSeconds = 0;
+    nsUInt8 uiNumArgs = 0;
+    NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiFormatID));
+    NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, iType));
+    NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, fSeconds));
+    NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiNumArgs));
+
+    if (uiFormatID >= m_Formats.GetCount())
+      return NS_FAILURE;
+
+    nsHybridArray<nsString, 16> arguments;
+    nsHybridArray<nsStringView, 16> argumentViews;
+    arguments.SetCount(uiNumArgs);
+    argumentViews.SetCount(uiNumArgs);
+
+    for (nsUInt32 i = 0; i < uiNumArgs; ++i)
+    {
+      NS_SUCCEED_OR_RETURN(ReadArgument(arguments[i]));
+      argumentViews[i] = arguments[i];
+    }
+
+    const Format& format = m_Formats[uiFormatID];
+
+    nsStringBuilder sText;
+    out_entry.m_sMsg = nsFormatString(format.m_sFormat.GetView()).BuildFormattedText(sText, argumentViews.GetData(), uiNumArgs);
+    out_entry.m_sTag = format.m_sTag;
+    out_entry.m_Type = static_cast<nsLogMsgType::Enum>(iType);
+    out_entry.m_uiIndentation = 0;
+    out_entry.m_fSeconds = fSeconds;
+    return NS_SUCCESS;
+  }
+}
+
+void nsStructuredLogReader::ReplayInto(nsLogInterface* pInterface)
+{
+  nsLogEntry entry;
+
+  while (ReadNextEntry(entry).Succeeded())
+  {
+    nsLoggingEventData le;
+    le.m_EventType = entry.m_Type;
+    le.m_sText = entry.m_sMsg;
+    le.m_sTag = entry.m_sTag;
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+    le.m_fSeconds = entry.m_fSeconds;
+#endif
+
+    pInterface->HandleLogMessage(le);
+  }
+}
+
+nsResult nsStructuredLogReader::ReadArgument(nsString& out_sText)
+{
+  nsUInt8 uiType = 0;
+  NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiType));
+
+  // the same BuildString() overloads as for regular formatting, so that the text is identical
+  char szTmp[64];
+
+  switch (uiType)
+  {
+    case nsStructuredLogArgType::Int:
+    {
+      nsInt64 iValue = 0;
+      NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, iValue));
+      out_sText = BuildString(szTmp, NS_ARRAY_SIZE(szTmp) - 1, iValue);
+      return NS_SUCCESS;
+    }
+
+    case nsStructuredLogArgType::UInt:
+    {
+      nsUInt64 uiValue = 0;
+      NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiValue));
+      out_sText = BuildString(szTmp, NS_ARRAY_SIZE(szTmp) - 1, uiValue);
+      return NS_SUCCESS;
+    }
+
+    case nsStructuredLogArgType::Double:
+    {
+      double fValue = 0;
+      NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, fValue));
+      out_sText = BuildString(szTmp, NS_ARRAY_SIZE(szTmp) - 1, fValue);
+      return NS_SUCCESS;
+    }
+
+    case nsStructuredLogArgType::Bool:
+    {
+      nsUInt8 uiValue = 0;
+      NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiValue));
+      out_sText = BuildString(szTmp, NS_ARRAY_SIZE(szTmp) - 1, uiValue != 0);
+      return NS_SUCCESS;
+    }
+
+    case nsStructuredLogArgType::String:
+    {
+      nsUInt32 uiLength = 0;
+      NS_SUCCEED_OR_RETURN(ReadValue(*m_pStream, uiLength));
+
+      // a generic stream can't tell how many bytes are left, so the text is read in chunks,
+      // to not allocate whatever a corrupted length asks for before the end of the stream is hit
+      nsHybridArray<char, 256> text;
+
+      while (text.GetCount() < uiLength)
+      {
+        const nsUInt32 uiOffset = text.GetCount();
+        const nsUInt32 uiChunkSize = nsMath::Min<nsUInt32>(uiLength - uiOffset, 4096);
+        text.SetCountUninitialized(uiOffset + uiChunkSize);
+
+        if (m_pStream->ReadBytes(text.GetData() + uiOffset, uiChunkSize) != uiChunkSize)
+          return NS_FAILURE;
+      }
+
+      out_sText = nsStringView(text.GetData(), uiLength);
+      return NS_SUCCESS;
+    }
+
+    default:
+      return NS_FAILURE;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void nsStructuredLog::SetWriter(nsStructuredLogWriter* pWriter)
+{
+  s_pWriter = pWriter;
+}
+
+void nsStructuredLog::LogText(nsLogMsgType::Enum type, const nsFormatString& text)
+{
+  nsLogInterface* pInterface = nsLog::GetThreadLocalLogSystem();
+
+  switch (type)
+  {
+    case nsLogMsgType::ErrorMsg:
+      nsLog::Error(pInterface, text);
+      break;
+    case nsLogMsgType::SeriousWarningMsg:
+      nsLog::SeriousWarning(pInterface, text);
+      break;
+    case nsLogMsgType::WarningMsg:
+      nsLog::Warning(pInterface, text);
+      break;
+    case nsLogMsgType::SuccessMsg:
+      nsLog::Success(pInterface, text);
+      break;
+    case nsLogMsgType::InfoMsg:
+      nsLog::Info(pInterface, text);
+      break;
+    case nsLogMsgType::DevMsg:
+      nsLog::Dev(pInterface, text);
+      break;
+    case nsLogMsgType::DebugMsg:
+      nsLog::Debug(pInterface, text);
+      break;
+
+    default:
+      NS_REPORT_FAILURE("Invalid log message type {}", (int)type);
+      break;
+  }
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_StructuredLog);
@@ -0,0 +1,103 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <type_traits>
+
+template <typename T>
+void nsStructuredLogArguments::Add(const T& value)
+{
+  using Type = std::decay_t<T>;
+
+  if constexpr (std::is_same_v<Type, bool>)
+  {
+    AddBool(value);
+  }
+  else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+  {
+    AddInt(static_cast<nsInt64>(value));
+  }
+  else if constexpr (std::is_integral_v<Type>)
+  {
+    AddUInt(static_cast<nsUInt64>(value));
+  }
+  else if constexpr (std::is_floating_point_v<Type>)
+  {
+    AddDouble(static_cast<double>(value));
+  }
+  else if constexpr (std::is_convertible_v<const T&, nsStringView>)
+  {
+    AddString(nsStringView(value));
+  }
+  else
+  {
+    char szTmp[64];
+    AddString(BuildString(szTmp, NS_ARRAY_SIZE(szTmp) - 1, value));
+  }
+}
+
+inline void nsStructuredLogArguments::AddInt(nsInt64 iValue)
+{
+  AddRaw(nsStructuredLogArgType::Int, &iValue, sizeof(iValue));
+}
+
+inline void nsStructuredLogArguments::AddUInt(nsUInt64 uiValue)
+{
+  AddRaw(nsStructuredLogArgType::UInt, &uiValue, sizeof(uiValue));
+}
+
+inline void nsStructuredLogArguments::AddDouble(double fValue)
+{
+  AddRaw(nsStructuredLogArgType::Double, &fValue, sizeof(fValue));
+}
+
+inline void nsStructuredLogArguments::AddBool(bool bValue)
+{
+  const nsUInt8 uiValue = bValue ? 1 : 0;
+  AddRaw(nsStructuredLogArgType::Bool, &uiValue, sizeof(uiValue));
+}
+
+inline void nsStructuredLogArguments::AddString(nsStringView sValue)
+{
+  const nsUInt32 uiLength = sValue.GetElementCount();
+  AddRaw(nsStructuredLogArgType::String, &uiLength, sizeof(uiLength));
+
+  const nsUInt32 uiOffset = m_Data.GetCount();
+  m_Data.SetCountUninitialized(uiOffset + uiLength);
+  nsMemoryUtils::Copy(m_Data.GetData() + uiOffset, reinterpret_cast<const nsUInt8*>(sValue.GetStartPointer()), uiLength);
+}
+
+inline void nsStructuredLogArguments::AddRaw(nsStructuredLogArgType::Enum type, const void* pData, nsUInt32 uiSize)
+{
+  NS_ASSERT_DEV(m_uiNumArguments < 255, "Too many arguments for a structured log message");
+  ++m_uiNumArguments;
+
+  const nsUInt32 uiOffset = m_Data.GetCount();
+  m_Data.SetCountUninitialized(uiOffset + 1 + uiSize);
+  m_Data[uiOffset] = type;
+  nsMemoryUtils::Copy(m_Data.GetData() + uiOffset + 1, static_cast<const nsUInt8*>(pData), uiSize);
+}
+
+template <typename... ARGS>
+void nsStructuredLog::Log(nsLogMsgType::Enum type, const char* szFormat, ARGS&&... args)
+{
+  nsStructuredLogWriter* pWriter = s_pWriter;
+
+  if (pWriter == nullptr)
+  {
+    LogText(type, nsFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...));
+    return;
+  }
+
+  nsUInt32 uiFormatID = 0;
+  if (!pWriter->FilterMessage(type, szFormat, uiFormatID))
+    return;
+
+  nsStructuredLogArguments arguments;
+  (arguments.Add(args), ...);
+
+  pWriter->WriteMessage(type, uiFormatID, arguments);
+}
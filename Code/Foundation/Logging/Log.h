@@ -66,6 +66,11 @@ struct NS_FOUNDATION_DLL nsLoggingEventData
   /// additional configuration, or simply be ignored.
   nsStringView m_sTag;
 
+  /// \brief The format string that m_sText was created from, before the arguments were inserted. Empty, if not known.
+  ///
+  /// Messages from the same place in code share the format string, which allows log writers to group them, see nsLogRateLimiter.
+  nsStringView m_sFormat;
+
 #if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
   /// \brief Used by log-blocks for profiling the duration of the block
   double m_fSeconds = 0;
@@ -74,6 +79,17 @@ struct NS_FOUNDATION_DLL nsLoggingEventData
 
 using nsLoggingEvent = nsEvent<const nsLoggingEventData&, nsMutex>;
 
+/// \brief Describes what happens in nsGlobalLog's async mode, when a thread logs faster than the messages can be dispatched.
+struct nsLogOverflowPolicy
+{
+  enum Enum : nsUInt8
+  {
+    Block,         ///< The logging thread waits until there is enough space in its queue again. No message is lost.
+    Drop,          ///< The message is discarded and only counted, see nsGlobalLog::GetNumDroppedMessages().
+    DropAndReport, ///< Like Drop, but additionally a warning with the number of dropped messages is logged, once the queue drained.
+  };
+};
+
 /// \brief Base class for all logging classes.
 ///
 /// You can derive from this class to create your own logging system,
@@ -144,7 +160,41 @@ public:
   /// override is set at the moment.
   static void SetGlobalLogOverride(nsLogInterface* pInterface);
 
+  /// \brief Switches nsGlobalLog to asynchronous dispatch.
+  ///
+  /// In async mode a log call does not run the log writers on the calling thread. Instead the message is copied into a lock-free ring
+  /// buffer that belongs to the calling thread, and a background thread dispatches the messages of all threads to the log writers,
+  /// in the order in which they were logged. This way threads don't stall on the event mutex or on slow writers (e.g. file I/O).
+  ///
+  /// \param uiQueueSizePerThread Size in bytes of the ring buffer of each logging thread. Rounded up to a power of two.
+  ///   Messages longer than half of this are truncated.
+  /// \param overflowPolicy What to do when a thread's ring buffer is full.
+  ///
+  /// Error messages are always flushed synchronously, i.e. once nsLog::Error() returns, all writers have seen the error and all
+  /// messages before it. The crash handler flushes the queues as well.
+  ///
+  /// \note Log writers are executed on the background thread in this mode, so they must not rely on running on the logging thread.
+  /// Enabling and disabling async mode must not happen while other threads are logging, typically it is done during startup and shutdown.
+  static void EnableAsyncMode(nsUInt32 uiQueueSizePerThread = 64 * 1024, nsLogOverflowPolicy::Enum overflowPolicy = nsLogOverflowPolicy::Block);
+
+  /// \brief Dispatches all queued messages and switches back to synchronous dispatch.
+  static void DisableAsyncMode();
+
+  /// \brief Whether EnableAsyncMode() is active.
+  static bool IsAsyncModeEnabled();
+
+  /// \brief In async mode, dispatches all messages that were logged so far, on the calling thread. Does nothing in synchronous mode.
+  static void FlushAsyncMessages();
+
+  /// \brief Returns how many messages were dropped in async mode, due to nsLogOverflowPolicy::Drop or DropAndReport.
+  static nsUInt64 GetNumDroppedMessages();
+
 private:
+  /// \brief Copies the message into the calling thread's queue. Returns false, if the message has to be dispatched synchronously.
+  static bool EnqueueAsyncMessage(const nsLoggingEventData& le);
+
+  friend class nsAsyncLogThread;
+
   /// \brief Counts the number of messages of each type.
   static nsAtomicInteger32 s_uiMessageCount[nsLogMsgType::ENUM_COUNT];
 
@@ -203,6 +253,13 @@ public:
     Error(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of Error() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void Error(const FORMAT& string)
+  {
+    Error(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief Not an error, but definitely a big problem, that should be looked into very soon.
   static void SeriousWarning(nsLogInterface* pInterface, const nsFormatString& string);
 
@@ -220,6 +277,13 @@ public:
     SeriousWarning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of SeriousWarning() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void SeriousWarning(const FORMAT& string)
+  {
+    SeriousWarning(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief A potential problem or a performance warning. Might be possible to ignore it.
   static void Warning(nsLogInterface* pInterface, const nsFormatString& string);
 
@@ -237,6 +301,13 @@ public:
     Warning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of Warning() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void Warning(const FORMAT& string)
+  {
+    Warning(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief Status information that something was completed successfully.
   static void Success(nsLogInterface* pInterface, const nsFormatString& string);
 
@@ -254,6 +325,13 @@ public:
     Success(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of Success() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void Success(const FORMAT& string)
+  {
+    Success(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief Status information that is important.
   static void Info(nsLogInterface* pInterface, const nsFormatString& string);
 
@@ -271,6 +349,13 @@ public:
     Info(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of Info() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void Info(const FORMAT& string)
+  {
+    Info(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief Status information that is nice to have during development.
   ///
   /// This function is compiled out in non-development builds.
@@ -292,6 +377,13 @@ public:
     Dev(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of Dev() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void Dev(const FORMAT& string)
+  {
+    Dev(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief Status information during debugging. Very verbose. Usually only temporarily added to the code.
   ///
   /// This function is compiled out in non-debug builds.
@@ -313,6 +405,13 @@ public:
     Debug(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of Debug() for already built format strings, e.g. from NS_FMT or nsFmt.
+  template <typename FORMAT, typename std::enable_if_t<std::is_base_of<nsFormatString, FORMAT>::value, int> = 0>
+  static void Debug(const FORMAT& string)
+  {
+    Debug(GetThreadLocalLogSystem(), string);
+  }
+
   /// \brief Instructs log writers to flush their caches, to ensure all log output (even non-critical information) is written.
   ///
   /// On some log writers this has no effect.
@@ -333,7 +432,9 @@ public:
 
   /// \brief Usually called internally by the other log functions, but can be called directly, if the message type is already known.
   /// pInterface must be != nullptr.
-  static void BroadcastLoggingEvent(nsLogInterface* pInterface, nsLogMsgType::Enum type, nsStringView sString);
+  ///
+  /// \a sFormat is the unformatted string that \a sString was created from, see nsLoggingEventData::m_sFormat.
+  static void BroadcastLoggingEvent(nsLogInterface* pInterface, nsLogMsgType::Enum type, nsStringView sString, nsStringView sFormat = {});
 
   /// \brief Calls low-level OS functionality to print a string to the typical outputs, e.g. printf and OutputDebugString.
   ///
@@ -0,0 +1,104 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief A filter stage between nsGlobalLog and the log writers, that keeps log storms from flooding the output.
+///
+/// Register the LogMessageHandler of an instance with nsGlobalLog::AddLogWriter() and register the actual log writers
+/// at the instance itself, through AddLogWriter().
+///
+/// Two filters are applied to every message:
+///   * Deduplication: After a message was passed on, further messages of the same type, tag and format string
+///     (see nsLoggingEventData::m_sFormat) are suppressed for the duration of the deduplication window.
+///     This catches the same warning being logged by many objects, even if each one inserts different arguments.
+///   * Rate limiting: Each combination of tag and message type has a token bucket, which allows short bursts,
+///     but limits how many messages per second are passed on in the long run.
+///
+/// The number of suppressed messages is reported in regular intervals, when the log is flushed and when the limiter is destroyed.
+/// Group begin and end events are always passed on, errors only unless SetFilterErrors() is enabled.
+class NS_FOUNDATION_DLL nsLogRateLimiter
+{
+public:
+  nsLogRateLimiter();
+  ~nsLogRateLimiter();
+
+  /// \brief Register this at nsGlobalLog::AddLogWriter(), to filter all messages of the global log.
+  void LogMessageHandler(const nsLoggingEventData& eventData);
+
+  /// \brief Registers a log writer that receives all messages that pass the filter, plus the summaries of suppressed messages.
+  nsEventSubscriptionID AddLogWriter(nsLoggingEvent::Handler handler);
+
+  /// \brief Unregisters a previously registered log writer.
+  void RemoveLogWriter(nsLoggingEvent::Handler handler);
+
+  /// \brief For how long repeats of a message are suppressed, after it was passed on. Zero disables deduplication. Default is one second.
+  void SetDeduplicationWindow(nsTime window);
+
+  /// \brief How many messages per second are passed on for each tag and message type, and how many may arrive in a burst.
+  ///
+  /// Setting fMessagesPerSecond to zero disables rate limiting. Defaults are 20 messages per second with bursts of up to 100 messages.
+  void SetRateLimit(double fMessagesPerSecond, nsUInt32 uiBurstSize);
+
+  /// \brief How often the numbers of suppressed messages are reported. Default is five seconds.
+  void SetSummaryInterval(nsTime interval);
+
+  /// \brief Whether errors are filtered as well. Off by default, so that no error is ever lost.
+  void SetFilterErrors(bool bFilter);
+
+  /// \brief Passes on messages that report how many messages were suppressed since the last summary.
+  void EmitSummaries();
+
+  /// \brief Returns how many messages were suppressed in total.
+  nsUInt64 GetNumSuppressedMessages() const;
+
+private:
+  struct Repeat
+  {
+    nsTime m_WindowStart;
+    nsUInt32 m_uiSuppressed = 0;
+    nsLogMsgType::Enum m_Type = nsLogMsgType::None;
+    nsString m_sTag;
+    nsString m_sExample;
+  };
+
+  struct Bucket
+  {
+    double m_fTokens = 0;
+    nsTime m_LastRefill;
+    nsUInt32 m_uiSuppressed = 0;
+    nsLogMsgType::Enum m_Type = nsLogMsgType::None;
+    nsString m_sTag;
+  };
+
+  struct Summary
+  {
+    nsLogMsgType::Enum m_Type;
+    nsString m_sTag;
+    nsString m_sText;
+  };
+
+  bool FilterMessage(const nsLoggingEventData& eventData, nsTime now);
+  void EmitSummaries(nsTime now);
+
+  mutable nsMutex m_Mutex;
+  nsLoggingEvent m_Output;
+
+  nsTime m_DeduplicationWindow = nsTime::MakeFromSeconds(1);
+  double m_fMessagesPerSecond = 20.0;
+  double m_fBurstSize = 100.0;
+  nsTime m_SummaryInterval = nsTime::MakeFromSeconds(5);
+  bool m_bFilterErrors = false;
+
+  nsTime m_LastSummary;
+  nsUInt64 m_uiNumSuppressed = 0;
+  nsHashTable<nsUInt64, Repeat> m_Repeats;
+  nsHashTable<nsUInt64, Bucket> m_Buckets;
+};
@@ -0,0 +1,220 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Containers/Set.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Mutex.h>
+
+struct nsLogEntry;
+
+/// \brief The types of argument values that are stored in a structured log.
+struct nsStructuredLogArgType
+{
+  enum Enum : nsUInt8
+  {
+    Int,    ///< Stored as nsInt64.
+    UInt,   ///< Stored as nsUInt64.
+    Double, ///< Stored as double, floats are promoted.
+    Bool,   ///< Stored as one byte.
+    String, ///< Stored as nsUInt32 length followed by the UTF-8 bytes. Also used for all types that have no raw representation.
+  };
+};
+
+/// \brief Collects the raw values of the arguments of a single structured log message.
+///
+/// Integers, floating point values, booleans and strings are stored as they are. All other types are formatted
+/// with their BuildString() overload right away, since their raw memory can't be interpreted later.
+class nsStructuredLogArguments
+{
+public:
+  template <typename T>
+  void Add(const T& value);
+
+  void AddInt(nsInt64 iValue);
+  void AddUInt(nsUInt64 uiValue);
+  void AddDouble(double fValue);
+  void AddBool(bool bValue);
+  void AddString(nsStringView sValue);
+
+  nsUInt8 GetNumArguments() const { return m_uiNumArguments; }
+  nsArrayPtr<const nsUInt8> GetData() const { return m_Data; }
+
+private:
+  void AddRaw(nsStructuredLogArgType::Enum type, const void* pData, nsUInt32 uiSize);
+
+  nsUInt8 m_uiNumArguments = 0;
+  nsHybridArray<nsUInt8, 256> m_Data;
+};
+
+/// \brief Writes log messages in a compact binary format, without formatting them.
+///
+/// Instead of the formatted text, every message stores an ID for its format string and the raw argument values.
+/// Each format string is only written once per log, the first time it is used. Filtering by message type and tag
+/// happens before the arguments are even looked at, so disabled messages are very cheap.
+///
+/// The text can be reconstructed at any later point with nsStructuredLogReader.
+///
+/// Use nsStructuredLog to send messages to the writer.
+class NS_FOUNDATION_DLL nsStructuredLogWriter
+{
+public:
+  nsStructuredLogWriter();
+  ~nsStructuredLogWriter();
+
+  /// \brief Opens the given file and writes all following messages into it.
+  nsResult BeginLog(nsStringView sFile);
+
+  /// \brief Writes all following messages into the given stream. The stream must stay valid until EndLog() is called.
+  void BeginLog(nsStreamWriter& ref_stream);
+
+  /// \brief Flushes the log and closes the file, if one was opened by BeginLog().
+  void EndLog();
+
+  /// \brief Whether BeginLog() was called successfully.
+  bool IsLogging() const { return m_pStream != nullptr; }
+
+  /// \brief Messages with a less important type than this are filtered out.
+  void SetLogLevel(nsLogMsgType::Enum logLevel) { m_LogLevel = logLevel; }
+
+  /// \brief Returns the currently set log level.
+  nsLogMsgType::Enum GetLogLevel() const { return m_LogLevel; }
+
+  /// \brief Disables or re-enables all messages with the given tag, e.g. "Physics" for all messages starting with "[Physics]".
+  void SetTagEnabled(nsStringView sTag, bool bEnabled);
+
+  /// \brief Returns true, if a message of the given type and format would be written to the log.
+  ///
+  /// Registers the format string on first use and returns its ID in out_uiFormatID.
+  bool FilterMessage(nsLogMsgType::Enum type, const char* szFormat, nsUInt32& out_uiFormatID);
+
+  /// \brief Writes a message that passed FilterMessage().
+  void WriteMessage(nsLogMsgType::Enum type, nsUInt32 uiFormatID, const nsStructuredLogArguments& args);
+
+private:
+  struct FormatInfo
+  {
+    nsUInt32 m_uiID = 0;
+    bool m_bEnabled = true;
+    nsString m_sTag;
+  };
+
+  nsMutex m_Mutex;
+  nsLogMsgType::Enum m_LogLevel = nsLogMsgType::All;
+  nsStreamWriter* m_pStream = nullptr;
+  nsFileWriter m_File;
+
+  // keyed by the address of the format string, not its content, to make the lookup cheap
+  nsHashTable<const void*, FormatInfo> m_Formats;
+  nsSet<nsString> m_DisabledTags;
+};
+
+/// \brief Reads a log that was written by nsStructuredLogWriter and turns the messages back into text.
+class NS_FOUNDATION_DLL nsStructuredLogReader
+{
+public:
+  /// \brief Reads and validates the header of the log. The stream must stay valid while messages are read.
+  nsResult Open(nsStreamReader& ref_stream);
+
+  /// \brief Formats the next message. Returns NS_FAILURE at the end of the log or if the data is corrupted.
+  nsResult ReadNextEntry(nsLogEntry& out_entry);
+
+  /// \brief Reads all remaining messages and passes them to the given log interface, e.g. to write them through the regular log writers.
+  void ReplayInto(nsLogInterface* pInterface);
+
+private:
+  struct Format
+  {
+    nsString m_sTag;
+    nsString m_sFormat;
+  };
+
+  nsResult ReadArgument(nsString& out_sText);
+
+  nsStreamReader* m_pStream = nullptr;
+  nsDynamicArray<Format> m_Formats;
+};
+
+/// \brief Logs messages through the structured log writer that is set with SetWriter().
+///
+/// The format string is stored by address, so it must be a string literal (or stay valid for as long as the writer is used).
+/// A tag at the start of the literal, e.g. "[Physics]Body {} woke up", is split off as usual.
+///
+/// Without a writer, the messages are formatted right away and sent to nsLog, so the same code works with both kinds of logging.
+class NS_FOUNDATION_DLL nsStructuredLog
+{
+public:
+  /// \brief Sets the writer that all messages are sent to. Pass nullptr to go back to regular text logging.
+  static void SetWriter(nsStructuredLogWriter* pWriter);
+
+  /// \brief Returns the currently set writer.
+  static nsStructuredLogWriter* GetWriter() { return s_pWriter; }
+
+  template <typename... ARGS>
+  static void Log(nsLogMsgType::Enum type, const char* szFormat, ARGS&&... args);
+
+  template <typename... ARGS>
+  static void Error(const char* szFormat, ARGS&&... args)
+  {
+    Log(nsLogMsgType::ErrorMsg, szFormat, std::forward<ARGS>(args)...);
+  }
+
+  template <typename... ARGS>
+  static void SeriousWarning(const char* szFormat, ARGS&&... args)
+  {
+    Log(nsLogMsgType::SeriousWarningMsg, szFormat, std::forward<ARGS>(args)...);
+  }
+
+  template <typename... ARGS>
+  static void Warning(const char* szFormat, ARGS&&... args)
+  {
+    Log(nsLogMsgType::WarningMsg, szFormat, std::forward<ARGS>(args)...);
+  }
+
+  template <typename... ARGS>
+  static void Success(const char* szFormat, ARGS&&... args)
+  {
+    Log(nsLogMsgType::SuccessMsg, szFormat, std::forward<ARGS>(args)...);
+  }
+
+  template <typename... ARGS>
+  static void Info(const char* szFormat, ARGS&&... args)
+  {
+    Log(nsLogMsgType::InfoMsg, szFormat, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief This function is compiled out in non-development builds.
+  template <typename... ARGS>
+  static void Dev(const char* szFormat, ARGS&&... args)
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+    Log(nsLogMsgType::DevMsg, szFormat, std::forward<ARGS>(args)...);
+#else
+    NS_IGNORE_UNUSED(szFormat);
+#endif
+  }
+
+  /// \brief This function is compiled out in non-debug builds.
+  template <typename... ARGS>
+  static void Debug(const char* szFormat, ARGS&&... args)
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    Log(nsLogMsgType::DebugMsg, szFormat, std::forward<ARGS>(args)...);
+#else
+    NS_IGNORE_UNUSED(szFormat);
+#endif
+  }
+
+private:
+  static void LogText(nsLogMsgType::Enum type, const nsFormatString& text);
+
+  static nsStructuredLogWriter* s_pWriter;
+};
+
+#include <Foundation/Logging/Implementation/StructuredLog_inl.h>
@@ -210,6 +210,25 @@ void nsRTTI::UpdateType(const nsRTTI* pParentType, nsUInt32 uiTypeSize, nsUInt32
   m_uiTypeVersion = uiTypeVersion;
   m_TypeFlags = flags;
   m_ParentHierarchy.Clear();
+
+  // The properties may have changed as well. Derived types have flattened the properties of this type into their own table,
+  // so theirs are outdated, too. The flags are reset under the same lock that SetupPropertyTable() holds while it rebuilds a table.
+  auto pData = GetTypeData();
+  NS_LOCK(pData->m_Mutex);
+
+  m_bPropertyTableBuilt = false;
+
+  for (nsRTTI* pType : pData->m_AllTypes)
+  {
+    for (const nsRTTI* pBase = pType->m_pParentType; pBase != nullptr; pBase = pBase->m_pParentType)
+    {
+      if (pBase == this)
+      {
+        pType->m_bPropertyTableBuilt = false;
+        break;
+      }
+    }
+  }
 }
 
 void nsRTTI::RegisterType()
@@ -293,25 +312,101 @@ const nsRTTI* nsRTTI::FindTypeIf(PredicateFunc func)
 
 const nsAbstractProperty* nsRTTI::FindPropertyByName(nsStringView sName, bool bSearchBaseTypes /* = true */) const
 {
-  const nsRTTI* pInstance = this;
+  const nsUInt32 uiIndex = FindPropertyIndexByName(sName);
+  if (uiIndex == nsInvalidIndex)
+    return nullptr;
+
+  // the properties of this type are at the end of the flattened list
+  if (!bSearchBaseTypes && uiIndex < m_AllProperties.GetCount() - m_Properties.GetCount())
+    return nullptr;
+
+  return m_AllProperties.GetData()[uiIndex];
+}
+
+nsUInt32 nsRTTI::FindPropertyIndexByName(nsStringView sName) const
+{
+  SetupPropertyTable();
+
+  const nsUInt32 uiTableSize = m_PropertyTable.GetCount();
+  if (uiTableSize == 0)
+    return nsInvalidIndex;
+
+  const nsUInt16* pTable = m_PropertyTable.GetData();
+  const nsUInt32 uiMask = uiTableSize - 1;
+
+  for (nsUInt32 uiSlot = static_cast<nsUInt32>(nsHashingUtils::StringHash(sName)) & uiMask;; uiSlot = (uiSlot + 1) & uiMask)
+  {
+    const nsUInt32 uiEntry = pTable[uiSlot];
+    if (uiEntry == 0)
+      return nsInvalidIndex;
+
+    if (m_AllProperties.GetData()[uiEntry - 1]->GetPropertyName() == sName)
+      return uiEntry - 1;
+  }
+}
+
+const nsAbstractProperty* nsRTTI::GetPropertyByIndex(nsUInt32 uiIndex) const
+{
+  SetupPropertyTable();
+
+  NS_ASSERT_DEBUG(uiIndex < m_AllProperties.GetCount(), "Property index {0} is out of range for type '{1}'", uiIndex, m_sTypeName);
+  return m_AllProperties.GetData()[uiIndex];
+}
+
+void nsRTTI::SetupPropertyTable() const
+{
+  if (m_bPropertyTableBuilt)
+    return;
+
+  auto pData = GetTypeData();
+  NS_LOCK(pData->m_Mutex);
 
-  do
+  if (m_bPropertyTableBuilt)
+    return;
+
+  nsHybridArray<const nsRTTI*, 8> hierarchy;
+  for (const nsRTTI* pInstance = this; pInstance != nullptr; pInstance = pInstance->m_pParentType)
   {
-    for (nsUInt32 p = 0; p < pInstance->m_Properties.GetCount(); ++p)
+    hierarchy.PushBack(pInstance);
+  }
+
+  m_AllProperties.Clear();
+  for (nsUInt32 i = hierarchy.GetCount(); i > 0; --i)
+  {
+    for (const nsAbstractProperty* pProp : hierarchy[i - 1]->m_Properties)
     {
-      if (pInstance->m_Properties[p]->GetPropertyName() == sName)
-      {
-        return pInstance->m_Properties[p];
-      }
+      m_AllProperties.PushBack(pProp);
     }
+  }
 
-    if (!bSearchBaseTypes)
-      return nullptr;
+  NS_ASSERT_DEV(m_AllProperties.GetCount() < 0x4000, "Type '{0}' has too many properties", m_sTypeName);
 
-    pInstance = pInstance->m_pParentType;
-  } while (pInstance != nullptr);
+  // keep the table at most half full, so probe sequences stay short
+  const nsUInt32 uiTableSize = m_AllProperties.IsEmpty() ? 0 : nsMath::PowerOfTwo_Ceil(m_AllProperties.GetCount() * 2);
+  m_PropertyTable.Clear();
+  m_PropertyTable.SetCount(static_cast<nsUInt16>(uiTableSize));
 
-  return nullptr;
+  // Insert from the most derived type upwards, so that, just like a linear search through the hierarchy,
+  // a property in a derived type is found before a base type property with the same name.
+  for (nsUInt32 i = m_AllProperties.GetCount(); i > 0; --i)
+  {
+    const nsStringView sName = m_AllProperties[i - 1]->GetPropertyName();
+
+    for (nsUInt32 uiSlot = static_cast<nsUInt32>(nsHashingUtils::StringHash(sName)) & (uiTableSize - 1);; uiSlot = (uiSlot + 1) & (uiTableSize - 1))
+    {
+      const nsUInt16 uiEntry = m_PropertyTable[uiSlot];
+      if (uiEntry == 0)
+      {
+        m_PropertyTable[uiSlot] = static_cast<nsUInt16>(i);
+        break;
+      }
+
+      if (m_AllProperties[uiEntry - 1]->GetPropertyName() == sName)
+        break;
+    }
+  }
+
+  m_bPropertyTableBuilt = true;
 }
 
 bool nsRTTI::DispatchMessage(void* pInstance, nsMessage& ref_msg) const
@@ -10,6 +10,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Configuration/Plugin.h>
 #include <Foundation/Reflection/Implementation/StaticRTTI.h>
+#include <Foundation/Threading/AtomicInteger.h>
 
 // *****************************************
 // ***** Runtime Type Information Data *****
@@ -113,9 +114,20 @@ public:
   /// \brief Searches all nsRTTI instances for one where the given predicate function returns true
   static const nsRTTI* FindTypeIf(PredicateFunc func);
 
-  /// \brief Will iterate over all properties of this type and (optionally) the base types to search for a property with the given name.
+  /// \brief Searches this type and (optionally) the base types for a property with the given name.
+  ///
+  /// The lookup goes through a hash table of all properties including the base types, which is built once per type.
   const nsAbstractProperty* FindPropertyByName(nsStringView sName, bool bSearchBaseTypes = true) const; // [tested]
 
+  /// \brief Returns the index of the property with the given name, including properties of base types, or nsInvalidIndex.
+  ///
+  /// The index refers to the order of GetAllProperties() and stays valid for the lifetime of the type,
+  /// so code that resolves the same property many times can cache it and use GetPropertyByIndex() instead.
+  nsUInt32 FindPropertyIndexByName(nsStringView sName) const; // [tested]
+
+  /// \brief Returns the property at the given index, see FindPropertyIndexByName().
+  const nsAbstractProperty* GetPropertyByIndex(nsUInt32 uiIndex) const; // [tested]
+
   /// \brief Returns the name of the plugin which this type is declared in.
   NS_ALWAYS_INLINE nsStringView GetPluginName() const { return m_sPluginName; } // [tested]
 
@@ -192,6 +204,7 @@ protected:
 
   void GatherDynamicMessageHandlers();
   void SetupParentHierarchy();
+  void SetupPropertyTable() const;
 
   const nsRTTI* m_pParentType = nullptr;
   nsRTTIAllocator* m_pAllocator = nullptr;
@@ -212,6 +225,12 @@ protected:
   nsArrayPtr<nsMessageSenderInfo> m_MessageSenders;
   nsSmallArray<const nsRTTI*, 7, nsStaticAllocatorWrapper> m_ParentHierarchy;
 
+  // All properties including base types in the order of GetAllProperties() and an open addressing table over their name hashes
+  // that stores indices + 1 into m_AllProperties. Built on first use, do not track this data either.
+  mutable nsAtomicBool m_bPropertyTableBuilt;
+  mutable nsSmallArray<const nsAbstractProperty*, 0, nsStaticAllocatorWrapper> m_AllProperties;
+  mutable nsSmallArray<nsUInt16, 0, nsStaticAllocatorWrapper> m_PropertyTable;
+
 private:
   NS_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, Reflection);
 
@@ -50,17 +50,30 @@ public:
   const nsAbstractObjectGraph* GetOwner() const { return m_pOwner; }
   const nsUuid& GetGuid() const { return m_Guid; }
   nsUInt32 GetTypeVersion() const { return m_uiTypeVersion; }
-  void SetTypeVersion(nsUInt32 uiTypeVersion) { m_uiTypeVersion = uiTypeVersion; }
+  void SetTypeVersion(nsUInt32 uiTypeVersion)
+  {
+    m_uiTypeVersion = uiTypeVersion;
+    m_bContentHashValid = false;
+  }
   nsStringView GetType() const { return m_sType; }
   void SetType(nsStringView sType);
 
   const Property* FindProperty(nsStringView sName) const;
+
+  /// \brief Returns the property with the given name for modification. This invalidates the content hash.
   Property* FindProperty(nsStringView sName);
 
   nsStringView GetNodeName() const { return m_sNodeName; }
 
+  /// \brief Returns a hash over the type, type version and all properties of this node. The guid and node name are not included.
+  ///
+  /// The hash does not depend on the order of the properties. It is computed on first use and cached until the node is modified.
+  /// Used by nsAbstractObjectGraph::CreateDiffWithBaseGraph to skip nodes that have not changed.
+  nsUInt64 GetContentHash() const;
+
 private:
   friend class nsAbstractObjectGraph;
+  friend class nsAbstractGraphBinarySerializer;
 
   nsAbstractObjectGraph* m_pOwner = nullptr;
 
@@ -70,6 +83,9 @@ private:
   nsStringView m_sNodeName;
 
   nsHybridArray<Property, 16> m_Properties;
+
+  mutable nsUInt64 m_uiContentHash = 0;
+  mutable bool m_bContentHashValid = false;
 };
 NS_DECLARE_REFLECTABLE_TYPE(NS_FOUNDATION_DLL, nsAbstractObjectNode);
 
@@ -170,6 +186,10 @@ public:
 
   nsAbstractObjectNode* CopyNodeIntoGraph(const nsAbstractObjectNode* pNode, FilterFunction& ref_filter);
 
+  /// \brief Computes the operations that turn \a base into this graph.
+  ///
+  /// Both node maps are walked once in guid order and nodes with the same content hash are skipped,
+  /// so the cost is linear in the node count plus the size of the nodes that actually changed.
   void CreateDiffWithBaseGraph(const nsAbstractObjectGraph& base, nsDeque<nsAbstractGraphDiffOperation>& out_diffResult) const;
 
   void ApplyDiff(nsDeque<nsAbstractGraphDiffOperation>& ref_diff);
@@ -14,8 +14,14 @@
 class NS_FOUNDATION_DLL nsAbstractGraphBinarySerializer
 {
 public:
+  /// \brief Writes the graph and optionally a types graph to the stream.
+  ///
+  /// Nodes are stored in chunks, which Read() parses in parallel on the nsTaskSystem.
   static void Write(nsStreamWriter& inout_stream, const nsAbstractObjectGraph* pGraph, const nsAbstractObjectGraph* pTypesGraph = nullptr);                // [tested]
   static void Read(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph, nsAbstractObjectGraph* pTypesGraph = nullptr, bool bApplyPatches = false); // [tested]
 
 private:
+  static void ReadStringTable(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph, nsDynamicArray<nsStringView>& out_strings);
+  static void ReadNode(nsStreamReader& inout_stream, nsArrayPtr<const nsStringView> strings, nsAbstractObjectNode& ref_node);
+  static void ReadGraph(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph);
 };
@@ -90,6 +90,26 @@ public:
 
 private:
   friend class nsGraphVersioning;
+
+  /// \brief The version hierarchy of a node type at a specific version, computed once per graph.
+  struct NodeTypeInfo
+  {
+    nsDynamicArray<nsVersionKey> m_BaseClasses;
+    bool m_bUpToDate = false; ///< No class in the hierarchy has any patches left to apply.
+  };
+
+  struct NodeTypeKey
+  {
+    nsStringView m_sType;
+    nsUInt32 m_uiTypeVersion = 0;
+  };
+
+  struct NodeTypeKeyHash
+  {
+    static nsUInt32 Hash(const NodeTypeKey& key) { return nsHashingUtils::StringHashTo32(nsHashingUtils::StringHash(key.m_sType, key.m_uiTypeVersion)); }
+    static bool Equal(const NodeTypeKey& a, const NodeTypeKey& b) { return a.m_uiTypeVersion == b.m_uiTypeVersion && a.m_sType == b.m_sType; }
+  };
+
   nsGraphPatchContext(nsGraphVersioning* pParent, nsAbstractObjectGraph* pGraph, nsAbstractObjectGraph* pTypesGraph);
   void Patch(nsAbstractObjectNode* pNode);
   void Patch(nsUInt32 uiBaseClassIndex, nsUInt32 uiTypeVersion, bool bForcePatch);
@@ -102,6 +122,7 @@ private:
   nsDynamicArray<nsVersionKey> m_BaseClasses;
   nsUInt32 m_uiBaseClassIndex = 0;
   mutable nsHashTable<nsHashedString, nsTypeVersionInfo> m_TypeToInfo;
+  nsHashTable<NodeTypeKey, NodeTypeInfo, NodeTypeKeyHash> m_NodeTypes;
 };
 
 /// \brief Singleton that allows version patching of nsAbstractObjectGraph.
@@ -128,7 +149,11 @@ private:
   void UpdatePatches();
   nsUInt32 GetMaxPatchVersion(const nsHashedString& sType) const;
 
+  /// \brief Returns the node patch for \a sType with the lowest version that is at least \a uiMinVersion, or nullptr.
+  const nsGraphPatch* FindNextNodePatch(const nsHashedString& sType, nsUInt32 uiMinVersion) const;
+
   nsHashTable<nsHashedString, nsUInt32> m_MaxPatchVersion; ///< Max version the given type can be patched to.
   nsDynamicArray<const nsGraphPatch*> m_GraphPatches;
   nsHashTable<nsVersionKey, const nsGraphPatch*, nsGraphVersioningHash> m_NodePatches;
+  nsHashTable<nsHashedString, nsDynamicArray<const nsGraphPatch*>> m_NodePatchChains; ///< All node patches of a type, sorted by version.
 };
@@ -5,6 +5,7 @@
  */
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 #include <Foundation/Serialization/ApplyNativePropertyChangesContext.h>
@@ -171,6 +172,7 @@ void nsAbstractObjectNode::AddProperty(nsStringView sName, const nsVariant& valu
   auto& prop = m_Properties.ExpandAndGetRef();
   prop.m_sPropertyName = m_pOwner->RegisterString(sName);
   prop.m_Value = value;
+  m_bContentHashValid = false;
 }
 
 void nsAbstractObjectNode::ChangeProperty(nsStringView sName, const nsVariant& value)
@@ -180,6 +182,7 @@ void nsAbstractObjectNode::ChangeProperty(nsStringView sName, const nsVariant& v
     if (m_Properties[i].m_sPropertyName == sName)
     {
       m_Properties[i].m_Value = value;
+      m_bContentHashValid = false;
       return;
     }
   }
@@ -194,6 +197,7 @@ void nsAbstractObjectNode::RenameProperty(nsStringView sOldName, nsStringView sN
     if (m_Properties[i].m_sPropertyName == sOldName)
     {
       m_Properties[i].m_sPropertyName = m_pOwner->RegisterString(sNewName);
+      m_bContentHashValid = false;
       return;
     }
   }
@@ -202,6 +206,7 @@ void nsAbstractObjectNode::RenameProperty(nsStringView sOldName, nsStringView sN
 void nsAbstractObjectNode::ClearProperties()
 {
   m_Properties.Clear();
+  m_bContentHashValid = false;
 }
 
 nsResult nsAbstractObjectNode::InlineProperty(nsStringView sName)
@@ -236,6 +241,7 @@ nsResult nsAbstractObjectNode::InlineProperty(nsStringView sName)
         return NS_FAILURE;
 
       prop.m_Value.MoveTypedObject(pObject, nsRTTI::FindTypeByName(pNode->GetType()));
+      m_bContentHashValid = false;
 
       // Delete old objects.
       for (nsUuid& uuid : context.m_SubTree)
@@ -255,6 +261,7 @@ void nsAbstractObjectNode::RemoveProperty(nsStringView sName)
     if (m_Properties[i].m_sPropertyName == sName)
     {
       m_Properties.RemoveAtAndSwap(i);
+      m_bContentHashValid = false;
       return;
     }
   }
@@ -263,6 +270,7 @@ void nsAbstractObjectNode::RemoveProperty(nsStringView sName)
 void nsAbstractObjectNode::SetType(nsStringView sType)
 {
   m_sType = m_pOwner->RegisterString(sType);
+  m_bContentHashValid = false;
 }
 
 const nsAbstractObjectNode::Property* nsAbstractObjectNode::FindProperty(nsStringView sName) const
@@ -284,6 +292,8 @@ nsAbstractObjectNode::Property* nsAbstractObjectNode::FindProperty(nsStringView
   {
     if (m_Properties[i].m_sPropertyName == sName)
     {
+      // the caller may modify the value
+      m_bContentHashValid = false;
       return &m_Properties[i];
     }
   }
@@ -291,6 +301,66 @@ nsAbstractObjectNode::Property* nsAbstractObjectNode::FindProperty(nsStringView
   return nullptr;
 }
 
+// Same as nsVariant::ComputeHash(), but typed pointers can't be hashed by nsVariant, so they are hashed by address (which is also how they
+// are compared). Arrays and dictionaries are walked here, because they may contain typed pointers as well.
+static nsUInt64 ComputePropertyValueHash(const nsVariant& value, nsUInt64 uiSeed)
+{
+  switch (value.GetType())
+  {
+    case nsVariantType::TypedPointer:
+    {
+      const void* pObject = value.Get<nsTypedPointer>().m_pObject;
+      return nsHashingUtils::xxHash64(&pObject, sizeof(pObject), uiSeed + nsVariantType::TypedPointer);
+    }
+
+    case nsVariantType::VariantArray:
+    {
+      nsUInt64 uiHash = uiSeed + nsVariantType::VariantArray;
+      for (const nsVariant& element : value.Get<nsVariantArray>())
+      {
+        uiHash = ComputePropertyValueHash(element, uiHash);
+      }
+      return uiHash;
+    }
+
+    case nsVariantType::VariantDictionary:
+    {
+      // summed up, so that the order of the entries does not matter
+      const nsUInt64 uiDictSeed = uiSeed + nsVariantType::VariantDictionary;
+      nsUInt64 uiHash = uiDictSeed;
+      for (auto& it : value.Get<nsVariantDictionary>())
+      {
+        uiHash += ComputePropertyValueHash(it.Value(), nsHashingUtils::xxHash64String(it.Key(), uiDictSeed));
+      }
+      return uiHash;
+    }
+
+    default:
+      return value.ComputeHash(uiSeed);
+  }
+}
+
+nsUInt64 nsAbstractObjectNode::GetContentHash() const
+{
+  if (m_bContentHashValid)
+    return m_uiContentHash;
+
+  // Property hashes are summed up, so that the order of the properties does not matter.
+  nsUInt64 uiPropertiesHash = 0;
+  for (const Property& prop : m_Properties)
+  {
+    const nsUInt64 uiNameHash = nsHashingUtils::StringHash(prop.m_sPropertyName);
+    uiPropertiesHash += ComputePropertyValueHash(prop.m_Value, uiNameHash);
+  }
+
+  nsUInt64 uiHash = nsHashingUtils::StringHash(m_sType, uiPropertiesHash);
+  uiHash = nsHashingUtils::xxHash64(&m_uiTypeVersion, sizeof(m_uiTypeVersion), uiHash);
+
+  m_uiContentHash = uiHash;
+  m_bContentHashValid = true;
+  return uiHash;
+}
+
 void nsAbstractObjectGraph::ReMapNodeGuids(const nsUuid& seedGuid, bool bRemapInverse /*= false*/)
 {
   nsHybridArray<nsAbstractObjectNode*, 16> nodes;
@@ -324,6 +394,7 @@ void nsAbstractObjectGraph::ReMapNodeGuids(const nsUuid& seedGuid, bool bRemapIn
     {
       RemapVariant(prop.m_Value, guidMap);
     }
+    pNode->m_bContentHashValid = false;
     m_Nodes[pNode->m_Guid] = pNode;
   }
 }
@@ -336,6 +407,9 @@ void nsAbstractObjectGraph::ReMapNodeGuidsToMatchGraph(nsAbstractObjectNode* pRo
 
   ReMapNodeGuidsToMatchGraphRecursive(guidMap, pRoot, rhsGraph, pRhsRoot);
 
+  if (guidMap.IsEmpty())
+    return;
+
   // go through all nodes to remap remaining occurrences of remapped guids
   for (auto it : m_Nodes)
   {
@@ -344,7 +418,7 @@ void nsAbstractObjectGraph::ReMapNodeGuidsToMatchGraph(nsAbstractObjectNode* pRo
     {
       RemapVariant(prop.m_Value, guidMap);
     }
-    m_Nodes[it.Value()->m_Guid] = it.Value();
+    it.Value()->m_bContentHashValid = false;
   }
 }
 
@@ -621,90 +695,89 @@ void nsAbstractObjectGraph::CreateDiffWithBaseGraph(const nsAbstractObjectGraph&
 {
   out_diffResult.Clear();
 
-  // check whether any nodes have been deleted
+  // Both maps are sorted by guid, so a single merge walk finds removed, added and common nodes without any lookups.
+  nsDynamicArray<const nsAbstractObjectNode*> addedNodes;
+  nsDynamicArray<const nsAbstractObjectNode*> changedNodes;
+  nsDynamicArray<const nsAbstractObjectNode*> changedBaseNodes;
+
+  auto itNodeBase = base.GetAllNodes().GetIterator();
+  auto itNodeThis = GetAllNodes().GetIterator();
+
+  while (itNodeBase.IsValid() || itNodeThis.IsValid())
   {
-    for (auto itNodeBase = base.GetAllNodes().GetIterator(); itNodeBase.IsValid(); ++itNodeBase)
+    if (!itNodeThis.IsValid() || (itNodeBase.IsValid() && itNodeBase.Key() < itNodeThis.Key()))
+    {
+      // does not exist in this graph -> has been deleted from base
+      nsAbstractGraphDiffOperation op;
+      op.m_Node = itNodeBase.Key();
+      op.m_Operation = nsAbstractGraphDiffOperation::Op::NodeRemoved;
+      op.m_sProperty = itNodeBase.Value()->m_sType;
+      op.m_Value = itNodeBase.Value()->m_sNodeName;
+
+      out_diffResult.PushBack(op);
+      ++itNodeBase;
+    }
+    else if (!itNodeBase.IsValid() || itNodeThis.Key() < itNodeBase.Key())
     {
-      if (GetNode(itNodeBase.Key()) == nullptr)
+      // does not exist in base graph -> has been added
+      addedNodes.PushBack(itNodeThis.Value());
+      ++itNodeThis;
+    }
+    else
+    {
+      // only nodes whose content differs need to be compared property by property
+      if (itNodeThis.Value()->GetContentHash() != itNodeBase.Value()->GetContentHash())
       {
-        // does not exist in this graph -> has been deleted from base
-        nsAbstractGraphDiffOperation op;
-        op.m_Node = itNodeBase.Key();
-        op.m_Operation = nsAbstractGraphDiffOperation::Op::NodeRemoved;
-        op.m_sProperty = itNodeBase.Value()->m_sType;
-        op.m_Value = itNodeBase.Value()->m_sNodeName;
-
-        out_diffResult.PushBack(op);
+        changedNodes.PushBack(itNodeThis.Value());
+        changedBaseNodes.PushBack(itNodeBase.Value());
       }
+
+      ++itNodeBase;
+      ++itNodeThis;
     }
   }
 
-  // check whether any nodes have been added
+  for (const nsAbstractObjectNode* pNode : addedNodes)
   {
-    for (auto itNodeThis = GetAllNodes().GetIterator(); itNodeThis.IsValid(); ++itNodeThis)
-    {
-      if (base.GetNode(itNodeThis.Key()) == nullptr)
-      {
-        // does not exist in base graph -> has been added
-        nsAbstractGraphDiffOperation op;
-        op.m_Node = itNodeThis.Key();
-        op.m_Operation = nsAbstractGraphDiffOperation::Op::NodeAdded;
-        op.m_sProperty = itNodeThis.Value()->m_sType;
-        op.m_Value = itNodeThis.Value()->m_sNodeName;
+    nsAbstractGraphDiffOperation op;
+    op.m_Node = pNode->m_Guid;
+    op.m_Operation = nsAbstractGraphDiffOperation::Op::NodeAdded;
+    op.m_sProperty = pNode->m_sType;
+    op.m_uiTypeVersion = pNode->m_uiTypeVersion;
+    op.m_Value = pNode->m_sNodeName;
 
-        out_diffResult.PushBack(op);
+    out_diffResult.PushBack(op);
 
-        // set all properties
-        for (const auto& prop : itNodeThis.Value()->GetProperties())
-        {
-          op.m_Operation = nsAbstractGraphDiffOperation::Op::PropertyChanged;
-          op.m_sProperty = prop.m_sPropertyName;
-          op.m_Value = prop.m_Value;
+    // set all properties
+    for (const auto& prop : pNode->GetProperties())
+    {
+      op.m_Operation = nsAbstractGraphDiffOperation::Op::PropertyChanged;
+      op.m_sProperty = prop.m_sPropertyName;
+      op.m_Value = prop.m_Value;
 
-          out_diffResult.PushBack(op);
-        }
-      }
+      out_diffResult.PushBack(op);
     }
   }
 
-  // check whether any properties have been modified
+  // check which properties have been modified
+  for (nsUInt32 i = 0; i < changedNodes.GetCount(); ++i)
   {
-    for (auto itNodeThis = GetAllNodes().GetIterator(); itNodeThis.IsValid(); ++itNodeThis)
-    {
-      const auto pBaseNode = base.GetNode(itNodeThis.Key());
+    const nsAbstractObjectNode* pNode = changedNodes[i];
+    const nsAbstractObjectNode* pBaseNode = changedBaseNodes[i];
 
-      if (pBaseNode == nullptr)
-        continue;
+    for (const nsAbstractObjectNode::Property& prop : pNode->GetProperties())
+    {
+      const nsAbstractObjectNode::Property* pBaseProp = pBaseNode->FindProperty(prop.m_sPropertyName);
 
-      for (const nsAbstractObjectNode::Property& prop : itNodeThis.Value()->GetProperties())
+      if (pBaseProp == nullptr || pBaseProp->m_Value != prop.m_Value)
       {
-        bool bDifferent = true;
-
-        for (const nsAbstractObjectNode::Property& baseProp : pBaseNode->GetProperties())
-        {
-          if (baseProp.m_sPropertyName == prop.m_sPropertyName)
-          {
-            if (baseProp.m_Value == prop.m_Value)
-            {
-              bDifferent = false;
-              break;
-            }
-
-            bDifferent = true;
-            break;
-          }
-        }
-
-        if (bDifferent)
-        {
-          nsAbstractGraphDiffOperation op;
-          op.m_Node = itNodeThis.Key();
-          op.m_Operation = nsAbstractGraphDiffOperation::Op::PropertyChanged;
-          op.m_sProperty = prop.m_sPropertyName;
-          op.m_Value = prop.m_Value;
+        nsAbstractGraphDiffOperation op;
+        op.m_Node = pNode->m_Guid;
+        op.m_Operation = nsAbstractGraphDiffOperation::Op::PropertyChanged;
+        op.m_sProperty = prop.m_sPropertyName;
+        op.m_Value = prop.m_Value;
 
-          out_diffResult.PushBack(op);
-        }
+        out_diffResult.PushBack(op);
       }
     }
   }
@@ -761,20 +834,31 @@ void nsAbstractObjectGraph::MergeDiffs(const nsDeque<nsAbstractGraphDiffOperatio
     nsUuid m_Node;
     nsStringView m_sProperty;
 
-    bool operator<(const Prop& rhs) const
-    {
-      if (m_Node == rhs.m_Node)
-        return m_sProperty < rhs.m_sProperty;
+    bool operator==(const Prop& rhs) const { return m_Node == rhs.m_Node && m_sProperty == rhs.m_sProperty; }
+  };
 
-      return m_Node < rhs.m_Node;
-    }
+  struct PropHashHelper
+  {
+    static nsUInt32 Hash(const Prop& value) { return nsHashHelper<nsUuid>::Hash(value.m_Node) ^ nsHashHelper<nsStringView>::Hash(value.m_sProperty); }
+    static bool Equal(const Prop& a, const Prop& b) { return a == b; }
+  };
 
-    bool operator==(const Prop& rhs) const { return m_Node == rhs.m_Node && m_sProperty == rhs.m_sProperty; }
+  // Property changes are kept in the order in which they first appear, the hash table only maps to the index.
+  nsHashTable<Prop, nsUInt32, PropHashHelper> propChangeIndices;
+  nsDynamicArray<nsHybridArray<const nsAbstractGraphDiffOperation*, 2>> propChanges;
+  auto AddPropChange = [&](const nsAbstractGraphDiffOperation& op) {
+    bool bExisted = false;
+    nsUInt32& uiIndex = propChangeIndices.FindOrAdd(Prop(op.m_Node, op.m_sProperty), &bExisted);
+    if (!bExisted)
+    {
+      uiIndex = propChanges.GetCount();
+      propChanges.ExpandAndGetRef();
+    }
+    propChanges[uiIndex].PushBack(&op);
   };
 
-  nsMap<Prop, nsHybridArray<const nsAbstractGraphDiffOperation*, 2>> propChanges;
-  nsSet<nsUuid> removed;
-  nsMap<nsUuid, nsUInt32> added;
+  nsHashSet<nsUuid> removed;
+  nsHashTable<nsUuid, nsUInt32> added;
   for (const nsAbstractGraphDiffOperation& op : lhs)
   {
     if (op.m_Operation == nsAbstractGraphDiffOperation::Op::NodeRemoved)
@@ -789,8 +873,7 @@ void nsAbstractObjectGraph::MergeDiffs(const nsDeque<nsAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == nsAbstractGraphDiffOperation::Op::PropertyChanged)
     {
-      auto it = propChanges.FindOrAdd(Prop(op.m_Node, op.m_sProperty));
-      it.Value().PushBack(&op);
+      AddPropChange(op);
     }
   }
   for (const nsAbstractGraphDiffOperation& op : rhs)
@@ -802,9 +885,9 @@ void nsAbstractObjectGraph::MergeDiffs(const nsDeque<nsAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == nsAbstractGraphDiffOperation::Op::NodeAdded)
     {
-      if (added.Contains(op.m_Node))
+      if (const nsUInt32* pLeftIndex = added.GetValue(op.m_Node))
       {
-        nsAbstractGraphDiffOperation& leftOp = ref_out[added[op.m_Node]];
+        nsAbstractGraphDiffOperation& leftOp = ref_out[*pLeftIndex];
         leftOp.m_sProperty = op.m_sProperty; // Take type from rhs.
       }
       else
@@ -814,15 +897,12 @@ void nsAbstractObjectGraph::MergeDiffs(const nsDeque<nsAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == nsAbstractGraphDiffOperation::Op::PropertyChanged)
     {
-      auto it = propChanges.FindOrAdd(Prop(op.m_Node, op.m_sProperty));
-      it.Value().PushBack(&op);
+      AddPropChange(op);
     }
   }
 
-  for (auto it = propChanges.GetIterator(); it.IsValid(); ++it)
+  for (const nsHybridArray<const nsAbstractGraphDiffOperation*, 2>& value : propChanges)
   {
-    const Prop& key = it.Key();
-    const nsHybridArray<const nsAbstractGraphDiffOperation*, 2>& value = it.Value();
 
     if (value.GetCount() == 1)
     {
@@ -838,11 +918,10 @@ void nsAbstractObjectGraph::MergeDiffs(const nsDeque<nsAbstractGraphDiffOperatio
         const nsVariantArray& leftArray = leftProp.m_Value.Get<nsVariantArray>();
         const nsVariantArray& rightArray = rightProp.m_Value.Get<nsVariantArray>();
 
-        const nsAbstractObjectNode* pNode = GetNode(key.m_Node);
+        const nsAbstractObjectNode* pNode = GetNode(leftProp.m_Node);
         if (pNode)
         {
-          nsStringBuilder sTemp(key.m_sProperty);
-          const nsAbstractObjectNode::Property* pProperty = pNode->FindProperty(sTemp);
+          const nsAbstractObjectNode::Property* pProperty = pNode->FindProperty(leftProp.m_sProperty);
           if (pProperty && pProperty->m_Value.GetType() == nsVariantType::VariantArray)
           {
             // Do 3-way array merge
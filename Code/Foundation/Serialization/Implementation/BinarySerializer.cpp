@@ -5,41 +5,131 @@
  */
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/GraphVersioning.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 enum nsBinarySerializerVersion : nsUInt32
 {
   InvalidVersion = 0,
   Version1,
+  Version2, ///< Strings are stored once per graph in a string table and referenced by index. Nodes are stored in chunks of known size, which can be parsed in parallel.
   // << insert new versions here >>
 
   ENUM_COUNT,
   CurrentVersion = ENUM_COUNT - 1 // automatically the highest version number
 };
 
+static void WriteVarUInt(nsStreamWriter& inout_stream, nsUInt32 uiValue)
+{
+  nsUInt8 bytes[5];
+  nsUInt32 uiBytes = 0;
+  while (uiValue >= 0x80)
+  {
+    bytes[uiBytes++] = static_cast<nsUInt8>(uiValue | 0x80);
+    uiValue >>= 7;
+  }
+  bytes[uiBytes++] = static_cast<nsUInt8>(uiValue);
+  inout_stream.WriteBytes(bytes, uiBytes).AssertSuccess();
+}
+
+static nsUInt32 ReadVarUInt(nsStreamReader& inout_stream)
+{
+  nsUInt32 uiValue = 0;
+  for (nsUInt32 uiShift = 0; uiShift < 35; uiShift += 7)
+  {
+    nsUInt8 uiByte = 0;
+    if (inout_stream.ReadBytes(&uiByte, 1) != 1)
+      break;
+
+    uiValue |= static_cast<nsUInt32>(uiByte & 0x7F) << uiShift;
+    if ((uiByte & 0x80) == 0)
+      break;
+  }
+  return uiValue;
+}
+
+/// Number of nodes per chunk in Version2, each chunk is parsed by one task.
+static constexpr nsUInt32 s_uiNodesPerChunk = 128;
+
 static void WriteGraph(const nsAbstractObjectGraph* pGraph, nsStreamWriter& inout_stream)
 {
   const auto& Nodes = pGraph->GetAllNodes();
 
-  nsUInt32 uiNodes = Nodes.GetCount();
-  inout_stream << uiNodes;
+  // All type, node and property names go into a string table first, nodes only reference them by index.
+  nsDynamicArray<nsStringView> strings;
+  nsHashTable<nsStringView, nsUInt32> stringToIndex;
+  auto AddString = [&](nsStringView sString) {
+    bool bExisted = false;
+    nsUInt32& uiIndex = stringToIndex.FindOrAdd(sString, &bExisted);
+    if (!bExisted)
+    {
+      uiIndex = strings.GetCount();
+      strings.PushBack(sString);
+    }
+  };
+
   for (auto itNode = Nodes.GetIterator(); itNode.IsValid(); ++itNode)
   {
     const auto& node = *itNode.Value();
-    inout_stream << node.GetGuid();
-    inout_stream << node.GetType();
-    inout_stream << node.GetTypeVersion();
-    inout_stream << node.GetNodeName();
+    AddString(node.GetType());
+    AddString(node.GetNodeName());
+
+    for (const nsAbstractObjectNode::Property& prop : node.GetProperties())
+    {
+      AddString(prop.m_sPropertyName);
+    }
+  }
+
+  WriteVarUInt(inout_stream, strings.GetCount());
+  for (nsStringView sString : strings)
+  {
+    inout_stream << sString;
+  }
+
+  WriteVarUInt(inout_stream, Nodes.GetCount());
+  WriteVarUInt(inout_stream, (Nodes.GetCount() + s_uiNodesPerChunk - 1) / s_uiNodesPerChunk);
+
+  // Each chunk is written to a temporary buffer first, so that its size can be stored in front of it.
+  nsContiguousMemoryStreamStorage chunkStorage;
+  nsMemoryStreamWriter chunk(&chunkStorage);
+  nsUInt32 uiNodesInChunk = 0;
+
+  auto FlushChunk = [&]() {
+    inout_stream << uiNodesInChunk;
+    inout_stream << chunkStorage.GetStorageSize32();
+    inout_stream.WriteBytes(chunkStorage.GetData(), chunkStorage.GetStorageSize32()).AssertSuccess();
+    chunkStorage.Clear();
+    chunk.SetWritePosition(0);
+    uiNodesInChunk = 0;
+  };
+
+  for (auto itNode = Nodes.GetIterator(); itNode.IsValid(); ++itNode)
+  {
+    const auto& node = *itNode.Value();
+    chunk << node.GetGuid();
+    WriteVarUInt(chunk, *stringToIndex.GetValue(node.GetType()));
+    chunk << node.GetTypeVersion();
+    WriteVarUInt(chunk, *stringToIndex.GetValue(node.GetNodeName()));
 
     const nsHybridArray<nsAbstractObjectNode::Property, 16>& properties = node.GetProperties();
-    nsUInt32 uiProps = properties.GetCount();
-    inout_stream << uiProps;
+    WriteVarUInt(chunk, properties.GetCount());
     for (const nsAbstractObjectNode::Property& prop : properties)
     {
-      inout_stream << prop.m_sPropertyName;
-      inout_stream << prop.m_Value;
+      WriteVarUInt(chunk, *stringToIndex.GetValue(prop.m_sPropertyName));
+      chunk << prop.m_Value;
     }
+
+    if (++uiNodesInChunk == s_uiNodesPerChunk)
+    {
+      FlushChunk();
+    }
+  }
+
+  if (uiNodesInChunk > 0)
+  {
+    FlushChunk();
   }
 }
 
@@ -55,7 +145,7 @@ void nsAbstractGraphBinarySerializer::Write(nsStreamWriter& inout_stream, const
   }
 }
 
-static void ReadGraph(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph)
+static void ReadGraphVersion1(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph)
 {
   nsUInt32 uiNodes = 0;
   inout_stream >> uiNodes;
@@ -83,21 +173,152 @@ static void ReadGraph(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGrap
   }
 }
 
+void nsAbstractGraphBinarySerializer::ReadStringTable(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph, nsDynamicArray<nsStringView>& out_strings)
+{
+  // Every string is registered in the graph exactly once, nodes and properties then only point into the graph's string storage.
+  const nsUInt32 uiStrings = ReadVarUInt(inout_stream);
+  out_strings.SetCount(uiStrings);
+
+  nsStringBuilder sTemp;
+  for (nsUInt32 i = 0; i < uiStrings; ++i)
+  {
+    inout_stream >> sTemp;
+    out_strings[i] = pGraph->RegisterString(sTemp);
+  }
+}
+
+void nsAbstractGraphBinarySerializer::ReadNode(nsStreamReader& inout_stream, nsArrayPtr<const nsStringView> strings, nsAbstractObjectNode& ref_node)
+{
+  auto GetString = [&](nsUInt32 uiIndex) -> nsStringView {
+    if (uiIndex < strings.GetCount())
+      return strings[uiIndex];
+
+    NS_REPORT_FAILURE("Invalid string index {0} in binary graph, the string table has {1} entries.", uiIndex, strings.GetCount());
+    return {};
+  };
+
+  inout_stream >> ref_node.m_Guid;
+  ref_node.m_sType = GetString(ReadVarUInt(inout_stream));
+  inout_stream >> ref_node.m_uiTypeVersion;
+  ref_node.m_sNodeName = GetString(ReadVarUInt(inout_stream));
+
+  const nsUInt32 uiProps = ReadVarUInt(inout_stream);
+  ref_node.m_Properties.Reserve(uiProps);
+  for (nsUInt32 propIdx = 0; propIdx < uiProps; ++propIdx)
+  {
+    nsAbstractObjectNode::Property& prop = ref_node.m_Properties.ExpandAndGetRef();
+    prop.m_sPropertyName = GetString(ReadVarUInt(inout_stream));
+    inout_stream >> prop.m_Value;
+  }
+}
+
+void nsAbstractGraphBinarySerializer::ReadGraph(nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph)
+{
+  nsDynamicArray<nsStringView> strings;
+  ReadStringTable(inout_stream, pGraph, strings);
+
+  struct Chunk
+  {
+    nsUInt32 m_uiFirstNode = 0;
+    nsUInt32 m_uiNodeCount = 0;
+    nsUInt32 m_uiDataOffset = 0;
+    nsUInt32 m_uiDataSize = 0;
+  };
+
+  const nsUInt32 uiNodes = ReadVarUInt(inout_stream);
+  const nsUInt32 uiChunks = ReadVarUInt(inout_stream);
+
+  // Read all chunks into memory first, the stream itself can only be read sequentially.
+  nsDynamicArray<Chunk> chunks;
+  chunks.SetCount(uiChunks);
+  nsDynamicArray<nsUInt8> data;
+  nsUInt32 uiFirstNode = 0;
+
+  for (Chunk& chunk : chunks)
+  {
+    inout_stream >> chunk.m_uiNodeCount;
+    inout_stream >> chunk.m_uiDataSize;
+    chunk.m_uiFirstNode = uiFirstNode;
+    chunk.m_uiDataOffset = data.GetCount();
+    uiFirstNode += chunk.m_uiNodeCount;
+
+    data.SetCountUninitialized(chunk.m_uiDataOffset + chunk.m_uiDataSize);
+    if (inout_stream.ReadBytes(data.GetData() + chunk.m_uiDataOffset, chunk.m_uiDataSize) != chunk.m_uiDataSize)
+    {
+      NS_REPORT_FAILURE("Binary graph is truncated.");
+      return;
+    }
+  }
+
+  if (uiFirstNode != uiNodes)
+  {
+    NS_REPORT_FAILURE("Binary graph chunks contain {0} nodes, expected {1}.", uiFirstNode, uiNodes);
+    return;
+  }
+
+  // Parsing the nodes and their property values is the expensive part and chunks are independent of each other,
+  // as they only reference the string table. Only adding the nodes to the graph has to be done serially.
+  nsDynamicArray<nsAbstractObjectNode> nodes;
+  nodes.SetCount(uiNodes);
+
+  auto ParseChunks = [&](nsUInt32 uiStartIndex, nsUInt32 uiEndIndex) {
+    for (nsUInt32 uiChunk = uiStartIndex; uiChunk < uiEndIndex; ++uiChunk)
+    {
+      const Chunk& chunk = chunks[uiChunk];
+      nsRawMemoryStreamReader reader(data.GetData() + chunk.m_uiDataOffset, chunk.m_uiDataSize);
+
+      for (nsUInt32 i = 0; i < chunk.m_uiNodeCount; ++i)
+      {
+        ReadNode(reader, strings, nodes[chunk.m_uiFirstNode + i]);
+      }
+    }
+  };
+
+  if (uiChunks > 1)
+  {
+    nsParallelForParams params;
+    params.m_uiMaxTasksPerThread = 1;
+    nsTaskSystem::ParallelForIndexed(0, uiChunks, ParseChunks, "ReadBinaryGraph", params);
+  }
+  else
+  {
+    ParseChunks(0, uiChunks);
+  }
+
+  for (nsAbstractObjectNode& node : nodes)
+  {
+    nsAbstractObjectNode* pNode = pGraph->AddNode(node.m_Guid, node.m_sType, node.m_uiTypeVersion, node.m_sNodeName);
+    pNode->m_Properties = std::move(node.m_Properties);
+  }
+}
+
 void nsAbstractGraphBinarySerializer::Read(
   nsStreamReader& inout_stream, nsAbstractObjectGraph* pGraph, nsAbstractObjectGraph* pTypesGraph, bool bApplyPatches)
 {
   nsUInt32 uiVersion = 0;
   inout_stream >> uiVersion;
-  if (uiVersion != nsBinarySerializerVersion::CurrentVersion)
+  if (uiVersion < nsBinarySerializerVersion::Version1 || uiVersion > nsBinarySerializerVersion::CurrentVersion)
   {
     NS_REPORT_FAILURE(
-      "Binary serializer version {0} does not match expected version {1}, re-export file.", uiVersion, nsBinarySerializerVersion::CurrentVersion);
+      "Binary serializer version {0} is not supported, the current version is {1}. Re-export the file.", uiVersion, nsBinarySerializerVersion::CurrentVersion);
     return;
   }
-  ReadGraph(inout_stream, pGraph);
-  if (pTypesGraph)
+
+  if (uiVersion == nsBinarySerializerVersion::Version1)
   {
-    ReadGraph(inout_stream, pTypesGraph);
+    ReadGraphVersion1(inout_stream, pGraph);
+    if (pTypesGraph)
+    {
+      ReadGraphVersion1(inout_stream, pTypesGraph);
+    }
+  }
+  else
+  {
+    ReadGraph(inout_stream, pGraph);
+    if (pTypesGraph)
+    {
+      ReadGraph(inout_stream, pTypesGraph);
+    }
   }
 
   if (bApplyPatches)
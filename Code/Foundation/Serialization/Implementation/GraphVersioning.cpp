@@ -115,14 +115,43 @@ nsGraphPatchContext::nsGraphPatchContext(nsGraphVersioning* pParent, nsAbstractO
 void nsGraphPatchContext::Patch(nsAbstractObjectNode* pNode)
 {
   m_pNode = pNode;
-  // Build version hierarchy.
-  m_BaseClasses.Clear();
-  nsVersionKey key;
-  key.m_sType.Assign(m_pNode->GetType());
-  key.m_uiTypeVersion = m_pNode->GetTypeVersion();
 
-  m_BaseClasses.PushBack(key);
-  UpdateBaseClasses();
+  // Build version hierarchy. It only depends on the type and version of the node, so it is computed once per graph.
+  NodeTypeKey typeKey;
+  typeKey.m_sType = m_pNode->GetType();
+  typeKey.m_uiTypeVersion = m_pNode->GetTypeVersion();
+
+  bool bExisted = false;
+  NodeTypeInfo& typeInfo = m_NodeTypes.FindOrAdd(typeKey, &bExisted);
+  if (!bExisted)
+  {
+    m_BaseClasses.Clear();
+    nsVersionKey key;
+    key.m_sType.Assign(typeKey.m_sType);
+    key.m_uiTypeVersion = typeKey.m_uiTypeVersion;
+
+    m_BaseClasses.PushBack(key);
+    UpdateBaseClasses();
+
+    typeInfo.m_BaseClasses = m_BaseClasses;
+    typeInfo.m_bUpToDate = true;
+    for (const nsVersionKey& baseClass : m_BaseClasses)
+    {
+      if (baseClass.m_uiTypeVersion < m_pParent->GetMaxPatchVersion(baseClass.m_sType))
+      {
+        typeInfo.m_bUpToDate = false;
+        break;
+      }
+    }
+  }
+
+  if (typeInfo.m_bUpToDate)
+  {
+    m_pNode->SetTypeVersion(typeInfo.m_BaseClasses[0].m_uiTypeVersion);
+    return;
+  }
+
+  m_BaseClasses = typeInfo.m_BaseClasses;
 
   // Patch
   for (m_uiBaseClassIndex = 0; m_uiBaseClassIndex < m_BaseClasses.GetCount(); ++m_uiBaseClassIndex)
@@ -146,7 +175,23 @@ void nsGraphPatchContext::Patch(nsUInt32 uiBaseClassIndex, nsUInt32 uiTypeVersio
     nsVersionKey key = m_BaseClasses[uiBaseClassIndex];
     key.m_uiTypeVersion += 1;
     const nsGraphPatch* pPatch = nullptr;
-    if (m_pParent->m_NodePatches.TryGetValue(key, pPatch))
+    if (uiBaseClassIndex == m_uiBaseClassIndex)
+    {
+      // Jump straight to the next version that has a patch instead of stepping through all versions in between.
+      pPatch = m_pParent->FindNextNodePatch(key.m_sType, key.m_uiTypeVersion);
+      if (pPatch == nullptr || pPatch->GetTypeVersion() > uiTypeVersion)
+      {
+        m_BaseClasses[m_uiBaseClassIndex].m_uiTypeVersion = uiTypeVersion;
+        break;
+      }
+      m_BaseClasses[m_uiBaseClassIndex].m_uiTypeVersion = pPatch->GetTypeVersion() - 1;
+    }
+    else
+    {
+      m_pParent->m_NodePatches.TryGetValue(key, pPatch);
+    }
+
+    if (pPatch)
     {
       pPatch->Patch(*this, m_pGraph, m_pNode);
       uiTypeVersion = m_pParent->GetMaxPatchVersion(m_BaseClasses[m_uiBaseClassIndex].m_sType);
@@ -266,6 +311,7 @@ void nsGraphVersioning::UpdatePatches()
 {
   m_GraphPatches.Clear();
   m_NodePatches.Clear();
+  m_NodePatchChains.Clear();
   m_MaxPatchVersion.Clear();
 
   nsVersionKey key;
@@ -301,6 +347,16 @@ void nsGraphVersioning::UpdatePatches()
   }
 
   m_GraphPatches.Sort([](const nsGraphPatch* a, const nsGraphPatch* b) -> bool { return a->GetTypeVersion() < b->GetTypeVersion(); });
+
+  for (auto it : m_NodePatches)
+  {
+    m_NodePatchChains[it.Key().m_sType].PushBack(it.Value());
+  }
+
+  for (auto it : m_NodePatchChains)
+  {
+    it.Value().Sort([](const nsGraphPatch* a, const nsGraphPatch* b) -> bool { return a->GetTypeVersion() < b->GetTypeVersion(); });
+  }
 }
 
 nsUInt32 nsGraphVersioning::GetMaxPatchVersion(const nsHashedString& sType) const
@@ -312,4 +368,17 @@ nsUInt32 nsGraphVersioning::GetMaxPatchVersion(const nsHashedString& sType) cons
   return 0;
 }
 
+const nsGraphPatch* nsGraphVersioning::FindNextNodePatch(const nsHashedString& sType, nsUInt32 uiMinVersion) const
+{
+  if (const nsDynamicArray<const nsGraphPatch*>* pChain = m_NodePatchChains.GetValue(sType))
+  {
+    for (const nsGraphPatch* pPatch : *pChain)
+    {
+      if (pPatch->GetTypeVersion() >= uiMinVersion)
+        return pPatch;
+    }
+  }
+  return nullptr;
+}
+
 NS_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_GraphVersioning);
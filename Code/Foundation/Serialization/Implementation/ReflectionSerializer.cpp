@@ -10,11 +10,193 @@
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/DdlSerializer.h>
+#include <Foundation/Serialization/Implementation/ReflectionSerializerPlan.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Types/VariantTypeRegistry.h>
 
+namespace
+{
+  // Binary streams written through a compiled nsReflectionSerializerPlan start with this tag, streams written through the object graph
+  // start with the nsAbstractGraphBinarySerializer version instead.
+  static constexpr nsUInt8 s_CompiledStreamTag[4] = {'n', 's', 'R', 'P'};
+  static constexpr nsUInt8 s_uiCompiledStreamVersion = 1;
+
+  // Written instead of the schema size, if the schema was already written to the stream before (see nsReflectionSerializerSchemaWriteContext).
+  static constexpr nsUInt32 s_uiSchemaReference = nsInvalidIndex;
+
+  /// Hands out the already consumed stream tag again before reading from the actual stream.
+  class nsPrefixedStreamReader : public nsStreamReader
+  {
+  public:
+    nsPrefixedStreamReader(nsStreamReader& ref_stream, const nsUInt8* pPrefix, nsUInt32 uiPrefixSize)
+      : m_Stream(ref_stream)
+      , m_pPrefix(pPrefix)
+      , m_uiPrefixSize(uiPrefixSize)
+    {
+    }
+
+    virtual nsUInt64 ReadBytes(void* pReadBuffer, nsUInt64 uiBytesToRead) override
+    {
+      const nsUInt32 uiFromPrefix = static_cast<nsUInt32>(nsMath::Min<nsUInt64>(uiBytesToRead, m_uiPrefixSize));
+      if (uiFromPrefix > 0)
+      {
+        nsMemoryUtils::Copy(static_cast<nsUInt8*>(pReadBuffer), m_pPrefix, uiFromPrefix);
+        m_pPrefix += uiFromPrefix;
+        m_uiPrefixSize -= uiFromPrefix;
+      }
+
+      if (uiFromPrefix == uiBytesToRead)
+        return uiBytesToRead;
+
+      return uiFromPrefix + m_Stream.ReadBytes(static_cast<nsUInt8*>(pReadBuffer) + uiFromPrefix, uiBytesToRead - uiFromPrefix);
+    }
+
+  private:
+    nsStreamReader& m_Stream;
+    const nsUInt8* m_pPrefix = nullptr;
+    nsUInt32 m_uiPrefixSize = 0;
+  };
+
+  static void WriteCompiled(nsStreamWriter& inout_stream, const nsReflectionSerializerPlan* pPlan, const void* pObject)
+  {
+    inout_stream.WriteBytes(s_CompiledStreamTag, sizeof(s_CompiledStreamTag)).AssertSuccess();
+    inout_stream << s_uiCompiledStreamVersion;
+    inout_stream << pPlan->GetType()->GetTypeName();
+    inout_stream << pPlan->GetSchemaHash();
+
+    auto* pSchemaContext = nsReflectionSerializerSchemaWriteContext::GetContext();
+    if (pSchemaContext != nullptr && !pSchemaContext->AddSchema(pPlan->GetSchemaHash()))
+    {
+      inout_stream << s_uiSchemaReference;
+    }
+    else
+    {
+      inout_stream << pPlan->GetSchema().GetCount();
+      inout_stream.WriteBytes(pPlan->GetSchema().GetPtr(), pPlan->GetSchema().GetCount()).AssertSuccess();
+    }
+
+    pPlan->WriteData(inout_stream, pObject);
+  }
+
+  /// Reads the rest of a stream written by WriteCompiled, after the tag. If pObject is null, the object is allocated from the type stored in the stream.
+  static void* ReadCompiled(nsStreamReader& inout_stream, const nsRTTI*& ref_pRtti, void* pObject)
+  {
+    nsUInt8 uiVersion = 0;
+    nsStringBuilder sType;
+    nsUInt64 uiSchemaHash = 0;
+    nsUInt32 uiSchemaSize = 0;
+    inout_stream >> uiVersion;
+
+    if (uiVersion != s_uiCompiledStreamVersion)
+    {
+      NS_REPORT_FAILURE("Compiled reflection stream version {0} does not match expected version {1}.", uiVersion, s_uiCompiledStreamVersion);
+      return nullptr;
+    }
+
+    inout_stream >> sType;
+    inout_stream >> uiSchemaHash;
+    inout_stream >> uiSchemaSize;
+
+    if (pObject == nullptr)
+    {
+      ref_pRtti = nsRTTI::FindTypeByName(sType);
+      if (ref_pRtti == nullptr || !ref_pRtti->GetAllocator()->CanAllocate())
+      {
+        nsLog::Error("Can't create an object of type '{0}' from the binary stream.", sType);
+        return nullptr;
+      }
+
+      pObject = ref_pRtti->GetAllocator()->Allocate<void>();
+    }
+
+    const nsReflectionSerializerPlan* pPlan = nsReflectionSerializerPlan::GetPlan(ref_pRtti, pObject);
+    if (pPlan->IsCompiled() && pPlan->GetSchemaHash() == uiSchemaHash)
+    {
+      if (uiSchemaSize != s_uiSchemaReference)
+      {
+        inout_stream.SkipBytes(uiSchemaSize);
+      }
+
+      if (pPlan->ReadData(inout_stream, pObject).Failed())
+      {
+        nsLog::Error("Failed to read object of type '{0}' from the binary stream.", sType);
+      }
+
+      return pObject;
+    }
+
+    // The type has changed since the data was written (or is a different type altogether), go through the object graph,
+    // which matches properties by name.
+    auto* pSchemaContext = nsReflectionSerializerSchemaReadContext::GetContext();
+    nsDynamicArray<nsUInt8> schema;
+
+    if (uiSchemaSize == s_uiSchemaReference)
+    {
+      if (pSchemaContext == nullptr || pSchemaContext->GetSchema(uiSchemaHash).IsEmpty())
+      {
+        nsLog::Error("Failed to read object of type '{0}' from the binary stream, its schema is unknown. Streams written with an "
+                     "nsReflectionSerializerSchemaWriteContext must be read with an nsReflectionSerializerSchemaReadContext.",
+          sType);
+        return pObject;
+      }
+
+      schema = pSchemaContext->GetSchema(uiSchemaHash);
+    }
+    else
+    {
+      schema.SetCountUninitialized(uiSchemaSize);
+      if (inout_stream.ReadBytes(schema.GetData(), uiSchemaSize) != uiSchemaSize)
+      {
+        nsLog::Error("Failed to read object of type '{0}' from the binary stream.", sType);
+        return pObject;
+      }
+
+      if (pSchemaContext != nullptr)
+      {
+        pSchemaContext->AddSchema(uiSchemaHash, schema);
+      }
+    }
+
+    nsAbstractObjectGraph graph;
+    nsRttiConverterContext context;
+
+    auto* pRootNode = nsReflectionSerializerPlan::ReadDataToGraph(schema, inout_stream, graph, "root");
+    if (pRootNode == nullptr)
+    {
+      nsLog::Error("Failed to read object of type '{0}' from the binary stream.", sType);
+      return pObject;
+    }
+
+    nsRttiConverterReader convRead(&graph, &context);
+    convRead.ApplyPropertiesToObject(pRootNode, ref_pRtti, pObject);
+    return pObject;
+  }
+} // namespace
+
+NS_IMPLEMENT_SERIALIZATION_CONTEXT(nsReflectionSerializerSchemaWriteContext)
+
+bool nsReflectionSerializerSchemaWriteContext::AddSchema(nsUInt64 uiSchemaHash)
+{
+  return !m_WrittenSchemas.Insert(uiSchemaHash);
+}
+
+NS_IMPLEMENT_SERIALIZATION_CONTEXT(nsReflectionSerializerSchemaReadContext)
+
+void nsReflectionSerializerSchemaReadContext::AddSchema(nsUInt64 uiSchemaHash, nsArrayPtr<const nsUInt8> schema)
+{
+  m_Schemas[uiSchemaHash] = schema;
+}
+
+nsArrayPtr<const nsUInt8> nsReflectionSerializerSchemaReadContext::GetSchema(nsUInt64 uiSchemaHash) const
+{
+  if (const nsDynamicArray<nsUInt8>* pSchema = m_Schemas.GetValue(uiSchemaHash))
+    return *pSchema;
+
+  return {};
+}
+
 ////////////////////////////////////////////////////////////////////////
 // nsReflectionSerializer public static functions
 ////////////////////////////////////////////////////////////////////////
@@ -50,6 +232,16 @@ void nsReflectionSerializer::WriteObjectToDDL(nsOpenDdlWriter& ref_ddl, const ns
 
 void nsReflectionSerializer::WriteObjectToBinary(nsStreamWriter& inout_stream, const nsRTTI* pRtti, const void* pObject)
 {
+  if (pObject != nullptr)
+  {
+    const nsReflectionSerializerPlan* pPlan = nsReflectionSerializerPlan::GetPlan(pRtti, pObject);
+    if (pPlan->IsCompiled())
+    {
+      WriteCompiled(inout_stream, pPlan, pObject);
+      return;
+    }
+  }
+
   nsAbstractObjectGraph graph;
   nsRttiConverterContext context;
   nsRttiConverterWriter conv(&graph, &context, false, true);
@@ -95,10 +287,18 @@ void* nsReflectionSerializer::ReadObjectFromDDL(const nsOpenDdlReaderElement* pR
 
 void* nsReflectionSerializer::ReadObjectFromBinary(nsStreamReader& inout_stream, const nsRTTI*& ref_pRtti)
 {
+  nsUInt8 tag[sizeof(s_CompiledStreamTag)] = {};
+  inout_stream.ReadBytes(tag, sizeof(tag));
+  if (nsMemoryUtils::IsEqual(tag, s_CompiledStreamTag, sizeof(tag)))
+  {
+    return ReadCompiled(inout_stream, ref_pRtti, nullptr);
+  }
+
   nsAbstractObjectGraph graph;
   nsRttiConverterContext context;
 
-  nsAbstractGraphBinarySerializer::Read(inout_stream, &graph);
+  nsPrefixedStreamReader graphStream(inout_stream, tag, sizeof(tag));
+  nsAbstractGraphBinarySerializer::Read(graphStream, &graph);
 
   nsRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -134,10 +334,20 @@ void nsReflectionSerializer::ReadObjectPropertiesFromDDL(nsStreamReader& inout_s
 
 void nsReflectionSerializer::ReadObjectPropertiesFromBinary(nsStreamReader& inout_stream, const nsRTTI& rtti, void* pObject)
 {
+  nsUInt8 tag[sizeof(s_CompiledStreamTag)] = {};
+  inout_stream.ReadBytes(tag, sizeof(tag));
+  if (nsMemoryUtils::IsEqual(tag, s_CompiledStreamTag, sizeof(tag)))
+  {
+    const nsRTTI* pRtti = &rtti;
+    ReadCompiled(inout_stream, pRtti, pObject);
+    return;
+  }
+
   nsAbstractObjectGraph graph;
   nsRttiConverterContext context;
 
-  nsAbstractGraphBinarySerializer::Read(inout_stream, &graph);
+  nsPrefixedStreamReader graphStream(inout_stream, tag, sizeof(tag));
+  nsAbstractGraphBinarySerializer::Read(graphStream, &graph);
 
   nsRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -0,0 +1,482 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <Foundation/Serialization/Implementation/ReflectionSerializerPlan.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace
+{
+  struct nsReflectionSerializerPlanCache
+  {
+    nsMutex m_Mutex;
+    nsHashTable<const nsRTTI*, nsReflectionSerializerPlan*> m_Plans;
+  };
+
+  static nsReflectionSerializerPlanCache& GetPlanCache()
+  {
+    static nsReflectionSerializerPlanCache s_Cache;
+    return s_Cache;
+  }
+
+  static void PluginEventHandler(const nsPluginEvent& e)
+  {
+    // plans reference nsRTTI and property instances, which are gone once a plugin is unloaded
+    if (e.m_EventType == nsPluginEvent::AfterPluginChanges)
+    {
+      nsReflectionSerializerPlan::ClearCache();
+    }
+  }
+
+  /// Whether a member of the given type has a fixed memory layout that can be copied bytewise.
+  static bool IsRawType(nsVariantType::Enum type)
+  {
+    return (type >= nsVariantType::Bool && type <= nsVariantType::Transform) || type == nsVariantType::Time || type == nsVariantType::Uuid ||
+           type == nsVariantType::Angle || type == nsVariantType::ColorGamma;
+  }
+
+  struct RawValueFunc
+  {
+    template <typename T>
+    NS_FORCE_INLINE void operator()(const nsUInt8* pData, nsUInt32& out_uiSize, nsVariant* pResult)
+    {
+      if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+      {
+        out_uiSize = sizeof(T);
+        if (pResult)
+        {
+          T value;
+          nsMemoryUtils::RawByteCopy(&value, pData, sizeof(T));
+          *pResult = value;
+        }
+      }
+    }
+  };
+
+  static nsUInt32 GetRawTypeSize(nsVariantType::Enum type)
+  {
+    nsUInt32 uiSize = 0;
+    RawValueFunc func;
+    nsVariant::DispatchTo(func, type, nullptr, uiSize, nullptr);
+    return uiSize;
+  }
+
+  // The schema is cached across streams, so its strings must never go through an active nsStringDeduplicationWriteContext
+  // or nsStringDeduplicationReadContext. They use the same format as nsStreamWriter::WriteString() without a context.
+  static void WriteSchemaString(nsStreamWriter& inout_schema, nsStringView sString)
+  {
+    const nsUInt32 uiCount = sString.GetElementCount();
+    inout_schema << uiCount;
+    inout_schema.WriteBytes(sString.GetStartPointer(), uiCount).AssertSuccess();
+  }
+
+  static nsResult ReadSchemaString(nsRawMemoryStreamReader& inout_schema, nsStringBuilder& out_sString)
+  {
+    nsUInt32 uiCount = 0;
+    inout_schema >> uiCount;
+
+    if (uiCount > inout_schema.GetByteCount() - inout_schema.GetReadPosition())
+      return NS_FAILURE;
+
+    nsHybridArray<char, 128> buffer;
+    buffer.SetCountUninitialized(uiCount);
+    inout_schema.ReadBytes(buffer.GetData(), uiCount);
+    out_sString = nsStringView(buffer.GetData(), uiCount);
+    return NS_SUCCESS;
+  }
+} // namespace
+
+// clang-format off
+NS_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ReflectionSerializerPlan)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "Reflection"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    nsPlugin::Events().AddEventHandler(PluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    nsPlugin::Events().RemoveEventHandler(PluginEventHandler);
+    nsReflectionSerializerPlan::ClearCache();
+  }
+
+NS_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+const nsReflectionSerializerPlan* nsReflectionSerializerPlan::GetPlan(const nsRTTI* pType, const void* pObject)
+{
+  auto& cache = GetPlanCache();
+  NS_LOCK(cache.m_Mutex);
+
+  nsReflectionSerializerPlan* pPlan = nullptr;
+  if (cache.m_Plans.TryGetValue(pType, pPlan))
+    return pPlan;
+
+  pPlan = NS_DEFAULT_NEW(nsReflectionSerializerPlan);
+  pPlan->m_pType = pType;
+  // the mutex is recursive, embedded types compile their own plans from within Compile
+  cache.m_Plans.Insert(pType, pPlan);
+  pPlan->Compile(pObject);
+  return pPlan;
+}
+
+void nsReflectionSerializerPlan::ClearCache()
+{
+  auto& cache = GetPlanCache();
+  NS_LOCK(cache.m_Mutex);
+
+  for (auto it : cache.m_Plans)
+  {
+    NS_DEFAULT_DELETE(it.Value());
+  }
+
+  cache.m_Plans.Clear();
+  cache.m_Plans.Compact();
+}
+
+void nsReflectionSerializerPlan::Compile(const void* pObject)
+{
+  nsDynamicArray<nsUInt8> fieldSchema;
+  nsMemoryStreamContainerWrapperStorage<nsDynamicArray<nsUInt8>> fieldStorage(&fieldSchema);
+  nsMemoryStreamWriter schema(&fieldStorage);
+  nsUInt32 uiFields = 0;
+
+  nsHybridArray<const nsAbstractProperty*, 32> properties;
+  m_pType->GetAllProperties(properties);
+
+  for (const nsAbstractProperty* pProp : properties)
+  {
+    if (pProp->GetFlags().IsSet(nsPropertyFlags::ReadOnly))
+      continue;
+
+    const nsRTTI* pPropType = pProp->GetSpecificType();
+    const bool bIsValueType = nsReflectionUtils::IsValueType(pProp);
+
+    Op op;
+    op.m_pProperty = pProp;
+
+    switch (pProp->GetCategory())
+    {
+      case nsPropertyCategory::Member:
+      {
+        auto pSpecific = static_cast<const nsAbstractMemberProperty*>(pProp);
+
+        if (pProp->GetFlags().IsSet(nsPropertyFlags::Pointer))
+          return;
+
+        if (pProp->GetFlags().IsAnySet(nsPropertyFlags::IsEnum | nsPropertyFlags::Bitflags))
+        {
+          op.m_Kind = OpKind::Enumeration;
+        }
+        else if (bIsValueType)
+        {
+          op.m_Kind = OpKind::Value;
+
+          const nsVariantType::Enum type = pPropType->GetVariantType();
+          const nsUInt8* pMember = static_cast<const nsUInt8*>(pSpecific->GetPropertyPointer(pObject));
+          if (pMember != nullptr && IsRawType(type) && GetRawTypeSize(type) == pPropType->GetTypeSize())
+          {
+            op.m_Kind = OpKind::Raw;
+            op.m_uiOffset = static_cast<nsUInt32>(pMember - static_cast<const nsUInt8*>(pObject));
+            op.m_uiSize = pPropType->GetTypeSize();
+          }
+        }
+        else if (pProp->GetFlags().IsSet(nsPropertyFlags::Class))
+        {
+          // nsRttiConverterWriter skips these as well
+          if (pPropType->GetProperties().GetCount() == 0)
+            continue;
+
+          const nsUInt8* pMember = static_cast<const nsUInt8*>(pSpecific->GetPropertyPointer(pObject));
+          if (pMember == nullptr)
+            return;
+
+          op.m_Kind = OpKind::Nested;
+          op.m_uiOffset = static_cast<nsUInt32>(pMember - static_cast<const nsUInt8*>(pObject));
+          op.m_pNested = GetPlan(pPropType, pMember);
+
+          if (!op.m_pNested->IsCompiled())
+            return;
+        }
+        else
+        {
+          return;
+        }
+      }
+      break;
+
+      case nsPropertyCategory::Array:
+      {
+        if (pProp->GetFlags().IsSet(nsPropertyFlags::Pointer) || !bIsValueType)
+          return;
+
+        op.m_Kind = OpKind::ValueArray;
+      }
+      break;
+
+      case nsPropertyCategory::Set:
+      case nsPropertyCategory::Map:
+        return;
+
+      default:
+        continue;
+    }
+
+    ++uiFields;
+    WriteSchemaString(schema, pProp->GetPropertyName());
+    schema << static_cast<nsUInt8>(op.m_Kind);
+    WriteSchemaString(schema, pPropType->GetTypeName());
+    schema << pPropType->GetTypeVersion();
+
+    if (op.m_Kind == OpKind::Raw)
+    {
+      schema << static_cast<nsUInt8>(pPropType->GetVariantType());
+    }
+    else if (op.m_Kind == OpKind::Nested)
+    {
+      schema.WriteBytes(op.m_pNested->m_Schema.GetData(), op.m_pNested->m_Schema.GetCount()).AssertSuccess();
+    }
+
+    // merge adjacent members into one copy
+    if (op.m_Kind == OpKind::Raw && !m_Ops.IsEmpty() && m_Ops.PeekBack().m_Kind == OpKind::Raw &&
+        m_Ops.PeekBack().m_uiOffset + m_Ops.PeekBack().m_uiSize == op.m_uiOffset)
+    {
+      m_Ops.PeekBack().m_uiSize += op.m_uiSize;
+      continue;
+    }
+
+    m_Ops.PushBack(op);
+  }
+
+  nsMemoryStreamContainerWrapperStorage<nsDynamicArray<nsUInt8>> storage(&m_Schema);
+  nsMemoryStreamWriter header(&storage);
+  WriteSchemaString(header, m_pType->GetTypeName());
+  header << m_pType->GetTypeVersion();
+  header << uiFields;
+  header.WriteBytes(fieldSchema.GetData(), fieldSchema.GetCount()).AssertSuccess();
+
+  m_uiSchemaHash = nsHashingUtils::xxHash64(m_Schema.GetData(), m_Schema.GetCount());
+  m_bCompiled = true;
+}
+
+void nsReflectionSerializerPlan::WriteData(nsStreamWriter& inout_stream, const void* pObject) const
+{
+  NS_ASSERT_DEBUG(m_bCompiled, "Type '{}' can't be serialized with a plan", m_pType->GetTypeName());
+
+  const nsUInt8* pBase = static_cast<const nsUInt8*>(pObject);
+
+  for (const Op& op : m_Ops)
+  {
+    switch (op.m_Kind)
+    {
+      case OpKind::Raw:
+        inout_stream.WriteBytes(pBase + op.m_uiOffset, op.m_uiSize).AssertSuccess();
+        break;
+
+      case OpKind::Enumeration:
+        inout_stream << static_cast<const nsAbstractEnumerationProperty*>(op.m_pProperty)->GetValue(pObject);
+        break;
+
+      case OpKind::Value:
+        inout_stream << nsReflectionUtils::GetMemberPropertyValue(static_cast<const nsAbstractMemberProperty*>(op.m_pProperty), pObject);
+        break;
+
+      case OpKind::ValueArray:
+      {
+        auto pSpecific = static_cast<const nsAbstractArrayProperty*>(op.m_pProperty);
+        const nsUInt32 uiCount = pSpecific->GetCount(pObject);
+        inout_stream << uiCount;
+        for (nsUInt32 i = 0; i < uiCount; ++i)
+        {
+          inout_stream << nsReflectionUtils::GetArrayPropertyValue(pSpecific, pObject, i);
+        }
+      }
+      break;
+
+      case OpKind::Nested:
+        op.m_pNested->WriteData(inout_stream, pBase + op.m_uiOffset);
+        break;
+    }
+  }
+}
+
+nsResult nsReflectionSerializerPlan::ReadData(nsStreamReader& inout_stream, void* pObject) const
+{
+  NS_ASSERT_DEBUG(m_bCompiled, "Type '{}' can't be deserialized with a plan", m_pType->GetTypeName());
+
+  nsUInt8* pBase = static_cast<nsUInt8*>(pObject);
+  nsVariant value;
+
+  for (const Op& op : m_Ops)
+  {
+    switch (op.m_Kind)
+    {
+      case OpKind::Raw:
+        if (inout_stream.ReadBytes(pBase + op.m_uiOffset, op.m_uiSize) != op.m_uiSize)
+          return NS_FAILURE;
+        break;
+
+      case OpKind::Enumeration:
+      {
+        nsInt64 iValue = 0;
+        inout_stream >> iValue;
+        static_cast<const nsAbstractEnumerationProperty*>(op.m_pProperty)->SetValue(pObject, iValue);
+      }
+      break;
+
+      case OpKind::Value:
+        inout_stream >> value;
+        nsReflectionUtils::SetMemberPropertyValue(static_cast<const nsAbstractMemberProperty*>(op.m_pProperty), pObject, value);
+        break;
+
+      case OpKind::ValueArray:
+      {
+        auto pSpecific = static_cast<const nsAbstractArrayProperty*>(op.m_pProperty);
+        nsUInt32 uiCount = 0;
+        inout_stream >> uiCount;
+        pSpecific->SetCount(pObject, uiCount);
+        for (nsUInt32 i = 0; i < uiCount; ++i)
+        {
+          inout_stream >> value;
+          nsReflectionUtils::SetArrayPropertyValue(pSpecific, pObject, i, value);
+        }
+      }
+      break;
+
+      case OpKind::Nested:
+        NS_SUCCEED_OR_RETURN(op.m_pNested->ReadData(inout_stream, pBase + op.m_uiOffset));
+        break;
+    }
+  }
+
+  return NS_SUCCESS;
+}
+
+nsAbstractObjectNode* nsReflectionSerializerPlan::ReadDataToGraph(nsArrayPtr<const nsUInt8> schema, nsStreamReader& inout_stream, nsAbstractObjectGraph& ref_graph, nsStringView sNodeName)
+{
+  nsRawMemoryStreamReader schemaReader(schema.GetPtr(), schema.GetCount());
+
+  struct Converter
+  {
+    nsRawMemoryStreamReader& m_Schema;
+    nsStreamReader& m_Data;
+    nsAbstractObjectGraph& m_Graph;
+
+    nsAbstractObjectNode* ReadNode(nsStringView sNodeName)
+    {
+      nsStringBuilder sType;
+      nsUInt32 uiTypeVersion = 0;
+      nsUInt32 uiFields = 0;
+      if (ReadSchemaString(m_Schema, sType).Failed())
+        return nullptr;
+
+      m_Schema >> uiTypeVersion;
+      m_Schema >> uiFields;
+
+      nsAbstractObjectNode* pNode = m_Graph.AddNode(nsUuid::MakeUuid(), sType, uiTypeVersion, sNodeName);
+
+      nsStringBuilder sName;
+      nsStringBuilder sPropType;
+      nsVariant value;
+      nsUInt8 rawBuffer[sizeof(nsMat4)];
+
+      for (nsUInt32 uiField = 0; uiField < uiFields; ++uiField)
+      {
+        nsUInt8 uiKind = 0;
+        nsUInt32 uiPropTypeVersion = 0;
+        if (ReadSchemaString(m_Schema, sName).Failed())
+          return nullptr;
+
+        m_Schema >> uiKind;
+
+        if (ReadSchemaString(m_Schema, sPropType).Failed())
+          return nullptr;
+
+        m_Schema >> uiPropTypeVersion;
+
+        switch (uiKind)
+        {
+          case OpKind::Raw:
+          {
+            nsUInt8 uiVariantType = 0;
+            m_Schema >> uiVariantType;
+
+            const nsVariantType::Enum type = static_cast<nsVariantType::Enum>(uiVariantType);
+            nsUInt32 uiSize = IsRawType(type) ? GetRawTypeSize(type) : 0;
+            if (uiSize == 0 || uiSize > sizeof(rawBuffer) || m_Data.ReadBytes(rawBuffer, uiSize) != uiSize)
+              return nullptr;
+
+            RawValueFunc func;
+            nsVariant::DispatchTo(func, type, rawBuffer, uiSize, &value);
+            pNode->AddProperty(sName, value);
+          }
+          break;
+
+          case OpKind::Enumeration:
+          {
+            nsInt64 iValue = 0;
+            m_Data >> iValue;
+            pNode->AddProperty(sName, iValue);
+          }
+          break;
+
+          case OpKind::Value:
+            m_Data >> value;
+            pNode->AddProperty(sName, value);
+            break;
+
+          case OpKind::ValueArray:
+          {
+            nsUInt32 uiCount = 0;
+            m_Data >> uiCount;
+
+            nsVariantArray values;
+            values.SetCount(uiCount);
+            for (nsUInt32 i = 0; i < uiCount; ++i)
+            {
+              m_Data >> values[i];
+            }
+            pNode->AddProperty(sName, values);
+          }
+          break;
+
+          case OpKind::Nested:
+          {
+            // sName is overwritten while reading the nested node
+            const nsString sPropName = sName;
+            nsAbstractObjectNode* pSubNode = ReadNode({});
+            if (pSubNode == nullptr)
+              return nullptr;
+
+            pNode->AddProperty(sPropName, pSubNode->GetGuid());
+          }
+          break;
+
+          default:
+            return nullptr;
+        }
+      }
+
+      return pNode;
+    }
+  };
+
+  Converter converter{schemaReader, inout_stream, ref_graph};
+  return converter.ReadNode(sNodeName);
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_ReflectionSerializerPlan);
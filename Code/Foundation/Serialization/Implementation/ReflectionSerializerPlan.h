@@ -0,0 +1,83 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Reflection/Reflection.h>
+
+class nsAbstractObjectGraph;
+class nsAbstractObjectNode;
+
+/// \brief A per-type plan used by nsReflectionSerializer to read and write objects straight to a binary stream.
+///
+/// The plan is compiled once per nsRTTI from the reflected properties. Direct POD members become raw byte offsets, where adjacent
+/// members are merged into a single copy, all other supported properties go through their accessors and embedded structs are inlined.
+/// Types with properties that cannot be expressed this way (pointers, sets, maps, arrays of structs, structs behind accessors)
+/// are marked as not compiled and nsReflectionSerializer uses the nsAbstractObjectGraph path for them instead.
+///
+/// Each plan also stores a schema describing the layout. The schema is written in front of the data and its hash is used on
+/// read to decide whether the data can be copied back directly or has to be converted through an object graph.
+/// Streams carry no state across calls, so the full schema is part of every written object, which makes each stream self-describing
+/// at the cost of the schema size (see nsReflectionSerializer::WriteObjectToBinary()).
+class nsReflectionSerializerPlan
+{
+public:
+  /// \brief Returns the cached plan for \a pType, compiling it on first use. \a pObject is an instance of the type.
+  static const nsReflectionSerializerPlan* GetPlan(const nsRTTI* pType, const void* pObject);
+
+  /// \brief Removes all cached plans, e.g. because types have been unloaded.
+  static void ClearCache();
+
+  /// \brief Whether the type can be serialized with this plan at all.
+  bool IsCompiled() const { return m_bCompiled; }
+
+  const nsRTTI* GetType() const { return m_pType; }
+  nsUInt64 GetSchemaHash() const { return m_uiSchemaHash; }
+  nsArrayPtr<const nsUInt8> GetSchema() const { return m_Schema; }
+
+  /// \brief Writes the properties of \a pObject in the layout described by the schema.
+  void WriteData(nsStreamWriter& inout_stream, const void* pObject) const;
+
+  /// \brief Reads data previously written with WriteData by a plan with the same schema hash into \a pObject.
+  nsResult ReadData(nsStreamReader& inout_stream, void* pObject) const;
+
+  /// \brief Reads data that was written by a plan with the given \a schema into an object graph.
+  ///
+  /// This is used when the schema hash in the stream does not match the plan of the reading side, e.g. because the type has changed
+  /// in the meantime. The resulting graph can be applied to an object with nsRttiConverterReader, which matches properties by name.
+  static nsAbstractObjectNode* ReadDataToGraph(nsArrayPtr<const nsUInt8> schema, nsStreamReader& inout_stream, nsAbstractObjectGraph& ref_graph, nsStringView sNodeName);
+
+private:
+  struct OpKind
+  {
+    enum Enum : nsUInt8
+    {
+      Raw,         ///< Bytes copied directly from / to the object at m_uiOffset.
+      Enumeration, ///< Enum or bitflags value, stored as nsInt64.
+      Value,       ///< Value type stored as an nsVariant through the property accessors.
+      ValueArray,  ///< Array of value types, stored as a count followed by nsVariant values.
+      Nested,      ///< Embedded struct at m_uiOffset, serialized with m_pNested.
+    };
+  };
+
+  struct Op
+  {
+    OpKind::Enum m_Kind = OpKind::Raw;
+    nsUInt32 m_uiOffset = 0;
+    nsUInt32 m_uiSize = 0;
+    const nsAbstractProperty* m_pProperty = nullptr;
+    const nsReflectionSerializerPlan* m_pNested = nullptr;
+  };
+
+  void Compile(const void* pObject);
+
+  const nsRTTI* m_pType = nullptr;
+  bool m_bCompiled = false;
+  nsUInt64 m_uiSchemaHash = 0;
+  nsDynamicArray<nsUInt8> m_Schema;
+  nsDynamicArray<Op> m_Ops;
+};
@@ -5,7 +5,10 @@
  */
 #pragma once
 
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/IO/OpenDdlWriter.h>
+#include <Foundation/IO/SerializationContext.h>
 #include <Foundation/Reflection/Reflection.h>
 
 class nsOpenDdlReaderElement;
@@ -30,6 +33,15 @@ public:
   static void WriteObjectToDDL(nsOpenDdlWriter& ref_ddl, const nsRTTI* pRtti, const void* pObject, nsUuid guid = nsUuid()); // [tested]
 
   /// \brief Same as WriteObjectToDDL but binary.
+  ///
+  /// Types that only consist of value type members, value arrays and embedded structs are written directly from their memory layout,
+  /// using a serialization plan that is compiled once per type. All other types go through an nsAbstractObjectGraph.
+  /// The read functions accept both forms. If the type has changed since the data was written, the data is converted through
+  /// an object graph, so properties are still matched by name.
+  ///
+  /// For that, the schema of the plan, i.e. the type name, version and the name and type of each property, is written in front of the data.
+  /// By default every call writes the full schema, which can be larger than the data of small objects. When writing many objects into
+  /// the same stream, use an nsReflectionSerializerSchemaWriteContext to write the schema only once per type.
   static void WriteObjectToBinary(nsStreamWriter& inout_stream, const nsRTTI* pRtti, const void* pObject); // [tested]
 
   /// \brief Reads the entire DDL data in the stream and restores a reflected object.
@@ -80,3 +92,36 @@ public:
     return static_cast<T*>(Clone(pObject, nsGetStaticRTTI<T>()));
   }
 };
+
+/// \brief While this context is active, nsReflectionSerializer::WriteObjectToBinary() writes the schema of each type only once,
+/// later objects of the same type only reference it. Create it on the stack for the duration of writing one stream.
+///
+/// If a type has changed since the stream was written, reading it requires an nsReflectionSerializerSchemaReadContext.
+class NS_FOUNDATION_DLL nsReflectionSerializerSchemaWriteContext : public nsSerializationContext<nsReflectionSerializerSchemaWriteContext>
+{
+  NS_DECLARE_SERIALIZATION_CONTEXT(nsReflectionSerializerSchemaWriteContext);
+
+public:
+  /// \brief Returns true, if the schema with the given hash has not been written to the stream yet. It counts as written afterwards.
+  bool AddSchema(nsUInt64 uiSchemaHash);
+
+private:
+  nsHashSet<nsUInt64> m_WrittenSchemas;
+};
+
+/// \brief Keeps the schemas of a stream written with an nsReflectionSerializerSchemaWriteContext, so that objects which only reference
+/// a schema can be read, even if their type has changed. Create it on the stack for the duration of reading the stream.
+class NS_FOUNDATION_DLL nsReflectionSerializerSchemaReadContext : public nsSerializationContext<nsReflectionSerializerSchemaReadContext>
+{
+  NS_DECLARE_SERIALIZATION_CONTEXT(nsReflectionSerializerSchemaReadContext);
+
+public:
+  /// \brief Stores a schema that was read from the stream.
+  void AddSchema(nsUInt64 uiSchemaHash, nsArrayPtr<const nsUInt8> schema);
+
+  /// \brief Returns the schema with the given hash that was read from the stream before, or an empty array.
+  nsArrayPtr<const nsUInt8> GetSchema(nsUInt64 uiSchemaHash) const;
+
+private:
+  nsHashTable<nsUInt64, nsDynamicArray<nsUInt8>> m_Schemas;
+};
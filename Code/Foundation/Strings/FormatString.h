@@ -11,6 +11,16 @@
 class nsStringBuilder;
 struct nsStringView;
 
+/// \brief A piece of a format string that was split up at compile time (see NS_FMT): a literal text, followed by an optional argument.
+struct nsFormatStringSegment
+{
+  nsUInt32 m_uiStart = 0;
+  nsUInt32 m_uiLength = 0;
+
+  /// \brief The index of the argument that follows the literal text, or -1 for none.
+  nsInt32 m_iArgument = -1;
+};
+
 /// \brief Implements formating of strings with placeholders and formatting options.
 ///
 /// nsFormatString can be used anywhere where a string should be formatable when passing it into a function.
@@ -56,6 +66,9 @@ struct nsStringView;
 /// would otherwise just use uint32 formatting).
 ///
 /// To implement custom formatting see the various free standing 'BuildString' functions.
+///
+/// For string literals prefer NS_FMT over nsFmt. It validates the format string and the number of arguments at compile time
+/// and does not need to parse the format string at runtime.
 class NS_FOUNDATION_DLL nsFormatString
 {
   NS_DISALLOW_COPY_AND_ASSIGN(nsFormatString); // pass by reference, never pass by value
@@ -82,15 +95,28 @@ public:
 
   bool IsEmpty() const { return m_sString.IsEmpty(); }
 
+  /// \brief Returns the format string without the arguments inserted.
+  nsStringView GetFormatString() const { return m_sString; }
+
   /// \brief Helper function to build the formatted text with the given arguments.
   ///
   /// \note We can't use nsArrayPtr here because of include order.
   nsStringView BuildFormattedText(nsStringBuilder& ref_sStorage, nsStringView* pArgs, nsUInt32 uiNumArgs) const;
 
 protected:
+  /// \brief Formats a single argument into szTmp (or returns a view to existing memory).
+  using BuildArgumentFunc = nsStringView (*)(const nsFormatString* pThis, nsUInt32 uiArgument, char* szTmp, nsUInt32 uiLength);
+
+  /// \brief Builds the text from pre-split segments, see nsCompiledFormatStringImpl.
+  nsStringView BuildSegmentedText(nsStringBuilder& ref_sStorage, const nsFormatStringSegment* pSegments, nsUInt32 uiNumSegments, BuildArgumentFunc buildArgument) const;
+
+  /// \brief Writes the text from pre-split segments into a fixed size buffer. Returns the length of the untruncated text.
+  nsUInt32 WriteSegmentedText(char* szBuffer, nsUInt32 uiBufferSize, const nsFormatStringSegment* pSegments, nsUInt32 uiNumSegments, BuildArgumentFunc buildArgument) const;
+
   nsStringView m_sString;
 };
 
+#include <Foundation/Strings/Implementation/FormatStringCompiled.h>
 #include <Foundation/Strings/Implementation/FormatStringImpl.h>
 
 template <typename... ARGS>
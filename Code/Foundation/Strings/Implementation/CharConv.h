@@ -0,0 +1,19 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+// [internal] Only included by translation units that convert between floating point values and text, and by their tests.
+
+#if __has_include(<charconv>)
+#  include <charconv>
+#endif
+
+// Exact floating point support for std::from_chars / std::to_chars is not available in every standard library.
+#if defined(__cpp_lib_to_chars)
+#  define NS_USE_CHARCONV_FLOAT NS_ON
+#else
+#  define NS_USE_CHARCONV_FLOAT NS_OFF
+#endif
@@ -70,15 +70,87 @@ nsStringView nsFormatString::BuildFormattedText(nsStringBuilder& ref_sStorage, n
     }
     else
     {
-      const nsUInt32 character = sString.GetCharacter();
-      ref_sStorage.Append(character);
-      sString.ChopAwayFirstCharacterUtf8();
+      // append everything up to the next potential placeholder at once
+      // '%' and '{' never appear inside of multi-byte Utf8 sequences, so this can't split a character
+      const char* szStart = sString.GetStartPointer();
+      const char* szEnd = sString.GetEndPointer();
+      const char* szCur = szStart + 1;
+
+      while (szCur < szEnd && *szCur != '%' && *szCur != '{')
+        ++szCur;
+
+      ref_sStorage.Append(nsStringView(szStart, szCur));
+      sString.SetStartPosition(szCur);
+    }
+  }
+
+  return ref_sStorage.GetView();
+}
+
+nsStringView nsFormatString::BuildSegmentedText(nsStringBuilder& ref_sStorage, const nsFormatStringSegment* pSegments, nsUInt32 uiNumSegments, BuildArgumentFunc buildArgument) const
+{
+  // same size as the temp buffers that nsFormatStringImpl uses
+  char szTmp[64];
+
+  ref_sStorage.Clear();
+
+  const char* szFormat = m_sString.GetStartPointer();
+
+  for (nsUInt32 i = 0; i < uiNumSegments; ++i)
+  {
+    const nsFormatStringSegment& segment = pSegments[i];
+
+    if (segment.m_uiLength > 0)
+    {
+      ref_sStorage.Append(nsStringView(szFormat + segment.m_uiStart, segment.m_uiLength));
+    }
+
+    if (segment.m_iArgument >= 0)
+    {
+      ref_sStorage.Append(buildArgument(this, segment.m_iArgument, szTmp, NS_ARRAY_SIZE(szTmp) - 1));
     }
   }
 
   return ref_sStorage.GetView();
 }
 
+nsUInt32 nsFormatString::WriteSegmentedText(char* szBuffer, nsUInt32 uiBufferSize, const nsFormatStringSegment* pSegments, nsUInt32 uiNumSegments, BuildArgumentFunc buildArgument) const
+{
+  NS_ASSERT_DEBUG(szBuffer != nullptr && uiBufferSize > 0, "Invalid output buffer");
+
+  char szTmp[64];
+  nsUInt32 uiWritePos = 0;
+
+  auto Write = [&](nsStringView sText)
+  {
+    const nsUInt32 uiLength = sText.GetElementCount();
+
+    if (uiWritePos + 1 < uiBufferSize)
+    {
+      nsMemoryUtils::Copy(szBuffer + uiWritePos, sText.GetStartPointer(), nsMath::Min(uiLength, uiBufferSize - 1 - uiWritePos));
+    }
+
+    uiWritePos += uiLength;
+  };
+
+  const char* szFormat = m_sString.GetStartPointer();
+
+  for (nsUInt32 i = 0; i < uiNumSegments; ++i)
+  {
+    const nsFormatStringSegment& segment = pSegments[i];
+
+    Write(nsStringView(szFormat + segment.m_uiStart, segment.m_uiLength));
+
+    if (segment.m_iArgument >= 0)
+    {
+      Write(buildArgument(this, segment.m_iArgument, szTmp, NS_ARRAY_SIZE(szTmp) - 1));
+    }
+  }
+
+  szBuffer[nsMath::Min(uiWritePos, uiBufferSize - 1)] = '\0';
+  return uiWritePos;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 nsStringView BuildString(char* szTmp, nsUInt32 uiLength, const nsArgI& arg)
@@ -0,0 +1,220 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+/// \brief Splits a format string literal into nsFormatStringSegment's at compile time. Used by NS_FMT.
+///
+/// The parsing rules are the same as in nsFormatString::BuildFormattedText(): '{}' refers to the argument after the previous one,
+/// '{0}' to '{9}' refer to a specific argument and '%%' writes a single percentage sign.
+template <nsUInt32 NumSegments>
+struct nsCompiledFormatString
+{
+  constexpr nsCompiledFormatString(const char* szFormat)
+    : m_szFormat(szFormat)
+  {
+    nsUInt32 uiPos = 0;
+    nsUInt32 uiSegmentStart = 0;
+    nsInt32 iLastArgument = -1;
+
+    while (szFormat[uiPos] != '\0')
+    {
+      const char c = szFormat[uiPos];
+
+      if (c == '%')
+      {
+        if (szFormat[uiPos + 1] == '%')
+        {
+          // keep the first percentage sign as part of the literal, skip the second one
+          AddSegment(uiSegmentStart, uiPos + 1, -1);
+          uiPos += 2;
+          uiSegmentStart = uiPos;
+        }
+        else
+        {
+          m_bSinglePercentSign = true;
+          ++uiPos;
+        }
+      }
+      else if (c == '{' && szFormat[uiPos + 1] >= '0' && szFormat[uiPos + 1] <= '9' && szFormat[uiPos + 2] == '}')
+      {
+        iLastArgument = szFormat[uiPos + 1] - '0';
+        AddSegment(uiSegmentStart, uiPos, iLastArgument);
+        uiPos += 3;
+        uiSegmentStart = uiPos;
+      }
+      else if (c == '{' && szFormat[uiPos + 1] == '}')
+      {
+        ++iLastArgument;
+        AddSegment(uiSegmentStart, uiPos, iLastArgument);
+        uiPos += 2;
+        uiSegmentStart = uiPos;
+      }
+      else
+      {
+        ++uiPos;
+      }
+    }
+
+    AddSegment(uiSegmentStart, uiPos, -1);
+  }
+
+  /// \brief Returns how many segments the format string is split into.
+  static constexpr nsUInt32 CountSegments(const char* szFormat)
+  {
+    nsUInt32 uiNumSegments = 1;
+
+    for (nsUInt32 uiPos = 0; szFormat[uiPos] != '\0'; ++uiPos)
+    {
+      if (szFormat[uiPos] == '%' && szFormat[uiPos + 1] == '%')
+      {
+        ++uiNumSegments;
+        ++uiPos;
+      }
+      else if (szFormat[uiPos] == '{' && szFormat[uiPos + 1] >= '0' && szFormat[uiPos + 1] <= '9' && szFormat[uiPos + 2] == '}')
+      {
+        ++uiNumSegments;
+        uiPos += 2;
+      }
+      else if (szFormat[uiPos] == '{' && szFormat[uiPos + 1] == '}')
+      {
+        ++uiNumSegments;
+        ++uiPos;
+      }
+    }
+
+    return uiNumSegments;
+  }
+
+  /// \brief Whether every argument below uiNumArguments is referenced at least once.
+  constexpr bool UsesAllArguments(nsUInt32 uiNumArguments) const
+  {
+    for (nsUInt32 i = 0; i < uiNumArguments; ++i)
+    {
+      if ((m_uiUsedArguments & (1ull << i)) == 0)
+        return false;
+    }
+
+    return true;
+  }
+
+  const char* m_szFormat = nullptr;
+  nsFormatStringSegment m_Segments[NumSegments] = {};
+  nsUInt32 m_uiNumSegments = 0;
+
+  /// \brief The highest referenced argument index + 1.
+  nsUInt32 m_uiNumArguments = 0;
+  nsUInt64 m_uiUsedArguments = 0;
+  bool m_bSinglePercentSign = false;
+
+private:
+  constexpr void AddSegment(nsUInt32 uiStart, nsUInt32 uiEnd, nsInt32 iArgument)
+  {
+    nsFormatStringSegment& segment = m_Segments[m_uiNumSegments++];
+    segment.m_uiStart = uiStart;
+    segment.m_uiLength = uiEnd - uiStart;
+    segment.m_iArgument = iArgument;
+
+    if (iArgument >= 0)
+    {
+      m_uiNumArguments = m_uiNumArguments > static_cast<nsUInt32>(iArgument + 1) ? m_uiNumArguments : static_cast<nsUInt32>(iArgument + 1);
+      m_uiUsedArguments |= iArgument < 64 ? (1ull << iArgument) : 0;
+    }
+  }
+};
+
+/// \brief Holds the compiled format string for one NS_FMT call site. FORMAT is a type with a static constexpr Get() function that returns
+/// the literal.
+template <typename FORMAT>
+struct nsCompiledFormatStringStorage
+{
+  static constexpr nsCompiledFormatString<nsCompiledFormatString<1>::CountSegments(FORMAT::Get())> s_Format{FORMAT::Get()};
+};
+
+/// \brief The nsFormatString that NS_FMT creates. Unlike nsFormatStringImpl, the format string is not parsed at runtime and the
+/// arguments are written directly into the output, one after the other.
+template <typename FORMAT, typename... ARGS>
+class nsCompiledFormatStringImpl : public nsFormatString
+{
+  static constexpr const auto& s_Format = nsCompiledFormatStringStorage<FORMAT>::s_Format;
+
+  NS_CHECK_AT_COMPILETIME_MSG(!s_Format.m_bSinglePercentSign, "Single percentage signs are not allowed in nsFormatString. Use double percentage signs for the actual character.")
+  NS_CHECK_AT_COMPILETIME_MSG(s_Format.m_uiNumArguments <= sizeof...(ARGS), "The format string references more arguments than were passed.")
+  NS_CHECK_AT_COMPILETIME_MSG(s_Format.UsesAllArguments(sizeof...(ARGS)), "Not all arguments are referenced by the format string.")
+
+public:
+  nsCompiledFormatStringImpl(ARGS&&... args)
+    : m_Arguments(std::forward<ARGS>(args)...)
+  {
+    m_sString = s_Format.m_szFormat;
+  }
+
+  virtual nsStringView GetText(nsStringBuilder& ref_sStorage) const override
+  {
+    return BuildSegmentedText(ref_sStorage, s_Format.m_Segments, s_Format.m_uiNumSegments, &BuildArgumentCallback);
+  }
+
+  virtual const char* GetTextCStr(nsStringBuilder& out_sString) const override
+  {
+    return BuildSegmentedText(out_sString, s_Format.m_Segments, s_Format.m_uiNumSegments, &BuildArgumentCallback).GetStartPointer();
+  }
+
+  /// \brief Writes the formatted text into a fixed size buffer, without any allocations.
+  ///
+  /// The result is always zero terminated and truncated if the buffer is too small.
+  /// Returns the length of the full text (excluding the terminator), like snprintf does.
+  nsUInt32 WriteTo(char* szBuffer, nsUInt32 uiBufferSize) const
+  {
+    return WriteSegmentedText(szBuffer, uiBufferSize, s_Format.m_Segments, s_Format.m_uiNumSegments, &BuildArgumentCallback);
+  }
+
+private:
+  static nsStringView BuildArgumentCallback(const nsFormatString* pThis, nsUInt32 uiArgument, char* szTmp, nsUInt32 uiLength)
+  {
+    return static_cast<const nsCompiledFormatStringImpl*>(pThis)->BuildArgument(uiArgument, szTmp, uiLength, std::index_sequence_for<ARGS...>());
+  }
+
+  template <std::size_t... I>
+  nsStringView BuildArgument(nsUInt32 uiArgument, char* szTmp, nsUInt32 uiLength, std::index_sequence<I...>) const
+  {
+    nsStringView sResult;
+
+    // using a free function allows to overload with various different argument types
+    NS_IGNORE_UNUSED(((uiArgument == I ? (sResult = BuildString(szTmp, uiLength, std::get<I>(m_Arguments)), true) : false) || ...));
+
+    return sResult;
+  }
+
+  // stores the arguments
+  std::tuple<ARGS...> m_Arguments;
+};
+
+template <typename FORMAT, typename... ARGS>
+NS_ALWAYS_INLINE nsCompiledFormatStringImpl<FORMAT, ARGS...> nsMakeCompiledFormatString(ARGS&&... args)
+{
+  return nsCompiledFormatStringImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...);
+}
+
+/// \brief Like nsFmt(), but the format string literal is split up and validated at compile time.
+///
+/// Using a single percentage sign, referencing more arguments than were passed, or passing arguments that are never referenced
+/// results in a compile error. Formatting skips the runtime parsing of the format string and writes the arguments directly into
+/// the output, which makes this the preferred choice for formatting on hot paths, e.g. for frequent log messages.
+///
+/// Example:
+///   nsLog::Info(NS_FMT("Loaded {} of {} assets", uiLoaded, uiTotal));
+///
+/// \note szFormat has to be a string literal.
+#define NS_FMT(szFormat, ...)                                                    \
+  ([&]() {                                                                       \
+    struct nsFormatLiteral                                                       \
+    {                                                                            \
+      static constexpr const char* Get() { return szFormat; }                    \
+    };                                                                           \
+    return nsMakeCompiledFormatString<nsFormatLiteral>(__VA_ARGS__);             \
+  }())
@@ -0,0 +1,203 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Strings/RopeStringBuilder.h>
+#include <Foundation/Strings/StringBuilder.h>
+
+nsRopeStringBuilder::nsRopeStringBuilder(nsAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+  , m_Pieces(pAllocator)
+  , m_Chunks(pAllocator)
+{
+}
+
+nsRopeStringBuilder::~nsRopeStringBuilder()
+{
+  Clear();
+}
+
+void nsRopeStringBuilder::Clear()
+{
+  for (char* pChunk : m_Chunks)
+  {
+    NS_DELETE_RAW_BUFFER(m_pAllocator, pChunk);
+  }
+
+  m_Chunks.Clear();
+  m_Pieces.Clear();
+  m_pChunkCur = nullptr;
+  m_pChunkEnd = nullptr;
+  m_uiElementCount = 0;
+}
+
+void nsRopeStringBuilder::Append(nsStringView sText)
+{
+  const nsUInt32 uiLength = sText.GetElementCount();
+
+  if (uiLength == 0)
+    return;
+
+  const char* pText = StoreText(sText);
+  m_uiElementCount += uiLength;
+
+  // consecutive appends end up next to each other in the same chunk
+  if (!m_Pieces.IsEmpty() && m_Pieces.PeekBack().m_pText + m_Pieces.PeekBack().m_uiLength == pText)
+  {
+    m_Pieces.PeekBack().m_uiLength += uiLength;
+    return;
+  }
+
+  m_Pieces.PushBack({pText, uiLength});
+}
+
+void nsRopeStringBuilder::AppendFormat(const nsFormatString& string)
+{
+  nsStringBuilder tmp;
+  Append(string.GetText(tmp));
+}
+
+void nsRopeStringBuilder::Insert(nsUInt32 uiPosition, nsStringView sText)
+{
+  NS_ASSERT_DEV(uiPosition <= m_uiElementCount, "Insert position {} is outside the string of length {}", uiPosition, m_uiElementCount);
+
+  if (uiPosition == m_uiElementCount)
+  {
+    Append(sText);
+    return;
+  }
+
+  const nsUInt32 uiLength = sText.GetElementCount();
+
+  if (uiLength == 0)
+    return;
+
+  // store the text first, sText may point into a piece that is about to be split
+  const char* pText = StoreText(sText);
+  const nsUInt32 uiIndex = SplitAt(uiPosition);
+  m_uiElementCount += uiLength;
+
+  // typing-like sequences of inserts at the end of the previous insert extend the same piece
+  if (uiIndex > 0 && m_Pieces[uiIndex - 1].m_pText + m_Pieces[uiIndex - 1].m_uiLength == pText)
+  {
+    m_Pieces[uiIndex - 1].m_uiLength += uiLength;
+    return;
+  }
+
+  m_Pieces.Insert({pText, uiLength}, uiIndex);
+}
+
+void nsRopeStringBuilder::Remove(nsUInt32 uiPosition, nsUInt32 uiCount)
+{
+  NS_ASSERT_DEV(uiPosition + uiCount <= m_uiElementCount, "Range {}, {} is outside the string of length {}", uiPosition, uiCount, m_uiElementCount);
+
+  if (uiCount == 0)
+    return;
+
+  const nsUInt32 uiFirst = SplitAt(uiPosition);
+  const nsUInt32 uiEnd = SplitAt(uiPosition + uiCount);
+
+  m_Pieces.RemoveAtAndCopy(uiFirst, uiEnd - uiFirst);
+  m_uiElementCount -= uiCount;
+}
+
+void nsRopeStringBuilder::Replace(nsUInt32 uiPosition, nsUInt32 uiCount, nsStringView sText)
+{
+  // store the text first, sText may point into the range that gets removed
+  const nsUInt32 uiLength = sText.GetElementCount();
+  const char* pText = uiLength > 0 ? StoreText(sText) : nullptr;
+
+  Remove(uiPosition, uiCount);
+
+  if (uiLength > 0)
+  {
+    m_Pieces.Insert({pText, uiLength}, SplitAt(uiPosition));
+    m_uiElementCount += uiLength;
+  }
+}
+
+nsResult nsRopeStringBuilder::WriteTo(nsStreamWriter& inout_stream) const
+{
+  for (const Piece& piece : m_Pieces)
+  {
+    NS_SUCCEED_OR_RETURN(inout_stream.WriteBytes(piece.m_pText, piece.m_uiLength));
+  }
+
+  return NS_SUCCESS;
+}
+
+void nsRopeStringBuilder::GetText(nsStringBuilder& out_sText) const
+{
+  out_sText.Clear();
+  out_sText.Reserve(m_uiElementCount);
+
+  for (const Piece& piece : m_Pieces)
+  {
+    out_sText.Append(nsStringView(piece.m_pText, piece.m_uiLength));
+  }
+}
+
+const char* nsRopeStringBuilder::StoreText(nsStringView sText)
+{
+  const nsUInt32 uiLength = sText.GetElementCount();
+  char* pTarget = nullptr;
+
+  if (uiLength > ChunkSize / 4)
+  {
+    // large texts get their own chunk, to not waste the rest of the current one
+    pTarget = NS_NEW_RAW_BUFFER(m_pAllocator, char, uiLength);
+    m_Chunks.PushBack(pTarget);
+  }
+  else
+  {
+    if (m_pChunkEnd - m_pChunkCur < static_cast<ptrdiff_t>(uiLength))
+    {
+      m_pChunkCur = NS_NEW_RAW_BUFFER(m_pAllocator, char, ChunkSize);
+      m_pChunkEnd = m_pChunkCur + ChunkSize;
+      m_Chunks.PushBack(m_pChunkCur);
+    }
+
+    pTarget = m_pChunkCur;
+    m_pChunkCur += uiLength;
+  }
+
+  nsMemoryUtils::Copy(pTarget, sText.GetStartPointer(), uiLength);
+  return pTarget;
+}
+
+nsUInt32 nsRopeStringBuilder::SplitAt(nsUInt32 uiPosition)
+{
+  if (uiPosition == m_uiElementCount)
+    return m_Pieces.GetCount();
+
+  nsUInt32 uiPieceStart = 0;
+
+  for (nsUInt32 i = 0; i < m_Pieces.GetCount(); ++i)
+  {
+    const Piece piece = m_Pieces[i];
+
+    if (uiPosition == uiPieceStart)
+      return i;
+
+    if (uiPosition < uiPieceStart + piece.m_uiLength)
+    {
+      const nsUInt32 uiOffset = uiPosition - uiPieceStart;
+      NS_ASSERT_DEBUG(!nsUnicodeUtils::IsUtf8ContinuationByte(piece.m_pText[uiOffset]), "Position {} is in the middle of a Utf8 character", uiPosition);
+
+      m_Pieces[i].m_uiLength = uiOffset;
+      m_Pieces.Insert({piece.m_pText + uiOffset, piece.m_uiLength - uiOffset}, i + 1);
+      return i + 1;
+    }
+
+    uiPieceStart += piece.m_uiLength;
+  }
+
+  NS_REPORT_FAILURE("Position {} is outside the string of length {}", uiPosition, m_uiElementCount);
+  return m_Pieces.GetCount();
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Strings_Implementation_RopeStringBuilder);
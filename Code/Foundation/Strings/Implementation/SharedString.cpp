@@ -0,0 +1,50 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Strings/SharedString.h>
+
+void nsSharedString::Assign(nsStringView sString)
+{
+  const nsUInt32 uiElementCount = sString.GetElementCount();
+
+  m_uiElementCount = uiElementCount;
+  m_uiHash = nsHashHelper<nsSharedString>::Hash(sString);
+
+  char* szTarget = m_szInline;
+
+  if (!IsInline())
+  {
+    // the string is stored directly behind the reference count, in the same allocation
+    void* pMemory = nsFoundation::GetDefaultAllocator()->Allocate(offsetof(SharedData, m_szString) + uiElementCount + 1, NS_ALIGNMENT_OF(SharedData));
+    m_pShared = new (pMemory) SharedData();
+    m_pShared->m_iRefCount = 1;
+
+    szTarget = m_pShared->m_szString;
+  }
+
+  nsMemoryUtils::Copy(szTarget, sString.GetStartPointer(), uiElementCount);
+  szTarget[uiElementCount] = '\0';
+}
+
+void nsSharedString::Release()
+{
+  if (IsInline())
+    return;
+
+  if (m_pShared->m_iRefCount.Decrement() == 0)
+  {
+    m_pShared->~SharedData();
+    nsFoundation::GetDefaultAllocator()->Deallocate(m_pShared);
+  }
+}
+
+nsStringView BuildString(char* szTmp, nsUInt32 uiLength, const nsSharedString& sArg)
+{
+  return sArg.GetView();
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Strings_Implementation_SharedString);
@@ -0,0 +1,118 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+NS_ALWAYS_INLINE nsSharedString::nsSharedString()
+{
+  SetEmpty();
+}
+
+inline nsSharedString::nsSharedString(const nsSharedString& rhs)
+{
+  // rhs holds a reference, so the data can't be deleted in the meantime on another thread
+  if (!rhs.IsInline())
+    rhs.m_pShared->m_iRefCount.Increment();
+
+  CopyFrom(rhs);
+}
+
+inline nsSharedString::nsSharedString(nsSharedString&& rhs)
+{
+  CopyFrom(rhs);
+  rhs.SetEmpty();
+}
+
+inline nsSharedString::nsSharedString(const char* szString)
+{
+  Assign(szString);
+}
+
+inline nsSharedString::nsSharedString(nsStringView sString)
+{
+  Assign(sString);
+}
+
+inline nsSharedString::~nsSharedString()
+{
+  Release();
+}
+
+inline void nsSharedString::operator=(const nsSharedString& rhs)
+{
+  // first increase the other refcount, then decrease ours, in case both share the data
+  if (!rhs.IsInline())
+    rhs.m_pShared->m_iRefCount.Increment();
+
+  Release();
+  CopyFrom(rhs);
+}
+
+inline void nsSharedString::operator=(nsSharedString&& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  Release();
+  CopyFrom(rhs);
+  rhs.SetEmpty();
+}
+
+inline void nsSharedString::operator=(const char* szString)
+{
+  *this = nsStringView(szString);
+}
+
+inline void nsSharedString::operator=(nsStringView sString)
+{
+  // sString may point into our own data, so it must be copied before the data is released
+  nsSharedString tmp(sString);
+  *this = std::move(tmp);
+}
+
+inline void nsSharedString::Clear()
+{
+  Release();
+  SetEmpty();
+}
+
+NS_ALWAYS_INLINE const char* nsSharedString::GetData() const
+{
+  return IsInline() ? m_szInline : m_pShared->m_szString;
+}
+
+inline nsUInt32 nsSharedString::GetRefCount() const
+{
+  return IsInline() ? 1 : static_cast<nsUInt32>(m_pShared->m_iRefCount);
+}
+
+inline bool nsSharedString::operator==(const nsSharedString& rhs) const
+{
+  if (m_uiElementCount != rhs.m_uiElementCount || m_uiHash != rhs.m_uiHash)
+    return false;
+
+  if (!IsInline() && m_pShared == rhs.m_pShared)
+    return true;
+
+  return nsMemoryUtils::IsEqual(GetData(), rhs.GetData(), m_uiElementCount);
+}
+
+NS_ALWAYS_INLINE void nsSharedString::SetEmpty()
+{
+  // computed at compile time, this runs on every default construction and move
+  constexpr nsUInt32 uiEmptyHash = nsHashingUtils::StringHashTo32(nsHashingUtils::StringHash(""));
+
+  m_szInline[0] = '\0';
+  m_uiElementCount = 0;
+  m_uiHash = uiEmptyHash;
+}
+
+NS_ALWAYS_INLINE void nsSharedString::CopyFrom(const nsSharedString& rhs)
+{
+  // copies either the inline string or the pointer to the shared data
+  nsMemoryUtils::RawByteCopy(m_szInline, rhs.m_szInline, sizeof(m_szInline));
+  m_uiElementCount = rhs.m_uiElementCount;
+  m_uiHash = rhs.m_uiHash;
+}
@@ -5,6 +5,7 @@
  */
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/SimdMath/SimdTypes.h>
 #include <Foundation/Strings/StringView.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
@@ -53,6 +54,263 @@ void nsStringUtils::PrintStringLengthStatistics()
 
 #endif
 
+namespace
+{
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+  // The functions below process 16 bytes at a time, as long as they only encounter ASCII characters
+  // and fall back to decoding one character at a time otherwise.
+
+  constexpr nsUInt32 s_uiBlockSize = 16;
+
+  /// \brief Whether a whole block can be read at pString. Either the block lies before pStringEnd, or the string is only zero terminated.
+  /// In that case the block may extend past the terminator, but it must not cross into the next page, which might not be mapped.
+  NS_ALWAYS_INLINE bool CanLoadBlock(const char* pString, const char* pStringEnd)
+  {
+    if (pStringEnd == nsUnicodeUtils::GetMaxStringEnd<char>())
+      return (reinterpret_cast<size_t>(pString) & 4095) <= 4096 - s_uiBlockSize;
+
+    return pString < pStringEnd && static_cast<size_t>(pStringEnd - pString) >= s_uiBlockSize;
+  }
+
+  NS_ALWAYS_INLINE __m128i LoadBlock(const char* pString)
+  {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString));
+  }
+
+  /// \brief Bit i is set, if byte i is zero.
+  NS_ALWAYS_INLINE nsUInt32 ZeroMask(__m128i v)
+  {
+    return static_cast<nsUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())));
+  }
+
+  /// \brief Bit i is set, if byte i is not an ASCII character.
+  NS_ALWAYS_INLINE nsUInt32 NonAsciiMask(__m128i v)
+  {
+    return static_cast<nsUInt32>(_mm_movemask_epi8(v));
+  }
+
+  /// \brief Bit i is set, if byte i is equal to c.
+  NS_ALWAYS_INLINE nsUInt32 MatchMask(__m128i v, __m128i c)
+  {
+    return static_cast<nsUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, c)));
+  }
+
+  /// \brief Bit i is set, if byte i starts a new character. UTF-8 continuation bytes are 0x80 to 0xBF, which is -128 to -65 as signed chars.
+  NS_ALWAYS_INLINE nsUInt32 CharacterStartMask(__m128i v)
+  {
+    return ~static_cast<nsUInt32>(_mm_movemask_epi8(_mm_cmplt_epi8(v, _mm_set1_epi8(-64)))) & 0xFFFF;
+  }
+
+  NS_ALWAYS_INLINE __m128i ToUpperAscii(__m128i v)
+  {
+    const __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+    return _mm_sub_epi8(v, _mm_and_si128(isLower, _mm_set1_epi8(0x20)));
+  }
+
+  NS_ALWAYS_INLINE __m128i ToLowerAscii(__m128i v)
+  {
+    const __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_add_epi8(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+  }
+
+  /// \brief Returns how many bytes at the start of both blocks are ASCII characters that are equal when ignoring the case.
+  NS_ALWAYS_INLINE nsUInt32 SkipEqualAsciiNoCase(const char* pString1, const char* pString2)
+  {
+    const __m128i v1 = LoadBlock(pString1);
+    const __m128i v2 = LoadBlock(pString2);
+
+    const nsUInt32 uiSpecial = ZeroMask(v1) | ZeroMask(v2) | NonAsciiMask(v1) | NonAsciiMask(v2);
+    const nsUInt32 uiDifferent = ~MatchMask(ToUpperAscii(v1), ToUpperAscii(v2)) & 0xFFFF;
+    const nsUInt32 uiStop = uiSpecial | uiDifferent;
+
+    return uiStop == 0 ? s_uiBlockSize : nsMath::CountTrailingZeros(uiStop);
+  }
+
+  /// \brief Whether a case-insensitive search for c can compare bytes. Not the case for non-ASCII characters and for 'i' and 's',
+  /// which also compare equal to some non-ASCII characters, see nsStringUtils::ToUpperChar().
+  NS_ALWAYS_INLINE bool CanCompareByteNoCase(char c)
+  {
+    return c > 0 && c != 'i' && c != 'I' && c != 's' && c != 'S';
+  }
+
+  /// \brief Bit i is set, if byte i may be equal to c. When ignoring the case, c must be an ASCII character, for which CanCompareByteNoCase() is true.
+  NS_ALWAYS_INLINE nsUInt32 CandidateMask(__m128i v, char c, bool bIgnoreCase)
+  {
+    if (bIgnoreCase && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')))
+      return MatchMask(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8(c | 0x20));
+
+    return MatchMask(v, _mm_set1_epi8(c));
+  }
+
+  NS_ALWAYS_INLINE bool MatchesAt(const char* pString, const char* pStringEnd, const char* szStringToFind, const char* szStringToFindEnd, bool bIgnoreCase)
+  {
+    if (bIgnoreCase)
+      return nsStringUtils::StartsWith_NoCase(pString, szStringToFind, pStringEnd, szStringToFindEnd);
+
+    return nsStringUtils::StartsWith(pString, szStringToFind, pStringEnd, szStringToFindEnd);
+  }
+
+  /// \brief Searches szStringToFind block by block, starting at ref_pCurPos. Only positions where the first two bytes match are compared in full.
+  ///
+  /// Returns true, if the search is finished, either because ref_pResult was found, or because the end of the source string was reached.
+  /// Otherwise ref_pCurPos is set to the start of the next character that has not been searched yet.
+  bool FindInBlocks(const char*& ref_pCurPos, const char* pSourceEnd, const char* szStringToFind, const char* szStringToFindEnd, bool bIgnoreCase, const char*& ref_pResult)
+  {
+    const char cFirst = szStringToFind[0];
+    const char cSecond = szStringToFind + 1 < szStringToFindEnd ? szStringToFind[1] : '\0';
+    const bool bUseSecond = cSecond != '\0' && (!bIgnoreCase || CanCompareByteNoCase(cSecond));
+
+    const char* pCur = ref_pCurPos;
+
+    while (true)
+    {
+      // the filter on the second byte reads one byte past the block
+      if (!CanLoadBlock(pCur, pSourceEnd) || !CanLoadBlock(pCur + 1, pSourceEnd))
+      {
+        if (pSourceEnd != nsUnicodeUtils::GetMaxStringEnd<char>())
+          break;
+
+        // zero terminated strings are continued byte by byte, until the next page can be reached
+        if (*pCur == '\0')
+          return true;
+
+        if (!nsUnicodeUtils::IsUtf8ContinuationByte(*pCur) && MatchesAt(pCur, pSourceEnd, szStringToFind, szStringToFindEnd, bIgnoreCase))
+        {
+          ref_pResult = pCur;
+          return true;
+        }
+
+        ++pCur;
+        continue;
+      }
+
+      const __m128i v = LoadBlock(pCur);
+      const nsUInt32 uiZeroMask = ZeroMask(v);
+
+      nsUInt32 uiCandidates = CandidateMask(v, cFirst, bIgnoreCase);
+      if (bUseSecond)
+        uiCandidates &= CandidateMask(LoadBlock(pCur + 1), cSecond, bIgnoreCase);
+
+      // ignore everything after the terminator
+      if (uiZeroMask != 0)
+        uiCandidates &= (1u << nsMath::CountTrailingZeros(uiZeroMask)) - 1;
+
+      while (uiCandidates != 0)
+      {
+        const char* pCandidate = pCur + nsMath::CountTrailingZeros(uiCandidates);
+
+        if (MatchesAt(pCandidate, pSourceEnd, szStringToFind, szStringToFindEnd, bIgnoreCase))
+        {
+          ref_pResult = pCandidate;
+          return true;
+        }
+
+        uiCandidates &= uiCandidates - 1;
+      }
+
+      if (uiZeroMask != 0)
+        return true;
+
+      pCur += s_uiBlockSize;
+    }
+
+    // blocks may end in the middle of a character
+    while (pCur < pSourceEnd && nsUnicodeUtils::IsUtf8ContinuationByte(*pCur))
+      ++pCur;
+
+    ref_pCurPos = pCur;
+    return false;
+  }
+#endif
+} // namespace
+
+void nsStringUtils::GetCharacterAndElementCount(const char* szUtf8, nsUInt32& ref_uiCharacterCount, nsUInt32& ref_uiElementCount, const char* pStringEnd)
+{
+  ref_uiCharacterCount = 0;
+  ref_uiElementCount = 0;
+
+  if (IsNullOrEmpty(szUtf8))
+    return;
+
+  const char* pCur = szUtf8;
+  nsUInt32 uiCharacters = 0;
+
+  while (true)
+  {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    if (CanLoadBlock(pCur, pStringEnd))
+    {
+      const __m128i v = LoadBlock(pCur);
+      const nsUInt32 uiZeroMask = ZeroMask(v);
+      const nsUInt32 uiStartMask = CharacterStartMask(v);
+
+      if (uiZeroMask != 0)
+      {
+        const nsUInt32 uiLength = nsMath::CountTrailingZeros(uiZeroMask);
+        uiCharacters += nsMath::CountBits(uiStartMask & ((1u << uiLength) - 1));
+        pCur += uiLength;
+        break;
+      }
+
+      uiCharacters += nsMath::CountBits(uiStartMask);
+      pCur += s_uiBlockSize;
+      continue;
+    }
+#endif
+
+    if (pCur >= pStringEnd || *pCur == '\0')
+      break;
+
+    // skip all the Utf8 continuation bytes
+    if (!nsUnicodeUtils::IsUtf8ContinuationByte(*pCur))
+      ++uiCharacters;
+
+    ++pCur;
+  }
+
+  ref_uiCharacterCount = uiCharacters;
+  ref_uiElementCount = static_cast<nsUInt32>(pCur - szUtf8);
+}
+
+nsUInt32 nsStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
+{
+  nsUInt32 uiCharacters = 0;
+  nsUInt32 uiElements = 0;
+  GetCharacterAndElementCount(szUtf8, uiCharacters, uiElements, pStringEnd);
+  return uiCharacters;
+}
+
+bool nsUnicodeUtils::IsValidUtf8(const char* szString, const char* szStringEnd)
+{
+  if (szStringEnd == GetMaxStringEnd<char>())
+    szStringEnd = szString + strlen(szString);
+
+  const char* pCur = szString;
+
+  while (pCur < szStringEnd)
+  {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    if (CanLoadBlock(pCur, szStringEnd) && NonAsciiMask(LoadBlock(pCur)) == 0)
+    {
+      pCur += s_uiBlockSize;
+      continue;
+    }
+#endif
+
+    if (static_cast<nsUInt8>(*pCur) < 0x80)
+    {
+      ++pCur;
+      continue;
+    }
+
+    // advances pCur to the next character
+    if (utf8::internal::validate_next(pCur, szStringEnd) != utf8::internal::UTF8_OK)
+      return false;
+  }
+
+  return true;
+}
+
 // Unicode ToUpper / ToLower character conversion
 //  License: $(WEB www.boost.org/LICENSE_1_0.txt, Boost License 1.0).
 //  Authors: $(WEB digitalmars.com, Walter Bright), Jonathan M Davis, and Kenji Hara
@@ -212,6 +470,22 @@ nsUInt32 nsStringUtils::ToUpperString(char* pString, const char* pStringEnd)
 
   while (pReadStart < pStringEnd && *pReadStart != '\0')
   {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    if (CanLoadBlock(pReadStart, pStringEnd))
+    {
+      const __m128i v = LoadBlock(pReadStart);
+
+      if ((ZeroMask(v) | NonAsciiMask(v)) == 0)
+      {
+        // the write position never overtakes the read position, and the whole block was already read
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pWriteStart), ToUpperAscii(v));
+        pReadStart += s_uiBlockSize;
+        pWriteStart += s_uiBlockSize;
+        continue;
+      }
+    }
+#endif
+
     const nsUInt32 uiChar = nsUnicodeUtils::DecodeUtf8ToUtf32(pReadStart);
     const nsUInt32 uiCharUpper = nsStringUtils::ToUpperChar(uiChar);
     pWriteStart = utf8::unchecked::utf32to8(&uiCharUpper, &uiCharUpper + 1, pWriteStart);
@@ -230,6 +504,22 @@ nsUInt32 nsStringUtils::ToLowerString(char* pString, const char* pStringEnd)
 
   while (pReadStart < pStringEnd && *pReadStart != '\0')
   {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    if (CanLoadBlock(pReadStart, pStringEnd))
+    {
+      const __m128i v = LoadBlock(pReadStart);
+
+      if ((ZeroMask(v) | NonAsciiMask(v)) == 0)
+      {
+        // the write position never overtakes the read position, and the whole block was already read
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pWriteStart), ToLowerAscii(v));
+        pReadStart += s_uiBlockSize;
+        pWriteStart += s_uiBlockSize;
+        continue;
+      }
+    }
+#endif
+
     const nsUInt32 uiChar = nsUnicodeUtils::DecodeUtf8ToUtf32(pReadStart);
     const nsUInt32 uiCharUpper = nsStringUtils::ToLowerChar(uiChar);
     pWriteStart = utf8::unchecked::utf32to8(&uiCharUpper, &uiCharUpper + 1, pWriteStart);
@@ -340,6 +630,18 @@ nsInt32 nsStringUtils::Compare_NoCase(const char* pString1, const char* pString2
 
   while ((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End))
   {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    if (CanLoadBlock(pString1, pString1End) && CanLoadBlock(pString2, pString2End))
+    {
+      const nsUInt32 uiEqualBytes = SkipEqualAsciiNoCase(pString1, pString2);
+      pString1 += uiEqualBytes;
+      pString2 += uiEqualBytes;
+
+      if (uiEqualBytes > 0)
+        continue;
+    }
+#endif
+
     // utf8::next will already advance the iterators
     const nsUInt32 uiChar1 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString1);
     const nsUInt32 uiChar2 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString2);
@@ -378,6 +680,20 @@ nsInt32 nsStringUtils::CompareN_NoCase(
 
   while ((*pString1 != '\0') && (*pString2 != '\0') && (uiCharsToCompare > 0) && (pString1 < pString1End) && (pString2 < pString2End))
   {
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+    if (uiCharsToCompare >= s_uiBlockSize && CanLoadBlock(pString1, pString1End) && CanLoadBlock(pString2, pString2End))
+    {
+      // only ASCII characters are skipped, so each byte is one character
+      const nsUInt32 uiEqualBytes = SkipEqualAsciiNoCase(pString1, pString2);
+      pString1 += uiEqualBytes;
+      pString2 += uiEqualBytes;
+      uiCharsToCompare -= uiEqualBytes;
+
+      if (uiEqualBytes > 0)
+        continue;
+    }
+#endif
+
     // utf8::next will already advance the iterators
     const nsUInt32 uiChar1 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString1);
     const nsUInt32 uiChar2 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString2);
@@ -615,6 +931,15 @@ const char* nsStringUtils::FindSubString(const char* szSource, const char* szStr
 
   const char* pCurPos = &szSource[0];
 
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+  if (szStringToFind < szStringToFindEnd)
+  {
+    const char* pResult = nullptr;
+    if (FindInBlocks(pCurPos, pSourceEnd, szStringToFind, szStringToFindEnd, false, pResult))
+      return pResult;
+  }
+#endif
+
   while ((pCurPos < pSourceEnd) && (*pCurPos != '\0'))
   {
     if (nsStringUtils::StartsWith(pCurPos, szStringToFind, pSourceEnd, szStringToFindEnd))
@@ -634,6 +959,15 @@ const char* nsStringUtils::FindSubString_NoCase(const char* szSource, const char
 
   const char* pCurPos = &szSource[0];
 
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE
+  if (szStringToFind < szStringToFindEnd && CanCompareByteNoCase(szStringToFind[0]))
+  {
+    const char* pResult = nullptr;
+    if (FindInBlocks(pCurPos, pSourceEnd, szStringToFind, szStringToFindEnd, true, pResult))
+      return pResult;
+  }
+#endif
+
   while ((*pCurPos != '\0') && (pCurPos < pSourceEnd))
   {
     if (nsStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd, szStringToFindEnd))
@@ -81,51 +81,6 @@ nsUInt32 nsStringUtils::GetStringElementCount(const T* pString, const T* pString
   return uiCount;
 }
 
-inline nsUInt32 nsStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
-{
-  if (IsNullOrEmpty(szUtf8))
-    return 0;
-
-  nsUInt32 uiCharacters = 0;
-
-  while ((*szUtf8 != '\0') && (szUtf8 < pStringEnd))
-  {
-    // skip all the Utf8 continuation bytes
-    if (!nsUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
-      ++uiCharacters;
-
-    ++szUtf8;
-  }
-
-  return uiCharacters;
-}
-
-inline void nsStringUtils::GetCharacterAndElementCount(
-  const char* szUtf8, nsUInt32& ref_uiCharacterCount, nsUInt32& ref_uiElementCount, const char* pStringEnd)
-{
-  ref_uiCharacterCount = 0;
-  ref_uiElementCount = 0;
-
-  if (IsNullOrEmpty(szUtf8))
-    return;
-
-  while (szUtf8 < pStringEnd)
-  {
-    char uiByte = *szUtf8;
-    if (uiByte == '\0')
-    {
-      break;
-    }
-
-    // skip all the Utf8 continuation bytes
-    if (!nsUnicodeUtils::IsUtf8ContinuationByte(uiByte))
-      ++ref_uiCharacterCount;
-
-    ++szUtf8;
-    ++ref_uiElementCount;
-  }
-}
-
 NS_ALWAYS_INLINE bool nsStringUtils::IsEqual(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
 {
   return nsStringUtils::Compare(pString1, pString2, pString1End, pString2End) == 0;
@@ -152,14 +152,6 @@ inline nsUInt32 nsUnicodeUtils::GetSizeForCharacterInUtf8(nsUInt32 uiCharacter)
   return 4;
 }
 
-inline bool nsUnicodeUtils::IsValidUtf8(const char* szString, const char* szStringEnd)
-{
-  if (szStringEnd == GetMaxStringEnd<char>())
-    szStringEnd = szString + strlen(szString);
-
-  return utf8::is_valid(szString, szStringEnd);
-}
-
 inline bool nsUnicodeUtils::SkipUtf8Bom(const char*& ref_szUtf8)
 {
   NS_ASSERT_DEBUG(ref_szUtf8 != nullptr, "This function expects non nullptr pointers");
@@ -5,7 +5,9 @@
  */
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Strings/Implementation/CharConv.h>
 #include <Foundation/Strings/StringUtils.h>
+#include <Foundation/Utilities/ConversionUtils.h>
 
 // This is an implementation of the sprintf function, with an additional buffer size
 // On some systems this is implemented under the name 'snprintf'
@@ -407,6 +409,44 @@ static void FormatUInt(char* szOutputBuffer, int& ref_iNumDigits, unsigned long
   if (iPrecision > 64)
     iPrecision = 64;
 
+  if (uiBase == 10)
+  {
+    // two digits at a time, this halves the number of (expensive) 64 bit divisions
+    static constexpr char s_szDigitPairs[] = "00010203040506070809"
+                                             "10111213141516171819"
+                                             "20212223242526272829"
+                                             "30313233343536373839"
+                                             "40414243444546474849"
+                                             "50515253545556575859"
+                                             "60616263646566676869"
+                                             "70717273747576777879"
+                                             "80818283848586878889"
+                                             "90919293949596979899";
+
+    while (uiValue >= 100)
+    {
+      const unsigned int uiPair = static_cast<unsigned int>(uiValue % 100) * 2;
+      uiValue /= 100;
+
+      // the buffer is written in reverse order
+      szOutputBuffer[ref_iNumDigits++] = s_szDigitPairs[uiPair + 1];
+      szOutputBuffer[ref_iNumDigits++] = s_szDigitPairs[uiPair];
+    }
+
+    if (uiValue >= 10)
+    {
+      const unsigned int uiPair = static_cast<unsigned int>(uiValue) * 2;
+      szOutputBuffer[ref_iNumDigits++] = s_szDigitPairs[uiPair + 1];
+      szOutputBuffer[ref_iNumDigits++] = s_szDigitPairs[uiPair];
+    }
+    else if (uiValue > 0)
+    {
+      szOutputBuffer[ref_iNumDigits++] = static_cast<char>('0' + uiValue);
+    }
+
+    uiValue = 0;
+  }
+
   while (uiValue > 0)
   {
     const unsigned int digit = uiValue % uiBase;
@@ -873,6 +913,124 @@ static void OutputFloat_Short(char* szOutputBuffer, unsigned int uiBufferSize, u
     OutputFloat(szOutputBuffer, uiBufferSize, ref_uiWritePos, value, iWidth, iPrecF, uiFlags, bUpperCase, bScientific, iPrecision < 0);
 }
 
+template <typename FloatType>
+static void OutputShortestFloat(char* szOutputBuffer, unsigned int uiBufferSize, unsigned int& ref_uiWritePos, FloatType value)
+{
+  if (IsNaN(value))
+  {
+    OutputNaN(szOutputBuffer, uiBufferSize, ref_uiWritePos);
+    return;
+  }
+
+  if (!IsFinite(value))
+  {
+    if (value < 0)
+      OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, '-');
+
+    OutputInf(szOutputBuffer, uiBufferSize, ref_uiWritePos);
+    return;
+  }
+
+  // first get the shortest digits in scientific notation
+  char szBuffer[64];
+  unsigned int uiLength = 0;
+
+#if NS_ENABLED(NS_USE_CHARCONV_FLOAT)
+  uiLength = static_cast<unsigned int>(std::to_chars(szBuffer, szBuffer + sizeof(szBuffer) - 1, value, std::chars_format::scientific).ptr - szBuffer);
+  szBuffer[uiLength] = '\0';
+#else
+  // without Ryu-style formatting available, increase the precision until the text converts back to the same value
+  const int iMaxPrecision = sizeof(FloatType) == 8 ? 16 : 8;
+
+  for (int iPrecision = 0; iPrecision <= iMaxPrecision; ++iPrecision)
+  {
+    uiLength = 0;
+    OutputFloat(szBuffer, sizeof(szBuffer), uiLength, value, 0, iPrecision, 0, false, true, false);
+    szBuffer[uiLength] = '\0';
+
+    FloatType parsed = 0;
+    if (nsConversionUtils::StringToFloat(szBuffer, parsed).Succeeded() && parsed == value)
+      break;
+  }
+#endif
+
+  // then lay them out, like JavaScript does: plain notation for exponents in (-7, 21), scientific notation otherwise
+  char szDigits[32];
+  int iNumDigits = 0;
+  int iExponent = 0;
+  bool bExponentIsNegative = false;
+
+  const char* szCur = szBuffer;
+
+  if (*szCur == '-')
+  {
+    OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, '-');
+    ++szCur;
+  }
+
+  for (; *szCur != '\0' && *szCur != 'e' && *szCur != 'E'; ++szCur)
+  {
+    if (*szCur >= '0' && *szCur <= '9' && iNumDigits < (int)sizeof(szDigits))
+      szDigits[iNumDigits++] = *szCur;
+  }
+
+  if (*szCur != '\0')
+    ++szCur;
+
+  for (; *szCur != '\0'; ++szCur)
+  {
+    if (*szCur == '-')
+      bExponentIsNegative = true;
+    else if (*szCur >= '0' && *szCur <= '9')
+      iExponent = iExponent * 10 + (*szCur - '0');
+  }
+
+  if (bExponentIsNegative)
+    iExponent = -iExponent;
+
+  while (iNumDigits > 1 && szDigits[iNumDigits - 1] == '0')
+    --iNumDigits;
+
+  if (iExponent > -7 && iExponent < 21)
+  {
+    if (iExponent < 0)
+    {
+      OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, '0');
+      OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, '.');
+      OutputPadding(szOutputBuffer, uiBufferSize, ref_uiWritePos, -iExponent - 1, '0');
+
+      for (int i = 0; i < iNumDigits; ++i)
+        OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, szDigits[i]);
+    }
+    else
+    {
+      for (int i = 0; i < iNumDigits; ++i)
+      {
+        if (i == iExponent + 1)
+          OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, '.');
+
+        OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, szDigits[i]);
+      }
+
+      OutputPadding(szOutputBuffer, uiBufferSize, ref_uiWritePos, iExponent + 1 - iNumDigits, '0');
+    }
+  }
+  else
+  {
+    OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, szDigits[0]);
+
+    if (iNumDigits > 1)
+      OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, '.');
+
+    for (int i = 1; i < iNumDigits; ++i)
+      OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, szDigits[i]);
+
+    OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, 'e');
+    OutputChar(szOutputBuffer, uiBufferSize, ref_uiWritePos, iExponent < 0 ? '-' : '+');
+    OutputUInt(szOutputBuffer, uiBufferSize, ref_uiWritePos, iExponent < 0 ? -iExponent : iExponent, 0, -1, 0, 10, false);
+  }
+}
+
 int nsStringUtils::vsnprintf(char* szOutputBuffer, unsigned int uiBufferSize, const char* szFormat, va_list szArgs0)
 {
   va_list args;
@@ -1094,5 +1252,14 @@ void nsStringUtils::OutputFormattedFloat(char* szOutputBuffer, nsUInt32 uiBuffer
     false, bScientific, bRemoveTrailingZeroes);
 }
 
+void nsStringUtils::OutputShortestFloat(char* szOutputBuffer, nsUInt32 uiBufferSize, nsUInt32& ref_uiWritePos, double value)
+{
+  ::OutputShortestFloat(szOutputBuffer, uiBufferSize, ref_uiWritePos, value);
+}
+
+void nsStringUtils::OutputShortestFloat(char* szOutputBuffer, nsUInt32 uiBufferSize, nsUInt32& ref_uiWritePos, float value)
+{
+  ::OutputShortestFloat(szOutputBuffer, uiBufferSize, ref_uiWritePos, value);
+}
 
 NS_STATICLINK_FILE(Foundation, Foundation_Strings_Implementation_snprintf);
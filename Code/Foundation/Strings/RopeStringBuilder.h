@@ -0,0 +1,110 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/FormatString.h>
+#include <Foundation/Strings/StringView.h>
+
+class nsStreamWriter;
+class nsStringBuilder;
+
+/// \brief A string builder for generating large texts, which never moves text that was already added.
+///
+/// nsStringBuilder stores its text in one contiguous buffer, so appending to a large string regularly reallocates and copies the whole
+/// buffer, and every insertion in the middle moves everything behind it. nsRopeStringBuilder instead copies all added text into
+/// fixed size chunks that never move, and represents the string as a sequence of pieces, each referencing a range of text in those chunks
+/// (a piece table).
+///
+/// Appending copies the new text into the current chunk and usually only extends the last piece. Inserting, removing and replacing text
+/// only splits and inserts pieces, so the cost depends on the number of pieces, not on the length of the text. The text of removed or
+/// replaced pieces stays in the chunks until Clear() is called.
+///
+/// Use WriteTo() to write the text to a stream piece by piece, without building a contiguous copy, or GetText() to get it as one string.
+/// All positions are byte offsets, which must not point into the middle of a Utf8 character.
+class NS_FOUNDATION_DLL nsRopeStringBuilder
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsRopeStringBuilder);
+
+public:
+  /// \brief Text is stored in chunks of this size. Larger texts get a chunk of their own.
+  static constexpr nsUInt32 ChunkSize = 16 * 1024;
+
+  nsRopeStringBuilder(nsAllocatorBase* pAllocator = nsFoundation::GetDefaultAllocator()); // [tested]
+  ~nsRopeStringBuilder(); // [tested]
+
+  /// \brief Removes all text and frees all chunks.
+  void Clear(); // [tested]
+
+  /// \brief Returns the number of bytes in the string.
+  nsUInt32 GetElementCount() const { return m_uiElementCount; } // [tested]
+
+  /// \brief Returns whether the string is empty.
+  bool IsEmpty() const { return m_uiElementCount == 0; } // [tested]
+
+  /// \brief Returns the number of pieces that the string currently consists of.
+  nsUInt32 GetPieceCount() const { return m_Pieces.GetCount(); } // [tested]
+
+  /// \brief Appends the given text.
+  void Append(nsStringView sText); // [tested]
+
+  /// \brief Appends a formatted string. Uses '{}' formatting placeholders, see nsFormatString for details.
+  void AppendFormat(const nsFormatString& string); // [tested]
+
+  /// \brief Appends a formatted string. Uses '{}' formatting placeholders, see nsFormatString for details.
+  template <typename... ARGS>
+  void AppendFormat(const char* szFormat, ARGS&&... args) // [tested]
+  {
+    AppendFormat(nsFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...));
+  }
+
+  /// \brief Inserts the given text in front of the byte at uiPosition. uiPosition may be equal to GetElementCount(), to append.
+  void Insert(nsUInt32 uiPosition, nsStringView sText); // [tested]
+
+  /// \brief Removes uiCount bytes, starting at uiPosition.
+  void Remove(nsUInt32 uiPosition, nsUInt32 uiCount); // [tested]
+
+  /// \brief Replaces uiCount bytes, starting at uiPosition, with the given text.
+  void Replace(nsUInt32 uiPosition, nsUInt32 uiCount, nsStringView sText); // [tested]
+
+  /// \brief Writes the text to the stream, one piece at a time.
+  nsResult WriteTo(nsStreamWriter& inout_stream) const; // [tested]
+
+  /// \brief Copies the whole text into out_sText.
+  void GetText(nsStringBuilder& out_sText) const; // [tested]
+
+  /// \brief Calls func(nsStringView) for every piece of the text, in order.
+  template <typename Func>
+  void IteratePieces(Func func) const // [tested]
+  {
+    for (const Piece& piece : m_Pieces)
+    {
+      func(nsStringView(piece.m_pText, piece.m_uiLength));
+    }
+  }
+
+private:
+  struct Piece
+  {
+    NS_DECLARE_POD_TYPE();
+
+    const char* m_pText;
+    nsUInt32 m_uiLength;
+  };
+
+  /// \brief Copies the text into the chunks and returns where it was stored.
+  const char* StoreText(nsStringView sText);
+
+  /// \brief Makes sure a piece starts at uiPosition and returns its index.
+  nsUInt32 SplitAt(nsUInt32 uiPosition);
+
+  nsAllocatorBase* m_pAllocator;
+  nsDynamicArray<Piece> m_Pieces;
+  nsDynamicArray<char*> m_Chunks;
+  char* m_pChunkCur = nullptr;
+  char* m_pChunkEnd = nullptr;
+  nsUInt32 m_uiElementCount = 0;
+};
@@ -0,0 +1,151 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Strings/StringView.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+/// \brief An immutable string that is cheap to copy, also across threads.
+///
+/// Short strings (up to InlineCapacity bytes) are stored inside the object itself. Longer strings are stored in a single heap allocation,
+/// which is shared by all copies and freed when the last copy is destroyed. The reference count is atomic, so copies may be created and
+/// destroyed on different threads. The string data itself is never modified after construction.
+///
+/// Unlike nsHashedString, nsSharedString does not use a central storage, so creating one never requires a lock. Identical strings that
+/// were created separately do not share their data though, so tables that store the same long strings many times should copy them from
+/// one nsSharedString, instead of constructing new ones from the string data.
+///
+/// The hash of the string is computed once on construction, so nsSharedString works well as a key in nsHashTable and nsHashSet.
+/// The hash is the same as the one of nsHashHelper<nsStringView>, so tables can be searched with any string view.
+class NS_FOUNDATION_DLL nsSharedString
+{
+public:
+  /// \brief Strings with up to this many bytes (excluding the terminator) are stored inside the object and don't allocate.
+  static constexpr nsUInt32 InlineCapacity = 23;
+
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
+  /// \brief Initializes this string to the empty string.
+  nsSharedString(); // [tested]
+
+  /// \brief Shares the data of rhs.
+  nsSharedString(const nsSharedString& rhs); // [tested]
+
+  /// \brief Takes over the data of rhs, which is empty afterwards.
+  nsSharedString(nsSharedString&& rhs); // [tested]
+
+  /// \brief Copies the given string.
+  nsSharedString(const char* szString); // [tested]
+
+  /// \brief Copies the given string.
+  nsSharedString(nsStringView sString); // [tested]
+
+  /// \brief Releases the reference to the shared data.
+  ~nsSharedString(); // [tested]
+
+  /// \brief Shares the data of rhs.
+  void operator=(const nsSharedString& rhs); // [tested]
+
+  /// \brief Takes over the data of rhs, which is empty afterwards.
+  void operator=(nsSharedString&& rhs); // [tested]
+
+  /// \brief Replaces the string with a copy of the given string.
+  void operator=(const char* szString); // [tested]
+
+  /// \brief Replaces the string with a copy of the given string.
+  void operator=(nsStringView sString); // [tested]
+
+  /// \brief Resets the string to the empty string.
+  void Clear(); // [tested]
+
+  /// \brief Returns a pointer to the zero terminated Utf8 string.
+  const char* GetData() const; // [tested]
+
+  /// \brief Returns the number of bytes in the string, excluding the terminator.
+  nsUInt32 GetElementCount() const { return m_uiElementCount; } // [tested]
+
+  /// \brief Returns whether the string is empty.
+  bool IsEmpty() const { return m_uiElementCount == 0; } // [tested]
+
+  /// \brief Returns the hash of the string, which is identical to nsHashHelper<nsStringView>::Hash().
+  nsUInt32 GetHash() const { return m_uiHash; } // [tested]
+
+  /// \brief Returns whether the string is stored inside the object, rather than in shared heap memory.
+  bool IsInline() const { return m_uiElementCount <= InlineCapacity; } // [tested]
+
+  /// \brief Returns how many nsSharedString objects share the data of this string. Always 1 for inline strings.
+  nsUInt32 GetRefCount() const; // [tested]
+
+  /// \brief Returns a string view to this string's data.
+  nsStringView GetView() const { return nsStringView(GetData(), m_uiElementCount); } // [tested]
+
+  /// \brief Returns a string view to this string's data.
+  operator nsStringView() const { return GetView(); } // [tested]
+
+  /// \brief Compares the strings. Strings that share their data or have different hashes are detected without looking at the data.
+  bool operator==(const nsSharedString& rhs) const; // [tested]
+
+  /// \brief Compares the strings.
+  bool operator==(nsStringView rhs) const { return GetView() == rhs; } // [tested]
+
+  /// \brief Compares the strings.
+  bool operator==(const char* szRhs) const { return GetView() == nsStringView(szRhs); } // [tested]
+
+  /// \brief \see operator==
+  bool operator!=(const nsSharedString& rhs) const { return !(*this == rhs); } // [tested]
+
+  /// \brief \see operator==
+  bool operator!=(nsStringView rhs) const { return !(*this == rhs); } // [tested]
+
+  /// \brief \see operator==
+  bool operator!=(const char* szRhs) const { return !(*this == szRhs); } // [tested]
+
+  /// \brief Sorts strings alphabetically (by their Utf8 bytes).
+  bool operator<(const nsSharedString& rhs) const { return GetView() < rhs.GetView(); } // [tested]
+
+private:
+  struct SharedData
+  {
+    nsAtomicInteger32 m_iRefCount;
+    char m_szString[1];
+  };
+
+  void Assign(nsStringView sString);
+  void Release();
+  void SetEmpty();
+  void CopyFrom(const nsSharedString& rhs);
+
+  union
+  {
+    char m_szInline[InlineCapacity + 1];
+    SharedData* m_pShared;
+  };
+
+  nsUInt32 m_uiElementCount = 0;
+  nsUInt32 m_uiHash = 0;
+};
+
+template <>
+struct nsHashHelper<nsSharedString>
+{
+  NS_ALWAYS_INLINE static nsUInt32 Hash(const nsSharedString& sValue) { return sValue.GetHash(); }
+
+  NS_ALWAYS_INLINE static nsUInt32 Hash(nsStringView sValue) { return nsHashingUtils::StringHashTo32(nsHashingUtils::StringHash(sValue)); }
+
+  NS_ALWAYS_INLINE static nsUInt32 Hash(const char* szValue) { return Hash(nsStringView(szValue)); }
+
+  NS_ALWAYS_INLINE static bool Equal(const nsSharedString& a, const nsSharedString& b) { return a == b; }
+
+  NS_ALWAYS_INLINE static bool Equal(const nsSharedString& a, nsStringView b) { return a == b; }
+
+  NS_ALWAYS_INLINE static bool Equal(const nsSharedString& a, const char* b) { return a == b; }
+};
+
+// For nsFormatString
+NS_FOUNDATION_DLL nsStringView BuildString(char* szTmp, nsUInt32 uiLength, const nsSharedString& sArg);
+
+#include <Foundation/Strings/Implementation/SharedString_inl.h>
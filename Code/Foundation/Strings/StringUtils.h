@@ -275,6 +275,16 @@ public:
   /// \brief [internal] Prefer to use snprintf.
   static void OutputFormattedFloat(char* szOutputBuffer, nsUInt32 uiBufferSize, nsUInt32& ref_uiWritePos, double value, nsUInt8 uiWidth, bool bPadZeros, nsInt8 iPrecision, bool bScientific, bool bRemoveTrailingZeroes = false);
 
+  /// \brief Writes the shortest decimal representation of value that converts back to exactly the same value.
+  ///
+  /// Values with a decimal exponent between -7 and 21 (exclusive) are written in plain notation (e.g. "0.00001" or "230000"), all others in
+  /// scientific notation (e.g. "1e+300"). The output is independent of the current locale.
+  /// nsConversionUtils::StringToFloat() reads the output back without any loss.
+  static void OutputShortestFloat(char* szOutputBuffer, nsUInt32 uiBufferSize, nsUInt32& ref_uiWritePos, double value);
+
+  /// \brief Same as the double overload, but finds the shortest text for the float value, e.g. 0.1f is written as "0.1" and not as "0.10000000149011612".
+  static void OutputShortestFloat(char* szOutputBuffer, nsUInt32 uiBufferSize, nsUInt32& ref_uiWritePos, float value);
+
 #if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
   static void AddUsedStringLength(nsUInt32 uiLength);
   static void PrintStringLengthStatistics();
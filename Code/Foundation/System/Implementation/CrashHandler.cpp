@@ -84,6 +84,9 @@ void nsCrashHandler_WriteMiniDump::SetDumpFilePath(nsStringView sAppName, nsBitf
 
 void nsCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
 {
+  // make sure the messages that led up to the crash are not stuck in the async log queues
+  nsGlobalLog::FlushAsyncMessages();
+
   bool crashDumpWritten = false;
   if (!m_sDumpFilePath.IsEmpty())
   {
@@ -63,8 +63,8 @@ namespace nsConversionUtils
   ///   Commas (',') are never treated as fractional part separators (as in the German locale).
   /// \param out_Res
   ///   If NS_SUCCESS is returned, out_Res will contain the result. Otherwise it stays unmodified.
-  ///   The result may have rounding errors, i.e. even though a double may be able to represent the string value exactly, there is no
-  ///   guarantee that out_Res will be 100% identical. If that is required, use the C lib atof() function.
+  ///   The result is the floating point value that is closest to the decimal value in the string, i.e. it is rounded correctly, where
+  ///   the standard library supports exact conversions (std::from_chars). Short values are converted directly without a library call.
   /// \param out_LastParsePosition
   ///   On success out_LastParsePosition will contain the address of the character in szString that stopped the parser. This might point
   ///   to the zero terminator of szString, or to some unexpected character, since for example "5+6" will parse as '5' and '+' will be the
@@ -80,11 +80,14 @@ namespace nsConversionUtils
   ///   point value, at all. atof() just returns zero in such a case. Also the way whitespace and signs at the beginning of the string are
   ///   handled is different and StringToFloat will return 'success' if it finds anything that can be parsed as a float, even if the string
   ///   continues with invalid text. So you can parse "2.54f+3.5" as "2.54f" and out_LastParsePosition will tell you where the parser
-  ///   stopped. On the down-side StringToFloat() is probably not as precise as atof(), because of a very simplistic conversion algorithm.
-  ///   If you require the features of StringToFloat() and the precision of atof(), you can let StringToFloat() handle the cases for
-  ///   detecting the validity, the sign and where the value ends and then use atof to parse only that substring with maximum precision.
+  ///   stopped. Unlike atof(), the result does not depend on the current locale.
   NS_FOUNDATION_DLL nsResult StringToFloat(nsStringView sText, double& out_fRes, const char** out_pLastParsePosition = nullptr); // [tested]
 
+  /// \brief Same as StringToFloat() for doubles, but rounds the value directly to the closest float.
+  ///
+  /// This avoids the double rounding that happens when the double result is cast to float afterwards.
+  NS_FOUNDATION_DLL nsResult StringToFloat(nsStringView sText, float& out_fRes, const char** out_pLastParsePosition = nullptr);
+
   /// \brief Parses szString and checks that the first word it finds starts with a phrase that can be interpreted as a boolean value.
   ///
   /// \param szString
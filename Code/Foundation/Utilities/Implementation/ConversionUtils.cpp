@@ -6,6 +6,7 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/Implementation/CharConv.h>
 #include <Foundation/Types/Variant.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
@@ -164,7 +165,23 @@ namespace nsConversionUtils
     return NS_SUCCESS;
   }
 
-  nsResult StringToFloat(nsStringView sText, double& out_fRes, const char** out_pLastParsePosition)
+  /// Exactly representable powers of ten, used for the fast path of the float conversion.
+  static constexpr double s_fPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  /// The maximum number of significant digits that are taken into account. This is more than any double needs to be rounded correctly,
+  /// all further digits only act as a sticky bit.
+  static constexpr nsUInt32 s_uiMaxSignificantDigits = 800;
+
+  /// The mantissa is exact for this many digits in the fast path. (10^15 < 2^53 and 10^7 < 2^24)
+  template <typename FloatType>
+  static constexpr nsUInt32 s_uiMaxFastPathDigits = sizeof(FloatType) == 8 ? 15 : 7;
+
+  /// The largest power of ten that is exact in the floating point type.
+  template <typename FloatType>
+  static constexpr nsInt64 s_iMaxFastPathExponent = sizeof(FloatType) == 8 ? 22 : 10;
+
+  template <typename FloatType>
+  static nsResult StringToFloatingPoint(nsStringView sText, FloatType& out_fRes, const char** out_pLastParsePosition)
   {
     if (sText.IsEmpty())
       return NS_FAILURE;
@@ -187,20 +204,74 @@ namespace nsConversionUtils
 
     NumberPart Part = Integer;
 
-    nsUInt64 uiIntegerPart = 0;    // with 64 Bit to represent the values a 32 Bit float value can be stored, but a 64 Bit double cannot
-    nsUInt64 uiFractionalPart = 0; // lets just assume we won't have such large or precise values stored in text form
-    nsUInt64 uiFractionDivisor = 1;
-    nsUInt64 uiExponentPart = 0;
+    // The significant digits (without leading zeros) are collected in the form "<digits>e<exponent>", which can be converted exactly.
+    // Small values are additionally accumulated in uiMantissa, so that the common cases can be computed directly.
+    char szNormalized[s_uiMaxSignificantDigits + 32];
+    nsUInt32 uiNumDigits = 0;
+    nsUInt64 uiMantissa = 0;
+    nsInt64 iDigitsExponent = 0;
+    nsInt64 iExponentPart = 0;
     bool bExponentIsPositive = true;
+    bool bDroppedDigits = false;
 
-    while (!sText.IsEmpty())
+    const char* pCur = sText.GetStartPointer();
+    const char* pEnd = sText.GetEndPointer();
+
+    auto AddDigit = [&](char c, bool bFraction)
     {
-      const char c = *sText.GetStartPointer();
+      if (uiNumDigits == 0 && c == '0')
+      {
+        // leading zeros only shift the exponent of the following digits
+        if (bFraction)
+          --iDigitsExponent;
+
+        return;
+      }
+
+      if (uiNumDigits < s_uiMaxSignificantDigits)
+      {
+        if (uiNumDigits < 19)
+          uiMantissa = uiMantissa * 10 + (c - '0');
+
+        szNormalized[uiNumDigits++] = c;
+
+        if (bFraction)
+          --iDigitsExponent;
+      }
+      else
+      {
+        bDroppedDigits |= (c != '0');
+
+        if (!bFraction)
+          ++iDigitsExponent;
+      }
+    };
+
+    auto StartExponent = [&]()
+    {
+      Part = Exponent;
+      ++pCur;
+
+      if (pCur < pEnd && *pCur == '-')
+      {
+        bExponentIsPositive = false;
+        ++pCur;
+      }
+      else if (pCur < pEnd && *pCur == '+')
+      {
+        bExponentIsPositive = true;
+        ++pCur;
+      }
+    };
+
+    while (pCur < pEnd)
+    {
+      const char c = *pCur;
 
       // allow underscores in floats for improved readability
       if (c == '_')
       {
-        sText.ChopAwayFirstCharacterAscii();
+        ++pCur;
         continue;
       }
 
@@ -209,41 +280,27 @@ namespace nsConversionUtils
         if (c == '.')
         {
           Part = Fraction;
-          sText.ChopAwayFirstCharacterAscii();
+          ++pCur;
           continue;
         }
 
         // c++ ' separator can appear starting with the second digit
-        if (uiIntegerPart > 0 && c == '\'')
+        if (uiNumDigits > 0 && c == '\'')
         {
-          sText.ChopAwayFirstCharacterAscii();
+          ++pCur;
           continue;
         }
 
         if (c >= '0' && c <= '9')
         {
-          uiIntegerPart *= 10;
-          uiIntegerPart += c - '0';
-          sText.ChopAwayFirstCharacterAscii();
+          AddDigit(c, false);
+          ++pCur;
           continue;
         }
 
         if ((c == 'e') || (c == 'E'))
         {
-          Part = Exponent;
-          sText.ChopAwayFirstCharacterAscii();
-
-          if (*sText.GetStartPointer() == '-')
-          {
-            bExponentIsPositive = false;
-            sText.ChopAwayFirstCharacterAscii();
-          }
-          else if (*sText.GetStartPointer() == '+')
-          {
-            bExponentIsPositive = true;
-            sText.ChopAwayFirstCharacterAscii();
-          }
-
+          StartExponent();
           continue;
         }
       }
@@ -251,29 +308,14 @@ namespace nsConversionUtils
       {
         if (c >= '0' && c <= '9')
         {
-          uiFractionalPart *= 10;
-          uiFractionalPart += c - '0';
-          uiFractionDivisor *= 10;
-          sText.ChopAwayFirstCharacterAscii();
+          AddDigit(c, true);
+          ++pCur;
           continue;
         }
 
         if ((c == 'e') || (c == 'E'))
         {
-          Part = Exponent;
-          sText.ChopAwayFirstCharacterAscii();
-
-          if (*sText.GetStartPointer() == '-')
-          {
-            bExponentIsPositive = false;
-            sText.ChopAwayFirstCharacterAscii();
-          }
-          else if (*sText.GetStartPointer() == '+')
-          {
-            bExponentIsPositive = true;
-            sText.ChopAwayFirstCharacterAscii();
-          }
-
+          StartExponent();
           continue;
         }
       }
@@ -281,9 +323,11 @@ namespace nsConversionUtils
       {
         if (c >= '0' && c <= '9')
         {
-          uiExponentPart *= 10;
-          uiExponentPart += c - '0';
-          sText.ChopAwayFirstCharacterAscii();
+          // clamp, anything this large is either zero or infinity anyway
+          if (iExponentPart < 100000)
+            iExponentPart = iExponentPart * 10 + (c - '0');
+
+          ++pCur;
           continue;
         }
       }
@@ -292,26 +336,66 @@ namespace nsConversionUtils
       break;
     }
 
-    // we might lose some precision here, but at least up to this point no precision loss was accumulated yet
-    out_fRes = (double)uiIntegerPart + (double)uiFractionalPart / (double)uiFractionDivisor;
+    if (out_pLastParsePosition)
+      *out_pLastParsePosition = pCur;
 
-    if (!bSignIsPos)
-      out_fRes = -out_fRes;
+    const nsInt64 iExponent = iDigitsExponent + (bExponentIsPositive ? iExponentPart : -iExponentPart);
+    FloatType fResult = 0;
 
-    if (out_pLastParsePosition)
-      *out_pLastParsePosition = sText.GetStartPointer();
+    if (uiNumDigits == 0)
+    {
+      fResult = 0;
+    }
+    else if (uiNumDigits <= s_uiMaxFastPathDigits<FloatType> && iExponent >= -s_iMaxFastPathExponent<FloatType> && iExponent <= s_iMaxFastPathExponent<FloatType>)
+    {
+      // both the mantissa and the power of ten are exact, so a single multiplication or division is correctly rounded
+      const FloatType fMantissa = static_cast<FloatType>(uiMantissa);
+      const FloatType fPower = static_cast<FloatType>(s_fPowersOfTen[iExponent < 0 ? -iExponent : iExponent]);
 
-    if (Part == Exponent)
+      fResult = iExponent < 0 ? fMantissa / fPower : fMantissa * fPower;
+    }
+    else
     {
-      if (bExponentIsPositive)
-        out_fRes *= nsMath::Pow(10.0, (double)uiExponentPart);
-      else
-        out_fRes /= nsMath::Pow(10.0, (double)uiExponentPart);
+      if (bDroppedDigits)
+      {
+        // acts as a sticky digit, so that values exactly half way between two floats are still rounded correctly
+        szNormalized[uiNumDigits++] = '1';
+      }
+
+      const nsInt64 iNormalizedExponent = iExponent - (bDroppedDigits ? 1 : 0);
+
+#if NS_ENABLED(NS_USE_CHARCONV_FLOAT)
+      nsUInt32 uiLength = uiNumDigits;
+      szNormalized[uiLength++] = 'e';
+      const std::to_chars_result res = std::to_chars(szNormalized + uiLength, szNormalized + sizeof(szNormalized), iNormalizedExponent);
+      uiLength = static_cast<nsUInt32>(res.ptr - szNormalized);
+
+      if (std::from_chars(szNormalized, szNormalized + uiLength, fResult).ec == std::errc::result_out_of_range)
+      {
+        // over- or underflow
+        fResult = iNormalizedExponent > 0 ? nsMath::Infinity<FloatType>() : static_cast<FloatType>(0);
+      }
+#else
+      // without an exact conversion available, compute the result from the first 19 digits
+      const nsInt64 iMantissaExponent = iNormalizedExponent + (nsInt64)(uiNumDigits - nsMath::Min<nsUInt32>(uiNumDigits, 19));
+      fResult = static_cast<FloatType>((double)uiMantissa * nsMath::Pow(10.0, (double)iMantissaExponent));
+#endif
     }
 
+    out_fRes = bSignIsPos ? fResult : -fResult;
     return NS_SUCCESS;
   }
 
+  nsResult StringToFloat(nsStringView sText, double& out_fRes, const char** out_pLastParsePosition)
+  {
+    return StringToFloatingPoint(sText, out_fRes, out_pLastParsePosition);
+  }
+
+  nsResult StringToFloat(nsStringView sText, float& out_fRes, const char** out_pLastParsePosition)
+  {
+    return StringToFloatingPoint(sText, out_fRes, out_pLastParsePosition);
+  }
+
   nsResult StringToBool(nsStringView sText, bool& out_bRes, const char** out_pLastParsePosition)
   {
     SkipWhitespace(sText);
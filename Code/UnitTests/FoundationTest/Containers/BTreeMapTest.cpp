@@ -0,0 +1,424 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/BTreeMap.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/String.h>
+
+namespace
+{
+  /// \brief Checks that the B-tree contains exactly the same elements as the reference map, in both directions.
+  template <typename BTree, typename Reference>
+  void CompareToReference(const BTree& tree, const Reference& reference)
+  {
+    NS_TEST_INT(tree.GetCount(), reference.GetCount());
+
+    auto itRef = reference.GetIterator();
+    for (auto it : tree)
+    {
+      NS_TEST_BOOL(itRef.IsValid());
+      if (!itRef.IsValid())
+        return;
+
+      NS_TEST_BOOL(it.Key() == itRef.Key());
+      NS_TEST_BOOL(it.Value() == itRef.Value());
+      ++itRef;
+    }
+    NS_TEST_BOOL(!itRef.IsValid());
+
+    itRef = reference.GetLastIterator();
+    for (auto it = tree.GetLastIterator(); it.IsValid(); --it)
+    {
+      NS_TEST_BOOL(itRef.IsValid());
+      if (!itRef.IsValid())
+        return;
+
+      NS_TEST_BOOL(it.Key() == itRef.Key());
+      --itRef;
+    }
+    NS_TEST_BOOL(!itRef.IsValid());
+  }
+
+  template <typename KeyType, typename MakeKey>
+  void RandomOperations(MakeKey makeKey, nsUInt32 uiKeyRange)
+  {
+    nsRandom rnd;
+    rnd.Initialize(27);
+
+    nsBTreeMap<KeyType, nsInt32> tree;
+    nsMap<KeyType, nsInt32> reference;
+
+    for (nsUInt32 i = 0; i < 20000; ++i)
+    {
+      const KeyType key = makeKey(rnd.UIntInRange(uiKeyRange));
+
+      switch (rnd.UIntInRange(5))
+      {
+        case 0:
+        case 1:
+          tree.Insert(key, i);
+          reference.Insert(key, i);
+          break;
+
+        case 2:
+          NS_TEST_BOOL(tree.Remove(key) == reference.Remove(key));
+          break;
+
+        case 3:
+        {
+          auto it = tree.LowerBound(key);
+          auto itRef = reference.LowerBound(key);
+          NS_TEST_BOOL(it.IsValid() == itRef.IsValid());
+
+          if (it.IsValid() && itRef.IsValid())
+          {
+            NS_TEST_BOOL(it.Key() == itRef.Key());
+
+            // removing returns the next element
+            it = tree.Remove(it);
+            itRef = reference.Remove(itRef);
+            NS_TEST_BOOL(it.IsValid() == itRef.IsValid());
+
+            if (it.IsValid() && itRef.IsValid())
+              NS_TEST_BOOL(it.Key() == itRef.Key());
+          }
+          break;
+        }
+
+        case 4:
+        {
+          auto it = tree.UpperBound(key);
+          auto itRef = reference.UpperBound(key);
+          NS_TEST_BOOL(it.IsValid() == itRef.IsValid());
+
+          if (it.IsValid() && itRef.IsValid())
+            NS_TEST_BOOL(it.Key() == itRef.Key());
+
+          NS_TEST_BOOL(tree.Contains(key) == reference.Contains(key));
+          break;
+        }
+      }
+    }
+
+    CompareToReference(tree, reference);
+
+    // remove everything again in random order, so that all nodes get merged
+    while (!reference.IsEmpty())
+    {
+      const KeyType key = makeKey(rnd.UIntInRange(uiKeyRange));
+      auto itRef = reference.LowerBound(key);
+      if (!itRef.IsValid())
+        itRef = reference.GetIterator();
+
+      NS_TEST_BOOL(tree.Remove(itRef.Key()));
+      reference.Remove(itRef);
+    }
+
+    NS_TEST_BOOL(tree.IsEmpty());
+    NS_TEST_INT(tree.GetHeapMemoryUsage(), 0);
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Containers, BTreeMap)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Constructor / Clear")
+  {
+    NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+
+    {
+      nsBTreeMap<nsConstructionCounter, nsConstructionCounter> m;
+      NS_TEST_BOOL(m.IsEmpty());
+      NS_TEST_INT(m.GetCount(), 0);
+      NS_TEST_INT(m.GetHeapMemoryUsage(), 0);
+      NS_TEST_BOOL(!m.GetIterator().IsValid());
+      NS_TEST_BOOL(!m.GetLastIterator().IsValid());
+
+      for (nsInt32 i = 0; i < 1000; ++i)
+        m[nsConstructionCounter(i)] = nsConstructionCounter(i * 2);
+
+      NS_TEST_INT(m.GetCount(), 1000);
+      NS_TEST_BOOL(m.GetHeapMemoryUsage() > 0);
+
+      m.Clear();
+      NS_TEST_BOOL(m.IsEmpty());
+      NS_TEST_INT(m.GetHeapMemoryUsage(), 0);
+      NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+
+      for (nsInt32 i = 0; i < 1000; ++i)
+        m.Insert(nsConstructionCounter(i), nsConstructionCounter(i));
+
+      for (nsInt32 i = 0; i < 1000; i += 2)
+        NS_TEST_BOOL(m.Remove(nsConstructionCounter(i)));
+    }
+
+    NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Insert / Find")
+  {
+    nsBTreeMap<nsInt32, nsInt32> m;
+
+    for (nsInt32 i = 0; i < 1000; ++i)
+    {
+      // insert in an order that splits nodes at all positions
+      const nsInt32 iKey = (i * 7919) % 1000;
+      m.Insert(iKey, iKey * 10);
+    }
+
+    NS_TEST_INT(m.GetCount(), 1000);
+
+    for (nsInt32 i = 0; i < 1000; ++i)
+    {
+      NS_TEST_BOOL(m.Contains(i));
+      NS_TEST_INT(m.Find(i).Value(), i * 10);
+    }
+
+    NS_TEST_BOOL(!m.Contains(-1));
+    NS_TEST_BOOL(!m.Find(1000).IsValid());
+
+    // inserting an existing key overwrites the value
+    auto it = m.Insert(5, 0);
+    NS_TEST_INT(it.Key(), 5);
+    NS_TEST_INT(it.Value(), 0);
+    NS_TEST_INT(m.GetCount(), 1000);
+
+    bool bExisted = false;
+    NS_TEST_INT(m.FindOrAdd(6, &bExisted).Value(), 60);
+    NS_TEST_BOOL(bExisted);
+    NS_TEST_INT(m.FindOrAdd(-6, &bExisted).Value(), 0);
+    NS_TEST_BOOL(!bExisted);
+    NS_TEST_INT(m.GetCount(), 1001);
+
+    m[-6] = 42;
+    NS_TEST_INT(m[-6], 42);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "GetValue / TryGetValue")
+  {
+    nsBTreeMap<nsString, nsInt32> m;
+    m["a"] = 1;
+    m["b"] = 2;
+    m[nsStringView("c")] = 3;
+
+    const auto& cm = m;
+
+    nsInt32 iValue = 0;
+    NS_TEST_BOOL(cm.TryGetValue("b", iValue));
+    NS_TEST_INT(iValue, 2);
+    NS_TEST_BOOL(!cm.TryGetValue("d", iValue));
+
+    const nsInt32* pConstValue = nullptr;
+    NS_TEST_BOOL(cm.TryGetValue(nsStringView("c"), pConstValue));
+    NS_TEST_INT(*pConstValue, 3);
+
+    nsInt32* pValue = nullptr;
+    NS_TEST_BOOL(cm.TryGetValue(nsString("a"), pValue));
+    *pValue = 10;
+
+    NS_TEST_INT(*m.GetValue("a"), 10);
+    NS_TEST_BOOL(cm.GetValue("d") == nullptr);
+    NS_TEST_INT(cm.GetValueOrDefault("d", 4), 4);
+    NS_TEST_INT(cm.GetValueOrDefault("c", 4), 3);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "LowerBound / UpperBound")
+  {
+    nsBTreeMap<nsInt32, nsInt32> m;
+
+    m[0] = 0;
+    m[3] = 30;
+    m[7] = 70;
+    m[9] = 90;
+
+    NS_TEST_INT(m.LowerBound(-1).Key(), 0);
+    NS_TEST_INT(m.LowerBound(0).Key(), 0);
+    NS_TEST_INT(m.LowerBound(1).Key(), 3);
+    NS_TEST_INT(m.LowerBound(3).Key(), 3);
+    NS_TEST_INT(m.LowerBound(4).Key(), 7);
+    NS_TEST_INT(m.LowerBound(8).Key(), 9);
+    NS_TEST_INT(m.LowerBound(9).Key(), 9);
+    NS_TEST_BOOL(!m.LowerBound(10).IsValid());
+
+    NS_TEST_INT(m.UpperBound(-1).Key(), 0);
+    NS_TEST_INT(m.UpperBound(0).Key(), 3);
+    NS_TEST_INT(m.UpperBound(3).Key(), 7);
+    NS_TEST_INT(m.UpperBound(8).Key(), 9);
+    NS_TEST_BOOL(!m.UpperBound(9).IsValid());
+    NS_TEST_BOOL(!m.UpperBound(10).IsValid());
+
+    // across many leaves
+    m.Clear();
+    for (nsInt32 i = 0; i < 10000; i += 2)
+      m[i] = i;
+
+    for (nsInt32 i = 0; i < 9998; ++i)
+    {
+      NS_TEST_INT(m.LowerBound(i).Key(), (i + 1) & ~1);
+      NS_TEST_INT(m.UpperBound(i).Key(), (i + 2) & ~1);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Iteration")
+  {
+    nsBTreeMap<nsUInt32, nsUInt32> m;
+
+    for (nsUInt32 i = 1000; i > 0; --i)
+      m[i] = i * 2;
+
+    nsUInt32 uiExpected = 1;
+    for (auto it : m)
+    {
+      NS_TEST_INT(it.Key(), uiExpected);
+      it.Value() = uiExpected;
+      ++uiExpected;
+    }
+    NS_TEST_INT(uiExpected, 1001);
+
+    const auto& cm = m;
+    for (auto it = cm.GetLastIterator(); it.IsValid(); it.Prev())
+    {
+      --uiExpected;
+      NS_TEST_INT(it.Key(), uiExpected);
+      NS_TEST_INT(it.Value(), uiExpected);
+    }
+    NS_TEST_INT(uiExpected, 1);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Remove (Iterator)")
+  {
+    nsBTreeMap<nsInt32, nsInt32> m;
+
+    for (nsInt32 i = 0; i < 1000; ++i)
+      m[i] = i;
+
+    // remove every other element while iterating
+    for (auto it = m.GetIterator(); it.IsValid();)
+    {
+      const nsInt32 iKey = it.Key();
+      it = m.Remove(it);
+
+      if (it.IsValid())
+      {
+        NS_TEST_INT(it.Key(), iKey + 1);
+        ++it;
+      }
+    }
+
+    NS_TEST_INT(m.GetCount(), 500);
+
+    nsInt32 iExpected = 1;
+    for (auto it : m)
+    {
+      NS_TEST_INT(it.Key(), iExpected);
+      iExpected += 2;
+    }
+
+    for (auto it = m.GetIterator(); it.IsValid();)
+      it = m.Remove(it);
+
+    NS_TEST_BOOL(m.IsEmpty());
+    NS_TEST_BOOL(!m.Remove(0));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Copy / operator== / Swap")
+  {
+    nsBTreeMap<nsString, nsInt32> m1;
+    for (nsInt32 i = 0; i < 500; ++i)
+    {
+      nsStringBuilder sKey;
+      sKey.Format("Key{}", i);
+      m1[sKey] = i;
+    }
+
+    nsBTreeMap<nsString, nsInt32> m2(m1);
+    NS_TEST_BOOL(m1 == m2);
+
+    m2["Key7"] = 8;
+    NS_TEST_BOOL(m1 != m2);
+
+    m2 = m1;
+    NS_TEST_BOOL(m1 == m2);
+
+    m2.Remove("Key7");
+    NS_TEST_BOOL(m1 != m2);
+
+    nsBTreeMap<nsString, nsInt32> m3;
+    m3["Other"] = 1;
+
+    m3.Swap(m2);
+    NS_TEST_INT(m2.GetCount(), 1);
+    NS_TEST_INT(m3.GetCount(), 499);
+    NS_TEST_BOOL(!m3.Contains("Key7"));
+    NS_TEST_INT(m3["Key8"], 8);
+    NS_TEST_INT(m2["Other"], 1);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Random Operations")
+  {
+    // these use the SIMD search
+    RandomOperations<nsInt32>([](nsUInt32 i)
+      { return static_cast<nsInt32>(i) - 1000; }, 3000);
+    RandomOperations<nsUInt32>([](nsUInt32 i)
+      { return i * 0x10001u; }, 3000);
+
+    RandomOperations<nsUInt64>([](nsUInt32 i)
+      { return static_cast<nsUInt64>(i) << 33; }, 3000);
+    RandomOperations<nsString>([](nsUInt32 i)
+      {
+        nsStringBuilder s;
+        s.Format("{}", i);
+        return nsString(s); },
+      1000);
+    RandomOperations<nsConstructionCounter>([](nsUInt32 i)
+      { return nsConstructionCounter(i); }, 1000);
+
+    NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "nsBTreeSearch")
+  {
+    const nsInt32 signedKeys[] = {-100, -5, -5, 0, 1, 7, 7, 7, 30};
+    const nsUInt32 unsignedKeys[] = {0, 1, 5, 5, 0x7FFFFFFFu, 0x80000000u, 0x80000000u, 0xFFFFFFFFu};
+
+    for (nsUInt32 uiCount = 0; uiCount <= NS_ARRAY_SIZE(signedKeys); ++uiCount)
+    {
+      for (nsInt32 iKey = -101; iKey <= 31; ++iKey)
+      {
+        nsUInt32 uiLess = 0;
+        nsUInt32 uiLessEqual = 0;
+        for (nsUInt32 i = 0; i < uiCount; ++i)
+        {
+          uiLess += signedKeys[i] < iKey ? 1 : 0;
+          uiLessEqual += signedKeys[i] <= iKey ? 1 : 0;
+        }
+
+        NS_TEST_INT(nsBTreeSearch::CountLess(signedKeys, uiCount, iKey), uiLess);
+        NS_TEST_INT(nsBTreeSearch::CountLessEqual(signedKeys, uiCount, iKey), uiLessEqual);
+      }
+    }
+
+    const nsUInt32 testKeys[] = {0, 1, 2, 5, 6, 0x7FFFFFFEu, 0x7FFFFFFFu, 0x80000000u, 0x80000001u, 0xFFFFFFFEu, 0xFFFFFFFFu};
+
+    for (nsUInt32 uiCount = 0; uiCount <= NS_ARRAY_SIZE(unsignedKeys); ++uiCount)
+    {
+      for (nsUInt32 uiKey : testKeys)
+      {
+        nsUInt32 uiLess = 0;
+        nsUInt32 uiLessEqual = 0;
+        for (nsUInt32 i = 0; i < uiCount; ++i)
+        {
+          uiLess += unsignedKeys[i] < uiKey ? 1 : 0;
+          uiLessEqual += unsignedKeys[i] <= uiKey ? 1 : 0;
+        }
+
+        NS_TEST_INT(nsBTreeSearch::CountLess(unsignedKeys, uiCount, uiKey), uiLess);
+        NS_TEST_INT(nsBTreeSearch::CountLessEqual(unsignedKeys, uiCount, uiKey), uiLessEqual);
+      }
+    }
+  }
+}
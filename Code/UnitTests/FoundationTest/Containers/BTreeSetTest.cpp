@@ -0,0 +1,114 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/BTreeSet.h>
+#include <Foundation/Containers/Set.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/String.h>
+
+NS_CREATE_SIMPLE_TEST(Containers, BTreeSet)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Insert / Remove / Find")
+  {
+    {
+      nsBTreeSet<nsConstructionCounter> s;
+
+      for (nsInt32 i = 0; i < 500; ++i)
+        s.Insert(nsConstructionCounter(i));
+
+      NS_TEST_INT(s.GetCount(), 500);
+      NS_TEST_INT(s.Insert(nsConstructionCounter(5)).Key().m_iData, 5);
+      NS_TEST_INT(s.GetCount(), 500);
+
+      NS_TEST_BOOL(s.Contains(nsConstructionCounter(499)));
+      NS_TEST_BOOL(s.Find(nsConstructionCounter(3)).IsValid());
+      NS_TEST_BOOL(!s.Find(nsConstructionCounter(500)).IsValid());
+
+      NS_TEST_BOOL(s.Remove(nsConstructionCounter(3)));
+      NS_TEST_BOOL(!s.Remove(nsConstructionCounter(3)));
+      NS_TEST_INT(s.GetCount(), 499);
+    }
+
+    NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+
+    nsBTreeSet<nsString> s;
+    s.Insert("b");
+    s.Insert(nsStringView("a"));
+    s.Insert(nsString("c"));
+
+    nsStringBuilder sAll;
+    for (const nsString& sKey : s)
+      sAll.Append(sKey);
+
+    NS_TEST_STRING(sAll, "abc");
+    NS_TEST_BOOL(s.Contains("a"));
+    NS_TEST_BOOL(!s.Contains("d"));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "LowerBound / UpperBound")
+  {
+    nsBTreeSet<nsUInt32> s;
+
+    for (nsUInt32 i = 0; i < 10000; i += 10)
+      s.Insert(i);
+
+    NS_TEST_INT(*s.LowerBound(0u), 0);
+    NS_TEST_INT(*s.LowerBound(1u), 10);
+    NS_TEST_INT(*s.LowerBound(10u), 10);
+    NS_TEST_INT(*s.UpperBound(10u), 20);
+    NS_TEST_INT(*s.UpperBound(9989u), 9990);
+    NS_TEST_BOOL(!s.LowerBound(9991u).IsValid());
+    NS_TEST_BOOL(!s.UpperBound(9990u).IsValid());
+    NS_TEST_INT(s.GetLastIterator().Key(), 9990);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Random Operations")
+  {
+    nsRandom rnd;
+    rnd.Initialize(11);
+
+    nsBTreeSet<nsInt32> s;
+    nsSet<nsInt32> reference;
+
+    for (nsUInt32 i = 0; i < 20000; ++i)
+    {
+      const nsInt32 iKey = static_cast<nsInt32>(rnd.UIntInRange(2000)) - 1000;
+
+      if (rnd.UIntInRange(3) != 0)
+      {
+        s.Insert(iKey);
+        reference.Insert(iKey);
+      }
+      else
+      {
+        NS_TEST_BOOL(s.Remove(iKey) == reference.Remove(iKey));
+      }
+    }
+
+    NS_TEST_INT(s.GetCount(), reference.GetCount());
+
+    auto itRef = reference.GetIterator();
+    for (nsInt32 iKey : s)
+    {
+      NS_TEST_INT(iKey, itRef.Key());
+      ++itRef;
+    }
+
+    nsBTreeSet<nsInt32> s2(s);
+    NS_TEST_BOOL(s2 == s);
+
+    for (auto it = s2.GetIterator(); it.IsValid();)
+      it = s2.Remove(it);
+
+    NS_TEST_BOOL(s2.IsEmpty());
+    NS_TEST_BOOL(s2 != s);
+
+    s2.Swap(s);
+    NS_TEST_BOOL(s.IsEmpty());
+    NS_TEST_INT(s2.GetCount(), reference.GetCount());
+  }
+}
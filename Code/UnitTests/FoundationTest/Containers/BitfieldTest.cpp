@@ -203,6 +203,129 @@ NS_CREATE_SIMPLE_TEST(Containers, Bitfield)
     NS_TEST_BOOL(bf.IsNoBitSet() == false);
     NS_TEST_BOOL(bf.AreAllBitsSet() == true);
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "GetNumBitsSet / GetLowestBitSet / FindNextBitSet")
+  {
+    nsDynamicBitfield bf;
+
+    NS_TEST_INT(bf.GetNumBitsSet(), 0);
+    NS_TEST_INT(bf.GetLowestBitSet(), 0);
+
+    bf.SetCount(250, false);
+
+    NS_TEST_INT(bf.GetNumBitsSet(), 0);
+    NS_TEST_INT(bf.GetLowestBitSet(), 250);
+    NS_TEST_INT(bf.FindNextBitSet(100), 250);
+
+    // the unused bits of the last int must not be counted
+    bf.SetAllBits();
+    NS_TEST_INT(bf.GetNumBitsSet(), 250);
+    NS_TEST_INT(bf.GetLowestBitSet(), 0);
+
+    bf.ClearAllBits();
+    bf.SetBit(31);
+    bf.SetBit(32);
+    bf.SetBit(200);
+    bf.SetBit(249);
+
+    NS_TEST_INT(bf.GetNumBitsSet(), 4);
+    NS_TEST_INT(bf.GetLowestBitSet(), 31);
+    NS_TEST_INT(bf.FindNextBitSet(31), 31);
+    NS_TEST_INT(bf.FindNextBitSet(32), 32);
+    NS_TEST_INT(bf.FindNextBitSet(33), 200);
+    NS_TEST_INT(bf.FindNextBitSet(201), 249);
+    NS_TEST_INT(bf.FindNextBitSet(250), 250);
+
+    bf.SetBitRange(64, 100);
+    NS_TEST_INT(bf.GetNumBitsSet(), 104);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Set Bit Iteration")
+  {
+    nsDynamicBitfield bf;
+    bf.SetCount(1000, false);
+
+    nsUInt32 uiNumBits = 0;
+    for (nsUInt32 uiBit : bf.GetSetBitIndices())
+    {
+      NS_IGNORE_UNUSED(uiBit);
+      ++uiNumBits;
+    }
+    NS_TEST_INT(uiNumBits, 0);
+
+    nsDynamicArray<nsUInt32> expected;
+    for (nsUInt32 i = 0; i < 1000; i += (i % 7) + 1)
+    {
+      bf.SetBit(i);
+      expected.PushBack(i);
+    }
+    bf.SetBit(999);
+    expected.PushBack(999);
+
+    nsDynamicArray<nsUInt32> iterated;
+    for (nsUInt32 uiBit : bf.GetSetBitIndices())
+    {
+      iterated.PushBack(uiBit);
+    }
+
+    NS_TEST_BOOL(iterated == expected);
+
+    uiNumBits = 0;
+    for (auto it = bf.GetSetBitIterator(); it.IsValid(); it.Next())
+    {
+      NS_TEST_BOOL(bf.IsBitSet(it.Value()));
+      ++uiNumBits;
+    }
+    NS_TEST_INT(uiNumBits, expected.GetCount());
+
+    // unused bits in the last int are not returned
+    nsHybridBitfield<64> bf2;
+    bf2.SetCount(33, false);
+    bf2.SetAllBits();
+    uiNumBits = 0;
+    for (nsUInt32 uiBit : bf2.GetSetBitIndices())
+    {
+      NS_TEST_INT(uiBit, uiNumBits);
+      ++uiNumBits;
+    }
+    NS_TEST_INT(uiNumBits, 33);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Boolean Operations")
+  {
+    nsDynamicBitfield a;
+    nsHybridBitfield<100> b;
+    a.SetCount(100, false);
+    b.SetCount(100, false);
+
+    for (nsUInt32 i = 0; i < 100; i += 2)
+      a.SetBit(i);
+
+    for (nsUInt32 i = 0; i < 100; i += 3)
+      b.SetBit(i);
+
+    nsDynamicBitfield c = a;
+    c &= b;
+    for (nsUInt32 i = 0; i < 100; ++i)
+      NS_TEST_BOOL(c.IsBitSet(i) == (i % 6 == 0));
+
+    c = a;
+    c |= b;
+    for (nsUInt32 i = 0; i < 100; ++i)
+      NS_TEST_BOOL(c.IsBitSet(i) == (i % 2 == 0 || i % 3 == 0));
+
+    c = a;
+    c ^= b;
+    for (nsUInt32 i = 0; i < 100; ++i)
+      NS_TEST_BOOL(c.IsBitSet(i) == ((i % 2 == 0) != (i % 3 == 0)));
+
+    c = a;
+    c.ClearBits(b);
+    for (nsUInt32 i = 0; i < 100; ++i)
+      NS_TEST_BOOL(c.IsBitSet(i) == (i % 2 == 0 && i % 3 != 0));
+
+    NS_TEST_INT(c.GetNumBitsSet(), 33);
+  }
 }
 
 
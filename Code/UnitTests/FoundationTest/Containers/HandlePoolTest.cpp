@@ -0,0 +1,249 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/HandlePool.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  using Id = nsGenericId<24, 8>;
+
+  class HandlePoolTestThread : public nsThread
+  {
+  public:
+    HandlePoolTestThread(nsHandlePool<Id, nsUInt32>* pPool, nsUInt32 uiIndex)
+      : nsThread("HandlePool Test")
+      , m_pPool(pPool)
+      , m_uiIndex(uiIndex)
+    {
+    }
+
+    virtual nsUInt32 Run() override
+    {
+      nsRandom rnd;
+      rnd.Initialize(m_uiIndex + 1);
+
+      nsDynamicArray<Id> ids;
+
+      for (nsUInt32 i = 0; i < 20000; ++i)
+      {
+        if (ids.IsEmpty() || rnd.UIntInRange(3) != 0)
+        {
+          ids.PushBack(m_pPool->Insert(m_uiIndex * 1000000 + i));
+        }
+        else
+        {
+          const nsUInt32 uiPos = rnd.UIntInRange(ids.GetCount());
+
+          nsUInt32 uiValue = 0;
+          if (!m_pPool->Remove(ids[uiPos], &uiValue) || uiValue / 1000000 != m_uiIndex)
+            ++m_uiNumErrors;
+
+          ids.RemoveAtAndSwap(uiPos);
+        }
+      }
+
+      for (Id id : ids)
+      {
+        nsUInt32* pValue = nullptr;
+        if (!m_pPool->TryGetValue(id, pValue) || *pValue / 1000000 != m_uiIndex)
+          ++m_uiNumErrors;
+      }
+
+      m_uiNumRemaining = ids.GetCount();
+      return 0;
+    }
+
+    nsHandlePool<Id, nsUInt32>* m_pPool;
+    nsUInt32 m_uiIndex;
+    nsUInt32 m_uiNumErrors = 0;
+    nsUInt32 m_uiNumRemaining = 0;
+  };
+
+  class HandlePoolRemoveThread : public nsThread
+  {
+  public:
+    HandlePoolRemoveThread(nsHandlePool<Id, nsUInt32>* pPool, const nsDynamicArray<Id>* pIds)
+      : nsThread("HandlePool Test")
+      , m_pPool(pPool)
+      , m_pIds(pIds)
+    {
+    }
+
+    virtual nsUInt32 Run() override
+    {
+      for (Id id : *m_pIds)
+      {
+        if (m_pPool->Remove(id))
+          ++m_uiNumRemoved;
+      }
+
+      return 0;
+    }
+
+    nsHandlePool<Id, nsUInt32>* m_pPool;
+    const nsDynamicArray<Id>* m_pIds;
+    nsUInt32 m_uiNumRemoved = 0;
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Containers, HandlePool)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Insert / Remove / Generations")
+  {
+    {
+      nsHandlePool<Id, nsConstructionCounter> pool;
+      NS_TEST_BOOL(pool.IsEmpty());
+      NS_TEST_BOOL(!pool.Contains(Id()));
+
+      nsDynamicArray<Id> ids;
+      for (nsInt32 i = 0; i < 200; ++i)
+      {
+        ids.PushBack(pool.Insert(nsConstructionCounter(i)));
+        NS_TEST_BOOL(ids.PeekBack().m_Data != 0);
+      }
+
+      NS_TEST_INT(pool.GetCount(), 200);
+      NS_TEST_INT(ids[0].m_InstanceIndex, 0);
+      NS_TEST_INT(ids[199].m_InstanceIndex, 199);
+
+      const nsConstructionCounter* pAddress = &pool[ids[150]];
+      NS_TEST_INT(pool[ids[150]].m_iData, 150);
+
+      nsConstructionCounter oldValue;
+      NS_TEST_BOOL(pool.Remove(ids[10], &oldValue));
+      NS_TEST_INT(oldValue.m_iData, 10);
+      NS_TEST_BOOL(!pool.Remove(ids[10]));
+      NS_TEST_BOOL(!pool.Contains(ids[10]));
+      NS_TEST_BOOL(pool.IsFreelistValid());
+
+      // the slot is reused with a new generation, the old id stays invalid
+      const Id newId = pool.Insert(nsConstructionCounter(1000));
+      NS_TEST_INT(newId.m_InstanceIndex, 10);
+      NS_TEST_BOOL(newId.m_Generation != ids[10].m_Generation);
+      NS_TEST_BOOL(!pool.Contains(ids[10]));
+      NS_TEST_BOOL(pool.Contains(newId));
+
+      nsConstructionCounter value;
+      NS_TEST_BOOL(!pool.TryGetValue(ids[10], value));
+      NS_TEST_BOOL(pool.TryGetValue(newId, value));
+      NS_TEST_INT(value.m_iData, 1000);
+
+      // addresses are stable while the pool grows
+      for (nsInt32 i = 0; i < 5000; ++i)
+        pool.Insert(nsConstructionCounter(i));
+
+      NS_TEST_BOOL(&pool[ids[150]] == pAddress);
+      NS_TEST_INT(pool.GetCount(), 5200);
+
+      pool.Clear();
+      NS_TEST_BOOL(pool.IsEmpty());
+      NS_TEST_BOOL(!pool.Contains(ids[150]));
+      NS_TEST_BOOL(pool.IsFreelistValid());
+      NS_TEST_BOOL(pool.GetHeapMemoryUsage() > 0);
+
+      NS_TEST_INT(pool.Insert(nsConstructionCounter(1)).m_InstanceIndex, 0);
+    }
+
+    NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Iterator")
+  {
+    nsHandlePool<Id, nsUInt32> pool;
+    NS_TEST_BOOL(!pool.GetIterator().IsValid());
+
+    nsDynamicArray<Id> ids;
+    for (nsUInt32 i = 0; i < 1000; ++i)
+      ids.PushBack(pool.Insert(i));
+
+    for (nsUInt32 i = 0; i < 1000; i += 3)
+      pool.Remove(ids[i]);
+
+    nsUInt32 uiCount = 0;
+    nsUInt32 uiPrevValue = 0;
+    for (auto it = pool.GetIterator(); it.IsValid(); ++it)
+    {
+      NS_TEST_BOOL(it.Value() % 3 != 0);
+      NS_TEST_BOOL(uiCount == 0 || it.Value() > uiPrevValue);
+      NS_TEST_BOOL(it.Id() == ids[it.Value()]);
+
+      uiPrevValue = it.Value();
+      it.Value() += 10000;
+      ++uiCount;
+    }
+
+    NS_TEST_INT(uiCount, pool.GetCount());
+    NS_TEST_INT(pool[ids[1]], 10001);
+
+    const nsHandlePool<Id, nsUInt32>& constPool = pool;
+    auto it = constPool.GetIterator();
+    NS_TEST_INT(it.Value(), 10001);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Multi-threaded Insert / Remove")
+  {
+    nsHandlePool<Id, nsUInt32> pool;
+
+    constexpr nsUInt32 uiNumThreads = 8;
+    nsUniquePtr<HandlePoolTestThread> threads[uiNumThreads];
+
+    for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i] = NS_DEFAULT_NEW(HandlePoolTestThread, &pool, i);
+      threads[i]->Start();
+    }
+
+    nsUInt32 uiNumRemaining = 0;
+    for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i]->Join();
+      NS_TEST_INT(threads[i]->m_uiNumErrors, 0);
+      uiNumRemaining += threads[i]->m_uiNumRemaining;
+    }
+
+    NS_TEST_INT(pool.GetCount(), uiNumRemaining);
+    NS_TEST_BOOL(pool.IsFreelistValid());
+
+    nsUInt32 uiNumIterated = 0;
+    for (auto it = pool.GetIterator(); it.IsValid(); ++it)
+      ++uiNumIterated;
+
+    NS_TEST_INT(uiNumIterated, uiNumRemaining);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Multi-threaded Remove of the same ids")
+  {
+    nsHandlePool<Id, nsUInt32> pool;
+
+    nsDynamicArray<Id> ids;
+    for (nsUInt32 i = 0; i < 10000; ++i)
+      ids.PushBack(pool.Insert(i));
+
+    constexpr nsUInt32 uiNumThreads = 4;
+    nsUniquePtr<HandlePoolRemoveThread> threads[uiNumThreads];
+
+    for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i] = NS_DEFAULT_NEW(HandlePoolRemoveThread, &pool, &ids);
+      threads[i]->Start();
+    }
+
+    nsUInt32 uiNumRemoved = 0;
+    for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i]->Join();
+      uiNumRemoved += threads[i]->m_uiNumRemoved;
+    }
+
+    NS_TEST_INT(uiNumRemoved, 10000);
+    NS_TEST_BOOL(pool.IsEmpty());
+    NS_TEST_BOOL(pool.IsFreelistValid());
+  }
+}
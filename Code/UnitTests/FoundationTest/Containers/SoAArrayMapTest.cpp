@@ -0,0 +1,191 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Containers/SoAArrayMap.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/String.h>
+
+namespace
+{
+  void TestAgainstArrayMap(nsSoAArrayMap<nsInt32, nsInt32>& ref_map, const nsArrayMap<nsInt32, nsInt32>& reference)
+  {
+    NS_TEST_INT(ref_map.GetCount(), reference.GetCount());
+
+    ref_map.Sort();
+    reference.Sort();
+
+    for (nsUInt32 i = 0; i < reference.GetCount(); ++i)
+    {
+      NS_TEST_INT(ref_map.GetKey(i), reference.GetKey(i));
+    }
+
+    for (nsInt32 iKey = -1100; iKey < 1100; iKey += 7)
+    {
+      NS_TEST_INT(ref_map.LowerBound(iKey), reference.LowerBound(iKey));
+      NS_TEST_INT(ref_map.UpperBound(iKey), reference.UpperBound(iKey));
+      NS_TEST_BOOL(ref_map.Contains(iKey) == reference.Contains(iKey));
+    }
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Containers, SoAArrayMap)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Insert / Find / FindOrAdd")
+  {
+    nsSoAArrayMap<nsString, nsInt32> m;
+    NS_TEST_BOOL(m.IsEmpty());
+    NS_TEST_INT(m.Find("a"), nsInvalidIndex);
+
+    m.Insert("c", 3);
+    m.Insert(nsString("a"), 1);
+    m.Insert(nsStringView("b"), 2);
+
+    NS_TEST_INT(m.GetCount(), 3);
+    NS_TEST_INT(m.Find("a"), 0);
+    NS_TEST_INT(m.GetValue(m.Find("b")), 2);
+    NS_TEST_STRING(m.GetKey(2), "c");
+    NS_TEST_INT(m.Find("d"), nsInvalidIndex);
+
+    bool bExisted = true;
+    m.FindOrAdd("d", &bExisted) = 4;
+    NS_TEST_BOOL(!bExisted);
+    m.FindOrAdd("d", &bExisted) = 5;
+    NS_TEST_BOOL(bExisted);
+    m["0"] = 7;
+
+    NS_TEST_INT(m.GetCount(), 5);
+    NS_TEST_INT(m.Find("0"), 0);
+    NS_TEST_INT(m.GetValues()[m.Find("d")], 5);
+    NS_TEST_STRING(m.GetKeys()[4], "d");
+
+    NS_TEST_BOOL(m.Contains("c", 3));
+    NS_TEST_BOOL(!m.Contains("c", 4));
+
+    m.Clear();
+    NS_TEST_BOOL(m.IsEmpty());
+    NS_TEST_INT(m.Find("0"), nsInvalidIndex);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "InsertBatch")
+  {
+    {
+      nsSoAArrayMap<nsConstructionCounter, nsConstructionCounter> m;
+      m.Insert(nsConstructionCounter(10), nsConstructionCounter(0));
+      m.Insert(nsConstructionCounter(30), nsConstructionCounter(0));
+
+      nsConstructionCounter keys[] = {nsConstructionCounter(40), nsConstructionCounter(20), nsConstructionCounter(10), nsConstructionCounter(0)};
+      nsConstructionCounter values[] = {nsConstructionCounter(1), nsConstructionCounter(2), nsConstructionCounter(3), nsConstructionCounter(4)};
+      m.InsertBatch(nsMakeArrayPtr(keys), nsMakeArrayPtr(values));
+
+      NS_TEST_INT(m.GetCount(), 6);
+
+      // equal keys keep their insertion order
+      const nsInt32 expectedKeys[] = {0, 10, 10, 20, 30, 40};
+      const nsInt32 expectedValues[] = {4, 0, 3, 2, 0, 1};
+      for (nsUInt32 i = 0; i < 6; ++i)
+      {
+        NS_TEST_INT(m.GetKey(i).m_iData, expectedKeys[i]);
+        NS_TEST_INT(m.GetValue(i).m_iData, expectedValues[i]);
+      }
+
+      nsSoAArrayMap<nsConstructionCounter, nsConstructionCounter> m2(m);
+      NS_TEST_BOOL(m2 == m);
+
+      NS_TEST_BOOL(m2.RemoveAndCopy(nsConstructionCounter(20), true));
+      NS_TEST_BOOL(m2 != m);
+      NS_TEST_INT(m2.GetKey(3).m_iData, 30);
+    }
+
+    NS_TEST_BOOL(nsConstructionCounter::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Eytzinger Layout")
+  {
+    nsSoAArrayMap<nsUInt32, nsUInt32> m;
+    m.SetUseEytzingerLayout(true);
+    NS_TEST_BOOL(m.GetUseEytzingerLayout());
+
+    NS_TEST_INT(m.LowerBound(0u), nsInvalidIndex);
+
+    // try every tree size up to a few full levels
+    for (nsUInt32 uiCount = 1; uiCount < 70; ++uiCount)
+    {
+      m.Insert(uiCount * 10, uiCount);
+
+      NS_TEST_INT(m.LowerBound(0u), 0);
+      NS_TEST_INT(m.UpperBound(uiCount * 10), nsInvalidIndex);
+      NS_TEST_INT(m.LowerBound(uiCount * 10 + 1), nsInvalidIndex);
+
+      for (nsUInt32 i = 1; i <= uiCount; ++i)
+      {
+        NS_TEST_INT(m.Find(i * 10), i - 1);
+        NS_TEST_INT(m.LowerBound(i * 10 - 5), i - 1);
+        NS_TEST_INT(m.UpperBound(i * 10 - 1), i - 1);
+        NS_TEST_INT(m.Find(i * 10 + 1), nsInvalidIndex);
+      }
+    }
+
+    const nsUInt64 uiMemory = m.GetHeapMemoryUsage();
+    m.SetUseEytzingerLayout(false);
+    NS_TEST_BOOL(m.GetHeapMemoryUsage() < uiMemory);
+    NS_TEST_INT(m.Find(350u), 34);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Random Operations")
+  {
+    for (nsUInt32 uiLayout = 0; uiLayout < 2; ++uiLayout)
+    {
+      nsRandom rnd;
+      rnd.Initialize(17);
+
+      nsSoAArrayMap<nsInt32, nsInt32> m;
+      m.SetUseEytzingerLayout(uiLayout == 1);
+      nsArrayMap<nsInt32, nsInt32> reference;
+
+      for (nsUInt32 uiRound = 0; uiRound < 20; ++uiRound)
+      {
+        const nsUInt32 uiOperation = rnd.UIntInRange(3);
+
+        if (uiOperation == 0)
+        {
+          for (nsUInt32 i = 0; i < 50; ++i)
+          {
+            const nsInt32 iKey = static_cast<nsInt32>(rnd.UIntInRange(2000)) - 1000;
+            m.Insert(iKey, i);
+            reference.Insert(iKey, i);
+          }
+        }
+        else if (uiOperation == 1)
+        {
+          nsDynamicArray<nsInt32> keys;
+          nsDynamicArray<nsInt32> values;
+          for (nsUInt32 i = 0; i < 100; ++i)
+          {
+            const nsInt32 iKey = static_cast<nsInt32>(rnd.UIntInRange(2000)) - 1000;
+            keys.PushBack(iKey);
+            values.PushBack(i);
+            reference.Insert(iKey, i);
+          }
+
+          m.InsertBatch(keys, values);
+        }
+        else
+        {
+          for (nsUInt32 i = 0; i < 30; ++i)
+          {
+            const nsInt32 iKey = static_cast<nsInt32>(rnd.UIntInRange(2000)) - 1000;
+            const bool bKeepSorted = rnd.UIntInRange(2) == 0;
+            NS_TEST_BOOL(m.RemoveAndCopy(iKey, bKeepSorted) == reference.RemoveAndCopy(iKey));
+          }
+        }
+
+        TestAgainstArrayMap(m, reference);
+      }
+    }
+  }
+}
@@ -6,6 +6,8 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
@@ -162,3 +164,243 @@ NS_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if (NS_ENABLED(NS_SUPPORTS_FILE_ITERATORS) && NS_ENABLED(NS_SUPPORTS_MEMORY_MAPPED_FILE) && defined(BUILDSYSTEM_ENABLE_ZSTD_SUPPORT))
+
+NS_CREATE_SIMPLE_TEST(IO, ArchiveDictionary)
+{
+  nsStringBuilder sOutputFolder = nsTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveDictionaryTest");
+  sOutputFolder.MakeCleanPath();
+
+  nsOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  nsOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!NS_TEST_BOOL(nsFileSystem::AddDataDirectory(sOutputFolder, "Clear", "output", nsFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  const nsStringBuilder sDataFolder(sOutputFolder, "/Data");
+  const nsStringBuilder sPlainArchive(sOutputFolder, "/Plain.nsArchive");
+  const nsStringBuilder sDictArchive(sOutputFolder, "/Dict.nsArchive");
+
+  const nsUInt32 uiNumFiles = 64;
+  nsDynamicArray<nsString> fileContent;
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Generate Data")
+  {
+    nsStringBuilder sFile, sContent;
+
+    for (nsUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      // many small files of few types, that are very similar to each other, but not identical
+      if (i % 2 == 0)
+      {
+        sFile.Format("{}/Materials/Material{}.nsMaterial", sDataFolder, i);
+        sContent.Format("{{ \"Shader\": \"Shaders/Materials/DefaultMaterial.nsShader\", \"BaseTexture\": \"Textures/Texture{}.dds\", \"Roughness\": {}, \"Metallic\": 0.0, \"TwoSided\": false, \"BlendMode\": \"Opaque\" }}", i, i * 0.01);
+      }
+      else
+      {
+        sFile.Format("{}/Prefabs/Prefab{}.nsPrefab", sDataFolder, i);
+        sContent.Format("<Prefab Name=\"Prefab{}\"><Object Name=\"Root\"><Component Type=\"nsMeshComponent\" Mesh=\"Meshes/Mesh{}.nsMesh\" CastShadows=\"true\"/></Object></Prefab>", i, i);
+      }
+
+      fileContent.PushBack(sContent);
+
+      nsOSFile file;
+      if (!NS_TEST_RESULT(file.Open(sFile, nsFileOpenMode::Write)))
+        return;
+
+      NS_TEST_RESULT(file.Write(sContent.GetData(), sContent.GetElementCount()));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Write Archives")
+  {
+    nsArchiveBuilder builder;
+    builder.AddFolder(sDataFolder, nsArchiveCompressionMode::Compressed_zstd);
+    NS_TEST_INT(builder.m_Entries.GetCount(), uiNumFiles);
+
+    NS_TEST_RESULT(builder.WriteArchive(":output/Plain.nsArchive"));
+
+    builder.SetDictionaryCompression(4);
+    NS_TEST_RESULT(builder.WriteArchive(":output/Dict.nsArchive"));
+
+    nsFileStats plainStats, dictStats;
+    NS_TEST_RESULT(nsOSFile::GetFileStats(sPlainArchive, plainStats));
+    NS_TEST_RESULT(nsOSFile::GetFileStats(sDictArchive, dictStats));
+
+    // the dictionary is stored in the archive as well, but the entries shrink a lot more
+    NS_TEST_BOOL(dictStats.m_uiFileSize < plainStats.m_uiFileSize);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Read Archive")
+  {
+    nsArchiveReader reader;
+    if (!NS_TEST_RESULT(reader.OpenArchive(sDictArchive)))
+      return;
+
+    const nsArchiveTOC& toc = reader.GetArchiveTOC();
+    NS_TEST_BOOL(!toc.m_CompressionDictionary.IsEmpty());
+    NS_TEST_BOOL(reader.GetCompressionDictionary() != nullptr);
+
+    nsUInt32 uiDictionaryEntries = 0;
+    nsStringBuilder sRead;
+    char szBuffer[512];
+
+    for (nsUInt32 i = 0; i < toc.m_Entries.GetCount(); ++i)
+    {
+      if (toc.m_Entries[i].m_CompressionMode == nsArchiveCompressionMode::Compressed_zstd_dictionary)
+        ++uiDictionaryEntries;
+
+      nsUniquePtr<nsStreamReader> pEntryReader = reader.CreateEntryReader(i);
+      const nsUInt64 uiRead = pEntryReader->ReadBytes(szBuffer, NS_ARRAY_SIZE(szBuffer) - 1);
+      szBuffer[uiRead] = '\0';
+
+      NS_TEST_INT(uiRead, toc.m_Entries[i].m_uiUncompressedDataSize);
+
+      // files are named after their index
+      nsStringView sPath = toc.GetEntryPathString(i);
+      sRead = nsPathUtils::GetFileName(sPath);
+      sRead.TrimWordStart("Material");
+      sRead.TrimWordStart("Prefab");
+
+      nsUInt32 uiFileIdx = 0;
+      NS_TEST_RESULT(nsConversionUtils::StringToUInt(sRead, uiFileIdx));
+      NS_TEST_STRING(szBuffer, fileContent[uiFileIdx]);
+    }
+
+    NS_TEST_BOOL(uiDictionaryEntries > 0);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (!NS_TEST_BOOL(nsFileSystem::AddDataDirectory(sDictArchive, "Clear", "archive", nsFileSystem::ReadOnly) == NS_SUCCESS))
+      return;
+
+    nsStringBuilder sFile;
+    char szBuffer[512];
+
+    for (nsUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      if (i % 2 == 0)
+        sFile.Format(":archive/Materials/Material{}.nsMaterial", i);
+      else
+        sFile.Format(":archive/Prefabs/Prefab{}.nsPrefab", i);
+
+      nsFileReader file;
+      if (!NS_TEST_RESULT(file.Open(sFile)))
+        continue;
+
+      const nsUInt64 uiRead = file.ReadBytes(szBuffer, NS_ARRAY_SIZE(szBuffer) - 1);
+      szBuffer[uiRead] = '\0';
+
+      NS_TEST_STRING(szBuffer, fileContent[i]);
+    }
+  }
+
+  nsFileSystem::RemoveDataDirectoryGroup("Clear");
+}
+
+NS_CREATE_SIMPLE_TEST(IO, ArchiveDeduplication)
+{
+  nsStringBuilder sOutputFolder = nsTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveDeduplicationTest");
+  sOutputFolder.MakeCleanPath();
+
+  nsOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  nsOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!NS_TEST_BOOL(nsFileSystem::AddDataDirectory(sOutputFolder, "Clear", "output", nsFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  const nsStringBuilder sDataFolder(sOutputFolder, "/Data");
+  const nsStringBuilder sArchive(sOutputFolder, "/Dedup.nsArchive");
+
+  // files 0, 2 and 3 are identical, file 1 has the same size but a different content
+  const char* szFileList[] = {"A/Shared.bin", "A/Unique.bin", "B/Shared.bin", "B/C/Copy.bin"};
+  const nsUInt32 uiFileSize = 1024 * 64;
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Generate Data")
+  {
+    nsDynamicArray<nsUInt8> content;
+    content.SetCountUninitialized(uiFileSize);
+
+    nsStringBuilder sFile;
+
+    for (nsUInt32 uiFileIdx = 0; uiFileIdx < NS_ARRAY_SIZE(szFileList); ++uiFileIdx)
+    {
+      const nsUInt32 uiSeed = (uiFileIdx == 1) ? 7 : 3;
+
+      for (nsUInt32 i = 0; i < uiFileSize; ++i)
+      {
+        content[i] = static_cast<nsUInt8>((i * uiSeed) ^ (i >> 8));
+      }
+
+      sFile.Set(sDataFolder, "/", szFileList[uiFileIdx]);
+
+      nsOSFile file;
+      if (!NS_TEST_RESULT(file.Open(sFile, nsFileOpenMode::Write)))
+        return;
+
+      NS_TEST_RESULT(file.Write(content.GetData(), content.GetCount()));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Write Archive")
+  {
+    nsArchiveBuilder builder;
+    builder.AddFolder(sDataFolder, nsArchiveCompressionMode::Uncompressed);
+    NS_TEST_INT(builder.m_Entries.GetCount(), NS_ARRAY_SIZE(szFileList));
+
+    NS_TEST_RESULT(builder.WriteArchive(":output/Dedup.nsArchive"));
+
+    nsFileStats stats;
+    NS_TEST_RESULT(nsOSFile::GetFileStats(sArchive, stats));
+
+    // only two distinct blobs are stored
+    NS_TEST_BOOL(stats.m_uiFileSize >= uiFileSize * 2);
+    NS_TEST_BOOL(stats.m_uiFileSize < uiFileSize * 3);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Read Archive")
+  {
+    nsArchiveReader reader;
+    if (!NS_TEST_RESULT(reader.OpenArchive(sArchive)))
+      return;
+
+    const nsArchiveTOC& toc = reader.GetArchiveTOC();
+    if (!NS_TEST_INT(toc.m_Entries.GetCount(), NS_ARRAY_SIZE(szFileList)))
+      return;
+
+    nsUInt32 uiEntries[NS_ARRAY_SIZE(szFileList)];
+    for (nsUInt32 uiFileIdx = 0; uiFileIdx < NS_ARRAY_SIZE(szFileList); ++uiFileIdx)
+    {
+      uiEntries[uiFileIdx] = toc.FindEntry(szFileList[uiFileIdx]);
+      if (!NS_TEST_BOOL(uiEntries[uiFileIdx] != nsInvalidIndex))
+        return;
+    }
+
+    const nsUInt64 uiSharedOffset = toc.m_Entries[uiEntries[0]].m_uiDataStartOffset;
+    NS_TEST_INT(toc.m_Entries[uiEntries[2]].m_uiDataStartOffset, uiSharedOffset);
+    NS_TEST_INT(toc.m_Entries[uiEntries[3]].m_uiDataStartOffset, uiSharedOffset);
+    NS_TEST_BOOL(toc.m_Entries[uiEntries[1]].m_uiDataStartOffset != uiSharedOffset);
+
+    // every entry still has its own path
+    NS_TEST_STRING(toc.GetEntryPathString(uiEntries[3]), szFileList[3]);
+
+    NS_TEST_RESULT(reader.ExtractAllFiles(":output/Unpacked"));
+
+    nsStringBuilder sFileSrc, sFileDst;
+    for (nsUInt32 uiFileIdx = 0; uiFileIdx < NS_ARRAY_SIZE(szFileList); ++uiFileIdx)
+    {
+      sFileSrc.Set(":output/Data/", szFileList[uiFileIdx]);
+      sFileDst.Set(":output/Unpacked/", szFileList[uiFileIdx]);
+
+      NS_TEST_FILES(sFileSrc, sFileDst, "Unpacked file should be identical");
+    }
+  }
+
+  nsFileSystem::RemoveDataDirectoryGroup("Clear");
+}
+
+#endif
@@ -139,6 +139,168 @@ NS_CREATE_SIMPLE_TEST(IO, CompressedStreamZstd)
       NS_TEST_BOOL(CompressedReader.ReadBytes(&uiTemp, sizeof(nsUInt32)) == 0);
     }
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Parallel Uncompress Single Frame")
+  {
+    MemoryReader.SetReadPosition(0);
+
+    nsCompressedStreamReaderZstdParallel ParallelReader(&MemoryReader);
+
+    nsDynamicArray<nsUInt32> TestDataRead;
+    TestDataRead.SetCountUninitialized(TestData.GetCount());
+
+    NS_TEST_INT(ParallelReader.ReadBytes(TestDataRead.GetData(), TestDataRead.GetCount() * sizeof(nsUInt32)), TestData.GetCount() * sizeof(nsUInt32));
+    NS_TEST_BOOL(TestData == TestDataRead);
+
+    nsUInt32 uiTemp = 0;
+    NS_TEST_BOOL(ParallelReader.ReadBytes(&uiTemp, sizeof(nsUInt32)) == 0);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Independent Frames")
+  {
+    nsDefaultMemoryStreamStorage FramedStorage;
+    nsMemoryStreamWriter FramedWriter(&FramedStorage);
+
+    const nsUInt32 uiTrailer = 0xABCDEF12;
+
+    {
+      nsCompressedStreamWriterZstd writer;
+      writer.SetOutputStream(&FramedWriter, 2);
+      writer.SetIndependentFrameSize(256);
+
+      // odd write sizes, so that writes straddle frame boundaries
+      for (nsUInt32 i = 0; i < TestData.GetCount();)
+      {
+        const nsUInt32 uiWrite = nsMath::Min<nsUInt32>(12345, TestData.GetCount() - i);
+        NS_TEST_BOOL(writer.WriteBytes(&TestData[i], sizeof(nsUInt32) * uiWrite).Succeeded());
+        i += uiWrite;
+
+        if (i == 12345 * 7)
+        {
+          // ends the current frame early
+          NS_TEST_BOOL(writer.Flush().Succeeded());
+        }
+      }
+
+      NS_TEST_BOOL(writer.FinishCompressedStream().Succeeded());
+      NS_TEST_INT(writer.GetUncompressedSize(), TestData.GetCount() * sizeof(nsUInt32));
+
+      FramedWriter << uiTrailer;
+    }
+
+    nsMemoryStreamReader FramedReader(&FramedStorage);
+
+    // the regular reader must be able to read multi-frame streams
+    {
+      nsCompressedStreamReaderZstd reader(&FramedReader);
+
+      nsDynamicArray<nsUInt32> TestDataRead;
+      TestDataRead.SetCountUninitialized(TestData.GetCount());
+
+      NS_TEST_INT(reader.ReadBytes(TestDataRead.GetData(), TestDataRead.GetCount() * sizeof(nsUInt32)), TestData.GetCount() * sizeof(nsUInt32));
+      NS_TEST_BOOL(TestData == TestDataRead);
+
+      nsUInt32 uiReadTrailer = 0;
+      FramedReader >> uiReadTrailer;
+      NS_TEST_INT(uiReadTrailer, uiTrailer);
+    }
+
+    FramedReader.SetReadPosition(0);
+
+    {
+      nsCompressedStreamReaderZstdParallel reader(&FramedReader, 3);
+
+      nsDynamicArray<nsUInt32> TestDataRead = TestData;
+
+      // alternate between reading and skipping, with different sizes
+      bool bSkip = false;
+      nsUInt32 uiStartPos = 0;
+      for (nsUInt32 uiRead = 1; uiStartPos < TestData.GetCount(); uiRead += 4099)
+      {
+        const nsUInt32 uiToRead = nsMath::Min(uiRead, TestData.GetCount() - uiStartPos);
+
+        if (bSkip)
+        {
+          NS_TEST_INT(reader.SkipBytes(sizeof(nsUInt32) * uiToRead), sizeof(nsUInt32) * uiToRead);
+        }
+        else
+        {
+          nsMemoryUtils::ZeroFill(&TestDataRead[uiStartPos], uiToRead);
+          NS_TEST_INT(reader.ReadBytes(&TestDataRead[uiStartPos], sizeof(nsUInt32) * uiToRead), sizeof(nsUInt32) * uiToRead);
+        }
+
+        bSkip = !bSkip;
+        uiStartPos += uiToRead;
+      }
+
+      NS_TEST_BOOL(TestData == TestDataRead);
+
+      nsUInt32 uiTemp = 0;
+      NS_TEST_BOOL(reader.ReadBytes(&uiTemp, sizeof(nsUInt32)) == 0);
+
+      nsUInt32 uiReadTrailer = 0;
+      FramedReader >> uiReadTrailer;
+      NS_TEST_INT(uiReadTrailer, uiTrailer);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Dictionary")
+  {
+    // a small message that only compresses well, if the compressor already knows similar data
+    const char* szDictionary = "{ \"Type\": \"Material\", \"Shader\": \"Shaders/Materials/DefaultMaterial.nsShader\", \"BaseTexture\": \"Textures/Default.dds\", \"Roughness\": 0.5, \"Metallic\": 0.0 }";
+    const char* szMessage = "{ \"Type\": \"Material\", \"Shader\": \"Shaders/Materials/DefaultMaterial.nsShader\", \"BaseTexture\": \"Textures/Stone.dds\", \"Roughness\": 0.7, \"Metallic\": 0.0 }";
+    const nsUInt32 uiMessageSize = nsStringUtils::GetStringElementCount(szMessage);
+
+    nsArrayPtr<const nsUInt8> dictionary(reinterpret_cast<const nsUInt8*>(szDictionary), nsStringUtils::GetStringElementCount(szDictionary));
+
+    nsDefaultMemoryStreamStorage plainStorage;
+    nsDefaultMemoryStreamStorage dictStorage;
+
+    {
+      nsMemoryStreamWriter plainWriter(&plainStorage);
+      nsCompressedStreamWriterZstd plainCompressor(&plainWriter, 0);
+      NS_TEST_RESULT(plainCompressor.WriteBytes(szMessage, uiMessageSize));
+      NS_TEST_RESULT(plainCompressor.FinishCompressedStream());
+
+      nsMemoryStreamWriter dictWriter(&dictStorage);
+      nsCompressedStreamWriterZstd dictCompressor;
+      dictCompressor.SetDictionary(dictionary);
+      dictCompressor.SetOutputStream(&dictWriter, 0);
+      NS_TEST_RESULT(dictCompressor.WriteBytes(szMessage, uiMessageSize));
+      NS_TEST_RESULT(dictCompressor.FinishCompressedStream());
+    }
+
+    NS_TEST_BOOL(dictStorage.GetStorageSize64() * 2 < plainStorage.GetStorageSize64());
+
+    nsCompressedStreamDictionaryZstd preparedDictionary;
+    NS_TEST_BOOL(!preparedDictionary.IsValid());
+    NS_TEST_RESULT(preparedDictionary.Create(dictionary));
+    NS_TEST_BOOL(preparedDictionary.IsValid());
+
+    char szRead[256] = {};
+
+    // the same reader can alternate between streams with and without dictionary
+    nsCompressedStreamReaderZstd reader;
+
+    for (nsUInt32 uiRound = 0; uiRound < 2; ++uiRound)
+    {
+      nsMemoryStreamReader dictReader(&dictStorage);
+      reader.SetDictionary(&preparedDictionary);
+      reader.SetInputStream(&dictReader);
+
+      nsMemoryUtils::ZeroFill(szRead, NS_ARRAY_SIZE(szRead));
+      NS_TEST_INT(reader.ReadBytes(szRead, NS_ARRAY_SIZE(szRead)), uiMessageSize);
+      NS_TEST_STRING(szRead, szMessage);
+
+      nsMemoryStreamReader plainReader(&plainStorage);
+      reader.SetDictionary(nullptr);
+      reader.SetInputStream(&plainReader);
+
+      nsMemoryUtils::ZeroFill(szRead, NS_ARRAY_SIZE(szRead));
+      NS_TEST_INT(reader.ReadBytes(szRead, NS_ARRAY_SIZE(szRead)), uiMessageSize);
+      NS_TEST_STRING(szRead, szMessage);
+    }
+  }
 }
 
 #endif
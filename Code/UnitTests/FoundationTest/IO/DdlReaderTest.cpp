@@ -120,10 +120,11 @@ static void WriteObjectToDDL(const nsOpenDdlReaderElement* pElement, nsOpenDdlWr
   }
 }
 
-static void WriteToDDL(const nsOpenDdlReader& doc, nsStreamWriter& ref_output)
+static void WriteToDDL(const nsOpenDdlReader& doc, nsStreamWriter& ref_output, nsOpenDdlWriter::OutputFormat format = nsOpenDdlWriter::OutputFormat::Text)
 {
   nsOpenDdlWriter writer;
   writer.SetOutputStream(&ref_output);
+  writer.SetOutputFormat(format);
   writer.SetPrimitiveTypeStringMode(nsOpenDdlWriter::TypeStringMode::Compliant);
   writer.SetFloatPrecisionMode(nsOpenDdlWriter::FloatPrecisionMode::Readable);
 
@@ -336,4 +337,110 @@ string{\"s\\2\",\"bla\"}\n\
     nsOpenDdlReader doc;
     NS_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Binary")
+  {
+    const char* szTestData = "\
+Node $GlobalNode\n\
+{\n\
+	Empty{}\n\
+	Name %Local\n\
+	{\n\
+		string{\"ConstantColor\",\"\",\"abc\"}\n\
+	}\n\
+}\n\
+bool{true,false,true,true,false}\n\
+string $Strings{\"s1\",\"\\n\\t\\r\"}\n\
+float{0,1.1,-3,23.42}\n\
+double{0,1.1,-3,23.42}\n\
+int8{0,12,34,56,78,109,127,-14,-56,-127}\n\
+int16{0,102,3040,5600,7008,109,10207,-1004,-5060,-10207}\n\
+int32{0,100002,300040,56000000,700008,1000009,100000207,-100000004,-506000000,-1020700000}\n\
+int64{0,100002111,300040222,560000003333,70000844444,1000009555555,100000207666666,-1000000047777777,-50600000008888888,-102070000099999}\n\
+unsigned_int8{0,12,34,56,78,109,127,255,156,207}\n\
+unsigned_int16{0,102,3040,56000,7008,109,10207,40004,50600,10207}\n\
+unsigned_int32{0,100002,300040,56000000,700008,1000009,100000207,100000004,2000001000,1020700000}\n\
+unsigned_int64{0,100002111,300040222,560000003333,70000844444,1000009555555,100000207666666,1000000047777777,50600000008888888,102070000099999}\n\
+";
+
+    StringStream stream(szTestData);
+
+    nsOpenDdlReader textDoc;
+    NS_TEST_BOOL(textDoc.ParseDocument(stream).Succeeded());
+
+    nsContiguousMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    WriteToDDL(textDoc, writer, nsOpenDdlWriter::OutputFormat::Binary);
+
+    nsArrayPtr<const nsUInt8> binary(storage.GetData(), storage.GetStorageSize32());
+    NS_TEST_BOOL(nsOpenDdlReader::IsBinaryDocument(binary));
+    NS_TEST_BOOL(!nsOpenDdlReader::IsBinaryDocument(nsArrayPtr<const nsUInt8>(reinterpret_cast<const nsUInt8*>(szTestData), 16)));
+
+    // the binary document must result in the same structure as the text document
+    nsOpenDdlReader binaryDoc;
+    NS_TEST_BOOL(binaryDoc.ParseBinaryDocument(binary).Succeeded());
+    TestDoc(binaryDoc, szTestData);
+
+    const nsOpenDdlReaderElement* pNode = binaryDoc.FindElement("GlobalNode");
+    if (NS_TEST_BOOL(pNode != nullptr))
+    {
+      NS_TEST_INT(pNode->GetNumChildObjects(), 2);
+      NS_TEST_BOOL(pNode->FindChild("Local") != nullptr);
+    }
+
+    const nsOpenDdlReaderElement* pStrings = binaryDoc.FindElement("Strings");
+    if (NS_TEST_BOOL(pStrings != nullptr && pStrings->HasPrimitives(nsOpenDdlPrimitiveType::String, 2)))
+    {
+      // strings are not copied
+      NS_TEST_BOOL(pStrings->GetPrimitivesString()[0].GetStartPointer() >= reinterpret_cast<const char*>(binary.GetPtr()));
+      NS_TEST_BOOL(pStrings->GetPrimitivesString()[0].GetEndPointer() <= reinterpret_cast<const char*>(binary.GetEndPtr()));
+    }
+
+    // truncated data is detected
+    {
+      nsTestLogInterface log;
+      nsTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("Binary OpenDDL document is corrupted", nsLogMsgType::ErrorMsg);
+
+      nsOpenDdlReader truncatedDoc;
+      NS_TEST_BOOL(truncatedDoc.ParseBinaryDocument(binary.GetSubArray(0, binary.GetCount() - 8)).Failed());
+    }
+
+    // a corrupted string count is detected before anything is allocated for it
+    {
+      StringStream stringStream("string{\"s1\",\"s2\"}");
+
+      nsOpenDdlReader stringDoc;
+      NS_TEST_BOOL(stringDoc.ParseDocument(stringStream).Succeeded());
+
+      nsContiguousMemoryStreamStorage stringStorage;
+      nsMemoryStreamWriter stringWriter(&stringStorage);
+      WriteToDDL(stringDoc, stringWriter, nsOpenDdlWriter::OutputFormat::Binary);
+
+      // copy into 64 bit elements to keep the required alignment
+      nsDynamicArray<nsUInt64> corrupted;
+      corrupted.SetCount((stringStorage.GetStorageSize32() + 7) / 8);
+      nsMemoryUtils::Copy(reinterpret_cast<nsUInt8*>(corrupted.GetData()), stringStorage.GetData(), stringStorage.GetStorageSize32());
+      nsArrayPtr<const nsUInt8> corruptedBinary(reinterpret_cast<const nsUInt8*>(corrupted.GetData()), stringStorage.GetStorageSize32());
+
+      nsOpenDdlReader validDoc;
+      NS_TEST_BOOL(validDoc.ParseBinaryDocument(corruptedBinary).Succeeded());
+
+      // the count of the first element, which directly follows the document header
+      nsOpenDdlBinaryElement* pElement = reinterpret_cast<nsOpenDdlBinaryElement*>(reinterpret_cast<nsUInt8*>(corrupted.GetData()) + nsOpenDdlBinaryElement::s_uiDocumentHeaderSize);
+      NS_TEST_INT(pElement->m_uiCount, 2);
+
+      for (nsUInt32 uiCount : {3u, 0x100000u, 0x10000001u})
+      {
+        pElement->m_uiCount = uiCount;
+
+        nsTestLogInterface log;
+        nsTestLogSystemScope logSystemScope(&log);
+        log.ExpectMessage("Binary OpenDDL document is corrupted", nsLogMsgType::ErrorMsg);
+
+        nsOpenDdlReader corruptedDoc;
+        NS_TEST_BOOL(corruptedDoc.ParseBinaryDocument(corruptedBinary).Failed());
+      }
+    }
+  }
 }
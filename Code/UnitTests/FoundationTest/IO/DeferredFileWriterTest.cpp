@@ -8,6 +8,7 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/DeferredFileWriter.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/OSFile.h>
 
 NS_CREATE_SIMPLE_TEST(IO, DeferredFileWriter)
 {
@@ -110,6 +111,114 @@ NS_CREATE_SIMPLE_TEST(IO, DeferredFileWriter)
     NS_TEST_BOOL(!nsFileSystem::ExistsFile(sTempFile2));
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Bounded Cache")
+  {
+    nsStringBuilder sTempFile3 = sOutputFolderResolved;
+    sTempFile3.AppendPath("Temp3.tmp");
+
+    // an unrelated file with the name of a naive temp file must not be touched
+    nsStringBuilder sUnrelatedFile(sTempFile3, ".tmp");
+
+    nsFileSystem::DeleteFile(sTempFile3);
+
+    {
+      nsFileWriter file;
+      NS_TEST_BOOL(file.Open(sUnrelatedFile).Succeeded());
+      file << nsUInt32(42);
+    }
+
+    auto WriteFile = [&](nsUInt64 uiCount, nsUInt64 uiChangedValue, bool bDiscard) -> bool
+    {
+      nsDeferredFileWriter writer;
+      writer.SetOutput(sTempFile3, true);
+      writer.SetMaxCacheSize(1024 * 64);
+
+      for (nsUInt64 i = 0; i < uiCount; ++i)
+      {
+        writer << (i == uiChangedValue ? 0 : i);
+      }
+
+      if (bDiscard)
+      {
+        writer.Discard();
+        return false;
+      }
+
+      bool bWritten = false;
+      NS_TEST_BOOL(writer.Close(&bWritten).Succeeded());
+      return bWritten;
+    };
+
+    auto CheckFile = [&](nsUInt64 uiCount, nsUInt64 uiChangedValue)
+    {
+#if NS_ENABLED(NS_SUPPORTS_FILE_ITERATORS) && NS_ENABLED(NS_SUPPORTS_FILE_STATS)
+      // no temp files are left behind
+      nsDynamicArray<nsFileStats> items;
+      nsOSFile::GatherAllItemsInFolder(items, sOutputFolderResolved, nsFileSystemIteratorFlags::ReportFiles);
+
+      for (const nsFileStats& item : items)
+      {
+        NS_TEST_BOOL(!item.m_sName.StartsWith("Temp3.tmp") || item.m_sName == "Temp3.tmp" || item.m_sName == "Temp3.tmp.tmp");
+      }
+#endif
+
+      {
+        nsFileReader unrelated;
+        nsUInt32 uiValue = 0;
+        NS_TEST_BOOL(unrelated.Open(sUnrelatedFile).Succeeded());
+        unrelated >> uiValue;
+        NS_TEST_INT(uiValue, 42);
+      }
+
+      nsFileReader reader;
+      if (!NS_TEST_BOOL(reader.Open(sTempFile3).Succeeded()))
+        return;
+
+      NS_TEST_INT(reader.GetFileSize(), uiCount * sizeof(nsUInt64));
+
+      for (nsUInt64 i = 0; i < uiCount; ++i)
+      {
+        nsUInt64 v;
+        reader >> v;
+        NS_TEST_BOOL(v == (i == uiChangedValue ? 0 : i));
+      }
+    };
+
+    // new file, larger than the cache
+    NS_TEST_BOOL(WriteFile(100'000, nsInvalidIndex, false));
+    CheckFile(100'000, nsInvalidIndex);
+
+    // identical content is not written again
+    NS_TEST_BOOL(!WriteFile(100'000, nsInvalidIndex, false));
+    CheckFile(100'000, nsInvalidIndex);
+
+    // difference at the very end
+    NS_TEST_BOOL(WriteFile(100'000, 99'999, false));
+    CheckFile(100'000, 99'999);
+
+    // difference after the data was cached
+    NS_TEST_BOOL(WriteFile(100'000, 50, false));
+    CheckFile(100'000, 50);
+
+    // shorter and longer than the existing file
+    NS_TEST_BOOL(WriteFile(90'000, 50, false));
+    CheckFile(90'000, 50);
+
+    NS_TEST_BOOL(WriteFile(110'000, 50, false));
+    CheckFile(110'000, 50);
+
+    // small enough to stay in memory
+    NS_TEST_BOOL(WriteFile(100, nsInvalidIndex, false));
+    CheckFile(100, nsInvalidIndex);
+
+    // discarding after data was moved to the temp file, leaves the existing file untouched
+    WriteFile(100'000, nsInvalidIndex, true);
+    CheckFile(100, nsInvalidIndex);
+
+    nsFileSystem::DeleteFile(sTempFile3);
+    nsFileSystem::DeleteFile(sUnrelatedFile);
+  }
+
   nsFileSystem::DeleteFile(sTempFile);
   nsFileSystem::ClearAllDataDirectories();
 }
@@ -0,0 +1,256 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/IO/JSONTape.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace JSONTapeTestDetail
+{
+  /// Records all parser callbacks as text, so that parsing from a stream and replaying a tape can be compared.
+  class EventRecorder : public nsJSONParser
+  {
+  public:
+    void ParseText(nsStringView sText)
+    {
+      nsRawMemoryStreamReader reader(sText.GetStartPointer(), sText.GetElementCount());
+      SetInputStream(reader);
+      ParseAll();
+    }
+
+    void ReplayTape(const nsJSONTape& tape) { ParseTape(tape); }
+
+    nsStringBuilder m_sEvents;
+
+  private:
+    virtual bool OnVariable(nsStringView sVarName) override
+    {
+      m_sEvents.AppendFormat("'{0}':", sVarName);
+      return sVarName != "skip_var";
+    }
+
+    virtual void OnReadValue(nsStringView sValue) override { m_sEvents.AppendFormat("'{0}' ", sValue); }
+    virtual void OnReadValue(double fValue) override { m_sEvents.AppendFormat("{0} ", fValue); }
+    virtual void OnReadValue(bool bValue) override { m_sEvents.Append(bValue ? "true " : "false "); }
+    virtual void OnReadValueNULL() override { m_sEvents.Append("null "); }
+
+    virtual void OnBeginObject() override
+    {
+      m_sEvents.Append("{ ");
+
+      if (m_sEvents.EndsWith("'skip_obj':{ "))
+        SkipObject();
+    }
+
+    virtual void OnEndObject() override { m_sEvents.Append("} "); }
+
+    virtual void OnBeginArray() override
+    {
+      m_sEvents.Append("[ ");
+
+      if (m_sEvents.EndsWith("'skip_array':[ "))
+        SkipArray();
+    }
+
+    virtual void OnEndArray() override { m_sEvents.Append("] "); }
+  };
+
+  nsResult ParseTape(nsJSONTape& ref_tape, nsStringView sText, nsLogInterface* pLog = nullptr)
+  {
+    return ref_tape.Parse(nsArrayPtr<const char>(sText.GetStartPointer(), sText.GetElementCount()), pLog);
+  }
+
+  void CompareWithStream(nsStringView sText)
+  {
+    EventRecorder fromStream;
+    fromStream.ParseText(sText);
+
+    nsJSONTape tape;
+    NS_TEST_BOOL(ParseTape(tape, sText).Succeeded());
+
+    EventRecorder fromTape;
+    fromTape.ReplayTape(tape);
+
+    NS_TEST_STRING(fromTape.m_sEvents, fromStream.m_sEvents);
+  }
+} // namespace JSONTapeTestDetail
+
+NS_CREATE_SIMPLE_TEST(IO, JSONTape)
+{
+  using namespace JSONTapeTestDetail;
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Values")
+  {
+    const char* szTestData = "{ \"string\" : \"text\", \"escaped\" : \"a\\\"b\\\\c\\/d\\n\\u00e4\\ud83e\\udd86\", \"number\" : -12.5e1, "
+                             "\"int\" : 42, \"true\" : true, \"false\" : false, \"null\" : null, "
+                             "\"array\" : [ 1, [], {}, \"x\" ], \"object\" : { \"inner\" : [ true ] } }";
+
+    nsJSONTape tape;
+    NS_TEST_BOOL(ParseTape(tape, szTestData).Succeeded());
+
+    const nsJSONTapeValue root = tape.GetRoot();
+    NS_TEST_BOOL(root.IsObject());
+    NS_TEST_INT(root.GetCount(), 9);
+
+    NS_TEST_STRING(root["string"].GetString(), "text");
+    NS_TEST_STRING(root["escaped"].GetString(), "a\"b\\c/d\n\xC3\xA4\xF0\x9F\xA6\x86");
+    NS_TEST_DOUBLE(root["number"].GetNumber(), -125.0, 0.0);
+    NS_TEST_DOUBLE(root["int"].GetNumber(), 42.0, 0.0);
+    NS_TEST_BOOL(root["true"].GetBool());
+    NS_TEST_BOOL(!root["false"].GetBool());
+    NS_TEST_BOOL(root["null"].IsNull());
+    NS_TEST_BOOL(!root["missing"].IsValid());
+    NS_TEST_BOOL(!root["string"]["inner"].IsValid());
+
+    const nsJSONTapeValue array = root["array"];
+    NS_TEST_BOOL(array.IsArray());
+    NS_TEST_INT(array.GetCount(), 4);
+    NS_TEST_DOUBLE(array.GetElement(0).GetNumber(), 1.0, 0.0);
+    NS_TEST_BOOL(array.GetElement(1).IsArray());
+    NS_TEST_INT(array.GetElement(1).GetCount(), 0);
+    NS_TEST_BOOL(!array.GetElement(1).GetFirstChild().IsValid());
+    NS_TEST_BOOL(array.GetElement(2).IsObject());
+    NS_TEST_STRING(array.GetElement(3).GetString(), "x");
+    NS_TEST_BOOL(!array.GetElement(4).IsValid());
+
+    NS_TEST_BOOL(root["object"]["inner"].GetElement(0).GetBool());
+
+    // members alternate between name and value
+    nsStringBuilder sNames;
+    for (nsJSONTapeValue name = root.GetFirstChild(); name.IsValid(); name = name.GetNextSibling().GetNextSibling())
+    {
+      sNames.Append(name.GetString(), " ");
+    }
+
+    NS_TEST_STRING(sNames, "string escaped number int true false null array object ");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Block Boundaries")
+  {
+    // strings, escape sequences and numbers crossing the 64 byte blocks of the structural search
+    for (nsUInt32 uiPadding = 0; uiPadding < 70; ++uiPadding)
+    {
+      nsStringBuilder sPadding;
+      for (nsUInt32 i = 0; i < uiPadding; ++i)
+        sPadding.Append(" ");
+
+      nsStringBuilder sText;
+      sText.Append("[", sPadding, "\"abc\\\\\\\\\\\"", sPadding, "\\\\\", 123456789, \"");
+      sText.Append(sPadding, "\", ", sPadding, "{ \"", sPadding, "\\\\\" : [ null");
+      sText.Append(sPadding, ", false ] } ]");
+
+      nsJSONTape tape;
+      NS_TEST_BOOL(ParseTape(tape, sText).Succeeded());
+
+      const nsJSONTapeValue root = tape.GetRoot();
+      NS_TEST_INT(root.GetCount(), 4);
+
+      nsStringBuilder sExpected;
+      sExpected.Set("abc\\\\\"", sPadding, "\\");
+      NS_TEST_STRING(root.GetElement(0).GetString(), sExpected);
+      NS_TEST_DOUBLE(root.GetElement(1).GetNumber(), 123456789.0, 0.0);
+      NS_TEST_STRING(root.GetElement(2).GetString(), sPadding);
+
+      sExpected.Set(sPadding, "\\");
+      NS_TEST_BOOL(root.GetElement(3)[sExpected].GetElement(0).IsNull());
+      NS_TEST_BOOL(!root.GetElement(3)[sExpected].GetElement(1).GetBool());
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Empty Document")
+  {
+    nsJSONTape tape;
+    NS_TEST_BOOL(ParseTape(tape, "").Succeeded());
+    NS_TEST_BOOL(!tape.GetRoot().IsValid());
+
+    NS_TEST_BOOL(ParseTape(tape, " \n  \t ").Succeeded());
+    NS_TEST_BOOL(!tape.GetRoot().IsValid());
+
+    NS_TEST_BOOL(ParseTape(tape, "\xEF\xBB\xBF[]").Succeeded());
+    NS_TEST_BOOL(tape.GetRoot().IsArray());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Comments and Separators")
+  {
+    const char* szTestData = "{\"a\"/* \"b\" : 1 */ : // line \"comment\"\n 1, \"b\":{,},,\"c\":[3.],\"d\":[.3,],\"e\" : \"//\",}// the end";
+
+    nsJSONTape tape;
+    NS_TEST_BOOL(ParseTape(tape, szTestData).Succeeded());
+
+    const nsJSONTapeValue root = tape.GetRoot();
+    NS_TEST_INT(root.GetCount(), 5);
+    NS_TEST_DOUBLE(root["a"].GetNumber(), 1.0, 0.0);
+    NS_TEST_INT(root["b"].GetCount(), 0);
+    NS_TEST_INT(root["c"].GetCount(), 1);
+    NS_TEST_INT(root["d"].GetCount(), 1);
+    NS_TEST_DOUBLE(root["d"].GetElement(0).GetNumber(), 0.3, 0.0001);
+    NS_TEST_STRING(root["e"].GetString(), "//");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Errors")
+  {
+    struct Case
+    {
+      const char* m_szText;
+      const char* m_szError;
+    };
+
+    const Case cases[] = {
+      {"\"text\"", "Line 1 (0): Start of document: Expected a { or [ or an empty document."},
+      {"{ \"a\" : 1", "End of the document reached without closing all objects."},
+      {"{ \"a\" : \"1 }", "Reached end of document before end of string was found."},
+      {"{ \"a\" 1 }", "Expected a ':' after the member name."},
+      {"{\n\"a\" : 1 ]", "Line 2 (8): Expected ',' or '}', got ']' instead."},
+      {"[1,,]", "Expected a value, got ','"},
+      {"[ tru ]", "Unexpected value 'tru'."},
+      {"[ 1.2.3 ]", "Could not convert '1.2.3'"},
+      {"[ \"\\q\" ]", "Unknown escape-sequence '\\q'"},
+      {"[ \"\\u12G4\" ]", "Unicode literal is malformed"},
+      {"[ 1 / 2 ]", "Unexpected character '/'."},
+      {"{}{}", "Unexpected data after the end of the document."},
+    };
+
+    for (const Case& c : cases)
+    {
+      nsTestLogInterface log;
+      log.ExpectMessage(c.m_szError, nsLogMsgType::ErrorMsg);
+
+      nsJSONTape tape;
+      NS_TEST_BOOL(ParseTape(tape, c.m_szText, &log).Failed());
+      NS_TEST_BOOL(!tape.GetRoot().IsValid());
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "ParseTape")
+  {
+    CompareWithStream("{ \"a\" : [ 1, 2.5, \"x\", true, false, null, {}, [] ], \"b\" : { \"c\" : \"\\u00e4\\n\" } }");
+    CompareWithStream("[ { \"a\" : 1 }, [ [ ] ], \"b\" ]");
+    CompareWithStream("{ \"skip_obj\" : { \"a\" : 1, \"c\" : [ { }, { \"e\" : { } } ] }, \"d\" : 3, \"skip_obj\" : { } }");
+    CompareWithStream("{ \"skip_array\" : [ \"a\", 1, [ { }, { \"e\" : [ ] } ] ], \"d\" : 3, \"skip_array\" : [ ] }");
+    CompareWithStream("{ \"skip_var\" : { \"a\" : 1 }, \"d\" : 3, \"f\" : { \"g\" : 4, \"skip_var\" : [ { }, 3, [], true ], \"h\" : 5 } }");
+    CompareWithStream("{ \"a\" : [ { \"skip_obj\" : { \"b\" : [ 1 ] }, \"c\" : 2 } ], \"d\" : 4 }");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "nsJSONReader")
+  {
+    const char* szTestData = "{ \"array\" : [ 1, \"two\", [ 3 ], { \"four\" : 4 } ], \"object\" : { \"bool\" : true, \"null\" : null } }";
+
+    nsJSONReader fromStream;
+    nsRawMemoryStreamReader stream(szTestData, nsStringUtils::GetStringElementCount(szTestData));
+    NS_TEST_BOOL(fromStream.Parse(stream).Succeeded());
+
+    nsJSONTape tape;
+    NS_TEST_BOOL(ParseTape(tape, szTestData).Succeeded());
+
+    nsJSONReader fromTape;
+    NS_TEST_BOOL(fromTape.Parse(tape).Succeeded());
+
+    NS_TEST_BOOL(fromTape.GetTopLevelElementType() == nsJSONReader::ElementType::Dictionary);
+    NS_TEST_BOOL(fromTape.GetTopLevelObject() == fromStream.GetTopLevelObject());
+  }
+}
@@ -373,7 +373,7 @@ NS_CREATE_SIMPLE_TEST(IO, StandardJSONWriter)
 {\n\
   \"String\" : \"testvälue\",\n\
   \"double\" : 43.56,\n\
-  \"float\" : 64.720001,\n\
+  \"float\" : 64.72,\n\
   \"bööl\" : true,\n\
   \"int\" : 23,\n\
   \"myarray\" : [ 1, 2.2, 3.3, false, \"ende\" ],\n\
@@ -218,6 +218,73 @@ Only concrete and clocks.\n\
 
 #endif
 
+#if (NS_ENABLED(NS_SUPPORTS_FILE_ITERATORS) && NS_ENABLED(NS_SUPPORTS_FILE_STATS))
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "GatherAllItemsInFolderParallel")
+  {
+    {
+      nsOSFile f;
+      NS_TEST_BOOL(f.Open(sOutputFile3.GetData(), nsFileOpenMode::Write) == NS_SUCCESS);
+    }
+
+    nsStringBuilder sFolder = nsTestFramework::GetInstance()->GetAbsOutputPath();
+    sFolder.MakeCleanPath();
+    sFolder.AppendPath("IO");
+
+    nsDynamicArray<nsFileStats> serialItems;
+    nsDynamicArray<nsFileStats> parallelItems;
+
+    nsBitflags<nsFileSystemIteratorFlags> flagCombinations[] = {nsFileSystemIteratorFlags::ReportFilesAndFoldersRecursive, nsFileSystemIteratorFlags::ReportFilesRecursive, nsFileSystemIteratorFlags::ReportFoldersRecursive, nsFileSystemIteratorFlags::ReportFolders};
+
+    for (auto flags : flagCombinations)
+    {
+      nsOSFile::GatherAllItemsInFolder(serialItems, sFolder, flags);
+      nsOSFile::GatherAllItemsInFolderParallel(parallelItems, sFolder, flags);
+
+      NS_TEST_BOOL(!serialItems.IsEmpty());
+
+      if (NS_TEST_INT(parallelItems.GetCount(), serialItems.GetCount()))
+      {
+        for (nsUInt32 i = 0; i < serialItems.GetCount(); ++i)
+        {
+          NS_TEST_STRING(parallelItems[i].m_sParentPath, serialItems[i].m_sParentPath);
+          NS_TEST_STRING(parallelItems[i].m_sName, serialItems[i].m_sName);
+          NS_TEST_BOOL(parallelItems[i].m_bIsDirectory == serialItems[i].m_bIsDirectory);
+          NS_TEST_INT(parallelItems[i].m_uiFileSize, serialItems[i].m_uiFileSize);
+        }
+      }
+    }
+
+    NS_TEST_BOOL(nsOSFile::DeleteFile(sOutputFile3.GetData()) == NS_SUCCESS);
+  }
+
+#endif
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Replace File")
+  {
+    nsStringBuilder sReplacement(sOutputFile2, ".replace");
+
+    {
+      nsOSFile f;
+      NS_TEST_BOOL(f.Open(sReplacement.GetData(), nsFileOpenMode::Write) == NS_SUCCESS);
+      NS_TEST_BOOL(f.Write(sFileContent.GetData(), uiTextLen) == NS_SUCCESS);
+    }
+
+    // replaces the existing copy
+    NS_TEST_BOOL(nsOSFile::ReplaceFile(sReplacement, sOutputFile2) == NS_SUCCESS);
+    NS_TEST_BOOL(!nsOSFile::ExistsFile(sReplacement));
+
+    {
+      nsOSFile f;
+      NS_TEST_BOOL(f.Open(sOutputFile2.GetData(), nsFileOpenMode::Read) == NS_SUCCESS);
+      NS_TEST_INT(f.GetFileSize(), uiTextLen);
+    }
+
+    // a missing source leaves the target untouched
+    NS_TEST_BOOL(nsOSFile::ReplaceFile(sReplacement, sOutputFile2) == NS_FAILURE);
+    NS_TEST_BOOL(nsOSFile::ExistsFile(sOutputFile2));
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Delete File")
   {
     NS_TEST_BOOL(nsOSFile::DeleteFile(sOutputFile.GetData()) == NS_SUCCESS);
@@ -10,6 +10,7 @@
 #include <Foundation/Logging/ConsoleWriter.h>
 #include <Foundation/Logging/HTMLWriter.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/LogRateLimiter.h>
 #include <Foundation/Logging/VisualStudioWriter.h>
 #include <Foundation/Threading/Thread.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
@@ -218,6 +219,42 @@ E: Remember when you tried to kill me twice?\n\
   NS_TEST_STRING(szResult2, szExpected2);
 }
 
+NS_CREATE_SIMPLE_TEST(Logging, FormatString)
+{
+  LogTestLogInterface log;
+  nsLogSystemScope logScope(&log);
+  log.SetLogLevel(nsLogMsgType::DevMsg);
+
+  const nsUInt32 uiLoaded = 3;
+  const nsUInt32 uiTotal = 4;
+
+  nsLog::Error(NS_FMT("Loaded {} of {} assets", uiLoaded, uiTotal));
+  nsLog::SeriousWarning(NS_FMT("{}", "serious"));
+  nsLog::Warning(NS_FMT("{1} {0}", "warning", "a"));
+  nsLog::Success(NS_FMT("100%% done"));
+  nsLog::Info(NS_FMT("{} info", 1));
+  nsLog::Dev(NS_FMT("dev {}", 2.5f));
+  nsLog::Info(nsFmt("{} runtime format", 1));
+  nsLog::Info(&log, NS_FMT("{} specific log", "to a"));
+
+  // plain strings are still formatted, not passed through as format strings
+  nsLog::Info("50%%");
+
+  const char* szExpected = "\
+E: Loaded 3 of 4 assets\n\
+SW: serious\n\
+W: a warning\n\
+S: 100% done\n\
+I: 1 info\n\
+E: dev 2.5\n\
+I: 1 runtime format\n\
+I: to a specific log\n\
+I: 50%\n\
+";
+
+  NS_TEST_STRING(log.m_Result, szExpected);
+}
+
 NS_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
 {
   nsLog::GetThreadLocalLogSystem()->SetLogLevel(nsLogMsgType::All);
@@ -259,3 +296,268 @@ NS_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+namespace
+{
+  struct AsyncLogCollector
+  {
+    void LogMessageHandler(const nsLoggingEventData& le)
+    {
+      if (le.m_sTag != "AsyncLogTest")
+        return;
+
+      NS_LOCK(m_Mutex);
+      m_Messages.PushBack(le.m_sText);
+      m_Types.PushBack(static_cast<nsUInt8>(le.m_EventType));
+    }
+
+    nsMutex m_Mutex;
+    nsDynamicArray<nsString> m_Messages;
+    nsDynamicArray<nsUInt8> m_Types;
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Logging, AsyncGlobalLog)
+{
+  AsyncLogCollector collector;
+  nsGlobalLog::AddLogWriter(nsMakeDelegate(&AsyncLogCollector::LogMessageHandler, &collector));
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Ordering")
+  {
+    collector.m_Messages.Clear();
+    collector.m_Types.Clear();
+
+    nsGlobalLog::EnableAsyncMode();
+    NS_TEST_BOOL(nsGlobalLog::IsAsyncModeEnabled());
+
+    class LogThread : public nsThread
+    {
+    public:
+      virtual nsUInt32 Run() override
+      {
+        nsStringBuilder sText;
+        for (nsUInt32 i = 0; i < 100; ++i)
+        {
+          sText.Format("T{} {}", m_uiIndex, i);
+          nsLog::Info("[AsyncLogTest]{}", sText);
+        }
+        return 0;
+      }
+
+      nsUInt32 m_uiIndex = 0;
+    };
+
+    LogThread thread[4];
+
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      thread[i].m_uiIndex = i;
+      thread[i].Start();
+    }
+
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      thread[i].Join();
+    }
+
+    nsLog::Info("[AsyncLogTest]Main 0");
+
+    // errors are dispatched before the log call returns, together with everything that was queued before
+    nsLog::Error("[AsyncLogTest]Main Error");
+    {
+      NS_LOCK(collector.m_Mutex);
+      NS_TEST_INT(collector.m_Messages.GetCount(), 402);
+      NS_TEST_STRING(collector.m_Messages.PeekBack(), "Main Error");
+      NS_TEST_INT(collector.m_Types.PeekBack(), nsLogMsgType::ErrorMsg);
+    }
+
+    nsLog::Info("[AsyncLogTest]Main 1");
+
+    nsGlobalLog::DisableAsyncMode();
+    NS_TEST_BOOL(!nsGlobalLog::IsAsyncModeEnabled());
+
+    NS_TEST_INT(collector.m_Messages.GetCount(), 403);
+    NS_TEST_STRING(collector.m_Messages[400], "Main 0");
+    NS_TEST_STRING(collector.m_Messages[402], "Main 1");
+
+    // the messages of each thread arrive in the order in which they were logged
+    nsUInt32 uiNext[4] = {0, 0, 0, 0};
+    nsStringBuilder sExpected;
+    for (nsUInt32 i = 0; i < 400; ++i)
+    {
+      const nsUInt32 uiThread = collector.m_Messages[i].GetData()[1] - '0';
+      if (!NS_TEST_BOOL(uiThread < 4))
+        break;
+
+      sExpected.Format("T{} {}", uiThread, uiNext[uiThread]);
+      NS_TEST_STRING(collector.m_Messages[i], sExpected);
+      ++uiNext[uiThread];
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Drop")
+  {
+    collector.m_Messages.Clear();
+    collector.m_Types.Clear();
+
+    const nsUInt64 uiDroppedBefore = nsGlobalLog::GetNumDroppedMessages();
+
+    // the smallest possible queue, without a chance for the dispatcher to catch up, must drop messages
+    nsGlobalLog::EnableAsyncMode(0, nsLogOverflowPolicy::Drop);
+
+    for (nsUInt32 i = 0; i < 1000; ++i)
+    {
+      nsLog::Info("[AsyncLogTest]Message");
+    }
+
+    nsGlobalLog::DisableAsyncMode();
+
+    const nsUInt64 uiDropped = nsGlobalLog::GetNumDroppedMessages() - uiDroppedBefore;
+    NS_TEST_INT(collector.m_Messages.GetCount() + uiDropped, 1000);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Logging During Thread Exit")
+  {
+    collector.m_Messages.Clear();
+    collector.m_Types.Clear();
+
+    nsGlobalLog::EnableAsyncMode();
+
+    class LogThread : public nsThread
+    {
+    public:
+      virtual nsUInt32 Run() override
+      {
+        // constructed before the log queue of this thread, so it is destroyed after it
+        struct LogOnExit
+        {
+          ~LogOnExit()
+          {
+            // deletes the queue of this thread, which is already orphaned and drained by then
+            nsGlobalLog::FlushAsyncMessages();
+            nsLog::Info("[AsyncLogTest]Exit");
+          }
+        };
+
+        static thread_local LogOnExit s_LogOnExit;
+        NS_IGNORE_UNUSED(s_LogOnExit);
+
+        nsLog::Info("[AsyncLogTest]Run");
+        return 0;
+      }
+    };
+
+    LogThread thread;
+    thread.Start();
+    thread.Join();
+
+    nsGlobalLog::DisableAsyncMode();
+
+    if (NS_TEST_INT(collector.m_Messages.GetCount(), 2))
+    {
+      NS_TEST_STRING(collector.m_Messages[0], "Run");
+      NS_TEST_STRING(collector.m_Messages[1], "Exit");
+    }
+  }
+
+  nsGlobalLog::RemoveLogWriter(nsMakeDelegate(&AsyncLogCollector::LogMessageHandler, &collector));
+}
+
+namespace
+{
+  class RateLimiterLogInterface : public nsLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const nsLoggingEventData& le) override { m_pLimiter->LogMessageHandler(le); }
+
+    nsLogRateLimiter* m_pLimiter = nullptr;
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Logging, LogRateLimiter)
+{
+  LogTestLogInterface output;
+
+  auto Setup = [&](nsLogRateLimiter& ref_limiter, RateLimiterLogInterface& ref_input)
+  {
+    output.m_Result.Clear();
+    ref_limiter.AddLogWriter(nsMakeDelegate(&LogTestLogInterface::HandleLogMessage, &output));
+    ref_limiter.SetSummaryInterval(nsTime::MakeFromHours(1));
+    ref_input.m_pLimiter = &ref_limiter;
+    ref_input.SetLogLevel(nsLogMsgType::All);
+  };
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Deduplication")
+  {
+    nsLogRateLimiter limiter;
+    RateLimiterLogInterface input;
+    Setup(limiter, input);
+    limiter.SetDeduplicationWindow(nsTime::MakeFromHours(1));
+    limiter.SetRateLimit(0, 0);
+
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      nsLog::Warning(&input, "[Entity]Entity {} has no mesh", i);
+      nsLog::Info(&input, "Frame {}", i);
+    }
+
+    // errors are never filtered by default
+    nsLog::Error(&input, "Broken");
+    nsLog::Error(&input, "Broken");
+
+    NS_TEST_INT(limiter.GetNumSuppressedMessages(), 198);
+
+    limiter.EmitSummaries();
+
+    NS_TEST_BOOL(output.m_Result.StartsWith("W:Entity Entity 0 has no mesh\n\
+I: Frame 0\n\
+E: Broken\n\
+E: Broken\n\
+"));
+
+    NS_TEST_BOOL(output.m_Result.FindSubString("W:Entity Suppressed 99 repeats of: Entity 1 has no mesh\n") != nullptr);
+    NS_TEST_BOOL(output.m_Result.FindSubString("I: Suppressed 99 repeats of: Frame 1\n") != nullptr);
+
+    // nothing more to report
+    output.m_Result.Clear();
+    limiter.EmitSummaries();
+    NS_TEST_BOOL(output.m_Result.IsEmpty());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Rate Limit")
+  {
+    nsLogRateLimiter limiter;
+    RateLimiterLogInterface input;
+    Setup(limiter, input);
+    limiter.SetDeduplicationWindow(nsTime::MakeZero());
+    limiter.SetRateLimit(0.001, 3);
+    limiter.SetFilterErrors(true);
+
+    for (nsUInt32 i = 0; i < 10; ++i)
+    {
+      nsLog::Warning(&input, "[Physics]Contact {}", i);
+      nsLog::Warning(&input, "[Audio]Voice {}", i);
+    }
+
+    nsLog::Error(&input, "[Physics]Broken");
+
+    NS_TEST_INT(limiter.GetNumSuppressedMessages(), 14);
+
+    // flushing the log reports the suppressed messages
+    nsLog::Flush(0, nsTime::MakeFromSeconds(10), &input);
+
+    NS_TEST_BOOL(output.m_Result.StartsWith("W:Physics Contact 0\n\
+W:Audio Voice 0\n\
+W:Physics Contact 1\n\
+W:Audio Voice 1\n\
+W:Physics Contact 2\n\
+W:Audio Voice 2\n\
+E:Physics Broken\n\
+"));
+
+    // the order of the summaries is undefined
+    NS_TEST_BOOL(output.m_Result.FindSubString("W:Audio Suppressed 7 messages that exceeded the rate limit\n") != nullptr);
+    NS_TEST_BOOL(output.m_Result.FindSubString("W:Physics Suppressed 7 messages that exceeded the rate limit\n") != nullptr);
+    NS_TEST_BOOL(output.m_Result.EndsWith("[Flush]\n"));
+  }
+}
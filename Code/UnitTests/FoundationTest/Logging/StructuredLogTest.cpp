@@ -0,0 +1,170 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/LogEntry.h>
+#include <Foundation/Logging/StructuredLog.h>
+#include <Foundation/Time/Time.h>
+
+NS_CREATE_SIMPLE_TEST(Logging, StructuredLog)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Write and Decode")
+  {
+    nsDefaultMemoryStreamStorage storage;
+
+    {
+      nsMemoryStreamWriter writer(&storage);
+
+      nsStructuredLogWriter log;
+      log.BeginLog(writer);
+      nsStructuredLog::SetWriter(&log);
+
+      const nsString sName = "Player";
+
+      for (nsUInt32 i = 0; i < 3; ++i)
+      {
+        nsStructuredLog::Info("[Game]Spawned {} at {}, {}", sName, i, -1.5f * i);
+      }
+
+      nsStructuredLog::Warning("Flags: {1} {0}", true, nsUInt64(0xFFFFFFFFFFFFFFFFull));
+      nsStructuredLog::Error("{} took {}", "Loading", nsTime::MakeFromMilliseconds(25));
+      nsStructuredLog::Success("100%% done");
+
+      nsStructuredLog::SetWriter(nullptr);
+      log.EndLog();
+    }
+
+    nsMemoryStreamReader reader(&storage);
+    nsStructuredLogReader decoder;
+    NS_TEST_RESULT(decoder.Open(reader));
+
+    nsLogEntry entry;
+    nsStringBuilder sExpected;
+    char szTmp[64];
+
+    for (nsUInt32 i = 0; i < 3; ++i)
+    {
+      NS_TEST_RESULT(decoder.ReadNextEntry(entry));
+      sExpected.Format("Spawned Player at {}, {}", i, -1.5f * i);
+      NS_TEST_STRING(entry.m_sMsg, sExpected);
+      NS_TEST_STRING(entry.m_sTag, "Game");
+      NS_TEST_BOOL(entry.m_Type == nsLogMsgType::InfoMsg);
+    }
+
+    NS_TEST_RESULT(decoder.ReadNextEntry(entry));
+    NS_TEST_STRING(entry.m_sMsg, "Flags: 18446744073709551615 true");
+    NS_TEST_STRING(entry.m_sTag, "");
+    NS_TEST_BOOL(entry.m_Type == nsLogMsgType::WarningMsg);
+
+    // types without a raw representation are formatted when they are logged
+    NS_TEST_RESULT(decoder.ReadNextEntry(entry));
+    sExpected.Set("Loading took ", BuildString(szTmp, NS_ARRAY_SIZE(szTmp) - 1, nsTime::MakeFromMilliseconds(25)));
+    NS_TEST_STRING(entry.m_sMsg, sExpected);
+    NS_TEST_BOOL(entry.m_Type == nsLogMsgType::ErrorMsg);
+
+    NS_TEST_RESULT(decoder.ReadNextEntry(entry));
+    NS_TEST_STRING(entry.m_sMsg, "100% done");
+
+    NS_TEST_BOOL(decoder.ReadNextEntry(entry).Failed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Filtering")
+  {
+    nsDefaultMemoryStreamStorage storage;
+
+    {
+      nsMemoryStreamWriter writer(&storage);
+
+      nsStructuredLogWriter log;
+      log.SetLogLevel(nsLogMsgType::InfoMsg);
+      log.SetTagEnabled("Physics", false);
+      log.BeginLog(writer);
+      nsStructuredLog::SetWriter(&log);
+
+      for (nsUInt32 i = 0; i < 2; ++i)
+      {
+        nsStructuredLog::Info("[Physics]Body {} woke up", i);
+        nsStructuredLog::Info("[Render]Frame {}", i);
+        nsStructuredLog::Dev("[Render]Dev {}", i);
+
+        // enabling the tag again affects formats that were already registered
+        log.SetTagEnabled("Physics", true);
+      }
+
+      nsStructuredLog::SetWriter(nullptr);
+      log.EndLog();
+    }
+
+    nsMemoryStreamReader reader(&storage);
+    nsStructuredLogReader decoder;
+    NS_TEST_RESULT(decoder.Open(reader));
+
+    nsLogSystemToBuffer buffer;
+    decoder.ReplayInto(&buffer);
+
+    NS_TEST_STRING(buffer.m_sBuffer, "Frame 0\nBody 1 woke up\nFrame 1\n");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Without Writer")
+  {
+    nsLogSystemToBuffer buffer;
+    nsLogSystemScope scope(&buffer);
+
+    nsStructuredLog::Warning("[Tag]Value {}", 42);
+
+    NS_TEST_STRING(buffer.m_sBuffer, "Warning: Value 42\n");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Invalid Data")
+  {
+    nsDefaultMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    writer << nsUInt32(12345);
+
+    nsMemoryStreamReader reader(&storage);
+    nsStructuredLogReader decoder;
+    NS_TEST_BOOL(decoder.Open(reader).Failed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Corrupted String Length")
+  {
+    nsContiguousMemoryStreamStorage storage;
+
+    {
+      nsMemoryStreamWriter writer(&storage);
+
+      nsStructuredLogWriter log;
+      log.BeginLog(writer);
+      nsStructuredLog::SetWriter(&log);
+      nsStructuredLog::Info("Loaded {}", "Level1");
+      nsStructuredLog::SetWriter(nullptr);
+      log.EndLog();
+    }
+
+    nsDynamicArray<nsUInt8> data;
+    data.SetCountUninitialized(storage.GetStorageSize32());
+    nsMemoryUtils::Copy(data.GetData(), storage.GetData(), data.GetCount());
+
+    // the string argument is the last thing in the log, directly preceded by its length
+    const nsUInt32 uiLengthOffset = data.GetCount() - 6 - sizeof(nsUInt32);
+    nsUInt32 uiLength = 0;
+    nsMemoryUtils::Copy(reinterpret_cast<nsUInt8*>(&uiLength), data.GetData() + uiLengthOffset, sizeof(nsUInt32));
+    NS_TEST_INT(uiLength, 6);
+
+    for (nsUInt32 uiCorruptedLength : {7u, 0x100000u, 0xFFFFFFFFu})
+    {
+      nsMemoryUtils::Copy(data.GetData() + uiLengthOffset, reinterpret_cast<const nsUInt8*>(&uiCorruptedLength), sizeof(nsUInt32));
+
+      nsRawMemoryStreamReader reader(data);
+      nsStructuredLogReader decoder;
+      NS_TEST_RESULT(decoder.Open(reader));
+
+      nsLogEntry entry;
+      NS_TEST_BOOL(decoder.ReadNextEntry(entry).Failed());
+    }
+  }
+}
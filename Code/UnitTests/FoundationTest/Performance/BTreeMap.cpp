@@ -0,0 +1,141 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/BTreeMap.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_ELEMENTS = 1024 * 16,
+    NUM_LOOKUPS = 1024 * 64,
+    NUM_SAMPLES = 4
+#else
+    NUM_ELEMENTS = 1024 * 256,
+    NUM_LOOKUPS = 1024 * 1024,
+    NUM_SAMPLES = 8
+#endif
+  };
+
+  template <typename MapType, typename KeyType>
+  void BenchmarkMap(const char* szName, const nsDynamicArray<KeyType>& keys, const nsDynamicArray<KeyType>& lookups)
+  {
+    nsTime tInsert;
+    nsTime tLookup;
+    nsTime tIterate;
+    nsTime tRemove;
+    nsUInt64 uiSum = 0;
+
+    for (nsUInt32 n = 0; n < NUM_SAMPLES; ++n)
+    {
+      MapType map;
+
+      nsTime t0 = nsTime::Now();
+      for (nsUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        map.Insert(keys[i], i);
+      }
+
+      nsTime t1 = nsTime::Now();
+      for (const KeyType& key : lookups)
+      {
+        auto it = map.Find(key);
+        if (it.IsValid())
+          uiSum += it.Value();
+      }
+
+      nsTime t2 = nsTime::Now();
+      for (auto it : map)
+      {
+        uiSum += it.Value();
+      }
+
+      nsTime t3 = nsTime::Now();
+      for (const KeyType& key : keys)
+      {
+        map.Remove(key);
+      }
+
+      nsTime t4 = nsTime::Now();
+
+      tInsert += t1 - t0;
+      tLookup += t2 - t1;
+      tIterate += t3 - t2;
+      tRemove += t4 - t3;
+    }
+
+    const double fSamples = static_cast<double>(NUM_SAMPLES);
+    nsLog::Info("[test]{0}: Insert {1}ms, Find {2}ms, Iterate {3}ms, Remove {4}ms", szName, nsArgF(tInsert.GetMilliseconds() / fSamples, 3),
+      nsArgF(tLookup.GetMilliseconds() / fSamples, 3), nsArgF(tIterate.GetMilliseconds() / fSamples, 3), nsArgF(tRemove.GetMilliseconds() / fSamples, 3), uiSum);
+  }
+
+  template <typename KeyType, typename MakeKey>
+  void GenerateKeys(MakeKey makeKey, nsDynamicArray<KeyType>& out_keys, nsDynamicArray<KeyType>& out_lookups)
+  {
+    nsRandom rnd;
+    rnd.Initialize(1);
+
+    out_keys.Clear();
+    for (nsUInt32 i = 0; i < NUM_ELEMENTS; ++i)
+    {
+      out_keys.PushBack(makeKey(rnd.UInt()));
+    }
+
+    // half of the lookups hit, half of them miss
+    out_lookups.Clear();
+    for (nsUInt32 i = 0; i < NUM_LOOKUPS; ++i)
+    {
+      out_lookups.PushBack((i & 1) ? out_keys[rnd.UIntInRange(NUM_ELEMENTS)] : makeKey(rnd.UInt()));
+    }
+  }
+} // namespace
+
+// Enable when needed
+#define NS_PERFORMANCE_TESTS_STATE nsTestBlock::DisabledNoWarning
+
+NS_CREATE_SIMPLE_TEST(Performance, BTreeMap)
+{
+  NS_TEST_BLOCK(NS_PERFORMANCE_TESTS_STATE, "nsUInt32 Keys")
+  {
+    nsDynamicArray<nsUInt32> keys, lookups;
+    GenerateKeys<nsUInt32>([](nsUInt32 i)
+      { return i; }, keys, lookups);
+
+    BenchmarkMap<nsMap<nsUInt32, nsUInt32>>("nsMap<nsUInt32, nsUInt32>", keys, lookups);
+    BenchmarkMap<nsBTreeMap<nsUInt32, nsUInt32>>("nsBTreeMap<nsUInt32, nsUInt32>", keys, lookups);
+  }
+
+  NS_TEST_BLOCK(NS_PERFORMANCE_TESTS_STATE, "nsUInt64 Keys")
+  {
+    nsDynamicArray<nsUInt64> keys, lookups;
+    GenerateKeys<nsUInt64>([](nsUInt32 i)
+      { return static_cast<nsUInt64>(i) * 0x9E3779B97F4A7C15ull; }, keys, lookups);
+
+    BenchmarkMap<nsMap<nsUInt64, nsUInt32>>("nsMap<nsUInt64, nsUInt32>", keys, lookups);
+    BenchmarkMap<nsBTreeMap<nsUInt64, nsUInt32>>("nsBTreeMap<nsUInt64, nsUInt32>", keys, lookups);
+  }
+
+  NS_TEST_BLOCK(NS_PERFORMANCE_TESTS_STATE, "nsString Keys")
+  {
+    nsDynamicArray<nsString> keys, lookups;
+    GenerateKeys<nsString>([](nsUInt32 i)
+      {
+        nsStringBuilder s;
+        s.Format("Objects/Group{}/Item{}", i % 64, i);
+        return nsString(s); },
+      keys, lookups);
+
+    BenchmarkMap<nsMap<nsString, nsUInt32>>("nsMap<nsString, nsUInt32>", keys, lookups);
+    BenchmarkMap<nsBTreeMap<nsString, nsUInt32>>("nsBTreeMap<nsString, nsUInt32>", keys, lookups);
+  }
+}
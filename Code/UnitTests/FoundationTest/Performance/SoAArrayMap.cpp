@@ -0,0 +1,106 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Containers/SoAArrayMap.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_ELEMENTS = 1024 * 16,
+    NUM_LOOKUPS = 1024 * 64,
+    NUM_BATCHES = 16,
+#else
+    NUM_ELEMENTS = 1024 * 512,
+    NUM_LOOKUPS = 1024 * 1024 * 2,
+    NUM_BATCHES = 64,
+#endif
+  };
+
+  struct Payload
+  {
+    NS_DECLARE_POD_TYPE();
+
+    nsUInt32 m_uiData[6];
+  };
+
+  template <typename MapType>
+  void BenchmarkMap(const char* szName, MapType& ref_map, const nsDynamicArray<nsUInt32>& keys, const nsDynamicArray<nsUInt32>& lookups)
+  {
+    // fill the map in several batches with lookups in between, like tables that are extended while being used
+    nsTime t0 = nsTime::Now();
+
+    Payload payload = {};
+    for (nsUInt32 i = 0; i < keys.GetCount(); ++i)
+    {
+      payload.m_uiData[0] = i;
+      ref_map.Insert(keys[i], payload);
+
+      if ((i + 1) % (NUM_ELEMENTS / NUM_BATCHES) == 0)
+        ref_map.Sort();
+    }
+
+    nsTime t1 = nsTime::Now();
+
+    nsUInt64 uiSum = 0;
+    for (nsUInt32 uiKey : lookups)
+    {
+      const nsUInt32 uiIndex = ref_map.Find(uiKey);
+      if (uiIndex != nsInvalidIndex)
+        uiSum += ref_map.GetValue(uiIndex).m_uiData[0];
+    }
+
+    nsTime t2 = nsTime::Now();
+
+    nsLog::Info("[test]{0}: Insert {1}ms, Find {2}ms", szName, nsArgF((t1 - t0).GetMilliseconds(), 3), nsArgF((t2 - t1).GetMilliseconds(), 3), uiSum);
+  }
+} // namespace
+
+// Enable when needed
+#define NS_PERFORMANCE_TESTS_STATE nsTestBlock::DisabledNoWarning
+
+NS_CREATE_SIMPLE_TEST(Performance, SoAArrayMap)
+{
+  NS_TEST_BLOCK(NS_PERFORMANCE_TESTS_STATE, "nsUInt32 Keys")
+  {
+    nsRandom rnd;
+    rnd.Initialize(1);
+
+    nsDynamicArray<nsUInt32> keys, lookups;
+    for (nsUInt32 i = 0; i < NUM_ELEMENTS; ++i)
+    {
+      keys.PushBack(rnd.UInt());
+    }
+
+    // half of the lookups hit, half of them miss
+    for (nsUInt32 i = 0; i < NUM_LOOKUPS; ++i)
+    {
+      lookups.PushBack((i & 1) ? keys[rnd.UIntInRange(NUM_ELEMENTS)] : rnd.UInt());
+    }
+
+    {
+      nsArrayMap<nsUInt32, Payload> map;
+      BenchmarkMap("nsArrayMap", map, keys, lookups);
+    }
+
+    {
+      nsSoAArrayMap<nsUInt32, Payload> map;
+      BenchmarkMap("nsSoAArrayMap", map, keys, lookups);
+    }
+
+    {
+      nsSoAArrayMap<nsUInt32, Payload> map;
+      map.SetUseEytzingerLayout(true);
+      BenchmarkMap("nsSoAArrayMap (Eytzinger)", map, keys, lookups);
+    }
+  }
+}
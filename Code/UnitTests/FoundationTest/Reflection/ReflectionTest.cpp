@@ -6,10 +6,29 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/StringDeduplicationContext.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <FoundationTest/Reflection/ReflectionTestClasses.h>
 
+namespace
+{
+  /// Exposes UpdateType(), which types with runtime defined properties use to change them.
+  class nsUpdatableTestRTTI : public nsRTTI
+  {
+  public:
+    nsUpdatableTestRTTI(nsStringView sName, const nsRTTI* pParentType, nsArrayPtr<const nsAbstractProperty*> properties)
+      : nsRTTI(sName, pParentType, 0, 1, nsVariantType::Invalid, nsTypeFlags::Class, nullptr, properties, {}, {}, {}, {}, nullptr)
+    {
+    }
+
+    void SetProperties(nsArrayPtr<const nsAbstractProperty*> properties)
+    {
+      m_Properties = properties;
+      UpdateType(m_pParentType, m_uiTypeSize, m_uiTypeVersion, m_uiVariantType, m_TypeFlags);
+    }
+  };
+} // namespace
 
 template <typename T>
 void TestSerialization(const T& source)
@@ -276,6 +295,55 @@ NS_CREATE_SIMPLE_TEST(Reflection, Types)
     }
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindPropertyIndexByName")
+  {
+    const nsRTTI* pType = nsRTTI::FindTypeByName("nsTestClass2");
+
+    nsHybridArray<const nsAbstractProperty*, 32> AllProps;
+    pType->GetAllProperties(AllProps);
+
+    for (nsUInt32 i = 0; i < AllProps.GetCount(); ++i)
+    {
+      NS_TEST_INT(pType->FindPropertyIndexByName(AllProps[i]->GetPropertyName()), i);
+      NS_TEST_BOOL(pType->GetPropertyByIndex(i) == AllProps[i]);
+      NS_TEST_BOOL(pType->FindPropertyByName(AllProps[i]->GetPropertyName()) == AllProps[i]);
+    }
+
+    NS_TEST_INT(pType->FindPropertyIndexByName("DoesNotExist"), nsInvalidIndex);
+    NS_TEST_BOOL(pType->FindPropertyByName("DoesNotExist") == nullptr);
+
+    // base type properties are only found when searching base types
+    NS_TEST_BOOL(pType->FindPropertyByName("Color") != nullptr);
+    NS_TEST_BOOL(pType->FindPropertyByName("Color", false) == nullptr);
+    NS_TEST_BOOL(pType->FindPropertyByName("Text", false) != nullptr);
+
+    const nsRTTI* pEmpty = nsGetStaticRTTI<nsReflectedClass>();
+    NS_TEST_INT(pEmpty->FindPropertyIndexByName("Float"), nsInvalidIndex);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindPropertyByName after UpdateType")
+  {
+    nsHybridArray<const nsAbstractProperty*, 16> baseProps;
+    baseProps.PushBackRange(nsGetStaticRTTI<nsTestClass1>()->GetProperties());
+
+    nsHybridArray<const nsAbstractProperty*, 16> derivedProps;
+    derivedProps.PushBackRange(nsGetStaticRTTI<nsTestClass2>()->GetProperties());
+
+    nsUpdatableTestRTTI baseType("nsUpdatableTestBase", nullptr, baseProps);
+    nsUpdatableTestRTTI derivedType("nsUpdatableTestDerived", &baseType, derivedProps);
+
+    NS_TEST_BOOL(baseType.FindPropertyByName("Color") != nullptr);
+    NS_TEST_BOOL(derivedType.FindPropertyByName("Color") != nullptr);
+    NS_TEST_BOOL(derivedType.FindPropertyByName("Text") != nullptr);
+
+    // the derived type has flattened the base type properties into its own table, which must be rebuilt as well
+    baseType.SetProperties({});
+
+    NS_TEST_BOOL(baseType.FindPropertyByName("Color") == nullptr);
+    NS_TEST_BOOL(derivedType.FindPropertyByName("Color") == nullptr);
+    NS_TEST_INT(derivedType.FindPropertyIndexByName("Text"), 0);
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Casts")
   {
     nsTestClass2 test;
@@ -1286,3 +1354,149 @@ NS_CREATE_SIMPLE_TEST(Reflection, Pointer)
 
   TestSerialization<nsTestPtr>(containers);
 }
+
+NS_CREATE_SIMPLE_TEST(Reflection, CompiledBinarySerialization)
+{
+  auto IsCompiledStream = [](const nsDefaultMemoryStreamStorage& storage) {
+    nsMemoryStreamReader reader(&storage);
+    char tag[4] = {};
+    reader.ReadBytes(tag, 4);
+    return nsStringView(tag, tag + 4) == "nsRP";
+  };
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Plain Types")
+  {
+    nsTestStruct3 source(5.5, 7);
+    source.m_UInt8 = 9;
+
+    nsDefaultMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    nsReflectionSerializer::WriteObjectToBinary(writer, nsGetStaticRTTI<nsTestStruct3>(), &source);
+    NS_TEST_BOOL(IsCompiledStream(storage));
+
+    nsTestStruct3 data;
+    nsMemoryStreamReader reader(&storage);
+    nsReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *nsGetStaticRTTI<nsTestStruct3>(), &data);
+    NS_TEST_BOOL(data == source);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Unsupported Types")
+  {
+    // sets and pointers are written through the object graph
+    nsTestSets sets;
+    nsDefaultMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    nsReflectionSerializer::WriteObjectToBinary(writer, nsGetStaticRTTI<nsTestSets>(), &sets);
+    NS_TEST_BOOL(!IsCompiledStream(storage));
+
+    nsTestStruct3 source(5.5, 7);
+    nsDefaultMemoryStreamStorage storage2;
+    nsMemoryStreamWriter writer2(&storage2);
+    nsReflectionSerializer::WriteObjectToBinary(writer2, nsGetStaticRTTI<nsTestStruct3>(), &source);
+    NS_TEST_BOOL(IsCompiledStream(storage2));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Changed Layout")
+  {
+    // nsTypedObjectStruct has the same property names as nsTestStruct3, but a different layout,
+    // so the data has to be converted through the object graph
+    nsTypedObjectStruct source(2.25, 3);
+    source.m_iInt32 = 42;
+
+    nsDefaultMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    nsReflectionSerializer::WriteObjectToBinary(writer, nsGetStaticRTTI<nsTypedObjectStruct>(), &source);
+    NS_TEST_BOOL(IsCompiledStream(storage));
+
+    nsTestStruct3 data;
+    nsMemoryStreamReader reader(&storage);
+    nsReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *nsGetStaticRTTI<nsTestStruct3>(), &data);
+    NS_TEST_DOUBLE(data.m_fFloat1, 2.25, 0.0);
+    NS_TEST_INT(data.m_UInt8, 3);
+    NS_TEST_INT(data.GetIntPublic(), 42);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Schema Context")
+  {
+    auto WriteObjects = [](nsDefaultMemoryStreamStorage& ref_storage, const nsRTTI* pRtti, const void* pObject) {
+      nsMemoryStreamWriter writer(&ref_storage);
+      for (nsUInt32 i = 0; i < 3; ++i)
+      {
+        nsReflectionSerializer::WriteObjectToBinary(writer, pRtti, pObject);
+      }
+    };
+
+    nsTestStruct3 source(5.5, 7);
+    source.m_UInt8 = 9;
+
+    nsDefaultMemoryStreamStorage storage;
+    WriteObjects(storage, nsGetStaticRTTI<nsTestStruct3>(), &source);
+
+    nsDefaultMemoryStreamStorage storageWithContext;
+    {
+      nsReflectionSerializerSchemaWriteContext context;
+      WriteObjects(storageWithContext, nsGetStaticRTTI<nsTestStruct3>(), &source);
+    }
+
+    // only the first object carries the schema
+    NS_TEST_BOOL(storageWithContext.GetStorageSize64() < storage.GetStorageSize64());
+
+    // the type has not changed, so no schema is needed to read the data back
+    {
+      nsMemoryStreamReader reader(&storageWithContext);
+      for (nsUInt32 i = 0; i < 3; ++i)
+      {
+        nsTestStruct3 data;
+        nsReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *nsGetStaticRTTI<nsTestStruct3>(), &data);
+        NS_TEST_BOOL(data == source);
+      }
+    }
+
+    // a changed type is converted with the schema kept by the read context
+    nsTypedObjectStruct changedSource(2.25, 3);
+    changedSource.m_iInt32 = 42;
+
+    nsDefaultMemoryStreamStorage changedStorage;
+    {
+      nsReflectionSerializerSchemaWriteContext context;
+      WriteObjects(changedStorage, nsGetStaticRTTI<nsTypedObjectStruct>(), &changedSource);
+    }
+
+    {
+      nsReflectionSerializerSchemaReadContext context;
+      nsMemoryStreamReader reader(&changedStorage);
+      for (nsUInt32 i = 0; i < 3; ++i)
+      {
+        nsTestStruct3 data;
+        nsReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *nsGetStaticRTTI<nsTestStruct3>(), &data);
+        NS_TEST_DOUBLE(data.m_fFloat1, 2.25, 0.0);
+        NS_TEST_INT(data.m_UInt8, 3);
+        NS_TEST_INT(data.GetIntPublic(), 42);
+      }
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "String Deduplication")
+  {
+    // the cached schema must not depend on the string deduplication context of the stream
+    nsTypedObjectStruct source(2.25, 3);
+    source.m_iInt32 = 42;
+
+    nsDefaultMemoryStreamStorage storage;
+    {
+      nsMemoryStreamWriter writer(&storage);
+      nsStringDeduplicationWriteContext context(writer);
+      nsReflectionSerializer::WriteObjectToBinary(context.Begin(), nsGetStaticRTTI<nsTypedObjectStruct>(), &source);
+      NS_TEST_BOOL(context.End().Succeeded());
+    }
+
+    nsMemoryStreamReader reader(&storage);
+    nsStringDeduplicationReadContext context(reader);
+
+    nsTestStruct3 data;
+    nsReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *nsGetStaticRTTI<nsTestStruct3>(), &data);
+    NS_TEST_DOUBLE(data.m_fFloat1, 2.25, 0.0);
+    NS_TEST_INT(data.m_UInt8, 3);
+    NS_TEST_INT(data.GetIntPublic(), 42);
+  }
+}
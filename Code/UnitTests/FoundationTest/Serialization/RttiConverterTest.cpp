@@ -10,6 +10,7 @@
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 #include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/DdlSerializer.h>
+#include <Foundation/Serialization/GraphPatch.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
 #include <FoundationTest/Reflection/ReflectionTestClasses.h>
@@ -335,3 +336,285 @@ NS_CREATE_SIMPLE_TEST(Serialization, RttiConverter)
     }
   }
 }
+
+NS_CREATE_SIMPLE_TEST(Serialization, BinaryGraph)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "String Table")
+  {
+    nsAbstractObjectGraph graph;
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      nsAbstractObjectNode* pNode = graph.AddNode(nsUuid::MakeUuid(), "nsRepeatedTypeName", 3, i == 0 ? "root" : "");
+      pNode->AddProperty("RepeatedPropertyName", i);
+      pNode->AddProperty("OtherPropertyName", nsVec3(1, 2, (float)i));
+    }
+
+    nsContiguousMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    nsAbstractGraphBinarySerializer::Write(writer, &graph);
+
+    // every name is only stored once
+    auto CountOccurrences = [&](nsStringView sName) {
+      nsUInt32 uiCount = 0;
+      for (nsUInt32 i = 0; i + sName.GetElementCount() <= storage.GetStorageSize32(); ++i)
+      {
+        if (nsMemoryUtils::RawByteCompare(storage.GetData() + i, sName.GetStartPointer(), sName.GetElementCount()) == 0)
+          ++uiCount;
+      }
+      return uiCount;
+    };
+
+    NS_TEST_INT(CountOccurrences("RepeatedPropertyName"), 1);
+    NS_TEST_INT(CountOccurrences("nsRepeatedTypeName"), 1);
+
+    nsMemoryStreamReader reader(&storage);
+    nsAbstractObjectGraph graph2;
+    nsAbstractGraphBinarySerializer::Read(reader, &graph2);
+
+    NS_TEST_INT(graph2.GetAllNodes().GetCount(), 100);
+    for (auto it = graph.GetAllNodes().GetIterator(); it.IsValid(); ++it)
+    {
+      const nsAbstractObjectNode* pNode = it.Value();
+      const nsAbstractObjectNode* pNode2 = graph2.GetNode(it.Key());
+      if (!NS_TEST_BOOL(pNode2 != nullptr))
+        continue;
+
+      NS_TEST_STRING(pNode2->GetType(), pNode->GetType());
+      NS_TEST_STRING(pNode2->GetNodeName(), pNode->GetNodeName());
+      NS_TEST_INT(pNode2->GetTypeVersion(), 3);
+      NS_TEST_INT(pNode2->GetProperties().GetCount(), 2);
+      NS_TEST_BOOL(pNode2->FindProperty("RepeatedPropertyName")->m_Value == pNode->FindProperty("RepeatedPropertyName")->m_Value);
+      NS_TEST_BOOL(pNode2->FindProperty("OtherPropertyName")->m_Value == pNode->FindProperty("OtherPropertyName")->m_Value);
+    }
+
+    NS_TEST_BOOL(graph2.GetNodeByName("root") != nullptr);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Chunks")
+  {
+    // enough nodes to be split into several chunks that are read in parallel
+    nsAbstractObjectGraph graph;
+    nsAbstractObjectGraph typesGraph;
+    for (nsUInt32 i = 0; i < 1000; ++i)
+    {
+      nsStringBuilder sName;
+      sName.Format("Node{0}", i);
+      nsAbstractObjectNode* pNode = graph.AddNode(nsUuid::MakeUuid(), i % 2 ? "nsTypeA" : "nsTypeB", i, sName);
+      pNode->AddProperty("Index", i);
+      pNode->AddProperty("Name", nsString(sName));
+    }
+    typesGraph.AddNode(nsUuid::MakeUuid(), "nsReflectedTypeDescriptor", 1)->AddProperty("TypeName", "nsTypeA");
+
+    nsContiguousMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    nsAbstractGraphBinarySerializer::Write(writer, &graph, &typesGraph);
+
+    nsMemoryStreamReader reader(&storage);
+    nsAbstractObjectGraph graph2;
+    nsAbstractObjectGraph typesGraph2;
+    nsAbstractGraphBinarySerializer::Read(reader, &graph2, &typesGraph2);
+
+    NS_TEST_INT(graph2.GetAllNodes().GetCount(), 1000);
+    NS_TEST_INT(typesGraph2.GetAllNodes().GetCount(), 1);
+    for (auto it = graph.GetAllNodes().GetIterator(); it.IsValid(); ++it)
+    {
+      const nsAbstractObjectNode* pNode = it.Value();
+      const nsAbstractObjectNode* pNode2 = graph2.GetNodeByName(pNode->GetNodeName());
+      if (!NS_TEST_BOOL(pNode2 != nullptr))
+        continue;
+
+      NS_TEST_BOOL(pNode2->GetGuid() == pNode->GetGuid());
+      NS_TEST_BOOL(pNode2->GetOwner() == &graph2);
+      NS_TEST_STRING(pNode2->GetType(), pNode->GetType());
+      NS_TEST_INT(pNode2->GetTypeVersion(), pNode->GetTypeVersion());
+      NS_TEST_BOOL(pNode2->FindProperty("Index")->m_Value == pNode->FindProperty("Index")->m_Value);
+      NS_TEST_BOOL(pNode2->FindProperty("Name")->m_Value == pNode->FindProperty("Name")->m_Value);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Version 1")
+  {
+    // streams written before the string table was introduced can still be read
+    nsContiguousMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+
+    const nsUuid guid = nsUuid::MakeUuid();
+    writer << nsUInt32(1);
+    writer << nsUInt32(1);
+    writer << guid;
+    writer << nsStringView("nsSomeType");
+    writer << nsUInt32(7);
+    writer << nsStringView("root");
+    writer << nsUInt32(1);
+    writer << nsStringView("Value");
+    writer << nsVariant(42);
+
+    nsMemoryStreamReader reader(&storage);
+    nsAbstractObjectGraph graph;
+    nsAbstractGraphBinarySerializer::Read(reader, &graph);
+
+    const nsAbstractObjectNode* pNode = graph.GetNodeByName("root");
+    if (NS_TEST_BOOL(pNode != nullptr))
+    {
+      NS_TEST_BOOL(pNode->GetGuid() == guid);
+      NS_TEST_STRING(pNode->GetType(), "nsSomeType");
+      NS_TEST_INT(pNode->GetTypeVersion(), 7);
+      NS_TEST_BOOL(pNode->FindProperty("Value")->m_Value == nsVariant(42));
+    }
+  }
+}
+
+NS_CREATE_SIMPLE_TEST(Serialization, GraphDiff)
+{
+  nsAbstractObjectGraph base;
+  nsDynamicArray<nsUuid> guids;
+  for (nsUInt32 i = 0; i < 10; ++i)
+  {
+    guids.PushBack(nsUuid::MakeUuid());
+    nsAbstractObjectNode* pNode = base.AddNode(guids.PeekBack(), "nsDiffType", 1);
+    pNode->AddProperty("A", i);
+    pNode->AddProperty("B", nsVec3(1, 2, 3));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Content Hash")
+  {
+    nsAbstractObjectGraph graph;
+    nsAbstractObjectNode* pNode = graph.AddNode(nsUuid::MakeUuid(), "nsDiffType", 1);
+    pNode->AddProperty("B", nsVec3(1, 2, 3));
+    pNode->AddProperty("A", 0u);
+
+    // property order does not matter, the guid is not part of the hash
+    const nsUInt64 uiHash = pNode->GetContentHash();
+    NS_TEST_INT(uiHash, base.GetNode(guids[0])->GetContentHash());
+
+    pNode->ChangeProperty("A", 1u);
+    NS_TEST_BOOL(pNode->GetContentHash() != uiHash);
+    NS_TEST_INT(pNode->GetContentHash(), base.GetNode(guids[1])->GetContentHash());
+
+    pNode->FindProperty("A")->m_Value = 0u;
+    NS_TEST_INT(pNode->GetContentHash(), uiHash);
+
+    pNode->SetTypeVersion(2);
+    NS_TEST_BOOL(pNode->GetContentHash() != uiHash);
+
+    // typed pointers are hashed by address, also inside arrays and dictionaries
+    nsInt32 iObjects[2] = {};
+    const nsRTTI* pType = nsGetStaticRTTI<nsInt32>();
+
+    nsVariantArray pointers;
+    pointers.PushBack(nsTypedPointer(&iObjects[0], pType));
+    nsVariantDictionary pointerDict;
+    pointerDict.Insert("P", nsTypedPointer(&iObjects[0], pType));
+
+    pNode->AddProperty("C", pointers);
+    pNode->AddProperty("D", pointerDict);
+    const nsUInt64 uiPointerHash = pNode->GetContentHash();
+
+    pointers[0] = nsTypedPointer(&iObjects[1], pType);
+    pNode->ChangeProperty("C", pointers);
+    NS_TEST_BOOL(pNode->GetContentHash() != uiPointerHash);
+
+    pointers[0] = nsTypedPointer(&iObjects[0], pType);
+    pNode->ChangeProperty("C", pointers);
+    NS_TEST_INT(pNode->GetContentHash(), uiPointerHash);
+
+    pointerDict["P"] = nsTypedPointer(&iObjects[1], pType);
+    pNode->ChangeProperty("D", pointerDict);
+    NS_TEST_BOOL(pNode->GetContentHash() != uiPointerHash);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "CreateDiffWithBaseGraph")
+  {
+    nsAbstractObjectGraph graph;
+    base.Clone(graph);
+
+    nsDeque<nsAbstractGraphDiffOperation> diff;
+    graph.CreateDiffWithBaseGraph(base, diff);
+    NS_TEST_BOOL(diff.IsEmpty());
+
+    graph.GetNode(guids[3])->ChangeProperty("B", nsVec3(4, 5, 6));
+    graph.RemoveNode(guids[5]);
+    const nsUuid addedGuid = nsUuid::MakeUuid();
+    graph.AddNode(addedGuid, "nsDiffType", 1, "added")->AddProperty("A", 42u);
+
+    graph.CreateDiffWithBaseGraph(base, diff);
+    if (NS_TEST_INT(diff.GetCount(), 4))
+    {
+      NS_TEST_BOOL(diff[0].m_Operation == nsAbstractGraphDiffOperation::Op::NodeRemoved);
+      NS_TEST_BOOL(diff[0].m_Node == guids[5]);
+      NS_TEST_BOOL(diff[1].m_Operation == nsAbstractGraphDiffOperation::Op::NodeAdded);
+      NS_TEST_BOOL(diff[1].m_Node == addedGuid);
+      NS_TEST_BOOL(diff[2].m_Operation == nsAbstractGraphDiffOperation::Op::PropertyChanged);
+      NS_TEST_BOOL(diff[2].m_Node == addedGuid);
+      NS_TEST_BOOL(diff[3].m_Operation == nsAbstractGraphDiffOperation::Op::PropertyChanged);
+      NS_TEST_BOOL(diff[3].m_Node == guids[3]);
+      NS_TEST_STRING(diff[3].m_sProperty, "B");
+    }
+
+    nsAbstractObjectGraph patched;
+    base.Clone(patched);
+    patched.ApplyDiff(diff);
+
+    nsDeque<nsAbstractGraphDiffOperation> diff2;
+    graph.CreateDiffWithBaseGraph(patched, diff2);
+    NS_TEST_BOOL(diff2.IsEmpty());
+  }
+}
+
+namespace
+{
+  class nsPatchChainTestPatch : public nsGraphPatch
+  {
+  public:
+    nsPatchChainTestPatch(nsUInt32 uiTypeVersion)
+      : nsGraphPatch("nsPatchChainTestType", uiTypeVersion)
+    {
+    }
+
+    virtual void Patch(nsGraphPatchContext& ref_context, nsAbstractObjectGraph* pGraph, nsAbstractObjectNode* pNode) const override
+    {
+      nsStringBuilder sName;
+      sName.Format("Patch{0}", GetTypeVersion());
+      pNode->AddProperty(sName, pNode->GetTypeVersion());
+    }
+  };
+
+  nsPatchChainTestPatch g_PatchChainTestPatch3(3);
+  nsPatchChainTestPatch g_PatchChainTestPatch7(7);
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Serialization, GraphVersioning)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Patch Chain")
+  {
+    // the types graph describes the version each type had when the graph was saved
+    auto AddTypeInfo = [](nsAbstractObjectGraph& ref_typesGraph, nsStringView sType, nsUInt32 uiVersion) {
+      nsAbstractObjectNode* pTypeNode = ref_typesGraph.AddNode(nsUuid::MakeUuid(), "nsReflectedTypeDescriptor", 1);
+      pTypeNode->AddProperty("TypeName", nsString(sType));
+      pTypeNode->AddProperty("ParentTypeName", nsString());
+      pTypeNode->AddProperty("TypeVersion", uiVersion);
+    };
+
+    for (nsUInt32 uiSavedVersion : {1u, 4u, 7u})
+    {
+      nsAbstractObjectGraph graph;
+      nsAbstractObjectGraph typesGraph;
+      AddTypeInfo(typesGraph, "nsPatchChainTestType", uiSavedVersion);
+
+      for (nsUInt32 i = 0; i < 10; ++i)
+      {
+        graph.AddNode(nsUuid::MakeUuid(), "nsPatchChainTestType", uiSavedVersion);
+      }
+
+      nsGraphVersioning::GetSingleton()->PatchGraph(&graph, &typesGraph);
+
+      for (auto it = graph.GetAllNodes().GetIterator(); it.IsValid(); ++it)
+      {
+        const nsAbstractObjectNode* pNode = it.Value();
+        NS_TEST_INT(pNode->GetTypeVersion(), 7);
+        NS_TEST_BOOL((pNode->FindProperty("Patch3") != nullptr) == (uiSavedVersion < 3));
+        NS_TEST_BOOL((pNode->FindProperty("Patch7") != nullptr) == (uiSavedVersion < 7));
+      }
+    }
+  }
+}
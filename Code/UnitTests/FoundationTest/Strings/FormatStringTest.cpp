@@ -193,6 +193,52 @@ NS_CREATE_SIMPLE_TEST(Strings, FormatString)
     TestFormat(nsFmt("{2}, {}, {1}, {}", nsUInt8(1), nsUInt16(2), nsUInt32(3), nsUInt64(4), nsUInt64(5)), "3, 4, 2, 3");
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "NS_FMT")
+  {
+    TestFormat(NS_FMT("Text"), "Text");
+    TestFormat(NS_FMT(""), "");
+    TestFormat(NS_FMT("{}{}{}{}", nsInt8(1), nsInt16(2), nsInt32(3), nsInt64(4)), "1234");
+    TestFormat(NS_FMT("{3}{2}{1}{0}", nsInt8(1), nsInt16(2), nsInt32(3), nsInt64(4)), "4321");
+    TestFormat(NS_FMT("{2}, {}, {1}, {0}", nsUInt8(1), nsUInt16(2), nsUInt32(3), nsUInt64(4)), "3, 4, 2, 1");
+    TestFormat(NS_FMT("{0} and {0} again", "twice"), "twice and twice again");
+    TestFormat(NS_FMT("100%% of {} {}%%", "nothing", 5), "100% of nothing 5%");
+    TestFormat(NS_FMT("{ not a placeholder {x} }"), "{ not a placeholder {x} }");
+    TestFormat(NS_FMT("Utf8: äöü {} ß", "ÄÖÜ"), "Utf8: äöü ÄÖÜ ß");
+
+    const nsString sString = "String";
+    const nsStringView sView = "View";
+    TestFormat(NS_FMT("{}, {}, {}, {}, {}", sString, sView, 2.5, true, nsArgU(255, 4, true, 16, true)), "String, View, 2.5, true, 00FF");
+
+    // has to give the same result as runtime parsing
+    {
+      nsStringBuilder sb1, sb2;
+      const nsStringView s1 = nsFmt("a{}b{}c{1}d%%e{}", 1, 2.25f, "x").GetText(sb1);
+      const nsStringView s2 = NS_FMT("a{}b{}c{1}d%%e{}", 1, 2.25f, "x").GetText(sb2);
+      NS_TEST_STRING(s1, s2);
+    }
+
+    // fixed buffer
+    {
+      char szBuffer[16];
+      NS_TEST_INT(NS_FMT("{} + {} = {}", 1, 2, 3).WriteTo(szBuffer, NS_ARRAY_SIZE(szBuffer)), 9);
+      NS_TEST_STRING(szBuffer, "1 + 2 = 3");
+
+      NS_TEST_INT(NS_FMT("Truncated: {}", "abcdefghijk").WriteTo(szBuffer, NS_ARRAY_SIZE(szBuffer)), 22);
+      NS_TEST_STRING(szBuffer, "Truncated: abcd");
+    }
+
+    // the segments are computed at compile time
+    constexpr nsCompiledFormatString<nsCompiledFormatString<1>::CountSegments("a{}b{1}c%%d")> format("a{}b{1}c%%d");
+    static_assert(format.m_uiNumSegments == 4);
+    static_assert(format.m_uiNumArguments == 2);
+    static_assert(format.m_Segments[0].m_uiLength == 1 && format.m_Segments[0].m_iArgument == 0);
+    static_assert(format.m_Segments[1].m_uiStart == 3 && format.m_Segments[1].m_iArgument == 1);
+    static_assert(format.m_Segments[2].m_uiStart == 7 && format.m_Segments[2].m_uiLength == 2 && format.m_Segments[2].m_iArgument == -1);
+    static_assert(format.m_Segments[3].m_uiStart == 10 && format.m_Segments[3].m_uiLength == 1);
+    static_assert(!nsCompiledFormatString<1>("50%").UsesAllArguments(1));
+    static_assert(nsCompiledFormatString<1>("50%").m_bSinglePercentSign);
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "nsTime")
   {
     TestFormat(nsFmt("{}", nsTime()), "0ns");
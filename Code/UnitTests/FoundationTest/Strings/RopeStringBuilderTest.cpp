@@ -0,0 +1,171 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/RopeStringBuilder.h>
+#include <Foundation/Strings/StringBuilder.h>
+
+NS_CREATE_SIMPLE_TEST(Strings, RopeStringBuilder)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Append")
+  {
+    nsRopeStringBuilder rope;
+    NS_TEST_BOOL(rope.IsEmpty());
+
+    rope.Append("Hello");
+    rope.Append("");
+    rope.Append(", ");
+    rope.AppendFormat("{} {}!", "World", 42);
+
+    NS_TEST_INT(rope.GetElementCount(), 16);
+    NS_TEST_INT(rope.GetPieceCount(), 1);
+
+    nsStringBuilder sText;
+    rope.GetText(sText);
+    NS_TEST_STRING(sText, "Hello, World 42!");
+
+    rope.Clear();
+    NS_TEST_BOOL(rope.IsEmpty());
+    NS_TEST_INT(rope.GetPieceCount(), 0);
+
+    // text that spans many chunks, plus one that is larger than a chunk
+    nsStringBuilder sExpected;
+    for (nsUInt32 i = 0; i < 10000; ++i)
+    {
+      rope.AppendFormat("Line {}\n", i);
+      sExpected.AppendFormat("Line {}\n", i);
+    }
+
+    nsStringBuilder sLarge;
+    while (sLarge.GetElementCount() <= nsRopeStringBuilder::ChunkSize)
+      sLarge.Append("0123456789abcdef");
+    rope.Append(sLarge);
+    sExpected.Append(sLarge);
+
+    rope.GetText(sText);
+    NS_TEST_INT(rope.GetElementCount(), sExpected.GetElementCount());
+    NS_TEST_BOOL(sText == sExpected);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Insert / Remove / Replace")
+  {
+    nsRopeStringBuilder rope;
+    nsStringBuilder sText;
+
+    rope.Append("abcdef");
+    rope.Insert(3, "XY");
+    rope.Insert(0, "<");
+    rope.Insert(rope.GetElementCount(), ">");
+    rope.GetText(sText);
+    NS_TEST_STRING(sText, "<abcXYdef>");
+
+    // consecutive inserts at the same spot extend one piece
+    const nsUInt32 uiPieces = rope.GetPieceCount();
+    rope.Insert(6, "1");
+    rope.Insert(7, "2");
+    rope.Insert(8, "3");
+    NS_TEST_INT(rope.GetPieceCount(), uiPieces + 1);
+    rope.GetText(sText);
+    NS_TEST_STRING(sText, "<abcXY123def>");
+
+    rope.Remove(4, 4);
+    rope.GetText(sText);
+    NS_TEST_STRING(sText, "<abc3def>");
+
+    rope.Replace(1, 3, "ABC");
+    rope.Replace(5, 3, "");
+    rope.Replace(4, 0, "-");
+    rope.GetText(sText);
+    NS_TEST_STRING(sText, "<ABC-3>");
+
+    rope.Remove(0, rope.GetElementCount());
+    NS_TEST_BOOL(rope.IsEmpty());
+    NS_TEST_INT(rope.GetPieceCount(), 0);
+
+    rope.Insert(0, "äöü");
+    rope.Insert(2, "-");
+    rope.GetText(sText);
+    NS_TEST_STRING(sText, nsStringUtf8(L"ä-öü").GetData());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Random Edits")
+  {
+    nsRandom rnd;
+    rnd.Initialize(42);
+
+    nsRopeStringBuilder rope;
+    nsStringBuilder sExpected;
+    nsStringBuilder sText;
+    nsStringBuilder sTmp;
+
+    for (nsUInt32 i = 0; i < 2000; ++i)
+    {
+      const nsUInt32 uiCount = sExpected.GetElementCount();
+      const nsUInt32 uiPos = rnd.UIntInRange(uiCount + 1);
+      const nsUInt32 uiLength = rnd.UIntInRange(uiCount - uiPos + 1);
+
+      sTmp.Format("[{}]", i);
+
+      switch (rnd.UIntInRange(4))
+      {
+        case 0:
+          rope.Append(sTmp);
+          sExpected.Append(sTmp);
+          break;
+
+        case 1:
+          rope.Insert(uiPos, sTmp);
+          sExpected.Insert(sExpected.GetData() + uiPos, sTmp);
+          break;
+
+        case 2:
+          rope.Remove(uiPos, uiLength / 4);
+          sExpected.ReplaceSubString(sExpected.GetData() + uiPos, sExpected.GetData() + uiPos + uiLength / 4, "");
+          break;
+
+        case 3:
+          rope.Replace(uiPos, uiLength / 4, sTmp);
+          sExpected.ReplaceSubString(sExpected.GetData() + uiPos, sExpected.GetData() + uiPos + uiLength / 4, sTmp);
+          break;
+      }
+
+      NS_TEST_INT(rope.GetElementCount(), sExpected.GetElementCount());
+    }
+
+    rope.GetText(sText);
+    NS_TEST_BOOL(sText == sExpected);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "WriteTo / IteratePieces")
+  {
+    nsRopeStringBuilder rope;
+    rope.Append("{ \"a\": 1 }");
+    rope.Insert(9, ", \"b\": 2 ");
+
+    nsDefaultMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    NS_TEST_RESULT(rope.WriteTo(writer));
+
+    char szWritten[64] = {};
+    nsMemoryStreamReader reader(&storage);
+    NS_TEST_INT(reader.ReadBytes(szWritten, sizeof(szWritten) - 1), rope.GetElementCount());
+
+    const nsStringBuilder sWritten = szWritten;
+    NS_TEST_STRING(sWritten, "{ \"a\": 1 , \"b\": 2 }");
+
+    nsUInt32 uiNumPieces = 0;
+    nsStringBuilder sIterated;
+    rope.IteratePieces([&](nsStringView sPiece)
+      {
+        ++uiNumPieces;
+        sIterated.Append(sPiece); });
+
+    NS_TEST_INT(uiNumPieces, rope.GetPieceCount());
+    NS_TEST_STRING(sIterated, sWritten);
+  }
+}
@@ -0,0 +1,172 @@
+/*
+ *   Copyright (c) 2023-present WD Studios L.L.C.
+ *   All rights reserved.
+ *   You are only allowed access to this code, if given WRITTEN permission by Watch Dogs LLC.
+ */
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Strings/SharedString.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+NS_CREATE_SIMPLE_TEST(Strings, SharedString)
+{
+  const char* szLong = "This string is too long to be stored inline";
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Constructor")
+  {
+    nsSharedString s;
+    NS_TEST_BOOL(s.IsEmpty());
+    NS_TEST_BOOL(s.IsInline());
+    NS_TEST_STRING(s.GetData(), "");
+    NS_TEST_INT(s.GetHash(), nsHashHelper<nsStringView>::Hash(""));
+
+    nsSharedString s2("Short");
+    NS_TEST_STRING(s2.GetData(), "Short");
+    NS_TEST_INT(s2.GetElementCount(), 5);
+    NS_TEST_BOOL(s2.IsInline());
+    NS_TEST_INT(s2.GetRefCount(), 1);
+
+    nsSharedString s3(szLong);
+    NS_TEST_STRING(s3.GetData(), szLong);
+    NS_TEST_INT(s3.GetElementCount(), nsStringUtils::GetStringElementCount(szLong));
+    NS_TEST_BOOL(!s3.IsInline());
+    NS_TEST_INT(s3.GetRefCount(), 1);
+    NS_TEST_INT(s3.GetHash(), nsHashHelper<nsStringView>::Hash(szLong));
+
+    // the longest inline string and the shortest shared one
+    nsSharedString s4(nsStringView("12345678901234567890123456789", nsSharedString::InlineCapacity));
+    NS_TEST_BOOL(s4.IsInline());
+    NS_TEST_STRING(s4.GetData(), "12345678901234567890123");
+
+    nsSharedString s5(nsStringView("12345678901234567890123456789", nsSharedString::InlineCapacity + 1));
+    NS_TEST_BOOL(!s5.IsInline());
+    NS_TEST_STRING(s5.GetData(), "123456789012345678901234");
+
+    // a view that is not zero terminated
+    nsSharedString s6(nsStringView(szLong + 5, 6));
+    NS_TEST_STRING(s6.GetData(), "string");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Copying")
+  {
+    nsSharedString s(szLong);
+
+    {
+      nsSharedString s2(s);
+      NS_TEST_INT(s.GetRefCount(), 2);
+      NS_TEST_BOOL(s2.GetData() == s.GetData());
+
+      nsSharedString s3;
+      s3 = s2;
+      NS_TEST_INT(s.GetRefCount(), 3);
+      NS_TEST_BOOL(s3.GetData() == s.GetData());
+
+      s3 = s3;
+      NS_TEST_INT(s.GetRefCount(), 3);
+
+      nsSharedString s4(std::move(s3));
+      NS_TEST_INT(s.GetRefCount(), 3);
+      NS_TEST_BOOL(s3.IsEmpty());
+      NS_TEST_BOOL(s3 == nsSharedString());
+      NS_TEST_INT(s3.GetHash(), nsHashHelper<nsStringView>::Hash(""));
+      NS_TEST_STRING(s4.GetData(), szLong);
+
+      s4 = "Short";
+      NS_TEST_INT(s.GetRefCount(), 2);
+      NS_TEST_STRING(s4.GetData(), "Short");
+
+      s2.Clear();
+      NS_TEST_INT(s.GetRefCount(), 1);
+      NS_TEST_BOOL(s2.IsEmpty());
+      NS_TEST_BOOL(s2 == "");
+    }
+
+    NS_TEST_INT(s.GetRefCount(), 1);
+    NS_TEST_STRING(s.GetData(), szLong);
+
+    // assigning a part of its own data
+    s = nsStringView(s.GetData() + 5, 31);
+    NS_TEST_STRING(s.GetData(), "string is too long to be stored");
+
+    s = nsStringView(s.GetData(), 6);
+    NS_TEST_STRING(s.GetData(), "string");
+    NS_TEST_BOOL(s.IsInline());
+
+    nsSharedString sShort("Short");
+    nsSharedString sShort2;
+    sShort2 = sShort;
+    NS_TEST_STRING(sShort2.GetData(), "Short");
+    NS_TEST_BOOL(sShort2.GetData() != sShort.GetData());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Comparison")
+  {
+    nsSharedString s1(szLong);
+    nsSharedString s2(szLong);
+    nsSharedString s3(s1);
+    nsSharedString s4("Short");
+
+    NS_TEST_BOOL(s1 == s2);
+    NS_TEST_BOOL(s1 == s3);
+    NS_TEST_BOOL(s1 != s4);
+    NS_TEST_BOOL(s1 == szLong);
+    NS_TEST_BOOL(s1 == nsStringView(szLong));
+    NS_TEST_BOOL(s4 == "Short");
+    NS_TEST_BOOL(s4 != "Shor");
+    NS_TEST_BOOL(s4 != nsStringView("Shorts"));
+
+    NS_TEST_BOOL(s4 < s1);
+    NS_TEST_BOOL(!(s1 < s2));
+
+    nsStringBuilder sb;
+    sb.Format("{}", s4);
+    NS_TEST_STRING(sb, "Short");
+
+    nsString sCopy(s1);
+    NS_TEST_STRING(sCopy, szLong);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "HashTable")
+  {
+    nsHashTable<nsSharedString, nsUInt32> table;
+
+    nsSharedString sKey(szLong);
+    table.Insert(sKey, 1);
+    table.Insert(nsSharedString("Short"), 2);
+    table.Insert("Literal", 3);
+
+    NS_TEST_INT(sKey.GetRefCount(), 2);
+
+    nsUInt32 uiValue = 0;
+    NS_TEST_BOOL(table.TryGetValue(szLong, uiValue));
+    NS_TEST_INT(uiValue, 1);
+    NS_TEST_BOOL(table.TryGetValue(nsStringView("Short"), uiValue));
+    NS_TEST_INT(uiValue, 2);
+    NS_TEST_BOOL(table.TryGetValue(nsSharedString("Literal"), uiValue));
+    NS_TEST_INT(uiValue, 3);
+    NS_TEST_BOOL(!table.Contains("Missing"));
+
+    table.Remove(sKey);
+    NS_TEST_INT(sKey.GetRefCount(), 1);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Threads")
+  {
+    nsSharedString s(szLong);
+
+    // copies are created and destroyed on many threads at once
+    nsTaskSystem::ParallelForIndexed(0u, 10000u, [&](nsUInt32 uiStartIndex, nsUInt32 uiEndIndex)
+      {
+        for (nsUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          nsSharedString sCopy(s);
+          nsSharedString sCopy2;
+          sCopy2 = sCopy;
+          NS_TEST_BOOL(sCopy2 == s);
+        } });
+
+    NS_TEST_INT(s.GetRefCount(), 1);
+  }
+}
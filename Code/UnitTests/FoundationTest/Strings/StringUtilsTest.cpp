@@ -679,6 +679,80 @@ NS_CREATE_SIMPLE_TEST(Strings, StringUtils)
     NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(s.GetData(), "abC2", s.GetData() + 33) == nullptr);
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Long Strings")
+  {
+    // longer strings are processed in blocks, make sure the block boundaries and terminators inside blocks are handled
+    nsStringUtf8 sMixed(L"The quick brown fox jumps over the lazy dog, äöü € and the lazy dog jumps over the quick brown fox ÄÖÜ!");
+    const char* szMixed = sMixed.GetData();
+
+    nsUInt32 uiCC, uiEC;
+    nsStringUtils::GetCharacterAndElementCount(szMixed, uiCC, uiEC);
+    NS_TEST_INT(uiCC, 103);
+    NS_TEST_INT(uiEC, 111);
+    NS_TEST_INT(nsStringUtils::GetCharacterCount(szMixed), 103);
+    NS_TEST_INT(nsStringUtils::GetCharacterCount(szMixed, szMixed + 49), 47);
+
+    for (nsUInt32 uiLength = 0; uiLength <= 40; ++uiLength)
+    {
+      const char* szAscii = "0123456789abcdefghijklmnopqrstuvwxyz0123";
+      nsStringUtils::GetCharacterAndElementCount(szAscii, uiCC, uiEC, szAscii + uiLength);
+      NS_TEST_INT(uiCC, uiLength);
+      NS_TEST_INT(uiEC, uiLength);
+    }
+
+    char szCopy[256];
+    nsStringUtils::Copy(szCopy, 256, szMixed);
+    nsStringUtils::ToUpperString(szCopy);
+    NS_TEST_STRING(szCopy, nsStringUtf8(L"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG, ÄÖÜ € AND THE LAZY DOG JUMPS OVER THE QUICK BROWN FOX ÄÖÜ!").GetData());
+    nsStringUtils::ToLowerString(szCopy);
+    NS_TEST_STRING(szCopy, nsStringUtf8(L"the quick brown fox jumps over the lazy dog, äöü € and the lazy dog jumps over the quick brown fox äöü!").GetData());
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase(szMixed, szCopy) == 0);
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase(szMixed, szCopy, szMixed + 60, szCopy + 61) < 0);
+
+    // characters that change their size
+    nsStringUtf8 sShrink(L"0123456789abcdefghij\u0131\u017F0123456789abcdefghij");
+    nsStringUtils::Copy(szCopy, 256, sShrink.GetData());
+    nsStringUtils::ToUpperString(szCopy);
+    NS_TEST_STRING(szCopy, "0123456789ABCDEFGHIJIS0123456789ABCDEFGHIJ");
+
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase("0123456789abcdefghijKlmnop", "0123456789ABCDEFGHIJkLMNOQ") < 0);
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase("0123456789abcdefghijklmnop", "0123456789ABCDEFGHIJKLMNO") > 0);
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase("0123456789abcdefghijklmnop", "0123456789ABCDEFGHIJKLMNOPQ") < 0);
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase("0123456789abcdefghijklmn[p", "0123456789ABCDEFGHIJKLMN{P") < 0);
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase(sShrink.GetData(), "0123456789ABCDEFGHIJIS0123456789ABCDEFGHIJ") == 0);
+    NS_TEST_BOOL(nsStringUtils::CompareN_NoCase("0123456789abcdefghijklmnop", "0123456789ABCDEFGHIJKLMNOQ", 25) == 0);
+    NS_TEST_BOOL(nsStringUtils::CompareN_NoCase("0123456789abcdefghijklmnop", "0123456789ABCDEFGHIJKLMNOQ", 26) < 0);
+    NS_TEST_BOOL(nsStringUtils::CompareN_NoCase(sShrink.GetData(), "0123456789ABCDEFGHIJIS0", 23) == 0);
+
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "fox") == szMixed + 16);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "fox ") == szMixed + 16);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "fox \xC3") == szMixed + 100);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "!") == szMixed + 110);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "x") == szMixed + 18);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "cat") == nullptr);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, nsStringUtf8(L"€").GetData()) == szMixed + 52);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "!", szMixed + 110) == nullptr);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "fox", szMixed + 18) == nullptr);
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szMixed, "fox", szMixed + 19) == szMixed + 16);
+
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(szMixed, "FOX") == szMixed + 16);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(szMixed, "LAZY DOG J") == szMixed + 64);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(szMixed, nsStringUtf8(L"FOX äöü").GetData()) == szMixed + 100);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(szMixed, "dOG, ") == szMixed + 40);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(szMixed, "Cat") == nullptr);
+
+    // 'i' and 's' also match characters outside of the ASCII range
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(sShrink.GetData(), "is") == sShrink.GetData() + 20);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(sShrink.GetData(), "s0") == sShrink.GetData() + 22);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(sShrink.GetData(), "jI") == sShrink.GetData() + 19);
+
+    // terminators in the middle of a block
+    const char szTerminated[] = "0123456789abcdefghij\0fox0123456789abcdefghij";
+    NS_TEST_BOOL(nsStringUtils::FindSubString(szTerminated, "fox") == nullptr);
+    NS_TEST_BOOL(nsStringUtils::FindSubString_NoCase(szTerminated, "FOX") == nullptr);
+    NS_TEST_INT(nsStringUtils::GetCharacterCount(szTerminated), 20);
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "FindLastSubString")
   {
     nsStringUtf8 s(L"abc def ghi äöü jkl ßßß abc2 def2 ghi2 äöü2 ß");
@@ -882,4 +956,76 @@ NS_CREATE_SIMPLE_TEST(Strings, StringUtils)
     NS_TEST_BOOL(nsStringUtils::IsValidIdentifierName("asdf1"));
     NS_TEST_BOOL(nsStringUtils::IsValidIdentifierName("_asdf"));
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "OutputShortestFloat")
+  {
+    char szBuffer[64];
+
+    auto ToString = [&](auto value) -> const char*
+    {
+      nsUInt32 uiWritePos = 0;
+      nsStringUtils::OutputShortestFloat(szBuffer, NS_ARRAY_SIZE(szBuffer), uiWritePos, value);
+      szBuffer[uiWritePos] = '\0';
+      return szBuffer;
+    };
+
+    NS_TEST_STRING(ToString(0.1), "0.1");
+    NS_TEST_STRING(ToString(0.1f), "0.1");
+    NS_TEST_STRING(ToString(-2.5), "-2.5");
+    NS_TEST_STRING(ToString(0.0), "0");
+    NS_TEST_STRING(ToString(100.0), "100");
+    NS_TEST_STRING(ToString(1.0 / 3.0), "0.3333333333333333");
+    NS_TEST_STRING(ToString(1.0f / 3.0f), "0.33333334");
+    NS_TEST_STRING(ToString(1e-5), "0.00001");
+    NS_TEST_STRING(ToString(23e4f), "230000");
+    NS_TEST_STRING(ToString(123.456), "123.456");
+    NS_TEST_STRING(ToString(1e20), "100000000000000000000");
+    NS_TEST_STRING(ToString(1e21), "1e+21");
+    NS_TEST_STRING(ToString(-5e-7), "-5e-7");
+    NS_TEST_STRING(ToString(1.5e-300), "1.5e-300");
+    NS_TEST_STRING(ToString(1e300), "1e+300");
+    NS_TEST_STRING(ToString(nsMath::Infinity<double>()), "Infinity");
+    NS_TEST_STRING(ToString(-nsMath::Infinity<float>()), "-Infinity");
+    NS_TEST_STRING(ToString(nsMath::NaN<double>()), "NaN");
+
+    // everything has to survive a round trip
+    const double values[] = {0.1, 1.0 / 3.0, 2.2250738585072014e-308, 4.9406564584124654e-324, 1.7976931348623157e308, 3.4028234663852886e38, -123456.789, 5e-10};
+
+    for (double value : values)
+    {
+      double fRead = 0;
+      NS_TEST_BOOL(nsConversionUtils::StringToFloat(ToString(value), fRead) == NS_SUCCESS);
+      NS_TEST_BOOL(fRead == value);
+
+      const float fValue = static_cast<float>(value);
+      if (!nsMath::IsFinite(fValue))
+        continue;
+
+      float fFloatRead = 0;
+      NS_TEST_BOOL(nsConversionUtils::StringToFloat(ToString(fValue), fFloatRead) == NS_SUCCESS);
+      NS_TEST_BOOL(fFloatRead == fValue);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "OutputFormattedUInt")
+  {
+    const nsUInt64 values[] = {0, 7, 10, 99, 100, 12345, 1000000, 4294967295ull, 18446744073709551615ull};
+    const char* szExpected[] = {"0", "7", "10", "99", "100", "12345", "1000000", "4294967295", "18446744073709551615"};
+
+    for (nsUInt32 i = 0; i < NS_ARRAY_SIZE(values); ++i)
+    {
+      char szBuffer[32];
+      nsUInt32 uiWritePos = 0;
+      nsStringUtils::OutputFormattedUInt(szBuffer, NS_ARRAY_SIZE(szBuffer), uiWritePos, values[i], 0, false, 10, false);
+      szBuffer[uiWritePos] = '\0';
+
+      NS_TEST_STRING(szBuffer, szExpected[i]);
+    }
+
+    char szBuffer[32];
+    nsUInt32 uiWritePos = 0;
+    nsStringUtils::OutputFormattedUInt(szBuffer, NS_ARRAY_SIZE(szBuffer), uiWritePos, 42, 6, true, 10, false);
+    szBuffer[uiWritePos] = '\0';
+    NS_TEST_STRING(szBuffer, "000042");
+  }
 }
@@ -309,4 +309,37 @@ NS_CREATE_SIMPLE_TEST(Strings, UnicodeUtils)
     NS_TEST_BOOL(nsUnicodeUtils::IsUtf16Surrogate(szNoSurrogate) == false);
     NS_TEST_BOOL(nsUnicodeUtils::IsUtf16Surrogate(szSurrogate) == true);
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "IsValidUtf8")
+  {
+    NS_TEST_BOOL(nsUnicodeUtils::IsValidUtf8(""));
+    NS_TEST_BOOL(nsUnicodeUtils::IsValidUtf8("abc"));
+
+    nsStringUtf8 s(L"This text is longer than a block: äöü € and some more ASCII after it");
+    NS_TEST_BOOL(nsUnicodeUtils::IsValidUtf8(s.GetData()));
+
+    // a sequence that is cut off by the end of the string
+    NS_TEST_BOOL(!nsUnicodeUtils::IsValidUtf8(s.GetData(), s.GetData() + 35));
+    NS_TEST_BOOL(nsUnicodeUtils::IsValidUtf8(s.GetData(), s.GetData() + 36));
+
+    char szInvalid[64];
+    nsStringUtils::Copy(szInvalid, 64, "0123456789abcdefghijklmnopqrstuvwxyz");
+
+    // invalid bytes in different positions of the blocks
+    for (nsUInt32 i = 0; i < 36; ++i)
+    {
+      const char c = szInvalid[i];
+
+      szInvalid[i] = static_cast<char>(0xFF);
+      NS_TEST_BOOL(!nsUnicodeUtils::IsValidUtf8(szInvalid));
+
+      // a continuation byte without a start byte
+      szInvalid[i] = static_cast<char>(0x80);
+      NS_TEST_BOOL(!nsUnicodeUtils::IsValidUtf8(szInvalid));
+
+      szInvalid[i] = c;
+    }
+
+    NS_TEST_BOOL(nsUnicodeUtils::IsValidUtf8(szInvalid));
+  }
 }
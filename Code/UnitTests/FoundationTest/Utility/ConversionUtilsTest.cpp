@@ -6,6 +6,7 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Math/Random.h>
+#include <Foundation/Strings/Implementation/CharConv.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
 NS_CREATE_SIMPLE_TEST_GROUP(Utility);
@@ -431,6 +432,61 @@ NS_CREATE_SIMPLE_TEST(Utility, ConversionUtils)
     NS_TEST_DOUBLE(fRes, 100'000.0, 0.000001);
   }
 
+  // without std::from_chars the conversion is only approximate
+#if NS_ENABLED(NS_USE_CHARCONV_FLOAT)
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "StringToFloat (exact)")
+  {
+    // the results have to be bit identical to the closest representable value
+    double fRes = 0;
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("0.1", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 0.1);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("123456.789e-3", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 123.456789);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("2.2250738585072014e-308", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 2.2250738585072014e-308);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("4.9406564584124654e-324", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 4.9406564584124654e-324);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("1.7976931348623157e308", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 1.7976931348623157e308);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("9007199254740993", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 9007199254740992.0);
+
+    // exactly half way between two doubles, only the digits far behind decide the rounding direction
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("9007199254740993.00000000000000000000000000000001", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 9007199254740994.0);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("3.141592653589793238462643383279502884197169399375105820974944", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 3.141592653589793238462643383279502884197169399375105820974944);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("-1e400", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(!nsMath::IsFinite(fRes) && fRes < 0);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("1e-400", fRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fRes == 0.0);
+
+    float fFloatRes = 0;
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("0.1", fFloatRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fFloatRes == 0.1f);
+
+    // rounding to double first gives exactly 1 + 2^-24, which is then rounded to even (1.0f), correct rounding gives 1.00000012f
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("1.000000059604644775390625000000000001", fFloatRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fFloatRes == 1.00000012f);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("1.00000005960464477539062499", fFloatRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fFloatRes == 1.0f);
+
+    NS_TEST_BOOL(nsConversionUtils::StringToFloat("3.4028234663852886e38", fFloatRes) == NS_SUCCESS);
+    NS_TEST_BOOL(fFloatRes == 3.4028234663852886e38f);
+  }
+#endif
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "StringToBool")
   {
     const char* szString = "";